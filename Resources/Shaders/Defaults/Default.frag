@@ -4,9 +4,6 @@
 
 layout(binding = 1) uniform UboObject
 {
-#if ANIMATED
-	mat4 jointTransforms[MAX_JOINTS];
-#endif
 	mat4 transform;
 
 	vec4 baseDiffuse;
@@ -14,6 +11,9 @@ layout(binding = 1) uniform UboObject
 	float roughness;
 	float ignoreFog;
 	float ignoreLighting;
+#if ANIMATED
+	int jointOffset;
+#endif
 } object;
 
 #if DIFFUSE_MAPPING
@@ -11,9 +11,6 @@ layout(binding = 0) uniform UboScene
 
 layout(binding = 1) uniform UboObject
 {
-#if ANIMATED
-	mat4 jointTransforms[MAX_JOINTS];
-#endif
 	mat4 transform;
 
 	vec4 baseDiffuse;
@@ -21,8 +18,18 @@ layout(binding = 1) uniform UboObject
 	float roughness;
 	float ignoreFog;
 	float ignoreLighting;
+#if ANIMATED
+	int jointOffset;
+#endif
 } object;
 
+#if ANIMATED
+layout(binding = 5) readonly buffer BufferJoints
+{
+	mat4 jointTransforms[];
+} bufferJoints;
+#endif
+
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec2 inUv;
 layout(location = 2) in vec3 inNormal;
@@ -33,6 +40,9 @@ layout(location = 3) in vec3 inTangent;
 layout(location = 4) in vec3 inJointIds;
 layout(location = 5) in vec3 inWeights;
 #endif
+#if INSTANCED
+layout(location = 4) in mat4 inTransform;
+#endif
 
 layout(location = 0) out vec4 outPosition;
 layout(location = 1) out vec2 outUv;
@@ -54,7 +64,7 @@ void main()
 
 	for (int i = 0; i < MAX_WEIGHTS; i++)
 	{
-		mat4 jointTransform = object.jointTransforms[int(inJointIds[i])];
+		mat4 jointTransform = bufferJoints.jointTransforms[object.jointOffset + int(inJointIds[i])];
 		vec4 posePosition = jointTransform * vec4(inPosition, 1.0f);
 		position += posePosition * inWeights[i];
 
@@ -66,8 +76,14 @@ void main()
 	vec4 normal = vec4(inNormal, 0.0f);
 #endif
 
-	vec4 worldPosition = object.transform * position;
-    mat3 normalMatrix = transpose(inverse(mat3(object.transform)));
+#if INSTANCED
+	mat4 transform = inTransform;
+#else
+	mat4 transform = object.transform;
+#endif
+
+	vec4 worldPosition = transform * position;
+    mat3 normalMatrix = transpose(inverse(mat3(transform)));
 
 	gl_Position = scene.projection * scene.view * worldPosition;
 
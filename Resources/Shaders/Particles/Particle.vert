@@ -8,13 +8,19 @@ layout(set = 0, binding = 0) uniform UboScene
 	mat4 view;
 } scene;
 
+layout(set = 0, binding = 2) uniform UboObject
+{
+	vec4 colourOffset;
+	float numberOfRows;
+} object;
+
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec2 inUv;
 
-layout(location = 4) in mat4 inModelMatrix;
-layout(location = 8) in vec4 inColourOffset;
-layout(location = 9) in vec4 inOffsets;
-layout(location = 10) in vec3 inBlend;
+layout(location = 4) in vec3 inInstancePosition;
+layout(location = 5) in float inRotation;
+layout(location = 6) in vec4 inOffsets;
+layout(location = 7) in vec3 inBlend;
 
 layout(location = 0) out vec2 outCoords1;
 layout(location = 1) out vec2 outCoords2;
@@ -29,13 +35,20 @@ out gl_PerVertex
 
 void main()
 {
-	vec4 worldPosition = inModelMatrix * vec4(inPosition, 1.0f);
+	// Billboards the quad, the cameras right and up axes are the first two rows of the view rotation.
+	vec3 cameraRight = vec3(scene.view[0][0], scene.view[1][0], scene.view[2][0]);
+	vec3 cameraUp = vec3(scene.view[0][1], scene.view[1][1], scene.view[2][1]);
+
+	float s = sin(inRotation);
+	float c = cos(inRotation);
+	vec2 corner = mat2(c, s, -s, c) * inPosition.xy * inBlend.z;
+	vec4 worldPosition = vec4(inInstancePosition + cameraRight * corner.x + cameraUp * corner.y, 1.0f);
 
 	gl_Position = scene.projection * scene.view * worldPosition;
 
-	vec2 uv = inUv / inBlend.z;
+	vec2 uv = inUv / object.numberOfRows;
 
-	outColourOffset = inColourOffset;
+	outColourOffset = object.colourOffset;
 	outCoords1 = uv + inOffsets.xy;
 	outCoords2 = uv + inOffsets.zw;
 	outBlendFactor = inBlend.x;
@@ -4,8 +4,11 @@
 // Acid header file.
 //
 
+#include "Animations/AnimatedModel.hpp"
 #include "Animations/Animation/Animation.hpp"
+#include "Animations/Animation/AnimationClip.hpp"
 #include "Animations/Animation/AnimationLoader.hpp"
+#include "Animations/Animations.hpp"
 #include "Animations/Animator.hpp"
 #include "Animations/Geometry/GeometryLoader.hpp"
 #include "Animations/Geometry/VertexAnimated.hpp"
@@ -14,6 +17,7 @@
 #include "Animations/Joint/JointTransform.hpp"
 #include "Animations/Keyframe/Keyframe.hpp"
 #include "Animations/MeshAnimated.hpp"
+#include "Animations/Skeleton/Skeleton.hpp"
 #include "Animations/Skeleton/SkeletonLoader.hpp"
 #include "Animations/Skin/SkinLoader.hpp"
 #include "Animations/Skin/VertexWeights.hpp"
@@ -50,6 +54,7 @@
 #include "Files/Files.hpp"
 #include "Files/FileSystem.hpp"
 #include "Files/FileWatcher.hpp"
+#include "Files/MappedFile.hpp"
 #include "Fonts/FontMetafile.hpp"
 #include "Fonts/FontType.hpp"
 #include "Fonts/RendererFonts.hpp"
@@ -81,6 +86,7 @@
 #include "Materials/MaterialDefault.hpp"
 #include "Materials/PipelineMaterial.hpp"
 #include "Maths/Colour.hpp"
+#include "Maths/Culling.hpp"
 #include "Maths/Delta.hpp"
 #include "Maths/Interpolation/SmoothFloat.hpp"
 #include "Maths/Maths.hpp"
@@ -88,6 +94,7 @@
 #include "Maths/Matrix3.hpp"
 #include "Maths/Matrix4.hpp"
 #include "Maths/Quaternion.hpp"
+#include "Maths/Simd.hpp"
 #include "Maths/Time.hpp"
 #include "Maths/Timer.hpp"
 #include "Maths/Transform.hpp"
@@ -104,10 +111,12 @@
 #include "Meshes/Mesh.hpp"
 #include "Meshes/MeshRender.hpp"
 #include "Meshes/RendererMeshes.hpp"
+#include "Meshes/RenderQueue.hpp"
 #include "Models/IVertex.hpp"
 #include "Models/Model.hpp"
 #include "Models/ModelRegister.hpp"
 #include "Models/Obj/ModelObj.hpp"
+#include "Models/Obj/ObjParser.hpp"
 #include "Models/Shapes/MeshPattern.hpp"
 #include "Models/Shapes/MeshSimple.hpp"
 #include "Models/Shapes/ModelCube.hpp"
@@ -116,7 +125,6 @@
 #include "Models/Shapes/ModelRectangle.hpp"
 #include "Models/Shapes/ModelSphere.hpp"
 #include "Models/VertexModel.hpp"
-#include "Models/VertexModelData.hpp"
 #include "Network/Ftp/Ftp.hpp"
 #include "Network/Ftp/FtpDataChannel.hpp"
 #include "Network/Ftp/FtpResponse.hpp"
@@ -135,6 +143,8 @@
 #include "Noise/Noise.hpp"
 #include "Particles/Particle.hpp"
 #include "Particles/Particles.hpp"
+#include "Particles/ParticleSorter.hpp"
+#include "Particles/ParticleStore.hpp"
 #include "Particles/ParticleSystem.hpp"
 #include "Particles/ParticleType.hpp"
 #include "Particles/RendererParticles.hpp"
@@ -175,16 +185,23 @@
 #include "Post/PostFilter.hpp"
 #include "Post/PostPipeline.hpp"
 #include "Renderer/Buffers/Buffer.hpp"
+#include "Renderer/Buffers/DynamicInstanceBuffer.hpp"
 #include "Renderer/Buffers/InstanceBuffer.hpp"
 #include "Renderer/Buffers/StorageBuffer.hpp"
 #include "Renderer/Buffers/UniformBuffer.hpp"
 #include "Renderer/Commands/CommandBuffer.hpp"
+#include "Renderer/Commands/CommandPool.hpp"
+#include "Renderer/Commands/UploadQueue.hpp"
 #include "Renderer/Descriptors/Descriptor.hpp"
 #include "Renderer/Descriptors/DescriptorSet.hpp"
 #include "Renderer/Handlers/DescriptorsHandler.hpp"
 #include "Renderer/Handlers/PushHandler.hpp"
 #include "Renderer/Handlers/StorageHandler.hpp"
 #include "Renderer/Handlers/UniformHandler.hpp"
+#include "Renderer/Memory/LinearAllocator.hpp"
+#include "Renderer/Memory/MemoryAllocator.hpp"
+#include "Renderer/Memory/MemoryBlock.hpp"
+#include "Renderer/Memory/RingAllocator.hpp"
 #include "Renderer/Pipelines/Pipeline.hpp"
 #include "Renderer/Pipelines/PipelineCompute.hpp"
 #include "Renderer/Pipelines/PipelineGraphics.hpp"
@@ -200,6 +217,10 @@
 #include "Renderer/RenderStage.hpp"
 #include "Resources/Resource.hpp"
 #include "Resources/Resources.hpp"
+#include "Scenes/Archetypes/Archetype.hpp"
+#include "Scenes/Archetypes/ArchetypeStorage.hpp"
+#include "Scenes/Archetypes/ComponentType.hpp"
+#include "Scenes/Archetypes/View.hpp"
 #include "Scenes/Camera.hpp"
 #include "Scenes/Component.hpp"
 #include "Scenes/ComponentRegister.hpp"
@@ -209,8 +230,12 @@
 #include "Scenes/ScenePhysics.hpp"
 #include "Scenes/Scenes.hpp"
 #include "Scenes/SceneStructure.hpp"
+#include "Scenes/SpatialTree.hpp"
+#include "Scenes/TransformHierarchy.hpp"
+#include "Serialized/Binary/Binary.hpp"
 #include "Serialized/Json/Json.hpp"
 #include "Serialized/Metadata.hpp"
+#include "Serialized/MetadataArena.hpp"
 #include "Serialized/Xml/Xml.hpp"
 #include "Serialized/Yaml/Yaml.hpp"
 #include "Shadows/RendererShadows.hpp"
@@ -221,8 +246,10 @@
 #include "Textures/Cubemap.hpp"
 #include "Textures/DepthStencil.hpp"
 #include "Textures/Texture.hpp"
-#include "Threads/Thread.hpp"
-#include "Threads/ThreadPool.hpp"
+#include "Threads/Job.hpp"
+#include "Threads/JobCounter.hpp"
+#include "Threads/JobDeque.hpp"
+#include "Threads/JobSystem.hpp"
 #include "Uis/Inputs/UiColourWheel.hpp"
 #include "Uis/Inputs/UiInputBoolean.hpp"
 #include "Uis/Inputs/UiInputButton.hpp"
@@ -0,0 +1,101 @@
+#include "AnimatedModel.hpp"
+
+#include <utility>
+#include "Files/File.hpp"
+#include "Resources/Resources.hpp"
+#include "Serialized/Xml/Xml.hpp"
+#include "Animation/AnimationLoader.hpp"
+#include "Geometry/GeometryLoader.hpp"
+#include "Skeleton/SkeletonLoader.hpp"
+#include "Skin/SkinLoader.hpp"
+#include "MeshAnimated.hpp"
+
+namespace acid
+{
+	std::shared_ptr<AnimatedModel> AnimatedModel::Create(const Metadata &metadata)
+	{
+		auto resource = Resources::Get()->Find<AnimatedModel>(metadata);
+
+		if (resource != nullptr)
+		{
+			return resource;
+		}
+
+		auto result = std::make_shared<AnimatedModel>("", false);
+		Resources::Get()->Add(metadata, result);
+		result->Decode(metadata);
+		result->Load();
+		return result;
+	}
+
+	std::shared_ptr<AnimatedModel> AnimatedModel::Create(const std::string &filename)
+	{
+		auto temp = AnimatedModel(filename, false);
+		Metadata metadata = Metadata();
+		temp.Encode(metadata);
+		return Create(metadata);
+	}
+
+	AnimatedModel::AnimatedModel(std::string filename, const bool &load) :
+		m_filename(std::move(filename)),
+		m_model(nullptr),
+		m_skeleton(nullptr),
+		m_animation(nullptr)
+	{
+		if (load)
+		{
+			AnimatedModel::Load();
+		}
+	}
+
+	void AnimatedModel::Load()
+	{
+		if (m_filename.empty())
+		{
+			return;
+		}
+
+		File file = File(m_filename, new Xml("COLLADA"));
+		file.Read();
+
+		SkinLoader skinLoader = SkinLoader(file.GetMetadata()->FindChild("library_controllers"), MeshAnimated::MaxWeights);
+		SkeletonLoader skeletonLoader = SkeletonLoader(file.GetMetadata()->FindChild("library_visual_scenes"), skinLoader.GetJointOrder());
+		GeometryLoader geometryLoader = GeometryLoader(file.GetMetadata()->FindChild("library_geometries"), skinLoader.GetVertexWeights());
+
+		auto vertices = geometryLoader.GetVertices();
+		auto indices = geometryLoader.GetIndices();
+		m_model = std::make_shared<Model>(vertices, indices);
+		m_skeleton = std::make_unique<Skeleton>(*skeletonLoader.GetHeadJoint());
+
+		AnimationLoader animationLoader = AnimationLoader(file.GetMetadata()->FindChild("library_animations"),
+		                                                  file.GetMetadata()->FindChild("library_visual_scenes"));
+		m_animation = std::make_unique<AnimationClip>(Animation(animationLoader.GetLengthSeconds(), animationLoader.GetKeyframes()), *m_skeleton);
+	}
+
+	void AnimatedModel::Decode(const Metadata &metadata)
+	{
+		metadata.GetChild("Filename", m_filename);
+	}
+
+	void AnimatedModel::Encode(Metadata &metadata) const
+	{
+		metadata.SetChild("Filename", m_filename);
+	}
+
+	std::size_t AnimatedModel::GetByteSize() const
+	{
+		std::size_t size = m_model == nullptr ? 0 : m_model->GetByteSize();
+
+		if (m_skeleton != nullptr)
+		{
+			size += m_skeleton->GetJointCount() * (2 * sizeof(Matrix4) + sizeof(int32_t) + sizeof(uint32_t));
+		}
+
+		if (m_animation != nullptr)
+		{
+			size += m_animation->GetKeyframeCount() * (sizeof(float) + m_animation->GetJointCount() * (sizeof(Vector3) + sizeof(Quaternion)));
+		}
+
+		return size;
+	}
+}
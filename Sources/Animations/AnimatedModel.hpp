@@ -0,0 +1,60 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include "Models/Model.hpp"
+#include "Resources/Resource.hpp"
+#include "Animation/AnimationClip.hpp"
+#include "Skeleton/Skeleton.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// The skin model, skeleton and animation loaded from a COLLADA file.
+	/// These are not changed once loaded, so every animated mesh using the same file shares one animated model.
+	/// </summary>
+	class ACID_EXPORT AnimatedModel :
+		public Resource
+	{
+	public:
+		/// <summary>
+		/// Will find an existing animated model with the same values, or create a new animated model.
+		/// </summary>
+		/// <param name="metadata"> The metadata to decode values from. </param>
+		static std::shared_ptr<AnimatedModel> Create(const Metadata &metadata);
+
+		/// <summary>
+		/// Will find an existing animated model with the same values, or create a new animated model.
+		/// </summary>
+		/// <param name="filename"> The COLLADA file to load from. </param>
+		static std::shared_ptr<AnimatedModel> Create(const std::string &filename);
+
+		/// <summary>
+		/// Creates a new animated model.
+		/// </summary>
+		/// <param name="filename"> The COLLADA file to load from. </param>
+		/// <param name="load"> If this resource will load immediately, otherwise <seealso cref="#Load()"/> can be called. </param>
+		explicit AnimatedModel(std::string filename, const bool &load = true);
+
+		void Load() override;
+
+		void Decode(const Metadata &metadata) override;
+
+		void Encode(Metadata &metadata) const override;
+
+		std::size_t GetByteSize() const override;
+
+		const std::string &GetFilename() const { return m_filename; }
+
+		const std::shared_ptr<Model> &GetModel() const { return m_model; }
+
+		const Skeleton *GetSkeleton() const { return m_skeleton.get(); }
+
+		const AnimationClip *GetAnimation() const { return m_animation.get(); }
+	private:
+		std::string m_filename;
+		std::shared_ptr<Model> m_model;
+		std::unique_ptr<Skeleton> m_skeleton;
+		std::unique_ptr<AnimationClip> m_animation;
+	};
+}
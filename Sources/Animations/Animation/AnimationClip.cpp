@@ -0,0 +1,128 @@
+#include "AnimationClip.hpp"
+
+#include <algorithm>
+
+namespace acid
+{
+	AnimationClip::AnimationClip(const Animation &animation, const Skeleton &skeleton) :
+		m_length(animation.GetLength()),
+		m_jointCount(skeleton.GetJointCount())
+	{
+		const auto &keyframes = animation.GetKeyframes();
+
+		for (const auto &keyframe : keyframes)
+		{
+			m_times.emplace_back(keyframe.GetTimeStamp().AsSeconds());
+		}
+
+		// A animation without keyframes holds the bind pose.
+		if (m_times.empty())
+		{
+			m_times.emplace_back(0.0f);
+		}
+
+		auto keyframeCount = m_times.size();
+		m_positions.reserve(m_jointCount * keyframeCount);
+		m_rotations.reserve(m_jointCount * keyframeCount);
+
+		for (uint32_t joint = 0; joint < m_jointCount; joint++)
+		{
+			const auto &name = skeleton.GetNames()[joint];
+			JointTransform bindTransform = JointTransform(skeleton.GetLocalBindTransforms()[joint]);
+
+			for (std::size_t keyframe = 0; keyframe < keyframeCount; keyframe++)
+			{
+				auto transform = bindTransform;
+
+				if (keyframe < keyframes.size())
+				{
+					auto it = keyframes[keyframe].GetPose().find(name);
+
+					if (it != keyframes[keyframe].GetPose().end())
+					{
+						transform = it->second;
+					}
+				}
+
+				m_positions.emplace_back(transform.GetPosition());
+				m_rotations.emplace_back(transform.GetRotation());
+			}
+		}
+	}
+
+	uint32_t AnimationClip::FindKeyframe(const float &time, uint32_t &cursor) const
+	{
+		auto last = static_cast<uint32_t>(m_times.size() - 1);
+
+		if (cursor > last)
+		{
+			cursor = 0;
+		}
+
+		if (m_times[cursor] <= time)
+		{
+			if (cursor == last || time < m_times[cursor + 1])
+			{
+				return cursor;
+			}
+
+			if (cursor + 1 == last || time < m_times[cursor + 2])
+			{
+				return ++cursor;
+			}
+		}
+
+		auto it = std::upper_bound(m_times.begin(), m_times.end(), time);
+		cursor = it == m_times.begin() ? 0 : static_cast<uint32_t>(it - m_times.begin() - 1);
+		return cursor;
+	}
+
+	void AnimationClip::Sample(const float &time, uint32_t &cursor, Vector3 *positions, Quaternion *rotations) const
+	{
+		auto keyframeCount = static_cast<uint32_t>(m_times.size());
+		uint32_t previous, next;
+		auto progression = GetProgression(time, cursor, previous, next);
+
+		for (uint32_t joint = 0; joint < m_jointCount; joint++)
+		{
+			auto track = joint * keyframeCount;
+			positions[joint] = m_positions[track + previous].Lerp(m_positions[track + next], progression);
+			rotations[joint] = m_rotations[track + previous].Slerp(m_rotations[track + next], progression);
+		}
+	}
+
+	void AnimationClip::SampleAdditive(const float &time, uint32_t &cursor, const float &weight, Vector3 *positions, Quaternion *rotations) const
+	{
+		auto keyframeCount = static_cast<uint32_t>(m_times.size());
+		uint32_t previous, next;
+		auto progression = GetProgression(time, cursor, previous, next);
+
+		for (uint32_t joint = 0; joint < m_jointCount; joint++)
+		{
+			auto track = joint * keyframeCount;
+			const auto &referencePosition = m_positions[track];
+			const auto &referenceRotation = m_rotations[track];
+			auto position = m_positions[track + previous].Lerp(m_positions[track + next], progression);
+			auto rotation = m_rotations[track + previous].Slerp(m_rotations[track + next], progression);
+
+			// The rotation from the reference pose, the inverse of a unit quaternion is its conjugate.
+			Quaternion difference = Quaternion(-referenceRotation.m_x, -referenceRotation.m_y, -referenceRotation.m_z, referenceRotation.m_w) * rotation;
+			positions[joint] += (position - referencePosition) * weight;
+			rotations[joint] = (rotations[joint] * Quaternion().Slerp(difference, weight)).Normalize();
+		}
+	}
+
+	float AnimationClip::GetProgression(const float &time, uint32_t &cursor, uint32_t &previous, uint32_t &next) const
+	{
+		auto keyframeCount = static_cast<uint32_t>(m_times.size());
+		previous = FindKeyframe(time, cursor);
+		next = std::min(previous + 1, keyframeCount - 1);
+
+		if (next == previous)
+		{
+			return 0.0f;
+		}
+
+		return std::clamp((time - m_times[previous]) / (m_times[next] - m_times[previous]), 0.0f, 1.0f);
+	}
+}
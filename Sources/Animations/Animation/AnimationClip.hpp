@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+#include "Helpers/NonCopyable.hpp"
+#include "Maths/Quaternion.hpp"
+#include "Maths/Time.hpp"
+#include "Maths/Vector3.hpp"
+#include "Animations/Skeleton/Skeleton.hpp"
+#include "Animation.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// An animation compiled against a skeleton, so it can be sampled without looking up joints by name.
+	/// Each joint has a track of positions and a track of rotations, stored one joint after another with a entry for every keyframe.
+	/// Joints that are not animated have tracks filled with their bind pose.
+	/// </summary>
+	class ACID_EXPORT AnimationClip :
+		public NonCopyable
+	{
+	public:
+		/// <summary>
+		/// Compiles a animation for a skeleton.
+		/// </summary>
+		/// <param name="animation"> The animation to compile. </param>
+		/// <param name="skeleton"> The skeleton the animation will be sampled for. </param>
+		AnimationClip(const Animation &animation, const Skeleton &skeleton);
+
+		const Time &GetLength() const { return m_length; }
+
+		uint32_t GetJointCount() const { return m_jointCount; }
+
+		uint32_t GetKeyframeCount() const { return static_cast<uint32_t>(m_times.size()); }
+
+		/// <summary>
+		/// Finds the last keyframe at or before a time. The cursor is checked first, as most updates stay on the same keyframe or move to the next one,
+		/// then the keyframes are binary searched.
+		/// </summary>
+		/// <param name="time"> The time in seconds. </param>
+		/// <param name="cursor"> The keyframe found by the last search, updated to the keyframe found. </param>
+		/// <returns> The keyframe. </returns>
+		uint32_t FindKeyframe(const float &time, uint32_t &cursor) const;
+
+		/// <summary>
+		/// Samples the local-space position and rotation of every joint at a time, interpolating between the keyframes around the time.
+		/// </summary>
+		/// <param name="time"> The time in seconds. </param>
+		/// <param name="cursor"> The keyframe cursor, see <seealso cref="#FindKeyframe()"/>. </param>
+		/// <param name="positions"> The array to write a position into for each joint in the skeleton. </param>
+		/// <param name="rotations"> The array to write a rotation into for each joint in the skeleton. </param>
+		void Sample(const float &time, uint32_t &cursor, Vector3 *positions, Quaternion *rotations) const;
+
+		/// <summary>
+		/// Samples this clip as a additive layer, the difference between the pose at a time and the first keyframe is weighted and applied on top of a existing pose.
+		/// </summary>
+		/// <param name="time"> The time in seconds. </param>
+		/// <param name="cursor"> The keyframe cursor, see <seealso cref="#FindKeyframe()"/>. </param>
+		/// <param name="weight"> How much of the difference to apply, from 0 to 1. </param>
+		/// <param name="positions"> The positions of the pose to add to. </param>
+		/// <param name="rotations"> The rotations of the pose to add to. </param>
+		void SampleAdditive(const float &time, uint32_t &cursor, const float &weight, Vector3 *positions, Quaternion *rotations) const;
+	private:
+		float GetProgression(const float &time, uint32_t &cursor, uint32_t &previous, uint32_t &next) const;
+
+		Time m_length;
+		uint32_t m_jointCount;
+		std::vector<float> m_times;
+		std::vector<Vector3> m_positions;
+		std::vector<Quaternion> m_rotations;
+	};
+}
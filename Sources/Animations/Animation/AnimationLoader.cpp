@@ -30,13 +30,13 @@ namespace acid
 	std::vector<Time> AnimationLoader::GetKeyTimes() const
 	{
 		auto timeData = m_libraryAnimations->FindChild("animation")->FindChild("source")->FindChild("float_array");
-		auto rawTimes = String::Split(timeData->GetValue(), " ");
+		auto rawTimes = String::FromList<float>(timeData->GetValue());
 		std::vector<Time> times = {};
 		times.reserve(rawTimes.size());
 
 		for (const auto &rawTime : rawTimes)
 		{
-			times.emplace_back(Time::Seconds(String::From<float>(rawTime)));
+			times.emplace_back(Time::Seconds(rawTime));
 		}
 
 		return times;
@@ -57,9 +57,8 @@ namespace acid
 
 		auto transformData = jointData->FindChildWithAttribute("source", "id", dataId);
 
-		std::string data = transformData->FindChild("float_array")->GetValue();
-		auto splitData = String::Split(data, " ");
-		ProcessTransforms(jointNameId, splitData, jointNameId == rootNodeId);
+		auto data = String::FromList<float>(transformData->FindChild("float_array")->GetValue());
+		ProcessTransforms(jointNameId, data, jointNameId == rootNodeId);
 	}
 
 	std::string AnimationLoader::GetDataId(const Metadata *jointData)
@@ -76,7 +75,7 @@ namespace acid
 		return splitData[0];
 	}
 
-	void AnimationLoader::ProcessTransforms(const std::string &jointName, const std::vector<std::string> &rawData, const bool &root)
+	void AnimationLoader::ProcessTransforms(const std::string &jointName, const std::vector<float> &rawData, const bool &root)
 	{
 		for (uint32_t i = 0; i < m_keyframes.size(); i++)
 		{
@@ -84,7 +83,7 @@ namespace acid
 
 			for (uint32_t j = 0; j < 16; j++)
 			{
-				transform.m_linear[j] = String::From<float>(rawData[i * 16 + j]);
+				transform.m_linear[j] = rawData[i * 16 + j];
 			}
 
 			transform = transform.Transpose();
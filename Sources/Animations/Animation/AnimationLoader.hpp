@@ -26,7 +26,7 @@ namespace acid
 
 		static std::string GetJointName(const Metadata *jointData);
 
-		void ProcessTransforms(const std::string &jointName, const std::vector<std::string> &rawData, const bool &root);
+		void ProcessTransforms(const std::string &jointName, const std::vector<float> &rawData, const bool &root);
 
 		const Metadata *m_libraryAnimations;
 		const Metadata *m_libraryVisualScenes;
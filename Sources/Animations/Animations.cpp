@@ -0,0 +1,87 @@
+#include "Animations.hpp"
+
+#include <algorithm>
+#include "Threads/JobSystem.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// The least animators given to each job, below this the cost of handing out jobs is more than the update.
+	/// </summary>
+	static const std::size_t MIN_ANIMATORS_PER_JOB = 16;
+
+	Animations::Animations() :
+		m_storageJoints(nullptr),
+		m_dirty(false)
+	{
+	}
+
+	void Animations::Update()
+	{
+		if (m_dirty)
+		{
+			Repack();
+		}
+
+		auto delta = Engine::Get()->GetDelta();
+
+		// Each job updates a contiguous run of animators, every animator writes into its own run of the shared array.
+		JobSystem::Get()->ParallelFor(0, m_animators.size(), MIN_ANIMATORS_PER_JOB, [this, &delta](const std::size_t &begin, const std::size_t &end)
+		{
+			for (auto i = begin; i < end; i++)
+			{
+				m_animators[i]->Update(delta);
+			}
+		});
+
+		if (m_storageJoints != nullptr)
+		{
+			m_storageJoints->Update(m_jointTransforms.data());
+		}
+	}
+
+	void Animations::Add(Animator *animator)
+	{
+		m_animators.emplace_back(animator);
+		m_dirty = true;
+	}
+
+	void Animations::Remove(Animator *animator)
+	{
+		auto it = std::find(m_animators.begin(), m_animators.end(), animator);
+
+		if (it == m_animators.end())
+		{
+			return;
+		}
+
+		animator->SetJointTransforms(nullptr);
+		m_animators.erase(it);
+		m_dirty = true;
+	}
+
+	void Animations::Repack()
+	{
+		std::size_t transformCount = 0;
+
+		for (const auto &animator : m_animators)
+		{
+			transformCount += animator->GetSkeleton()->GetTransformCount();
+		}
+
+		// Transforms not written by a animator without a animation are left as the identity.
+		m_jointTransforms.assign(transformCount, Matrix4());
+		std::size_t offset = 0;
+
+		for (auto &animator : m_animators)
+		{
+			animator->SetJointTransforms(m_jointTransforms.data() + offset, static_cast<uint32_t>(offset));
+			offset += animator->GetSkeleton()->GetTransformCount();
+		}
+
+		// The buffer is sized for the new array, it is filled after the animators update.
+		m_storageJoints = m_jointTransforms.empty() ? nullptr : std::make_unique<StorageBuffer>(static_cast<VkDeviceSize>(sizeof(Matrix4) * transformCount));
+
+		m_dirty = false;
+	}
+}
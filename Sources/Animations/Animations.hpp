@@ -0,0 +1,67 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "Engine/Engine.hpp"
+#include "Maths/Matrix4.hpp"
+#include "Renderer/Buffers/StorageBuffer.hpp"
+#include "Animator.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// A module used for updating every registered animator, animators are updated in parallel across the thread pool.
+	/// The joint transforms of every animator are written into one shared array, each animator owning a contiguous run of it.
+	/// Every update the shared array is uploaded into one storage buffer, animated materials index it with <seealso cref="Animator#GetJointOffset()"/>.
+	/// </summary>
+	class ACID_EXPORT Animations :
+		public Module
+	{
+	public:
+		/// <summary>
+		/// Gets this engine instance.
+		/// </summary>
+		/// <returns> The current module instance. </returns>
+		static Animations *Get() { return Engine::Get()->GetModuleManager().Get<Animations>(); }
+
+		Animations();
+
+		void Update() override;
+
+		/// <summary>
+		/// Registers a animator to be updated every frame, from the next update its joint transforms are written into the shared array.
+		/// </summary>
+		/// <param name="animator"> The animator, it must be removed before it is destroyed. </param>
+		void Add(Animator *animator);
+
+		/// <summary>
+		/// Stops updating a animator, it goes back to writing joint transforms into its own array.
+		/// </summary>
+		/// <param name="animator"> The animator. </param>
+		void Remove(Animator *animator);
+
+		const std::vector<Animator *> &GetAnimators() const { return m_animators; }
+
+		/// <summary>
+		/// Gets the joint transforms of every animator, as of the last update.
+		/// </summary>
+		/// <returns> The shared joint transforms. </returns>
+		const std::vector<Matrix4> &GetJointTransforms() const { return m_jointTransforms; }
+
+		/// <summary>
+		/// Gets the storage buffer the shared joint transforms are uploaded into.
+		/// </summary>
+		/// <returns> The joint transforms buffer, or nullptr if there are no joint transforms. </returns>
+		const StorageBuffer *GetStorageJoints() const { return m_storageJoints.get(); }
+	private:
+		/// <summary>
+		/// Gives every animator its run of the shared array, called when animators have been added or removed.
+		/// </summary>
+		void Repack();
+
+		std::vector<Animator *> m_animators;
+		std::vector<Matrix4> m_jointTransforms;
+		std::unique_ptr<StorageBuffer> m_storageJoints;
+		bool m_dirty;
+	};
+}
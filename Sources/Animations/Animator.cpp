@@ -1,105 +1,133 @@
 #include "Animator.hpp"
 
-#include "Engine/Engine.hpp"
-
 namespace acid
 {
-	Animator::Animator(Joint *rootJoint) :
-		m_rootJoint(rootJoint),
-		m_animationTime(Time::Zero),
-		m_currentAnimation(nullptr)
+	Animator::Animator(const Skeleton *skeleton) :
+		m_skeleton(skeleton),
+		m_current({nullptr, Time::Zero, 0}),
+		m_fade({nullptr, Time::Zero, 0}),
+		m_additive({nullptr, Time::Zero, 0}),
+		m_fadeElapsed(Time::Zero),
+		m_fadeDuration(Time::Zero),
+		m_additiveWeight(1.0f),
+		m_positions(skeleton->GetJointCount()),
+		m_rotations(skeleton->GetJointCount()),
+		m_fadePositions(skeleton->GetJointCount()),
+		m_fadeRotations(skeleton->GetJointCount()),
+		m_modelTransforms(skeleton->GetJointCount()),
+		m_ownJointTransforms(skeleton->GetTransformCount()),
+		m_jointTransforms(m_ownJointTransforms.data()),
+		m_jointOffset(std::nullopt)
 	{
 	}
 
-	void Animator::Update()
+	void Animator::Update(const Time &delta)
 	{
-		if (m_currentAnimation == nullptr)
+		if (m_current.m_animation == nullptr)
 		{
 			return;
 		}
 
-		IncreaseAnimationTime();
-		auto currentPose = CalculateCurrentAnimationPose();
-		ApplyPoseToJoints(currentPose, *m_rootJoint, Matrix4::Identity);
-	}
+		IncreaseAnimationTime(delta);
+		m_current.m_animation->Sample(m_current.m_time.AsSeconds(), m_current.m_cursor, m_positions.data(), m_rotations.data());
 
-	void Animator::IncreaseAnimationTime()
-	{
-		m_animationTime += Engine::Get()->GetDelta();
+		if (m_fade.m_animation != nullptr)
+		{
+			// Blends from the pose of the animation being faded out, into the current animation.
+			auto progression = m_fadeElapsed / m_fadeDuration;
+			m_fade.m_animation->Sample(m_fade.m_time.AsSeconds(), m_fade.m_cursor, m_fadePositions.data(), m_fadeRotations.data());
+
+			for (uint32_t i = 0; i < m_positions.size(); i++)
+			{
+				m_positions[i] = m_fadePositions[i].Lerp(m_positions[i], progression);
+				m_rotations[i] = m_fadeRotations[i].Slerp(m_rotations[i], progression);
+			}
+		}
 
-		if (m_animationTime > m_currentAnimation->GetLength())
+		if (m_additive.m_animation != nullptr)
 		{
-			m_animationTime = m_animationTime % m_currentAnimation->GetLength();
+			m_additive.m_animation->SampleAdditive(m_additive.m_time.AsSeconds(), m_additive.m_cursor, m_additiveWeight, m_positions.data(), m_rotations.data());
 		}
-	}
 
-	std::map<std::string, Matrix4> Animator::CalculateCurrentAnimationPose()
-	{
-		auto frames = GetPreviousAndNextFrames();
-		float progression = CalculateProgression(frames[0], frames[1]);
-		return InterpolatePoses(frames[0], frames[1], progression);
+		// Parents come before their children, so each parents model-space transform is ready when a child needs it.
+		const auto &parents = m_skeleton->GetParents();
+		const auto &indices = m_skeleton->GetIndices();
+		const auto &inverseBindTransforms = m_skeleton->GetInverseBindTransforms();
+
+		for (uint32_t i = 0; i < m_positions.size(); i++)
+		{
+			// The same as translating a identity matrix then multiplying by the rotation, without the multiply.
+			Matrix4 localTransform = m_rotations[i].ToRotationMatrix();
+			localTransform[3][0] = m_positions[i].m_x;
+			localTransform[3][1] = m_positions[i].m_y;
+			localTransform[3][2] = m_positions[i].m_z;
+
+			m_modelTransforms[i] = parents[i] < 0 ? localTransform : m_modelTransforms[parents[i]] * localTransform;
+			m_jointTransforms[indices[i]] = m_modelTransforms[i] * inverseBindTransforms[i];
+		}
 	}
 
-	std::array<Keyframe, 2> Animator::GetPreviousAndNextFrames() const
+	void Animator::IncreaseAnimationTime(const Time &delta)
 	{
-		auto allFrames = m_currentAnimation->GetKeyframes();
-		Keyframe previousFrame = allFrames[0];
-		Keyframe nextFrame = allFrames[0];
+		IncreaseLayerTime(m_current, delta);
+		IncreaseLayerTime(m_additive, delta);
 
-		for (uint32_t i = 1; i < allFrames.size(); i++)
+		if (m_fade.m_animation != nullptr)
 		{
-			nextFrame = allFrames[i];
+			IncreaseLayerTime(m_fade, delta);
+			m_fadeElapsed += delta;
 
-			if (nextFrame.GetTimeStamp() > m_animationTime)
+			if (m_fadeElapsed >= m_fadeDuration)
 			{
-				break;
+				m_fade.m_animation = nullptr;
 			}
-
-			previousFrame = allFrames[i];
 		}
-
-		return {previousFrame, nextFrame};
 	}
 
-	float Animator::CalculateProgression(const Keyframe &previousFrame, const Keyframe &nextFrame) const
+	void Animator::DoAnimation(const AnimationClip *animation)
 	{
-		Time totalTime = nextFrame.GetTimeStamp() - previousFrame.GetTimeStamp();
-		Time currentTime = m_animationTime - previousFrame.GetTimeStamp();
-		return currentTime / totalTime;
+		m_current = {animation, Time::Zero, 0};
+		m_fade.m_animation = nullptr;
 	}
 
-	std::map<std::string, Matrix4> Animator::InterpolatePoses(const Keyframe &previousFrame, const Keyframe &nextFrame, const float &progression) const
+	void Animator::CrossFade(const AnimationClip *animation, const Time &duration)
 	{
-		auto currentPose = std::map<std::string, Matrix4>();
-
-		for (const auto &[name, joint] : previousFrame.GetPose())
+		if (m_current.m_animation == nullptr || duration <= Time::Zero)
 		{
-			JointTransform previousTransform = previousFrame.GetPose().find(name)->second;
-			JointTransform nextTransform = nextFrame.GetPose().find(name)->second;
-			JointTransform currentTransform = JointTransform::Interpolate(previousTransform, nextTransform, progression);
-			currentPose.emplace(name, currentTransform.GetLocalTransform());
+			DoAnimation(animation);
+			return;
 		}
 
-		return currentPose;
+		m_fade = m_current;
+		m_current = {animation, Time::Zero, 0};
+		m_fadeElapsed = Time::Zero;
+		m_fadeDuration = duration;
 	}
 
-	void Animator::ApplyPoseToJoints(const std::map<std::string, Matrix4> &currentPose, Joint &joint, const Matrix4 &parentTransform)
+	void Animator::SetAdditive(const AnimationClip *animation, const float &weight)
 	{
-		Matrix4 currentLocalTransform = currentPose.find(joint.GetName())->second;
-		Matrix4 currentTransform = parentTransform * currentLocalTransform;
+		m_additive = {animation, Time::Zero, 0};
+		m_additiveWeight = weight;
+	}
+
+	void Animator::SetJointTransforms(Matrix4 *jointTransforms, const std::optional<uint32_t> &jointOffset)
+	{
+		m_jointTransforms = jointTransforms == nullptr ? m_ownJointTransforms.data() : jointTransforms;
+		m_jointOffset = jointTransforms == nullptr ? std::nullopt : jointOffset;
+	}
 
-		for (const auto &childJoint : joint.GetChildren())
+	void Animator::IncreaseLayerTime(Layer &layer, const Time &delta)
+	{
+		if (layer.m_animation == nullptr)
 		{
-			ApplyPoseToJoints(currentPose, *childJoint, currentTransform);
+			return;
 		}
 
-		currentTransform = currentTransform * joint.GetInverseBindTransform();
-		joint.SetAnimatedTransform(currentTransform);
-	}
+		layer.m_time += delta;
 
-	void Animator::DoAnimation(Animation *animation)
-	{
-		m_animationTime = Time::Zero;
-		m_currentAnimation = animation;
+		if (layer.m_time > layer.m_animation->GetLength() && layer.m_animation->GetLength() != Time::Zero)
+		{
+			layer.m_time = layer.m_time % layer.m_animation->GetLength();
+		}
 	}
 }
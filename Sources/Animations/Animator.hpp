@@ -1,135 +1,141 @@
 #pragma once
 
-#include <array>
+#include <optional>
+#include <vector>
+#include "Helpers/NonCopyable.hpp"
+#include "Maths/Matrix4.hpp"
+#include "Maths/Quaternion.hpp"
 #include "Maths/Time.hpp"
-#include "Animation/Animation.hpp"
-#include "Joint/Joint.hpp"
+#include "Maths/Vector3.hpp"
+#include "Animation/AnimationClip.hpp"
+#include "Skeleton/Skeleton.hpp"
 
 namespace acid
 {
 	/// <summary>
 	/// This class contains all the functionality to apply an animation to an animated entity.
-	/// An Animator instance is associated with just one animated entity.
+	/// An Animator instance is associated with just one animated entity, the skeleton and clips it plays are not changed so can be shared between animators.
 	/// It also keeps track of the running time (in seconds) of the current animation,
 	/// along with a reference to the currently playing animation for the corresponding entity.
 	/// <para>
 	/// An Animator instance needs to be updated every frame, in order for it to keep updating the animation pose of the associated entity.
-	/// The currently playing animation can be changed at any time using <seealso cref="#DoAnimation()"/>.
+	/// The currently playing animation can be changed at any time using <seealso cref="#DoAnimation()"/>, or faded into using <seealso cref="#CrossFade()"/>.
+	/// A additive animation can be layered on top with <seealso cref="#SetAdditive()"/>.
 	/// The Animator will keep looping the current animation until a new animation is chosen.
 	/// </para>
 	/// <para>
-	/// The Animator calculates the desired current animation pose by interpolating between the previous and next keyframes of the animation
-	/// (based on the current animation time). The Animator then updates the transforms all of the joints each frame to match the current desired animation pose.
+	/// The Animator samples the local-space pose of every joint from the current clip into flat arrays, blends in the other layers, then walks the skeleton
+	/// (where every joint comes after its parent) to build the model-space transforms and the joint transforms loaded up to the vertex shader.
+	/// All arrays are allocated when the animator is created, so updating does not allocate, and animators can be updated from different threads.
 	/// </para>
 	/// </summary>
-	class ACID_EXPORT Animator
+	class ACID_EXPORT Animator :
+		public NonCopyable
 	{
 	public:
 		/// <summary>
 		/// Creates a new animator.
 		/// </summary>
-		/// <param name="rootJoint"> The root joint of the joint hierarchy which makes up the "skeleton" of the entity. </param>
-		explicit Animator(Joint *rootJoint);
+		/// <param name="skeleton"> The skeleton of the entity, must outlive the animator. </param>
+		explicit Animator(const Skeleton *skeleton);
 
 		/// <summary>
 		/// This method should be called each frame to update the animation currently being played. This increases the animation time (and loops it back to zero if necessary),
-		/// finds the pose that the entity should be in at that time of the animation, and then applied that pose to all the entity's joints.
+		/// samples the pose that the entity should be in at that time of the animation, and then builds the joint transforms for that pose.
 		/// </summary>
-		void Update();
+		/// <param name="delta"> The time since the last update. </param>
+		void Update(const Time &delta);
 
 		/// <summary>
-		/// Increases the current animation time which allows the animation to progress. If the current animation has reached the end then the timer is reset, causing the animation to loop.
+		/// Increases the time of every playing animation, which allows the animations to progress. If a animation has reached the end then its timer is reset, causing the animation to loop.
+		/// A finished cross-fade is ended.
 		/// </summary>
-		void IncreaseAnimationTime();
+		/// <param name="delta"> The time since the last update. </param>
+		void IncreaseAnimationTime(const Time &delta);
+
+		const Skeleton *GetSkeleton() const { return m_skeleton; }
+
+		const AnimationClip *GetCurrentAnimation() const { return m_current.m_animation; }
 
 		/// <summary>
-		/// This method returns the current animation pose of the entity. It returns
-		/// the desired local-space transforms for all the joints in a map, indexed
-		/// by the name of the joint that they correspond to.
-		/// <para>
-		/// The pose is calculated based on the previous and next keyframes in the
-		/// current animation. Each keyframe provides the desired pose at a certain
-		/// time in the animation, so the animated pose for the current time can be
-		/// calculated by interpolating between the previous and next keyframe.
-		/// </para>
-		/// <para>
-		/// This method first finds the previous and next keyframe, calculates how far
-		/// between the two the current animation is, and then calculated the pose
-		/// for the current animation time by interpolating between the transforms at
-		/// those keyframes.
-		/// </para>
+		/// Indicates that the entity should carry out the given animation. Resets the animation time so that the new animation starts from the beginning, and ends any cross-fade.
 		/// </summary>
-		/// <returns> The current pose as a map of the desired local-space transforms for all the joints.
-		/// The transforms are indexed by the name ID of the joint that they should be applied to. </returns>
-		std::map<std::string, Matrix4> CalculateCurrentAnimationPose();
+		/// <param name="animation"> The new animation to carry out, compiled for this animators skeleton. </param>
+		void DoAnimation(const AnimationClip *animation);
 
 		/// <summary>
-		/// Finds the previous keyframe in the animation and the next keyframe in the animation, and returns them in an array of length 2.
-		/// If there is no  previous frame (perhaps current animation time is 0.5 and the first keyframe is at time 1.5)
-		/// then the next keyframe is used as both the previous and next keyframe. The reverse happens if there is no next keyframe.
+		/// Starts a new animation from the beginning, blending from the pose of the current animation over a duration.
 		/// </summary>
-		/// <returns> The previous and next keyframes, in an array which therefore will always have a length of 2. </returns>
-		std::array<Keyframe, 2> GetPreviousAndNextFrames() const;
+		/// <param name="animation"> The new animation to carry out, compiled for this animators skeleton. </param>
+		/// <param name="duration"> The time taken to fully blend into the new animation. </param>
+		void CrossFade(const AnimationClip *animation, const Time &duration);
 
 		/// <summary>
-		/// Calculates how far between the previous and next keyframe the current animation time is, and returns it as a value between 0 and 1.
+		/// Sets a animation to layer on top of the current animation, the difference between its pose and its first keyframe is added on.
 		/// </summary>
-		/// <param name="previousFrame"> The previous keyframe in the animation. </param>
-		/// <param name="nextFrame"> The next keyframe in the animation.
-		/// </param>
-		/// <returns> A number between 0 and 1 indicating how far between the two keyframes the current animation time is. </returns>
-		float CalculateProgression(const Keyframe &previousFrame, const Keyframe &nextFrame) const;
+		/// <param name="animation"> The additive animation, compiled for this animators skeleton, or nullptr to remove the layer. </param>
+		/// <param name="weight"> How much of the additive animation to apply, from 0 to 1. </param>
+		void SetAdditive(const AnimationClip *animation, const float &weight = 1.0f);
+
+		const AnimationClip *GetAdditiveAnimation() const { return m_additive.m_animation; }
+
+		const float &GetAdditiveWeight() const { return m_additiveWeight; }
+
+		void SetAdditiveWeight(const float &additiveWeight) { m_additiveWeight = additiveWeight; }
+
+		const Time &GetAnimationTime() const { return m_current.m_time; }
+
+		bool IsCrossFading() const { return m_fade.m_animation != nullptr; }
 
 		/// <summary>
-		/// Calculates all the local-space joint transforms for the desired current pose by interpolating between
-		/// the transforms at the previous and next keyframes.
+		/// Gets the transforms that move each joint from its bind position to its position in the current pose,
+		/// indexed by the joints shader index.
 		/// </summary>
-		/// <param name="previousFrame"> The previous keyframe in the animation. </param>
-		/// <param name="nextFrame"> The next keyframe in the animation. </param>
-		/// <param name="progression"> A number between 0 and 1 indicating how far between the previous and next keyframes the current animation time is.
-		/// </param>
-		/// <returns> The local-space transforms for all the joints for the desired current pose.
-		/// They are returned in a map, indexed by the name of the joint to which they should be applied. </returns>
-		std::map<std::string, Matrix4> InterpolatePoses(const Keyframe &previousFrame, const Keyframe &nextFrame, const float &progression) const;
+		/// <returns> The joint transforms, there are <seealso cref="Skeleton#GetTransformCount()"/> transforms. </returns>
+		const Matrix4 *GetJointTransforms() const { return m_jointTransforms; }
 
 		/// <summary>
-		/// This method applies the current pose to a given joint, and all of its descendants.
-		/// It does this by getting the desired local-transform for the
-		/// current joint, before applying it to the joint. Before applying the
-		/// transformations it needs to be converted from local-space to model-space
-		/// (so that they are relative to the model's origin, rather than relative to
-		/// the parent joint). This can be done by multiplying the local-transform of
-		/// the joint with the model-space transform of the parent joint.
-		/// <para>
-		/// The same thing is then done to all the child joints.
-		/// </para>
-		/// <para>
-		/// Finally the inverse of the joint's bind transform is multiplied with the
-		/// model-space transform of the joint. This basically "subtracts" the
-		/// joint's original bind (no animation applied) transform from the desired
-		/// pose transform. The result of this is then the transform required to move
-		/// the joint from its original model-space transform to it's desired
-		/// model-space posed transform. This is the transform that needs to be
-		/// loaded up to the vertex shader and used to transform the vertices into
-		/// the current pose.
-		/// </para>
+		/// Gets where the joint transforms start in the shared array they are written into.
 		/// </summary>
-		/// <param name="currentPose"> A map of the local-space transforms for all the joints for the desired pose. The map is indexed by the name of the joint which the transform corresponds to. </param>
-		/// <param name="joint"> The current joint which the pose should be applied to. </param>
-		/// <param name="parentTransform"> The desired model-space transform of the parent joint for the pose. </param>
-		static void ApplyPoseToJoints(const std::map<std::string, Matrix4> &currentPose, Joint &joint, const Matrix4 &parentTransform);
-
-		const Animation *GetCurrentAnimation() const { return m_currentAnimation; }
+		/// <returns> The index of the first joint transform, or nothing while writing into a array owned by this animator. </returns>
+		const std::optional<uint32_t> &GetJointOffset() const { return m_jointOffset; }
 
 		/// <summary>
-		/// Indicates that the entity should carry out the given animation. Resets the animation time so that the new animation starts from the beginning.
+		/// Sets the array the joint transforms are written into, this lets many animators write into one shared array.
 		/// </summary>
-		/// <param name="animation"> The new animation to carry out. </param>
-		void DoAnimation(Animation *animation);
+		/// <param name="jointTransforms"> The array with room for <seealso cref="Skeleton#GetTransformCount()"/> transforms,
+		/// or nullptr to write into a array owned by this animator. </param>
+		/// <param name="jointOffset"> The index of jointTransforms in the shared array. </param>
+		void SetJointTransforms(Matrix4 *jointTransforms, const std::optional<uint32_t> &jointOffset = std::nullopt);
 	private:
-		Joint *m_rootJoint;
+		/// <summary>
+		/// A animation being played, with its own time and keyframe cursor.
+		/// </summary>
+		struct Layer
+		{
+			const AnimationClip *m_animation;
+			Time m_time;
+			uint32_t m_cursor;
+		};
+
+		static void IncreaseLayerTime(Layer &layer, const Time &delta);
+
+		const Skeleton *m_skeleton;
+
+		Layer m_current;
+		Layer m_fade;
+		Layer m_additive;
+		Time m_fadeElapsed;
+		Time m_fadeDuration;
+		float m_additiveWeight;
 
-		Time m_animationTime;
-		Animation *m_currentAnimation;
+		std::vector<Vector3> m_positions;
+		std::vector<Quaternion> m_rotations;
+		std::vector<Vector3> m_fadePositions;
+		std::vector<Quaternion> m_fadeRotations;
+		std::vector<Matrix4> m_modelTransforms;
+		std::vector<Matrix4> m_ownJointTransforms;
+		Matrix4 *m_jointTransforms;
+		std::optional<uint32_t> m_jointOffset;
 	};
 }
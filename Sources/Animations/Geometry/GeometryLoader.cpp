@@ -35,11 +35,11 @@ namespace acid
 		std::string positionsSource = m_meshData->FindChild("vertices")->FindChild("input")->FindAttribute("source").substr(1);
 		auto positionsData = m_meshData->FindChildWithAttribute("source", "id", positionsSource)->FindChild("float_array");
 		auto positionsCount = String::From<uint32_t>(positionsData->FindAttribute("count"));
-		auto positionsRawData = String::Split(positionsData->GetValue(), " ");
+		auto positionsRawData = String::FromList<float>(positionsData->GetValue());
 
 		for (uint32_t i = 0; i < positionsCount / 3; i++)
 		{
-			Vector4 position = Vector4(String::From<float>(positionsRawData[i * 3]), String::From<float>(positionsRawData[i * 3 + 1]), String::From<float>(positionsRawData[i * 3 + 2]), 1.0f);
+			Vector4 position = Vector4(positionsRawData[i * 3], positionsRawData[i * 3 + 1], positionsRawData[i * 3 + 2], 1.0f);
 			position = MeshAnimated::Correction.Transform(position);
 			VertexAnimatedData *newVertex = new VertexAnimatedData(static_cast<int32_t>(m_positionsList.size()), position);
 			newVertex->SetSkinData(m_vertexWeights[m_positionsList.size()]);
@@ -52,11 +52,11 @@ namespace acid
 		std::string uvsSource = m_meshData->FindChildWithBackup("polylist", "triangles")->FindChildWithAttribute("input", "semantic", "TEXCOORD")->FindAttribute("source").substr(1);
 		auto uvsData = m_meshData->FindChildWithAttribute("source", "id", uvsSource)->FindChild("float_array");
 		auto uvsCount = String::From<uint32_t>(uvsData->FindAttribute("count"));
-		auto uvsRawData = String::Split(uvsData->GetValue(), " ");
+		auto uvsRawData = String::FromList<float>(uvsData->GetValue());
 
 		for (uint32_t i = 0; i < uvsCount / 2; i++)
 		{
-			Vector2 uv = Vector2(String::From<float>(uvsRawData[i * 2]), 1.0f - String::From<float>(uvsRawData[i * 2 + 1]));
+			Vector2 uv = Vector2(uvsRawData[i * 2], 1.0f - uvsRawData[i * 2 + 1]);
 			m_uvsList.emplace_back(uv);
 		}
 	}
@@ -66,11 +66,11 @@ namespace acid
 		std::string normalsSource = m_meshData->FindChildWithBackup("polylist", "triangles")->FindChildWithAttribute("input", "semantic", "NORMAL")->FindAttribute("source").substr(1);
 		auto normalsData = m_meshData->FindChildWithAttribute("source", "id", normalsSource)->FindChild("float_array");
 		auto normalsCount = String::From<uint32_t>(normalsData->FindAttribute("count"));
-		auto normalsRawData = String::Split(normalsData->GetValue(), " ");
+		auto normalsRawData = String::FromList<float>(normalsData->GetValue());
 
 		for (uint32_t i = 0; i < normalsCount / 3; i++)
 		{
-			Vector4 normal = Vector4(String::From<float>(normalsRawData[i * 3]), String::From<float>(normalsRawData[i * 3 + 1]), String::From<float>(normalsRawData[i * 3 + 2]), 0.0f);
+			Vector4 normal = Vector4(normalsRawData[i * 3], normalsRawData[i * 3 + 1], normalsRawData[i * 3 + 2], 0.0f);
 			normal = MeshAnimated::Correction.Transform(normal);
 			m_normalsList.emplace_back(normal);
 		}
@@ -79,13 +79,13 @@ namespace acid
 	void GeometryLoader::AssembleVertices()
 	{
 		auto indexCount = static_cast<int32_t>(m_meshData->FindChildWithBackup("polylist", "triangles")->FindChildren("input").size());
-		auto indexRawData = String::Split(m_meshData->FindChildWithBackup("polylist", "triangles")->FindChild("p")->GetValue(), " ");
+		auto indexRawData = String::FromList<int32_t>(m_meshData->FindChildWithBackup("polylist", "triangles")->FindChild("p")->GetValue());
 
 		for (uint32_t i = 0; i < indexRawData.size() / indexCount; i++)
 		{
-			auto positionIndex = String::From<int32_t>(indexRawData[i * indexCount]);
-			auto normalIndex = String::From<int32_t>(indexRawData[i * indexCount + 1]);
-			auto uvIndex = String::From<int32_t>(indexRawData[i * indexCount + 2]);
+			auto positionIndex = indexRawData[i * indexCount];
+			auto normalIndex = indexRawData[i * indexCount + 1];
+			auto uvIndex = indexRawData[i * indexCount + 2];
 			ProcessVertex(positionIndex, normalIndex, uvIndex);
 		}
 	}
@@ -2,68 +2,52 @@
 #include <utility>
 
 #include "Maths/Maths.hpp"
-#include "Files/File.hpp"
-#include "Serialized/Xml/Xml.hpp"
-#include "Files/FileSystem.hpp"
-#include "Skeleton/SkeletonLoader.hpp"
+#include "Animations.hpp"
 
 namespace acid
 {
 	const Matrix4 MeshAnimated::Correction = Matrix4(Matrix4::Identity.Rotate(-90.0f * Maths::DegToRad, Vector3::Right));
-	const uint32_t MeshAnimated::MaxJoints = 50;
 	const uint32_t MeshAnimated::MaxWeights = 3;
 
 	MeshAnimated::MeshAnimated(std::string filename) :
 		m_filename(std::move(filename)),
 		m_model(nullptr),
-		m_headJoint(nullptr),
-		m_animator(nullptr),
-		m_animation(nullptr)
+		m_animatedModel(nullptr),
+		m_animator(nullptr)
 	{
 		Load();
 	}
 
-	void MeshAnimated::Update()
+	MeshAnimated::~MeshAnimated()
 	{
-		if (m_animator != nullptr)
+		if (m_animator != nullptr && Animations::Get() != nullptr)
 		{
-			m_animator->Update();
+			Animations::Get()->Remove(m_animator.get());
 		}
+	}
 
-		if (m_headJoint != nullptr)
-		{
-			m_jointMatrices.clear();
-			m_jointMatrices.resize(MaxJoints);
-			AddJointsToArray(*m_headJoint, m_jointMatrices);
-		//	m_jointMatrices.shrink_to_fit();
-		}
+	void MeshAnimated::Update()
+	{
 	}
 
 	void MeshAnimated::Load()
 	{
+		if (m_animator != nullptr)
+		{
+			Animations::Get()->Remove(m_animator.get());
+			m_animator = nullptr;
+		}
+
 		if (m_filename.empty())
 		{
 			return;
 		}
 
-		File file = File(m_filename, new Xml("COLLADA"));
-		file.Read();
-
-		SkinLoader skinLoader = SkinLoader(file.GetMetadata()->FindChild("library_controllers"), MaxWeights);
-		SkeletonLoader skeletonLoader = SkeletonLoader(file.GetMetadata()->FindChild("library_visual_scenes"), skinLoader.GetJointOrder());
-		GeometryLoader geometryLoader = GeometryLoader(file.GetMetadata()->FindChild("library_geometries"), skinLoader.GetVertexWeights());
-
-		auto vertices = geometryLoader.GetVertices();
-		auto indices = geometryLoader.GetIndices();
-		m_model = std::make_shared<Model>(vertices, indices);
-		m_headJoint.reset(CreateJoints(*skeletonLoader.GetHeadJoint()));
-		m_headJoint->CalculateInverseBindTransform(Matrix4::Identity);
-		m_animator = std::make_unique<Animator>(m_headJoint.get());
-
-		AnimationLoader animationLoader = AnimationLoader(file.GetMetadata()->FindChild("library_animations"),
-		                                                  file.GetMetadata()->FindChild("library_visual_scenes"));
-		m_animation = std::make_unique<Animation>(animationLoader.GetLengthSeconds(), animationLoader.GetKeyframes());
-		m_animator->DoAnimation(m_animation.get());
+		m_animatedModel = AnimatedModel::Create(m_filename);
+		m_model = m_animatedModel->GetModel();
+		m_animator = std::make_unique<Animator>(m_animatedModel->GetSkeleton());
+		m_animator->DoAnimation(m_animatedModel->GetAnimation());
+		Animations::Get()->Add(m_animator.get());
 	}
 
 	void MeshAnimated::Decode(const Metadata &metadata)
@@ -76,28 +60,18 @@ namespace acid
 		metadata.SetChild("Model", m_filename);
 	}
 
-	Joint *MeshAnimated::CreateJoints(const JointData &data)
+	const Matrix4 *MeshAnimated::GetJointTransforms() const
 	{
-		auto joint = new Joint(data.GetIndex(), data.GetNameId(), data.GetBindLocalTransform());
-
-		for (const auto &child : data.GetChildren())
-		{
-			joint->AddChild(CreateJoints(*child));
-		}
-
-		return joint;
+		return m_animator == nullptr ? nullptr : m_animator->GetJointTransforms();
 	}
 
-	void MeshAnimated::AddJointsToArray(const Joint &headJoint, std::vector<Matrix4> &jointMatrices)
+	uint32_t MeshAnimated::GetJointTransformCount() const
 	{
-		if (headJoint.GetIndex() < jointMatrices.size())
-		{
-			jointMatrices[headJoint.GetIndex()] = headJoint.GetAnimatedTransform();
-		}
+		return m_animator == nullptr ? 0 : m_animator->GetSkeleton()->GetTransformCount();
+	}
 
-		for (const auto &childJoint : headJoint.GetChildren())
-		{
-			AddJointsToArray(*childJoint, jointMatrices);
-		}
+	std::optional<uint32_t> MeshAnimated::GetJointOffset() const
+	{
+		return m_animator == nullptr ? std::nullopt : m_animator->GetJointOffset();
 	}
 }
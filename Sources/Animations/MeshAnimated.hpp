@@ -2,27 +2,28 @@
 
 #include "Maths/Matrix4.hpp"
 #include "Meshes/Mesh.hpp"
-#include "Animation/AnimationLoader.hpp"
-#include "Geometry/GeometryLoader.hpp"
 #include "Geometry/VertexAnimated.hpp"
-#include "Skin/SkinLoader.hpp"
+#include "AnimatedModel.hpp"
 #include "Animator.hpp"
 
 namespace acid
 {
 	/// <summary>
 	/// This class represents an animated armature with a skin mesh.
+	/// The skin model, skeleton and animation are shared with every other mesh loaded from the same file,
+	/// while the animator is owned by this mesh and updated by the <seealso cref="Animations"/> module.
 	/// </summary>
 	class ACID_EXPORT MeshAnimated :
 		public Mesh
 	{
 	public:
 		static const Matrix4 Correction;
-		static const uint32_t MaxJoints;
 		static const uint32_t MaxWeights;
 
 		explicit MeshAnimated(std::string filename = "");
 
+		~MeshAnimated();
+
 		void Update() override;
 
 		void Load(); // override
@@ -37,18 +38,31 @@ namespace acid
 
 		void SetModel(const std::shared_ptr<Model> &model) override { m_model = model; }
 
-		const std::vector<Matrix4> &GetJointTransforms() const { return m_jointMatrices; }
-	private:
-		static Joint *CreateJoints(const JointData &data);
+		const std::shared_ptr<AnimatedModel> &GetAnimatedModel() const { return m_animatedModel; }
+
+		/// <summary>
+		/// Gets the animator, used to change or blend the animations played by this mesh.
+		/// </summary>
+		/// <returns> The animator, or nullptr if no file is loaded. </returns>
+		Animator *GetAnimator() const { return m_animator.get(); }
 
-		static void AddJointsToArray(const Joint &headJoint, std::vector<Matrix4> &jointMatrices);
+		/// <summary>
+		/// Gets the joint transforms of the current pose.
+		/// </summary>
+		/// <returns> The joint transforms, or nullptr if no file is loaded. </returns>
+		const Matrix4 *GetJointTransforms() const;
 
+		uint32_t GetJointTransformCount() const;
+
+		/// <summary>
+		/// Gets where the joint transforms of the current pose start in the storage buffer of the <seealso cref="Animations"/> module.
+		/// </summary>
+		/// <returns> The index of the first joint transform, or nothing until the animator has its run of the shared array. </returns>
+		std::optional<uint32_t> GetJointOffset() const;
+	private:
 		std::string m_filename;
 		std::shared_ptr<Model> m_model;
-		std::unique_ptr<Joint> m_headJoint;
+		std::shared_ptr<AnimatedModel> m_animatedModel;
 		std::unique_ptr<Animator> m_animator;
-		std::unique_ptr<Animation> m_animation;
-
-		std::vector<Matrix4> m_jointMatrices;
 	};
 }
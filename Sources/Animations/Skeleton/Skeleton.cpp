@@ -0,0 +1,42 @@
+#include "Skeleton.hpp"
+
+#include <algorithm>
+
+namespace acid
+{
+	Skeleton::Skeleton(const JointData &headJoint) :
+		m_transformCount(0)
+	{
+		AddJoint(headJoint, -1, Matrix4::Identity);
+	}
+
+	std::optional<uint32_t> Skeleton::FindJoint(const std::string &name) const
+	{
+		auto it = std::find(m_names.begin(), m_names.end(), name);
+
+		if (it == m_names.end())
+		{
+			return {};
+		}
+
+		return static_cast<uint32_t>(it - m_names.begin());
+	}
+
+	void Skeleton::AddJoint(const JointData &joint, const int32_t &parent, const Matrix4 &parentBindTransform)
+	{
+		auto bindTransform = parentBindTransform * joint.GetBindLocalTransform();
+		auto index = static_cast<int32_t>(m_names.size());
+
+		m_names.emplace_back(joint.GetNameId());
+		m_parents.emplace_back(parent);
+		m_indices.emplace_back(joint.GetIndex());
+		m_localBindTransforms.emplace_back(joint.GetBindLocalTransform());
+		m_inverseBindTransforms.emplace_back(bindTransform.Invert());
+		m_transformCount = std::max(m_transformCount, joint.GetIndex() + 1);
+
+		for (const auto &child : joint.GetChildren())
+		{
+			AddJoint(*child, index, bindTransform);
+		}
+	}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+#include "Helpers/NonCopyable.hpp"
+#include "Maths/Matrix4.hpp"
+#include "Animations/Joint/Joint.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// A joint hierarchy flattened into arrays, with joints resolved to indices when loaded.
+	/// Joints are stored depth first, so every joint comes after its parent and a pose can be built in one pass over the arrays.
+	/// </summary>
+	class ACID_EXPORT Skeleton :
+		public NonCopyable
+	{
+	public:
+		/// <summary>
+		/// Creates a new skeleton from loaded joint data.
+		/// </summary>
+		/// <param name="headJoint"> The root joint of the hierarchy. </param>
+		explicit Skeleton(const JointData &headJoint);
+
+		uint32_t GetJointCount() const { return static_cast<uint32_t>(m_names.size()); }
+
+		/// <summary>
+		/// Finds the position of a joint in the skeletons arrays.
+		/// </summary>
+		/// <param name="name"> The name of the joint. </param>
+		/// <returns> The joint, if it is in the skeleton. </returns>
+		std::optional<uint32_t> FindJoint(const std::string &name) const;
+
+		const std::vector<std::string> &GetNames() const { return m_names; }
+
+		/// <summary>
+		/// Gets the parent of each joint, the root joint has a parent of -1.
+		/// </summary>
+		/// <returns> The parent joints. </returns>
+		const std::vector<int32_t> &GetParents() const { return m_parents; }
+
+		/// <summary>
+		/// Gets the index of each joint in the shaders joint transform array.
+		/// </summary>
+		/// <returns> The shader indices. </returns>
+		const std::vector<uint32_t> &GetIndices() const { return m_indices; }
+
+		const std::vector<Matrix4> &GetLocalBindTransforms() const { return m_localBindTransforms; }
+
+		const std::vector<Matrix4> &GetInverseBindTransforms() const { return m_inverseBindTransforms; }
+
+		/// <summary>
+		/// Gets the size of the shaders joint transform array needed for this skeleton, one more than the largest shader index.
+		/// </summary>
+		/// <returns> The joint transform count. </returns>
+		const uint32_t &GetTransformCount() const { return m_transformCount; }
+	private:
+		void AddJoint(const JointData &joint, const int32_t &parent, const Matrix4 &parentBindTransform);
+
+		std::vector<std::string> m_names;
+		std::vector<int32_t> m_parents;
+		std::vector<uint32_t> m_indices;
+		std::vector<Matrix4> m_localBindTransforms;
+		std::vector<Matrix4> m_inverseBindTransforms;
+		uint32_t m_transformCount;
+	};
+}
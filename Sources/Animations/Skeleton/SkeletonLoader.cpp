@@ -32,13 +32,13 @@ namespace acid
 	{
 		std::string nameId = jointNode->FindAttribute("id");
 		auto index = GetBoneIndex(nameId);
-		auto matrixData = String::Split(jointNode->FindChild("matrix")->GetValue(), " ");
+		auto matrixData = String::FromList<float>(jointNode->FindChild("matrix")->GetValue());
 
 		Matrix4 transform = Matrix4();
 
 		for (uint32_t i = 0; i < matrixData.size(); i++)
 		{
-			transform.m_linear[i] = String::From<float>(matrixData[i]);
+			transform.m_linear[i] = matrixData[i];
 		}
 
 		transform = transform.Transpose();
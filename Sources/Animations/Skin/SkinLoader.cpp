@@ -27,33 +27,17 @@ namespace acid
 		std::string weightsDataId = inputNode->FindChildWithAttribute("input", "semantic", "WEIGHT")->FindAttribute("source").substr(1);
 		auto weightsNode = m_skinData->FindChildWithAttribute("source", "id", weightsDataId)->FindChild("float_array");
 
-		auto rawData = String::Split(weightsNode->GetValue(), " ");
-		std::vector<float> weights(rawData.size());
-
-		for (uint32_t i = 0; i < weights.size(); i++)
-		{
-			weights[i] = String::From<float>(rawData[i]);
-		}
-
-		return weights;
+		return String::FromList<float>(weightsNode->GetValue());
 	}
 
 	std::vector<uint32_t> SkinLoader::GetEffectiveJointsCounts(const Metadata *weightsDataNode) const
 	{
-		auto rawData = String::Split(weightsDataNode->FindChild("vcount")->GetString(), " ");
-		std::vector<uint32_t> counts(rawData.size());
-
-		for (uint32_t i = 0; i < rawData.size(); i++)
-		{
-			counts[i] = String::From<uint32_t>(rawData[i]);
-		}
-
-		return counts;
+		return String::FromList<uint32_t>(weightsDataNode->FindChild("vcount")->GetString());
 	}
 
 	void SkinLoader::GetSkinWeights(const Metadata *weightsDataNode, const std::vector<uint32_t> &counts, const std::vector<float> &weights)
 	{
-		auto rawData = String::Split(weightsDataNode->FindChild("v")->GetString(), " ");
+		auto rawData = String::FromList<uint32_t>(weightsDataNode->FindChild("v")->GetString());
 		uint32_t pointer = 0;
 
 		for (auto count : counts)
@@ -62,8 +46,8 @@ namespace acid
 
 			for (uint32_t i = 0; i < count; i++)
 			{
-				auto jointId = String::From<uint32_t>(rawData[pointer++]);
-				auto weightId = String::From<uint32_t>(rawData[pointer++]);
+				auto jointId = rawData[pointer++];
+				auto weightId = rawData[pointer++];
 				skinData.AddJointEffect(jointId, weights[weightId]);
 			}
 
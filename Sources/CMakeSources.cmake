@@ -1,8 +1,11 @@
 # All of these will be set as PUBLIC sources to Acid
 set(_temp_acid_headers
 		Acid.hpp
+		Animations/AnimatedModel.hpp
 		Animations/Animation/Animation.hpp
+		Animations/Animation/AnimationClip.hpp
 		Animations/Animation/AnimationLoader.hpp
+		Animations/Animations.hpp
 		Animations/Animator.hpp
 		Animations/Geometry/GeometryLoader.hpp
 		Animations/Geometry/VertexAnimated.hpp
@@ -11,6 +14,7 @@ set(_temp_acid_headers
 		Animations/Joint/JointTransform.hpp
 		Animations/Keyframe/Keyframe.hpp
 		Animations/MeshAnimated.hpp
+		Animations/Skeleton/Skeleton.hpp
 		Animations/Skeleton/SkeletonLoader.hpp
 		Animations/Skin/SkinLoader.hpp
 		Animations/Skin/VertexWeights.hpp
@@ -47,6 +51,7 @@ set(_temp_acid_headers
 		Files/Files.hpp
 		Files/FileSystem.hpp
 		Files/FileWatcher.hpp
+		Files/MappedFile.hpp
 		Fonts/FontMetafile.hpp
 		Fonts/FontType.hpp
 		Fonts/RendererFonts.hpp
@@ -78,6 +83,7 @@ set(_temp_acid_headers
 		Materials/MaterialDefault.hpp
 		Materials/PipelineMaterial.hpp
 		Maths/Colour.hpp
+		Maths/Culling.hpp
 		Maths/Delta.hpp
 		Maths/Interpolation/SmoothFloat.hpp
 		Maths/Maths.hpp
@@ -85,6 +91,7 @@ set(_temp_acid_headers
 		Maths/Matrix3.hpp
 		Maths/Matrix4.hpp
 		Maths/Quaternion.hpp
+		Maths/Simd.hpp
 		Maths/Time.hpp
 		Maths/Timer.hpp
 		Maths/Transform.hpp
@@ -101,10 +108,12 @@ set(_temp_acid_headers
 		Meshes/Mesh.hpp
 		Meshes/MeshRender.hpp
 		Meshes/RendererMeshes.hpp
+		Meshes/RenderQueue.hpp
 		Models/IVertex.hpp
 		Models/Model.hpp
 		Models/ModelRegister.hpp
 		Models/Obj/ModelObj.hpp
+		Models/Obj/ObjParser.hpp
 		Models/Shapes/MeshPattern.hpp
 		Models/Shapes/MeshSimple.hpp
 		Models/Shapes/ModelCube.hpp
@@ -113,7 +122,6 @@ set(_temp_acid_headers
 		Models/Shapes/ModelRectangle.hpp
 		Models/Shapes/ModelSphere.hpp
 		Models/VertexModel.hpp
-		Models/VertexModelData.hpp
 		Network/Ftp/Ftp.hpp
 		Network/Ftp/FtpDataChannel.hpp
 		Network/Ftp/FtpResponse.hpp
@@ -132,6 +140,8 @@ set(_temp_acid_headers
 		Noise/Noise.hpp
 		Particles/Particle.hpp
 		Particles/Particles.hpp
+		Particles/ParticleSorter.hpp
+		Particles/ParticleStore.hpp
 		Particles/ParticleSystem.hpp
 		Particles/ParticleType.hpp
 		Particles/RendererParticles.hpp
@@ -172,16 +182,23 @@ set(_temp_acid_headers
 		Post/PostFilter.hpp
 		Post/PostPipeline.hpp
 		Renderer/Buffers/Buffer.hpp
+		Renderer/Buffers/DynamicInstanceBuffer.hpp
 		Renderer/Buffers/InstanceBuffer.hpp
 		Renderer/Buffers/StorageBuffer.hpp
 		Renderer/Buffers/UniformBuffer.hpp
 		Renderer/Commands/CommandBuffer.hpp
+		Renderer/Commands/CommandPool.hpp
+		Renderer/Commands/UploadQueue.hpp
 		Renderer/Descriptors/Descriptor.hpp
 		Renderer/Descriptors/DescriptorSet.hpp
 		Renderer/Handlers/DescriptorsHandler.hpp
 		Renderer/Handlers/PushHandler.hpp
 		Renderer/Handlers/StorageHandler.hpp
 		Renderer/Handlers/UniformHandler.hpp
+		Renderer/Memory/LinearAllocator.hpp
+		Renderer/Memory/MemoryAllocator.hpp
+		Renderer/Memory/MemoryBlock.hpp
+		Renderer/Memory/RingAllocator.hpp
 		Renderer/Pipelines/Pipeline.hpp
 		Renderer/Pipelines/PipelineCompute.hpp
 		Renderer/Pipelines/PipelineGraphics.hpp
@@ -197,6 +214,10 @@ set(_temp_acid_headers
 		Renderer/RenderStage.hpp
 		Resources/Resource.hpp
 		Resources/Resources.hpp
+		Scenes/Archetypes/Archetype.hpp
+		Scenes/Archetypes/ArchetypeStorage.hpp
+		Scenes/Archetypes/ComponentType.hpp
+		Scenes/Archetypes/View.hpp
 		Scenes/Camera.hpp
 		Scenes/Component.hpp
 		Scenes/ComponentRegister.hpp
@@ -206,8 +227,12 @@ set(_temp_acid_headers
 		Scenes/ScenePhysics.hpp
 		Scenes/Scenes.hpp
 		Scenes/SceneStructure.hpp
+		Scenes/SpatialTree.hpp
+		Scenes/TransformHierarchy.hpp
+		Serialized/Binary/Binary.hpp
 		Serialized/Json/Json.hpp
 		Serialized/Metadata.hpp
+		Serialized/MetadataArena.hpp
 		Serialized/Xml/Xml.hpp
 		Serialized/Yaml/Yaml.hpp
 		Shadows/RendererShadows.hpp
@@ -218,8 +243,10 @@ set(_temp_acid_headers
 		Textures/Cubemap.hpp
 		Textures/DepthStencil.hpp
 		Textures/Texture.hpp
-		Threads/Thread.hpp
-		Threads/ThreadPool.hpp
+		Threads/Job.hpp
+		Threads/JobCounter.hpp
+		Threads/JobDeque.hpp
+		Threads/JobSystem.hpp
 		Uis/Inputs/UiColourWheel.hpp
 		Uis/Inputs/UiInputBoolean.hpp
 		Uis/Inputs/UiInputButton.hpp
@@ -236,8 +263,11 @@ set(_temp_acid_headers
 		Uis/UiStartLogo.hpp
 		)
 set(_temp_acid_sources
+		Animations/AnimatedModel.cpp
 		Animations/Animation/Animation.cpp
+		Animations/Animation/AnimationClip.cpp
 		Animations/Animation/AnimationLoader.cpp
+		Animations/Animations.cpp
 		Animations/Animator.cpp
 		Animations/Geometry/GeometryLoader.cpp
 		Animations/Geometry/VertexAnimated.cpp
@@ -246,6 +276,7 @@ set(_temp_acid_sources
 		Animations/Joint/JointTransform.cpp
 		Animations/Keyframe/Keyframe.cpp
 		Animations/MeshAnimated.cpp
+		Animations/Skeleton/Skeleton.cpp
 		Animations/Skeleton/SkeletonLoader.cpp
 		Animations/Skin/SkinLoader.cpp
 		Animations/Skin/VertexWeights.cpp
@@ -276,6 +307,7 @@ set(_temp_acid_sources
 		Files/Files.cpp
 		Files/FileSystem.cpp
 		Files/FileWatcher.cpp
+		Files/MappedFile.cpp
 		Fonts/FontMetafile.cpp
 		Fonts/FontType.cpp
 		Fonts/RendererFonts.cpp
@@ -301,6 +333,7 @@ set(_temp_acid_sources
 		Materials/MaterialDefault.cpp
 		Materials/PipelineMaterial.cpp
 		Maths/Colour.cpp
+		Maths/Culling.cpp
 		Maths/Delta.cpp
 		Maths/Maths.cpp
 		Maths/Matrix2.cpp
@@ -316,9 +349,11 @@ set(_temp_acid_sources
 		Meshes/Mesh.cpp
 		Meshes/MeshRender.cpp
 		Meshes/RendererMeshes.cpp
+		Meshes/RenderQueue.cpp
 		Models/Model.cpp
 		Models/ModelRegister.cpp
 		Models/Obj/ModelObj.cpp
+		Models/Obj/ObjParser.cpp
 		Models/Shapes/MeshPattern.cpp
 		Models/Shapes/MeshSimple.cpp
 		Models/Shapes/ModelCube.cpp
@@ -327,7 +362,6 @@ set(_temp_acid_sources
 		Models/Shapes/ModelRectangle.cpp
 		Models/Shapes/ModelSphere.cpp
 		Models/VertexModel.cpp
-		Models/VertexModelData.cpp
 		Network/Ftp/Ftp.cpp
 		Network/Ftp/FtpDataChannel.cpp
 		Network/Ftp/FtpResponse.cpp
@@ -346,6 +380,8 @@ set(_temp_acid_sources
 		Noise/Noise.cpp
 		Particles/Particle.cpp
 		Particles/Particles.cpp
+		Particles/ParticleSorter.cpp
+		Particles/ParticleStore.cpp
 		Particles/ParticleSystem.cpp
 		Particles/ParticleType.cpp
 		Particles/RendererParticles.cpp
@@ -385,15 +421,22 @@ set(_temp_acid_sources
 		Post/Pipelines/PipelineBlur.cpp
 		Post/PostFilter.cpp
 		Renderer/Buffers/Buffer.cpp
+		Renderer/Buffers/DynamicInstanceBuffer.cpp
 		Renderer/Buffers/InstanceBuffer.cpp
 		Renderer/Buffers/StorageBuffer.cpp
 		Renderer/Buffers/UniformBuffer.cpp
 		Renderer/Commands/CommandBuffer.cpp
+		Renderer/Commands/CommandPool.cpp
+		Renderer/Commands/UploadQueue.cpp
 		Renderer/Descriptors/DescriptorSet.cpp
 		Renderer/Handlers/DescriptorsHandler.cpp
 		Renderer/Handlers/PushHandler.cpp
 		Renderer/Handlers/StorageHandler.cpp
 		Renderer/Handlers/UniformHandler.cpp
+		Renderer/Memory/LinearAllocator.cpp
+		Renderer/Memory/MemoryAllocator.cpp
+		Renderer/Memory/MemoryBlock.cpp
+		Renderer/Memory/RingAllocator.cpp
 		Renderer/Pipelines/PipelineCompute.cpp
 		Renderer/Pipelines/PipelineGraphics.cpp
 		Renderer/Pipelines/Shader.cpp
@@ -404,14 +447,21 @@ set(_temp_acid_sources
 		Renderer/Renderpass/Swapchain.cpp
 		Renderer/RenderStage.cpp
 		Resources/Resources.cpp
+		Scenes/Archetypes/Archetype.cpp
+		Scenes/Archetypes/ArchetypeStorage.cpp
+		Scenes/Archetypes/ComponentType.cpp
 		Scenes/ComponentRegister.cpp
 		Scenes/Entity.cpp
 		Scenes/EntityPrefab.cpp
 		Scenes/ScenePhysics.cpp
 		Scenes/Scenes.cpp
 		Scenes/SceneStructure.cpp
+		Scenes/SpatialTree.cpp
+		Scenes/TransformHierarchy.cpp
+		Serialized/Binary/Binary.cpp
 		Serialized/Json/Json.cpp
 		Serialized/Metadata.cpp
+		Serialized/MetadataArena.cpp
 		Serialized/Xml/Xml.cpp
 		Serialized/Yaml/Yaml.cpp
 		Shadows/RendererShadows.cpp
@@ -422,8 +472,8 @@ set(_temp_acid_sources
 		Textures/Cubemap.cpp
 		Textures/DepthStencil.cpp
 		Textures/Texture.cpp
-		Threads/Thread.cpp
-		Threads/ThreadPool.cpp
+		Threads/JobCounter.cpp
+		Threads/JobSystem.cpp
 		Uis/Inputs/UiColourWheel.cpp
 		Uis/Inputs/UiInputBoolean.cpp
 		Uis/Inputs/UiInputButton.cpp
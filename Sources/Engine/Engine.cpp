@@ -46,6 +46,7 @@ namespace acid
 			m_moduleUpdater.Update(m_moduleManager);
 		}
 
+		Log::Flush();
 		return EXIT_SUCCESS;
 	}
 
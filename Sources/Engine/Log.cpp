@@ -1,31 +1,405 @@
 #include "Log.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
 #if defined(ACID_BUILD_WINDOWS)
 #include <Windows.h>
 #endif
 #include "Files/FileSystem.hpp"
+#include "Helpers/NonCopyable.hpp"
 
 namespace acid
 {
-	std::mutex Log::MUTEX = std::mutex();
-	std::ofstream Log::STREAM = std::ofstream();
+	std::atomic<Log::Level> Log::LEVEL(Log::Level::Debug);
+	std::atomic<uint32_t> Log::RATE_LIMIT(0);
 
-	void Log::Out(const std::string &string)
-	{
-		std::lock_guard<std::mutex> lock(MUTEX);
-		fprintf(stdout, "%s", string.c_str());
-		STREAM << string;
-	}
+	// The messages the queue holds, must be a power of two.
+	static const std::size_t QUEUE_CAPACITY = 4096;
+	// The characters a message is stored in, longer messages are allocated.
+	static const std::size_t MESSAGE_SIZE = 216;
+	// The formats the rate limit is tracked for, must be a power of two.
+	static const std::size_t RATE_LIMIT_SITES = 256;
+	// The longest a message waits in the queue before it is written.
+	static const auto WRITE_INTERVAL = std::chrono::milliseconds(5);
+
+	// Set once the writer is destroyed, messages logged after are written on the calling thread.
+	static bool WRITER_DESTROYED = false;
 
-	void Log::Error(const std::string &string)
+	/// <summary>
+	/// Owns the queue of messages and the thread that writes them, from Vyukov's bounded queue.
+	/// Any thread claims an entry by moving the enqueue position, and publishes it by setting the entry sequence, the writer reads entries in order.
+	/// </summary>
+	class LogWriter :
+		public NonCopyable
 	{
-		std::lock_guard<std::mutex> lock(MUTEX);
-		fprintf(stderr, "%s", string.c_str());
-		STREAM << string;
-	}
+	public:
+		LogWriter() :
+			m_entries(std::make_unique<Entry[]>(QUEUE_CAPACITY)),
+			m_enqueuePosition(0),
+			m_dropped(0),
+			m_sites(std::make_unique<Site[]>(RATE_LIMIT_SITES)),
+			m_dequeuePosition(0),
+			m_lineStart(true),
+			m_written(0),
+			m_flushing(false),
+			m_stopping(false)
+		{
+			for (std::size_t i = 0; i < QUEUE_CAPACITY; i++)
+			{
+				m_entries[i].m_sequence.store(i, std::memory_order_relaxed);
+			}
+
+			m_thread = std::thread(&LogWriter::Run, this);
+		}
+
+		~LogWriter()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_stopping = true;
+			}
+
+			m_condition.notify_all();
+			m_thread.join();
+			WRITER_DESTROYED = true;
+		}
+
+		static LogWriter *Get()
+		{
+			static LogWriter writer;
+			return WRITER_DESTROYED ? nullptr : &writer;
+		}
+
+		/// <summary>
+		/// Queues a message, never waits on the writer. The message is dropped if the queue is full.
+		/// </summary>
+		/// <param name="level"> The level of the message. </param>
+		/// <param name="time"> The time the message was logged. </param>
+		/// <param name="write"> Writes the message into a buffer and returns its length. </param>
+		template<typename F>
+		void Push(const Log::Level &level, const std::chrono::system_clock::time_point &time, const F &write)
+		{
+			auto position = m_enqueuePosition.load(std::memory_order_relaxed);
+			Entry *entry;
+
+			while (true)
+			{
+				entry = &m_entries[position & (QUEUE_CAPACITY - 1)];
+				auto difference = static_cast<intptr_t>(entry->m_sequence.load(std::memory_order_acquire)) - static_cast<intptr_t>(position);
+
+				if (difference == 0)
+				{
+					if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+				else if (difference < 0)
+				{
+					// The writer has not reached this entry from the last time around the queue.
+					m_dropped.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+				else
+				{
+					position = m_enqueuePosition.load(std::memory_order_relaxed);
+				}
+			}
+
+			entry->m_level = level;
+			entry->m_time = time;
+			auto length = static_cast<std::size_t>(std::max(write(entry->m_text, MESSAGE_SIZE), 0));
+
+			if (length >= MESSAGE_SIZE)
+			{
+				entry->m_overflow = std::make_unique<char[]>(length + 1);
+				write(entry->m_overflow.get(), length + 1);
+			}
+
+			entry->m_length = length;
+			entry->m_sequence.store(position + 1, std::memory_order_release);
+		}
+
+		/// <summary>
+		/// Counts a message against the rate limit of its format, the writer notes how many messages of a format were suppressed.
+		/// </summary>
+		/// <param name="site"> The format, or nullptr if the message is not rate limited. </param>
+		/// <param name="time"> The time the message was logged. </param>
+		/// <returns> If the message should be queued. </returns>
+		bool Limit(const char *site, const std::chrono::system_clock::time_point &time)
+		{
+			auto rateLimit = Log::GetRateLimit();
+
+			if (site == nullptr || rateLimit == 0)
+			{
+				return true;
+			}
+
+			// Formats are string literals, a Fibonacci hash of the address spreads them over the table.
+			auto index = static_cast<std::size_t>((static_cast<uint64_t>(reinterpret_cast<uintptr_t>(site)) * 11400714819323198485ull) >> 56) & (RATE_LIMIT_SITES - 1);
+			auto &entry = m_sites[index];
+			auto second = std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+
+			// Counts are shared between threads without a lock, a race only lets through or suppresses a few messages more.
+			if (auto last = entry.m_site.load(std::memory_order_relaxed); last != site)
+			{
+				entry.m_site.store(site, std::memory_order_relaxed);
+				entry.m_second.store(second, std::memory_order_relaxed);
+				entry.m_count.store(0, std::memory_order_relaxed);
+
+				// The format that had this entry is still owed its note.
+				if (auto suppressed = entry.m_suppressed.exchange(0, std::memory_order_relaxed); suppressed > 0)
+				{
+					Push(Log::Level::Warning, time, [suppressed, last](char *buffer, std::size_t size)
+					{
+						return FormatSuppressed(buffer, size, suppressed, last);
+					});
+				}
+			}
+
+			if (auto last = entry.m_second.load(std::memory_order_relaxed);
+				last != second && entry.m_second.compare_exchange_strong(last, second, std::memory_order_relaxed))
+			{
+				entry.m_count.store(0, std::memory_order_relaxed);
+			}
+
+			if (entry.m_count.fetch_add(1, std::memory_order_relaxed) < rateLimit)
+			{
+				return true;
+			}
+
+			entry.m_suppressed.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		/// <summary>
+		/// Wakes the writer and waits until every message queued before the call is written.
+		/// </summary>
+		void Flush()
+		{
+			auto position = m_enqueuePosition.load();
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_flushing = true;
+			m_condition.notify_all();
+			m_flushed.wait(lock, [this, position]()
+			{
+				return m_written >= position;
+			});
+		}
+
+		void OpenLog(const std::string &filename)
+		{
+			std::lock_guard<std::mutex> lock(m_streamMutex);
+			FileSystem::Create(filename);
+			m_stream.open(filename);
+			m_lineStart = true;
+		}
+
+		/// <summary>
+		/// Writes a message on the calling thread, used once the writer thread has stopped.
+		/// </summary>
+		static void WriteDirect(const Log::Level &level, const char *text, const std::size_t &length)
+		{
+			fwrite(text, 1, length, level == Log::Level::Error ? stderr : stdout);
+		}
+	private:
+		struct Entry
+		{
+			std::atomic<std::size_t> m_sequence;
+			Log::Level m_level;
+			std::chrono::system_clock::time_point m_time;
+			std::size_t m_length;
+			std::unique_ptr<char[]> m_overflow;
+			char m_text[MESSAGE_SIZE];
+		};
+
+		struct Site
+		{
+			std::atomic<const char *> m_site{nullptr};
+			std::atomic<int64_t> m_second{0};
+			std::atomic<uint32_t> m_count{0};
+			std::atomic<uint32_t> m_suppressed{0};
+			// The last second a note was written for this entry, only used by the writer.
+			int64_t m_reported = 0;
+		};
+
+		void Run()
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+
+			while (true)
+			{
+				auto stopping = m_stopping;
+				auto flushing = m_flushing;
+				m_flushing = false;
+				lock.unlock();
+				auto written = Drain(stopping || flushing);
+				lock.lock();
+
+				m_written = written;
+				m_flushed.notify_all();
+
+				if (stopping)
+				{
+					break;
+				}
+
+				m_condition.wait_for(lock, WRITE_INTERVAL, [this]()
+				{
+					return m_flushing || m_stopping;
+				});
+			}
+		}
+
+		/// <summary>
+		/// Writes every message published in order, stops at the first entry still being written.
+		/// </summary>
+		/// <param name="all"> If every suppressed message is noted now, instead of at most once a second for each format. </param>
+		/// <returns> The position of the next entry to be written. </returns>
+		std::size_t Drain(const bool &all)
+		{
+			std::lock_guard<std::mutex> lock(m_streamMutex);
+
+			while (true)
+			{
+				auto &entry = m_entries[m_dequeuePosition & (QUEUE_CAPACITY - 1)];
+
+				if (entry.m_sequence.load(std::memory_order_acquire) != m_dequeuePosition + 1)
+				{
+					break;
+				}
+
+				Output(entry.m_level, entry.m_time, entry.m_overflow != nullptr ? entry.m_overflow.get() : entry.m_text, entry.m_length);
+				entry.m_overflow.reset();
+				entry.m_sequence.store(m_dequeuePosition + QUEUE_CAPACITY, std::memory_order_release);
+				m_dequeuePosition++;
+			}
+
+			if (auto dropped = m_dropped.exchange(0, std::memory_order_relaxed); dropped > 0)
+			{
+				char buffer[128];
+				auto length = snprintf(buffer, sizeof(buffer), "Log: %llu messages were dropped, the queue was full\n", static_cast<unsigned long long>(dropped));
+				Output(Log::Level::Warning, std::chrono::system_clock::now(), buffer, static_cast<std::size_t>(length));
+			}
+
+			WriteSuppressed(all);
+			fflush(stdout);
+			m_stream.flush();
+			return m_dequeuePosition;
+		}
+
+		/// <summary>
+		/// Notes the messages suppressed for each format, so the count is written even once a burst has stopped.
+		/// </summary>
+		/// <param name="all"> If formats noted in this second are noted again. </param>
+		void WriteSuppressed(const bool &all)
+		{
+			auto time = std::chrono::system_clock::now();
+			auto second = std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+
+			for (std::size_t i = 0; i < RATE_LIMIT_SITES; i++)
+			{
+				auto &entry = m_sites[i];
+
+				if (entry.m_suppressed.load(std::memory_order_relaxed) == 0 || (!all && entry.m_reported == second))
+				{
+					continue;
+				}
+
+				auto site = entry.m_site.load(std::memory_order_relaxed);
+				auto suppressed = entry.m_suppressed.exchange(0, std::memory_order_relaxed);
+				entry.m_reported = second;
+
+				char buffer[MESSAGE_SIZE];
+				auto length = std::max(FormatSuppressed(buffer, sizeof(buffer), suppressed, site), 0);
+				Output(Log::Level::Warning, time, buffer, std::min(static_cast<std::size_t>(length), sizeof(buffer) - 1));
+			}
+		}
+
+		/// <summary>
+		/// Writes the note for messages of a format that were suppressed, like snprintf.
+		/// </summary>
+		static int32_t FormatSuppressed(char *buffer, const std::size_t &size, const uint32_t &suppressed, const char *site)
+		{
+			auto siteLength = site != nullptr ? std::strcspn(site, "\n") : 0;
+			return snprintf(buffer, size, "Log: %u messages like \"%.*s\" were suppressed\n", suppressed, static_cast<int32_t>(siteLength), site != nullptr ? site : "");
+		}
+
+		void Output(const Log::Level &level, const std::chrono::system_clock::time_point &time, const char *text, const std::size_t &length)
+		{
+			WriteDirect(level, text, length);
+
+			if (!m_stream.is_open())
+			{
+				return;
+			}
+
+			// Messages are often written in parts, so the file is prefixed with the time and level at the start of each line.
+			for (std::size_t begin = 0; begin < length;)
+			{
+				if (m_lineStart)
+				{
+					WritePrefix(level, time);
+				}
+
+				auto newline = static_cast<const char *>(std::memchr(text + begin, '\n', length - begin));
+				auto end = newline != nullptr ? static_cast<std::size_t>(newline - text) + 1 : length;
+				m_stream.write(text + begin, end - begin);
+				m_lineStart = newline != nullptr;
+				begin = end;
+			}
+		}
+
+		void WritePrefix(const Log::Level &level, const std::chrono::system_clock::time_point &time)
+		{
+			static const char *LEVEL_NAMES[] = { "Debug", "Info", "Warning", "Error" };
+
+			auto rawtime = std::chrono::system_clock::to_time_t(time);
+			auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count() % 1000;
+			struct tm timeinfo = {};
+#if defined(ACID_BUILD_WINDOWS)
+			localtime_s(&timeinfo, &rawtime);
+#else
+			localtime_r(&rawtime, &timeinfo);
+#endif
+			char buffer[64];
+			auto length = strftime(buffer, sizeof(buffer), "%H:%M:%S", &timeinfo);
+			length += snprintf(buffer + length, sizeof(buffer) - length, ".%03i [%s] ", static_cast<int32_t>(milliseconds),
+				LEVEL_NAMES[static_cast<int32_t>(level)]);
+			m_stream.write(buffer, length);
+		}
+
+		// Written by any thread.
+		std::unique_ptr<Entry[]> m_entries;
+		alignas(64) std::atomic<std::size_t> m_enqueuePosition;
+		std::atomic<uint64_t> m_dropped;
+		std::unique_ptr<Site[]> m_sites;
+
+		// Only used by the writer thread, and by OpenLog under the stream mutex.
+		alignas(64) std::size_t m_dequeuePosition;
+		std::mutex m_streamMutex;
+		std::ofstream m_stream;
+		bool m_lineStart;
+
+		std::thread m_thread;
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+		std::condition_variable m_flushed;
+		std::size_t m_written;
+		bool m_flushing;
+		bool m_stopping;
+	};
 
 	void Log::Popup(const std::string &title, const std::string &message)
 	{
+		Flush();
 #if defined(ACID_BUILD_WINDOWS)
 		MessageBox(nullptr, message.c_str(), title.c_str(), 0);
 #endif
@@ -33,8 +407,93 @@ namespace acid
 
 	void Log::OpenLog(const std::string &filename)
 	{
-		std::lock_guard<std::mutex> lock(MUTEX);
-		FileSystem::Create(filename);
-		STREAM.open(filename);
+		if (auto writer = LogWriter::Get(); writer != nullptr)
+		{
+			writer->OpenLog(filename);
+		}
+	}
+
+	void Log::Flush()
+	{
+		if (auto writer = LogWriter::Get(); writer != nullptr)
+		{
+			writer->Flush();
+		}
+	}
+
+	void Log::Write(const Level &level, const char *site, const char *string, const std::size_t &length)
+	{
+		auto writer = LogWriter::Get();
+
+		if (writer == nullptr)
+		{
+			LogWriter::WriteDirect(level, string, length);
+			return;
+		}
+
+		auto time = std::chrono::system_clock::now();
+
+		if (!writer->Limit(site, time))
+		{
+			return;
+		}
+
+		writer->Push(level, time, [string, length](char *buffer, std::size_t size)
+		{
+			std::memcpy(buffer, string, std::min(length, size));
+			return static_cast<int32_t>(length);
+		});
+	}
+
+	int32_t Log::FormatEscaped(char *buffer, std::size_t size, const char *format, const void *args)
+	{
+		std::size_t length = 0;
+
+		for (auto it = format; *it != '\0'; ++it)
+		{
+			if (it[0] == '%' && it[1] == '%')
+			{
+				++it;
+			}
+
+			if (length + 1 < size)
+			{
+				buffer[length] = *it;
+			}
+
+			length++;
+		}
+
+		if (size > 0)
+		{
+			buffer[std::min(length, size - 1)] = '\0';
+		}
+
+		return static_cast<int32_t>(length);
+	}
+
+	void Log::Write(const Level &level, const char *format, const Formatter &formatter, const void *args)
+	{
+		auto writer = LogWriter::Get();
+
+		if (writer == nullptr)
+		{
+			char buffer[MESSAGE_SIZE];
+			auto length = std::max(formatter(buffer, sizeof(buffer), format, args), 0);
+			LogWriter::WriteDirect(level, buffer, std::min(static_cast<std::size_t>(length), sizeof(buffer) - 1));
+			return;
+		}
+
+		auto time = std::chrono::system_clock::now();
+
+		if (!writer->Limit(format, time))
+		{
+			return;
+		}
+
+		writer->Push(level, time, [formatter, format, args](char *buffer, std::size_t size)
+		{
+			return formatter(buffer, size, format, args);
+		});
 	}
 }
@@ -1,24 +1,45 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <memory>
 #include <mutex>
-#include <fstream>
 #include <string>
+#include <tuple>
 #include "Exports.hpp"
 
+// The lowest level of message compiled in, messages below it are removed at compile time.
+// 0 is debug, 1 is info, 2 is warning and 3 is error.
+#if !defined(ACID_LOG_LEVEL)
+#define ACID_LOG_LEVEL 0
+#endif
+
 namespace acid
 {
 	/// <summary>
-	/// A logging class used in Acid, will write output to a file one the application has closed.
+	/// A logging class used in Acid. Messages are formatted on the calling thread into a lock free queue,
+	/// a background thread writes them into the console and log file so a thread logging never waits on either.
+	/// When the queue is full messages are dropped and counted. When a rate limit is set, messages of a format logged more often than it are suppressed and counted.
 	/// </summary>
 	class ACID_EXPORT Log
 	{
 	public:
+		enum class Level
+		{
+			Debug = 0,
+			Info = 1,
+			Warning = 2,
+			Error = 3
+		};
+
 		/// <summary>
 		/// Outputs a message into the console.
 		/// </summary>
 		/// <param name="string"> The string to output. </param>
-		static void Out(const std::string &string);
+		static void Out(const std::string &string) { WriteString<Level::Info>(string); }
 
 		/// <summary>
 		/// Outputs a message into the console.
@@ -26,16 +47,41 @@ namespace acid
 		/// <param name="format"> The format to output into. </param>
 		/// <param name="args"> The args to be added into the format. </param>
 		template<typename... Args>
-		static void Out(const std::string &format, Args &&... args)
-		{
-			Out(StringFormat(format, std::forward<Args>(args)...));
-		}
+		static void Out(const char *format, Args &&... args) { WriteFormat<Level::Info>(format, args...); }
+
+		/// <summary>
+		/// Outputs a debug message into the console.
+		/// </summary>
+		/// <param name="string"> The string to output. </param>
+		static void Debug(const std::string &string) { WriteString<Level::Debug>(string); }
+
+		/// <summary>
+		/// Outputs a debug message into the console.
+		/// </summary>
+		/// <param name="format"> The format to output into. </param>
+		/// <param name="args"> The args to be added into the format. </param>
+		template<typename... Args>
+		static void Debug(const char *format, Args &&... args) { WriteFormat<Level::Debug>(format, args...); }
+
+		/// <summary>
+		/// Outputs a warning into the console.
+		/// </summary>
+		/// <param name="string"> The string to output. </param>
+		static void Warning(const std::string &string) { WriteString<Level::Warning>(string); }
+
+		/// <summary>
+		/// Outputs a warning into the console.
+		/// </summary>
+		/// <param name="format"> The format to output into. </param>
+		/// <param name="args"> The args to be added into the format. </param>
+		template<typename... Args>
+		static void Warning(const char *format, Args &&... args) { WriteFormat<Level::Warning>(format, args...); }
 
 		/// <summary>
 		/// Outputs a error into the console.
 		/// </summary>
 		/// <param name="string"> The string to output. </param>
-		static void Error(const std::string &string);
+		static void Error(const std::string &string) { WriteString<Level::Error>(string); }
 
 		/// <summary>
 		/// Outputs a error into the console.
@@ -43,13 +89,10 @@ namespace acid
 		/// <param name="format"> The format to output into. </param>
 		/// <param name="args"> The args to be added into the format. </param>
 		template<typename... Args>
-		static void Error(const std::string &format, Args &&... args)
-		{
-			Error(StringFormat(format, std::forward<Args>(args)...));
-		}
+		static void Error(const char *format, Args &&... args) { WriteFormat<Level::Error>(format, args...); }
 
 		/// <summary>
-		/// Displays a popup menu.
+		/// Displays a popup menu, messages logged before it are written first.
 		/// </summary>
 		/// <param name="title"> The title. </param>
 		/// <param name="message"> The message. </param>
@@ -60,17 +103,108 @@ namespace acid
 		/// </summary>
 		/// <param name="filename"> The filename to output into. </param>
 		static void OpenLog(const std::string &filename);
+
+		/// <summary>
+		/// Waits until every message logged before this call has been written.
+		/// </summary>
+		static void Flush();
+
+		/// <summary>
+		/// Gets the lowest level of message that is output.
+		/// </summary>
+		/// <returns> The log level. </returns>
+		static Level GetLevel() { return LEVEL.load(std::memory_order_relaxed); }
+
+		/// <summary>
+		/// Sets the lowest level of message that is output, levels below <see cref="ACID_LOG_LEVEL"/> are never output.
+		/// </summary>
+		/// <param name="level"> The log level. </param>
+		static void SetLevel(const Level &level) { LEVEL.store(level, std::memory_order_relaxed); }
+
+		/// <summary>
+		/// Gets the most messages of a format output each second, messages after this are suppressed. Unlimited by default.
+		/// </summary>
+		/// <returns> The messages per second, 0 if unlimited. </returns>
+		static uint32_t GetRateLimit() { return RATE_LIMIT.load(std::memory_order_relaxed); }
+
+		/// <summary>
+		/// Sets the most messages of a format output each second. Formats are told apart by address,
+		/// so identical literals the compiler pools share a limit.
+		/// </summary>
+		/// <param name="rateLimit"> The messages per second, 0 if unlimited. </param>
+		static void SetRateLimit(const uint32_t &rateLimit) { RATE_LIMIT.store(rateLimit, std::memory_order_relaxed); }
 	private:
-		static ACID_STATE std::mutex MUTEX;
-		static ACID_STATE std::ofstream STREAM;
+		/// <summary>
+		/// Writes a message into a buffer, returns the length of the whole message like snprintf.
+		/// </summary>
+		using Formatter = int32_t(*)(char *buffer, std::size_t size, const char *format, const void *args);
 
-		template<typename... Args>
-		static std::string StringFormat(const std::string &format, Args &&... args)
+		static ACID_STATE std::atomic<Level> LEVEL;
+		static ACID_STATE std::atomic<uint32_t> RATE_LIMIT;
+
+		template<Level L>
+		static bool IsEnabled()
+		{
+			if constexpr (static_cast<int32_t>(L) < ACID_LOG_LEVEL)
+			{
+				return false;
+			}
+			else
+			{
+				return L >= GetLevel();
+			}
+		}
+
+		template<Level L>
+		static void WriteString(const std::string &string)
 		{
-			size_t size = snprintf(nullptr, 0, format.c_str(), args ...) + 1; // Extra space for '\0'
-			std::unique_ptr<char[]> buf(new char[size]);
-			snprintf(buf.get(), size, format.c_str(), args ...);
-			return std::string(buf.get(), buf.get() + size - 1); // Excludes the '\0'
+			if (IsEnabled<L>())
+			{
+				Write(L, nullptr, string.c_str(), string.size());
+			}
 		}
+
+		template<Level L, typename... Args>
+		static void WriteFormat(const char *format, Args &... args)
+		{
+			if (!IsEnabled<L>())
+			{
+				return;
+			}
+
+			if constexpr (sizeof...(Args) == 0)
+			{
+				// Without arguments only escaped percent signs change, a message without any is written as it is.
+				if (std::strchr(format, '%') == nullptr)
+				{
+					Write(L, format, format, std::char_traits<char>::length(format));
+				}
+				else
+				{
+					Write(L, format, &Log::FormatEscaped, nullptr);
+				}
+			}
+			else
+			{
+				using Arguments = std::tuple<Args &...>;
+				Arguments arguments(args...);
+				Write(L, format, [](char *buffer, std::size_t size, const char *formatString, const void *data) -> int32_t
+				{
+					return std::apply([buffer, size, formatString](auto &... values)
+					{
+						return snprintf(buffer, size, formatString, values...);
+					}, *static_cast<const Arguments *>(data));
+				}, &arguments);
+			}
+		}
+
+		/// <summary>
+		/// Formats a format string that has no arguments like snprintf, each "%%" is written as a single '%'.
+		/// </summary>
+		static int32_t FormatEscaped(char *buffer, std::size_t size, const char *format, const void *args);
+
+		static void Write(const Level &level, const char *site, const char *string, const std::size_t &length);
+
+		static void Write(const Level &level, const char *format, const Formatter &formatter, const void *args);
 	};
 }
@@ -1,5 +1,6 @@
 #include "ModuleManager.hpp"
 
+#include "Animations/Animations.hpp"
 #include "Audio/Audio.hpp"
 #include "Devices/Joysticks.hpp"
 #include "Devices/Keyboard.hpp"
@@ -40,6 +41,7 @@ namespace acid
 		Add<Keyboard>(Module::Stage::Pre);
 		Add<Mouse>(Module::Stage::Pre);
 		Add<Files>(Module::Stage::Pre);
+		Add<Animations>(Module::Stage::Normal);
 		Add<Scenes>(Module::Stage::Normal);
 		Add<Gizmos>(Module::Stage::Normal);
 		Add<Resources>(Module::Stage::Pre);
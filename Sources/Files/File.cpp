@@ -2,11 +2,79 @@
 
 #include <utility>
 #include "Engine/Engine.hpp"
+#include "Serialized/Binary/Binary.hpp"
 #include "Files.hpp"
 #include "FileSystem.hpp"
 
 namespace acid
 {
+	/// <summary>
+	/// Gets the path on disk of a file found by real or partial path.
+	/// </summary>
+	static std::optional<std::string> FindRealPath(const std::string &filename)
+	{
+		if (Files::ExistsInPath(filename))
+		{
+			return Files::RealPath(filename);
+		}
+
+		if (FileSystem::Exists(filename))
+		{
+			return filename;
+		}
+
+		return {};
+	}
+
+	/// <summary>
+	/// Loads a binary document into a metadata node, the file is memory mapped when it is on disk.
+	/// </summary>
+	static bool ReadBinary(const std::string &filename, Metadata *metadata)
+	{
+		if (auto realPath = FindRealPath(filename); realPath)
+		{
+			return Binary::Load(metadata, *realPath);
+		}
+
+		if (Files::ExistsInPath(filename))
+		{
+			ifstream inStream(filename);
+			return Binary::Load(metadata, &inStream);
+		}
+
+		return false;
+	}
+
+	static void ReadText(const std::string &filename, Metadata *metadata)
+	{
+		if (Files::ExistsInPath(filename))
+		{
+			ifstream inStream(filename);
+			metadata->Load(&inStream);
+		}
+		else if (FileSystem::Exists(filename))
+		{
+			std::ifstream inStream(filename);
+			metadata->Load(&inStream);
+			inStream.close();
+		}
+	}
+
+	/// <summary>
+	/// Gets if a baked binary copy of a text document can be used in its place, a copy on disk that is older than its source is ignored.
+	/// </summary>
+	static bool IsBakedCurrent(const std::string &filename, const std::string &bakedFilename)
+	{
+		if (!Files::ExistsInPath(bakedFilename) && !FileSystem::Exists(bakedFilename))
+		{
+			return false;
+		}
+
+		auto realPath = FindRealPath(filename);
+		auto bakedRealPath = FindRealPath(bakedFilename);
+		return !realPath || !bakedRealPath || FileSystem::LastModified(*bakedRealPath) >= FileSystem::LastModified(*realPath);
+	}
+
 	File::File(std::string filename, Metadata *metadata) :
 		m_filename(std::move(filename)),
 		m_metadata(metadata)
@@ -19,16 +87,16 @@ namespace acid
 		auto debugStart = Engine::GetTime();
 #endif
 
-		if (Files::ExistsInPath(m_filename))
+		// A baked binary copy of a text document is loaded in its place.
+		auto bakedFilename = m_filename + Binary::Extension;
+
+		if (FileSystem::FileSuffix(m_filename) == Binary::Extension)
 		{
-			ifstream inStream(m_filename);
-			m_metadata->Load(&inStream);
+			ReadBinary(m_filename, m_metadata.get());
 		}
-		else if (FileSystem::Exists(m_filename))
+		else if (!IsBakedCurrent(m_filename, bakedFilename) || !ReadBinary(bakedFilename, m_metadata.get()))
 		{
-			std::ifstream inStream(m_filename);
-			m_metadata->Load(&inStream);
-			inStream.close();
+			ReadText(m_filename, m_metadata.get());
 		}
 
 #if defined(ACID_VERBOSE)
@@ -43,16 +111,29 @@ namespace acid
 		auto debugStart = Engine::GetTime();
 #endif
 
+		auto binary = FileSystem::FileSuffix(m_filename) == Binary::Extension;
+
+		auto write = [this, &binary](std::ostream *outStream)
+		{
+			if (binary)
+			{
+				Binary::Write(*m_metadata, outStream);
+				return;
+			}
+
+			m_metadata->Write(outStream);
+		};
+
 		if (Files::ExistsInPath(m_filename))
 		{
 			ofstream outStream(m_filename);
-			m_metadata->Write(&outStream);
+			write(&outStream);
 		}
 		else // if (FileSystem::Exists(m_filename))
 		{
 			FileSystem::Create(m_filename);
-			std::ofstream outStream(m_filename);
-			m_metadata->Write(&outStream);
+			std::ofstream outStream(m_filename, binary ? std::ios::binary : std::ios::out);
+			write(&outStream);
 			outStream.close();
 		}
 
@@ -293,6 +293,18 @@ namespace acid
 		return std::string(data.begin(), data.end());
 	}
 
+	std::optional<std::string> Files::RealPath(const std::string &path)
+	{
+		auto directory = PHYSFS_getRealDir(path.c_str());
+
+		if (directory == nullptr || !FileSystem::IsDirectory(directory))
+		{
+			return {};
+		}
+
+		return FileSystem::JoinPath({directory, path});
+	}
+
 	std::vector<std::string> Files::FilesInPath(const std::string &path, const bool &recursive)
 	{
 		std::vector<std::string> result = {};
@@ -105,6 +105,13 @@ namespace acid
 		/// <returns> The data read from the file. </returns>
 		static std::optional<std::string> Read(const std::string &path);
 
+		/// <summary>
+		/// Gets the path on disk of a file found in a search path, files inside of archives have no real path.
+		/// </summary>
+		/// <param name="path"> The path to look for. </param>
+		/// <returns> The real path, used to memory map files. </returns>
+		static std::optional<std::string> RealPath(const std::string &path);
+
 		/// <summary>
 		/// Finds all the files in a path.
 		/// </summary>
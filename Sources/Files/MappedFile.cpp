@@ -0,0 +1,106 @@
+#include "MappedFile.hpp"
+
+#if defined(ACID_BUILD_WINDOWS)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "Engine/Log.hpp"
+
+namespace acid
+{
+	MappedFile::MappedFile(const std::string &filename) :
+		m_data(nullptr),
+		m_size(0)
+#if defined(ACID_BUILD_WINDOWS)
+		,
+		m_file(INVALID_HANDLE_VALUE),
+		m_mapping(nullptr)
+#endif
+	{
+#if defined(ACID_BUILD_WINDOWS)
+		m_file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+		if (m_file == INVALID_HANDLE_VALUE)
+		{
+			Log::Error("Could not open file to map '%s'\n", filename.c_str());
+			return;
+		}
+
+		LARGE_INTEGER size;
+
+		if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+		{
+			return;
+		}
+
+		m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+		if (m_mapping == nullptr)
+		{
+			Log::Error("Could not create file mapping of '%s'\n", filename.c_str());
+			return;
+		}
+
+		m_data = static_cast<const char *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+		m_size = static_cast<std::size_t>(size.QuadPart);
+#else
+		auto file = open(filename.c_str(), O_RDONLY);
+
+		if (file == -1)
+		{
+			Log::Error("Could not open file to map '%s'\n", filename.c_str());
+			return;
+		}
+
+		struct stat st;
+
+		if (fstat(file, &st) == -1 || st.st_size == 0)
+		{
+			close(file);
+			return;
+		}
+
+		auto data = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+		// The mapping keeps its own reference to the file.
+		close(file);
+
+		if (data == MAP_FAILED)
+		{
+			Log::Error("Could not map file '%s'\n", filename.c_str());
+			return;
+		}
+
+		m_data = static_cast<const char *>(data);
+		m_size = static_cast<std::size_t>(st.st_size);
+#endif
+	}
+
+	MappedFile::~MappedFile()
+	{
+#if defined(ACID_BUILD_WINDOWS)
+		if (m_data != nullptr)
+		{
+			UnmapViewOfFile(m_data);
+		}
+
+		if (m_mapping != nullptr)
+		{
+			CloseHandle(m_mapping);
+		}
+
+		if (m_file != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(m_file);
+		}
+#else
+		if (m_data != nullptr)
+		{
+			munmap(const_cast<char *>(m_data), m_size);
+		}
+#endif
+	}
+}
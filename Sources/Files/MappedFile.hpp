@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include "Helpers/NonCopyable.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// A read only view of a file on disk that is mapped into memory, pages are loaded by the OS as they are touched.
+	/// </summary>
+	class ACID_EXPORT MappedFile :
+		public NonCopyable
+	{
+	public:
+		/// <summary>
+		/// Maps a file into memory, check <seealso cref="#IsOpen()"/> to see if the mapping succeeded.
+		/// </summary>
+		/// <param name="filename"> The real path of the file to map. </param>
+		explicit MappedFile(const std::string &filename);
+
+		~MappedFile();
+
+		bool IsOpen() const { return m_data != nullptr; }
+
+		const char *GetData() const { return m_data; }
+
+		std::size_t GetSize() const { return m_size; }
+	private:
+		const char *m_data;
+		std::size_t m_size;
+#if defined(ACID_BUILD_WINDOWS)
+		void *m_file;
+		void *m_mapping;
+#endif
+	};
+}
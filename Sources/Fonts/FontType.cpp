@@ -7,15 +7,15 @@ namespace acid
 {
 	std::shared_ptr<FontType> FontType::Create(const Metadata &metadata)
 	{
-		auto resource = Resources::Get()->Find(metadata);
+		auto resource = Resources::Get()->Find<FontType>(metadata);
 
 		if (resource != nullptr)
 		{
-			return std::dynamic_pointer_cast<FontType>(resource);
+			return resource;
 		}
 
 		auto result = std::make_shared<FontType>("", "");
-		Resources::Get()->Add(metadata, std::dynamic_pointer_cast<Resource>(result));
+		Resources::Get()->Add(metadata, result);
 		result->Decode(metadata);
 		result->Load();
 		return result;
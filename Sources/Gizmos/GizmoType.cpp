@@ -13,15 +13,15 @@ namespace acid
 
 	std::shared_ptr<GizmoType> GizmoType::Create(const Metadata &metadata)
 	{
-		auto resource = Resources::Get()->Find(metadata);
+		auto resource = Resources::Get()->Find<GizmoType>(metadata);
 
 		if (resource != nullptr)
 		{
-			return std::dynamic_pointer_cast<GizmoType>(resource);
+			return resource;
 		}
 
 		auto result = std::make_shared<GizmoType>(nullptr);
-		Resources::Get()->Add(metadata, std::dynamic_pointer_cast<Resource>(result));
+		Resources::Get()->Add(metadata, result);
 		result->Decode(metadata);
 		result->Load();
 		return result;
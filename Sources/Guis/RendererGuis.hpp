@@ -13,6 +13,8 @@ namespace acid
 		explicit RendererGuis(const Pipeline::Stage &pipelineStage);
 
 		void Render(const CommandBuffer &commandBuffer) override;
+
+		bool IsParallel() const override { return true; }
 	private:
 		PipelineGraphics m_pipeline;
 		UniformHandler m_uniformScene;
@@ -1,14 +1,18 @@
 #include "String.hpp"
 
 #include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <memory>
 
 namespace acid
 {
-	std::vector<std::string> String::Split(const std::string &str, const std::string &sep, const bool &trim)
+	std::vector<std::string> String::Split(const std::string_view &str, const std::string &sep, const bool &trim)
 	{
-		std::unique_ptr<char[]> copy(new char[strlen(str.c_str()) + 1]);
-		std::strcpy(copy.get(), str.c_str());
+		std::unique_ptr<char[]> copy(new char[str.size() + 1]);
+		std::memcpy(copy.get(), str.data(), str.size());
+		copy[str.size()] = '\0';
 
 		std::vector<std::string> result = {};
 		auto current = std::strtok(copy.get(), sep.c_str());
@@ -87,6 +91,19 @@ namespace acid
 		return result;
 	}
 
+	std::string_view String::Trim(const std::string_view &str, const std::string_view &whitespace)
+	{
+		auto strBegin = str.find_first_not_of(whitespace);
+
+		if (strBegin == std::string_view::npos)
+		{
+			return {};
+		}
+
+		auto strEnd = str.find_last_not_of(whitespace);
+		return str.substr(strBegin, strEnd - strBegin + 1);
+	}
+
 	std::string String::Substring(const std::string &str, const uint32_t &start, const uint32_t &end)
 	{
 		auto result = str;
@@ -158,4 +175,124 @@ namespace acid
 		std::transform(result.begin(), result.end(), result.begin(), toupper);
 		return result;
 	}
+
+	std::size_t String::CountTokens(const std::string_view &str)
+	{
+		std::size_t count = 0;
+		auto inToken = false;
+
+		for (const auto &c : str)
+		{
+			auto whitespace = IsWhitespace(c);
+			count += !whitespace && !inToken;
+			inToken = !whitespace;
+		}
+
+		return count;
+	}
+
+	std::string_view String::SkipToNumber(const std::string_view &str)
+	{
+		std::size_t begin = 0;
+
+		while (begin < str.size() && IsWhitespace(str[begin]))
+		{
+			begin++;
+		}
+
+		// Streams accept a explicit plus sign, charconv does not.
+		if (begin + 1 < str.size() && str[begin] == '+' && str[begin + 1] != '-')
+		{
+			begin++;
+		}
+
+		return str.substr(begin);
+	}
+
+#if defined(__cpp_lib_to_chars)
+	template<typename T>
+	static std::string ToFloatChars(const T &val)
+	{
+		char buffer[32];
+		auto result = std::to_chars(buffer, buffer + sizeof(buffer), val);
+		return std::string(buffer, result.ptr);
+	}
+
+	template<typename T>
+	static bool FromFloatChars(const std::string_view &str, T &val)
+	{
+		return std::from_chars(str.data(), str.data() + str.size(), val).ec == std::errc();
+	}
+#else
+	/// <summary>
+	/// Writes the shortest printf form that reads back as the same value, for standard libraries without floating point charconv.
+	/// </summary>
+	template<typename T>
+	static std::string ToFloatChars(const T &val)
+	{
+		char buffer[32];
+		auto minDigits = std::is_same_v<float, T> ? 6 : 15;
+		auto maxDigits = std::is_same_v<float, T> ? 9 : 17;
+
+		for (auto digits = minDigits; digits <= maxDigits; digits++)
+		{
+			std::snprintf(buffer, sizeof(buffer), "%.*g", digits, static_cast<double>(val));
+
+			if (static_cast<T>(std::strtod(buffer, nullptr)) == val)
+			{
+				break;
+			}
+		}
+
+		return buffer;
+	}
+
+	template<typename T>
+	static bool FromFloatChars(const std::string_view &str, T &val)
+	{
+		char buffer[64];
+		auto size = std::min(str.size(), sizeof(buffer) - 1);
+		std::memcpy(buffer, str.data(), size);
+		buffer[size] = '\0';
+
+		char *end;
+		val = static_cast<T>(std::strtod(buffer, &end));
+		return end != buffer;
+	}
+#endif
+
+	std::string String::ToFloat(const float &val)
+	{
+		return ToFloatChars(val);
+	}
+
+	std::string String::ToFloat(const double &val)
+	{
+		return ToFloatChars(val);
+	}
+
+	bool String::FromFloat(const std::string_view &str, float &val)
+	{
+		return FromFloatChars(SkipToNumber(str), val);
+	}
+
+	bool String::FromFloat(const std::string_view &str, double &val)
+	{
+		return FromFloatChars(SkipToNumber(str), val);
+	}
+
+	bool String::FromBool(const std::string_view &str)
+	{
+		auto trimmed = Trim(str);
+
+		if (trimmed.size() == 4)
+		{
+			return std::equal(trimmed.begin(), trimmed.end(), "true", [](const char &a, const char &b)
+			{
+				return std::tolower(a) == b;
+			});
+		}
+
+		return From<int32_t>(trimmed) == 1;
+	}
 }
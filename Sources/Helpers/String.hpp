@@ -1,8 +1,10 @@
 #pragma once
 
+#include <charconv>
 #include <locale>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <optional>
 #include "Engine/Exports.hpp"
@@ -22,7 +24,7 @@ namespace acid
 		/// <param name="sep"> The separator. </param>
 		/// <param name="trim"> If each object should be trimmed. </param>
 		/// <returns> The split string vector. </returns>
-		static std::vector<std::string> Split(const std::string &str, const std::string &sep, const bool &trim = false);
+		static std::vector<std::string> Split(const std::string_view &str, const std::string &sep, const bool &trim = false);
 
 		/// <summary>
 		/// Gets if a string starts with a token.
@@ -63,6 +65,14 @@ namespace acid
 		/// <returns> The trimmed string. </returns>
 		static std::string Trim(const std::string &str, const std::string &whitespace = " \t\n\r");
 
+		/// <summary>
+		/// Trims the left and right side of a string view of whitespace, without copying.
+		/// </summary>
+		/// <param name="str"> The string view. </param>
+		/// <param name="whitespace"> The whitespace type. </param>
+		/// <returns> The trimmed view. </returns>
+		static std::string_view Trim(const std::string_view &str, const std::string_view &whitespace = " \t\n\r");
+
 		/// <summary>
 		/// Takes a substring of a string between two bounds.
 		/// </summary>
@@ -121,7 +131,8 @@ namespace acid
 		static std::string Uppercase(const std::string &str);
 
 		/// <summary>
-		/// Converts a type to a string.
+		/// Converts a type to a string, numbers are written without allocating a stream.
+		/// Floating point numbers are written with the fewest digits that read back as the same value.
 		/// </summary>
 		/// <param name="val"> The value to convert. </param>
 		/// <returns> The value as a string. </returns>
@@ -131,12 +142,26 @@ namespace acid
 			if constexpr (std::is_enum_v<T>)
 			{
 				typedef typename std::underlying_type<T>::type safe_type;
-				return std::to_string(static_cast<safe_type>(val));
+				return To(static_cast<safe_type>(val));
 			}
 			else if constexpr (std::is_same_v<bool, T>)
 			{
 				return val ? "true" : "false";
 			}
+			else if constexpr (std::is_integral_v<T>)
+			{
+				char buffer[24];
+				auto result = std::to_chars(buffer, buffer + sizeof(buffer), val);
+				return std::string(buffer, result.ptr);
+			}
+			else if constexpr (std::is_same_v<float, T>)
+			{
+				return ToFloat(val);
+			}
+			else if constexpr (std::is_floating_point_v<T>)
+			{
+				return ToFloat(static_cast<double>(val));
+			}
 			else
 			{
 				return std::to_string(static_cast<T>(val));
@@ -154,44 +179,138 @@ namespace acid
 		};
 
 		/// <summary>
-		/// Converts a string to a type.
+		/// Converts a string to a type, leading whitespace is skipped and parsing stops at the first character that is not part of the value.
 		/// </summary>
 		/// <param name="str"> The string to convert. </param>
-		/// <returns> The string as a value. </returns>
+		/// <returns> The string as a value, or a default value if the string does not start with one. </returns>
 		template<typename T>
-		static T From(const std::string &str)
+		static T From(const std::string_view &str)
 		{
-			if constexpr (std::is_enum_v<T>)
+			if constexpr (is_optional<T>::value)
 			{
-				typedef typename std::underlying_type<T>::type safe_type;
-				return static_cast<T>(From<safe_type>(str));
+				typedef typename T::value_type base_type;
+				base_type temp;
+
+				if (!FromChars(str, temp))
+				{
+					return {};
+				}
+
+				return temp;
 			}
-			else if constexpr (std::is_same_v<bool, T>)
+			else
 			{
-				return Lowercase(str) == "true" || From<int32_t>(str) == 1;
+				T temp;
+
+				if (!FromChars(str, temp))
+				{
+					return T();
+				}
+
+				return temp;
 			}
-			else
+		}
+
+		/// <summary>
+		/// Converts a whitespace separated list to values, without splitting it into strings first.
+		/// </summary>
+		/// <param name="str"> The string to convert. </param>
+		/// <returns> The values, a token that is not a value is read as a default value. </returns>
+		template<typename T>
+		static std::vector<T> FromList(const std::string_view &str)
+		{
+			std::vector<T> result;
+			result.reserve(CountTokens(str));
+			auto it = str.data();
+			auto end = str.data() + str.size();
+
+			while (true)
 			{
-				std::istringstream iss(str);
+				while (it != end && IsWhitespace(*it))
+				{
+					it++;
+				}
 
-				if constexpr (is_optional<T>::value)
+				if (it == end)
 				{
-					typedef typename T::value_type base_type;
-					base_type temp;
+					break;
+				}
 
-					if ((iss >> temp).fail())
-					{
-						return {};
-					}
+				auto tokenEnd = it;
 
-					return temp;
+				while (tokenEnd != end && !IsWhitespace(*tokenEnd))
+				{
+					tokenEnd++;
 				}
-				else
+
+				result.emplace_back(From<T>(std::string_view(it, tokenEnd - it)));
+				it = tokenEnd;
+			}
+
+			return result;
+		}
+	private:
+		static bool IsWhitespace(const char &c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+		static std::size_t CountTokens(const std::string_view &str);
+
+		static std::string_view SkipToNumber(const std::string_view &str);
+
+		static std::string ToFloat(const float &val);
+
+		static std::string ToFloat(const double &val);
+
+		static bool FromFloat(const std::string_view &str, float &val);
+
+		static bool FromFloat(const std::string_view &str, double &val);
+
+		static bool FromBool(const std::string_view &str);
+
+		template<typename T>
+		static bool FromChars(const std::string_view &str, T &val)
+		{
+			if constexpr (std::is_enum_v<T>)
+			{
+				typename std::underlying_type<T>::type temp;
+
+				if (!FromChars(str, temp))
 				{
-					T temp;
-					iss >> temp;
-					return temp;
+					return false;
 				}
+
+				val = static_cast<T>(temp);
+				return true;
+			}
+			else if constexpr (std::is_same_v<bool, T>)
+			{
+				val = FromBool(str);
+				return true;
+			}
+			else if constexpr (std::is_integral_v<T>)
+			{
+				auto number = SkipToNumber(str);
+				return std::from_chars(number.data(), number.data() + number.size(), val).ec == std::errc();
+			}
+			else if constexpr (std::is_same_v<long double, T>)
+			{
+				double temp;
+
+				if (!FromFloat(str, temp))
+				{
+					return false;
+				}
+
+				val = temp;
+				return true;
+			}
+			else if constexpr (std::is_floating_point_v<T>)
+			{
+				return FromFloat(str, val);
+			}
+			else
+			{
+				std::istringstream iss{std::string(str)};
+				return !(iss >> val).fail();
 			}
 		}
 	};
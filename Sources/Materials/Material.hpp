@@ -35,6 +35,24 @@ namespace acid
 		/// <param name="descriptorSet"> The descriptor handler to update. </param>
 		virtual void PushDescriptors(DescriptorsHandler &descriptorSet) = 0;
 
+		/// <summary>
+		/// Gets if the resources pushed by this material are ready to be drawn with, until then meshes using it are not drawn.
+		/// </summary>
+		/// <returns> If the material is ready. </returns>
+		virtual bool IsLoaded() const { return true; }
+
+		/// <summary>
+		/// Gets if the material pipeline reads the transform of each mesh from the instance input of <seealso cref="RenderQueue"/>, instead of the object uniforms.
+		/// </summary>
+		/// <returns> If meshes using this material are drawn as instances. </returns>
+		virtual bool IsInstanced() const { return false; }
+
+		/// <summary>
+		/// Gets a hash of everything this material pushes apart from the transform, instanced meshes sharing a model and key are drawn together.
+		/// </summary>
+		/// <returns> The batch key. </returns>
+		virtual std::size_t GetBatchKey() const { return 0; }
+
 		/// <summary>
 		/// Gets the material pipeline defined in this material.
 		/// </summary>
@@ -1,7 +1,10 @@
 #include "MaterialDefault.hpp"
 
+#include <functional>
 #include <utility>
+#include "Animations/Animations.hpp"
 #include "Animations/MeshAnimated.hpp"
+#include "Meshes/RenderQueue.hpp"
 #include "Models/VertexModel.hpp"
 #include "Scenes/Entity.hpp"
 
@@ -34,7 +37,16 @@ namespace acid
 		}
 
 		m_animated = dynamic_cast<MeshAnimated *>(mesh) != nullptr;
-		m_pipelineMaterial = PipelineMaterial::Create({1, 0}, PipelineGraphicsCreate({"Shaders/Defaults/Default.vert", "Shaders/Defaults/Default.frag"}, {mesh->GetVertexInput()},
+
+		// Animated meshes push their own joints, so are not instanced.
+		std::vector<Shader::VertexInput> vertexInputs = {mesh->GetVertexInput(0)};
+
+		if (IsInstanced())
+		{
+			vertexInputs.emplace_back(RenderQueue::GetVertexInput(1));
+		}
+
+		m_pipelineMaterial = PipelineMaterial::Create({1, 0}, PipelineGraphicsCreate({"Shaders/Defaults/Default.vert", "Shaders/Defaults/Default.frag"}, vertexInputs,
 			PipelineGraphics::Mode::Mrt, PipelineGraphics::Depth::ReadWrite, VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, VK_POLYGON_MODE_FILL, VK_CULL_MODE_BACK_BIT, false, GetDefines()));
 	}
 
@@ -76,9 +88,13 @@ namespace acid
 	{
 		if (m_animated)
 		{
-			auto meshAnimated = GetParent()->GetComponent<MeshAnimated>();
-			auto joints = meshAnimated->GetJointTransforms(); // TODO: Move into storage buffer and update every frame.
-			uniformObject.Push("jointTransforms", *joints.data(), sizeof(Matrix4) * joints.size());
+			// The joint transforms are read from the shared storage buffer, starting at the run of this meshes animator.
+			auto jointOffset = GetParent()->GetComponent<MeshAnimated>()->GetJointOffset();
+
+			if (jointOffset)
+			{
+				uniformObject.Push("jointOffset", static_cast<int32_t>(*jointOffset));
+			}
 		}
 
 		uniformObject.Push("transform", GetParent()->GetWorldMatrix());
@@ -94,6 +110,44 @@ namespace acid
 		descriptorSet.Push("samplerDiffuse", m_diffuseTexture);
 		descriptorSet.Push("samplerMaterial", m_materialTexture);
 		descriptorSet.Push("samplerNormal", m_normalTexture);
+
+		if (m_animated)
+		{
+			descriptorSet.Push("BufferJoints", Animations::Get()->GetStorageJoints());
+		}
+	}
+
+	bool MaterialDefault::IsLoaded() const
+	{
+		// Animated meshes are not drawn until their animator has a run of the shared joint transforms.
+		return (m_diffuseTexture == nullptr || m_diffuseTexture->IsLoaded()) &&
+			(m_materialTexture == nullptr || m_materialTexture->IsLoaded()) &&
+			(m_normalTexture == nullptr || m_normalTexture->IsLoaded()) &&
+			(!m_animated || GetParent()->GetComponent<MeshAnimated>()->GetJointOffset());
+	}
+
+	std::size_t MaterialDefault::GetBatchKey() const
+	{
+		std::size_t key = 0;
+		auto combine = [&key](const std::size_t &hash)
+		{
+			key ^= hash + 0x9e3779b9 + (key << 6) + (key >> 2);
+		};
+
+		combine(std::hash<const Texture *>()(m_diffuseTexture.get()));
+		combine(std::hash<const Texture *>()(m_materialTexture.get()));
+		combine(std::hash<const Texture *>()(m_normalTexture.get()));
+
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			combine(std::hash<float>()(m_baseDiffuse[i]));
+		}
+
+		combine(std::hash<float>()(m_metallic));
+		combine(std::hash<float>()(m_roughness));
+		combine(std::hash<bool>()(m_ignoreLighting));
+		combine(std::hash<bool>()(m_ignoreFog));
+		return key;
 	}
 
 	std::vector<Shader::Define> MaterialDefault::GetDefines() const
@@ -103,7 +157,7 @@ namespace acid
 		result.emplace_back("MATERIAL_MAPPING", String::To<int32_t>(m_materialTexture != nullptr));
 		result.emplace_back("NORMAL_MAPPING", String::To<int32_t>(m_normalTexture != nullptr));
 		result.emplace_back("ANIMATED", String::To<int32_t>(m_animated));
-		result.emplace_back("MAX_JOINTS", String::To(MeshAnimated::MaxJoints));
+		result.emplace_back("INSTANCED", String::To<int32_t>(IsInstanced()));
 		result.emplace_back("MAX_WEIGHTS", String::To(MeshAnimated::MaxWeights));
 		return result;
 	}
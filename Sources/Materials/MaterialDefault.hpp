@@ -30,6 +30,12 @@ namespace acid
 
 		void PushDescriptors(DescriptorsHandler &descriptorSet) override;
 
+		bool IsLoaded() const override;
+
+		bool IsInstanced() const override { return !m_animated; }
+
+		std::size_t GetBatchKey() const override;
+
 		const Colour &GetBaseDiffuse() const { return m_baseDiffuse; }
 
 		void SetBaseDiffuse(const Colour &baseDiffuse) { m_baseDiffuse = baseDiffuse; }
@@ -11,15 +11,15 @@ namespace acid
 		Metadata metadata = Metadata();
 		temp.Encode(metadata);
 
-		auto resource = Resources::Get()->Find(metadata);
+		auto resource = Resources::Get()->Find<PipelineMaterial>(metadata);
 
 		if (resource != nullptr)
 		{
-			return std::dynamic_pointer_cast<PipelineMaterial>(resource);
+			return resource;
 		}
 
 		auto result = std::make_shared<PipelineMaterial>(pipelineStage, pipelineCreate);
-		Resources::Get()->Add(metadata, std::dynamic_pointer_cast<Resource>(result));
+		Resources::Get()->Add(metadata, result);
 	//	result->Decode(metadata);
 	//	result->Load();
 		return result;
@@ -0,0 +1,173 @@
+#include "Culling.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include "Physics/Frustum.hpp"
+#include "Simd.hpp"
+
+namespace acid
+{
+	// The number of set bits in each 4 bit mask.
+	static const uint32_t MASK_COUNTS[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+
+	/// <summary>
+	/// The frustum planes with each coefficient packed into all four floats, so a group of bounds is tested against a plane without shuffles.
+	/// </summary>
+	struct PackedPlanes
+	{
+		explicit PackedPlanes(const Frustum &frustum)
+		{
+			const auto &planes = frustum.GetPlanes();
+
+			for (uint32_t i = 0; i < 6; i++)
+			{
+				x[i] = Simd::Splat(planes[i][0]);
+				y[i] = Simd::Splat(planes[i][1]);
+				z[i] = Simd::Splat(planes[i][2]);
+				w[i] = Simd::Splat(planes[i][3]);
+			}
+		}
+
+		Simd::Float4 x[6];
+		Simd::Float4 y[6];
+		Simd::Float4 z[6];
+		Simd::Float4 w[6];
+	};
+
+	/// <summary>
+	/// Loads each group of four bounds and passes the mask of the visible ones to a function.
+	/// The last group is copied into zero padded arrays when the count is not a multiple of four, and the bits of the padding are cleared.
+	/// </summary>
+	template<std::size_t N, typename T, typename F>
+	static void ForEachGroup(const std::array<const float *, N> &arrays, const std::size_t &count, T test, F function)
+	{
+		Simd::Float4 values[N];
+		std::size_t i = 0;
+
+		for (; i + 4 <= count; i += 4)
+		{
+			for (std::size_t j = 0; j < N; j++)
+			{
+				values[j] = Simd::LoadUnaligned(arrays[j] + i);
+			}
+
+			function(i, test(values));
+		}
+
+		if (i == count)
+		{
+			return;
+		}
+
+		alignas(16) float padded[N][4] = {};
+
+		for (std::size_t j = 0; j < N; j++)
+		{
+			std::copy(arrays[j] + i, arrays[j] + count, padded[j]);
+			values[j] = Simd::Load(padded[j]);
+		}
+
+		function(i, test(values) & ((1u << (count - i)) - 1));
+	}
+
+	template<typename F>
+	static void ForEachCubes(const Frustum &frustum, const Culling::Cubes &cubes, const std::size_t &count, F function)
+	{
+		PackedPlanes planes(frustum);
+		auto zero = Simd::Splat(0.0f);
+
+		ForEachGroup<6>({cubes.minX, cubes.minY, cubes.minZ, cubes.maxX, cubes.maxY, cubes.maxZ}, count, [&](const Simd::Float4 *values)
+		{
+			auto distance = Simd::Splat(std::numeric_limits<float>::max());
+
+			for (uint32_t i = 0; i < 6; i++)
+			{
+				// The distance of the corner furthest along the plane normal, a box is outside when this corner is behind any plane.
+				auto x = Simd::Max(Simd::Multiply(planes.x[i], values[0]), Simd::Multiply(planes.x[i], values[3]));
+				auto y = Simd::Max(Simd::Multiply(planes.y[i], values[1]), Simd::Multiply(planes.y[i], values[4]));
+				auto z = Simd::Max(Simd::Multiply(planes.z[i], values[2]), Simd::Multiply(planes.z[i], values[5]));
+				distance = Simd::Min(distance, Simd::Add(Simd::Add(Simd::Add(x, y), z), planes.w[i]));
+			}
+
+			return Simd::MoveMask(Simd::Greater(distance, zero));
+		}, function);
+	}
+
+	template<typename F>
+	static void ForEachSpheres(const Frustum &frustum, const Culling::Spheres &spheres, const std::size_t &count, const float &radiusScale, F function)
+	{
+		PackedPlanes planes(frustum);
+		auto scale = Simd::Splat(-radiusScale);
+
+		ForEachGroup<4>({spheres.x, spheres.y, spheres.z, spheres.radius}, count, [&](const Simd::Float4 *values)
+		{
+			auto distance = Simd::Splat(std::numeric_limits<float>::max());
+
+			for (uint32_t i = 0; i < 6; i++)
+			{
+				auto plane = Simd::Add(Simd::Add(Simd::Add(Simd::Multiply(planes.x[i], values[0]), Simd::Multiply(planes.y[i], values[1])),
+					Simd::Multiply(planes.z[i], values[2])), planes.w[i]);
+				distance = Simd::Min(distance, plane);
+			}
+
+			return Simd::MoveMask(Simd::Greater(distance, Simd::Multiply(values[3], scale)));
+		}, function);
+	}
+
+	std::size_t Culling::CubesInFrustum(const Frustum &frustum, const Cubes &cubes, const std::size_t &count, uint64_t *visible)
+	{
+		std::fill(visible, visible + GetBitsetSize(count), 0);
+		std::size_t result = 0;
+
+		ForEachCubes(frustum, cubes, count, [&](const std::size_t &index, const uint32_t &mask)
+		{
+			visible[index / 64] |= static_cast<uint64_t>(mask) << (index % 64);
+			result += MASK_COUNTS[mask];
+		});
+
+		return result;
+	}
+
+	void Culling::CubesInFrustum(const Frustum &frustum, const Cubes &cubes, const std::size_t &count, std::vector<uint32_t> &visible)
+	{
+		ForEachCubes(frustum, cubes, count, [&](const std::size_t &index, const uint32_t &mask)
+		{
+			for (uint32_t i = 0; i < 4; i++)
+			{
+				if (mask & (1u << i))
+				{
+					visible.emplace_back(static_cast<uint32_t>(index + i));
+				}
+			}
+		});
+	}
+
+	std::size_t Culling::SpheresInFrustum(const Frustum &frustum, const Spheres &spheres, const std::size_t &count, uint64_t *visible, const float &radiusScale)
+	{
+		std::fill(visible, visible + GetBitsetSize(count), 0);
+		std::size_t result = 0;
+
+		ForEachSpheres(frustum, spheres, count, radiusScale, [&](const std::size_t &index, const uint32_t &mask)
+		{
+			visible[index / 64] |= static_cast<uint64_t>(mask) << (index % 64);
+			result += MASK_COUNTS[mask];
+		});
+
+		return result;
+	}
+
+	void Culling::SpheresInFrustum(const Frustum &frustum, const Spheres &spheres, const std::size_t &count, std::vector<uint32_t> &visible, const float &radiusScale)
+	{
+		ForEachSpheres(frustum, spheres, count, radiusScale, [&](const std::size_t &index, const uint32_t &mask)
+		{
+			for (uint32_t i = 0; i < 4; i++)
+			{
+				if (mask & (1u << i))
+				{
+					visible.emplace_back(static_cast<uint32_t>(index + i));
+				}
+			}
+		});
+	}
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Engine/Exports.hpp"
+
+namespace acid
+{
+	class Frustum;
+
+	/// <summary>
+	/// Tests arrays of bounds against the six planes of a <seealso cref="Frustum"/>, four bounds at a time with SIMD.
+	/// Bounds are given as one array for each component, and the results are either a bitset with a bit for each bound or a list of the visible indices.
+	/// A range of a larger array is culled by offsetting every pointer, when the range starts at a multiple of 64 the bitset is offset by the start over 64,
+	/// so ranges culled on different threads write different words.
+	/// </summary>
+	class ACID_EXPORT Culling
+	{
+	public:
+		/// <summary>
+		/// Axis aligned boxes, stored as one array for each component.
+		/// </summary>
+		struct Cubes
+		{
+			const float *minX;
+			const float *minY;
+			const float *minZ;
+			const float *maxX;
+			const float *maxY;
+			const float *maxZ;
+		};
+
+		/// <summary>
+		/// Spheres, stored as one array for each component.
+		/// </summary>
+		struct Spheres
+		{
+			const float *x;
+			const float *y;
+			const float *z;
+			const float *radius;
+		};
+
+		/// <summary>
+		/// Tests boxes against a frustum, a box is visible under the same rule as <seealso cref="Frustum#CubeInFrustum"/>.
+		/// </summary>
+		/// <param name="frustum"> The frustum to test against. </param>
+		/// <param name="cubes"> The boxes. </param>
+		/// <param name="count"> The number of boxes. </param>
+		/// <param name="visible"> The bitset written with a bit for each box, it must hold <seealso cref="GetBitsetSize"/> words. </param>
+		/// <returns> The number of visible boxes. </returns>
+		static std::size_t CubesInFrustum(const Frustum &frustum, const Cubes &cubes, const std::size_t &count, uint64_t *visible);
+
+		/// <summary>
+		/// Tests boxes against a frustum, a box is visible under the same rule as <seealso cref="Frustum#CubeInFrustum"/>.
+		/// </summary>
+		/// <param name="frustum"> The frustum to test against. </param>
+		/// <param name="cubes"> The boxes. </param>
+		/// <param name="count"> The number of boxes. </param>
+		/// <param name="visible"> The list the indices of visible boxes are added to, in increasing order. </param>
+		static void CubesInFrustum(const Frustum &frustum, const Cubes &cubes, const std::size_t &count, std::vector<uint32_t> &visible);
+
+		/// <summary>
+		/// Tests spheres against a frustum, a sphere is visible under the same rule as <seealso cref="Frustum#SphereInFrustum"/>.
+		/// </summary>
+		/// <param name="frustum"> The frustum to test against. </param>
+		/// <param name="spheres"> The spheres. </param>
+		/// <param name="count"> The number of spheres. </param>
+		/// <param name="visible"> The bitset written with a bit for each sphere, it must hold <seealso cref="GetBitsetSize"/> words. </param>
+		/// <param name="radiusScale"> How much every radius is scaled by. </param>
+		/// <returns> The number of visible spheres. </returns>
+		static std::size_t SpheresInFrustum(const Frustum &frustum, const Spheres &spheres, const std::size_t &count, uint64_t *visible,
+			const float &radiusScale = 1.0f);
+
+		/// <summary>
+		/// Tests spheres against a frustum, a sphere is visible under the same rule as <seealso cref="Frustum#SphereInFrustum"/>.
+		/// </summary>
+		/// <param name="frustum"> The frustum to test against. </param>
+		/// <param name="spheres"> The spheres. </param>
+		/// <param name="count"> The number of spheres. </param>
+		/// <param name="visible"> The list the indices of visible spheres are added to, in increasing order. </param>
+		/// <param name="radiusScale"> How much every radius is scaled by. </param>
+		static void SpheresInFrustum(const Frustum &frustum, const Spheres &spheres, const std::size_t &count, std::vector<uint32_t> &visible,
+			const float &radiusScale = 1.0f);
+
+		/// <summary>
+		/// Gets the number of 64 bit words a bitset needs to hold a bit for each bound.
+		/// </summary>
+		/// <param name="count"> The number of bounds. </param>
+		/// <returns> The number of words. </returns>
+		static std::size_t GetBitsetSize(const std::size_t &count) { return (count + 63) / 64; }
+	};
+}
@@ -1,6 +1,5 @@
 #include "Matrix4.hpp"
 
-#include <cassert>
 #include <cstring>
 #include "Matrix2.hpp"
 #include "Matrix3.hpp"
@@ -13,15 +12,6 @@ namespace acid
 	const Matrix4 Matrix4::Identity = Matrix4(1.0f);
 	const Matrix4 Matrix4::Zero = Matrix4(0.0f);
 
-	Matrix4::Matrix4(const float &diagonal)
-	{
-		memset(m_rows, 0, 4 * sizeof(Vector4));
-		m_rows[0][0] = diagonal;
-		m_rows[1][1] = diagonal;
-		m_rows[2][2] = diagonal;
-		m_rows[3][3] = diagonal;
-	}
-
 	Matrix4::Matrix4(const Matrix2 &source)
 	{
 		memset(m_rows, 0, 4 * sizeof(Vector4));
@@ -47,63 +37,6 @@ namespace acid
 		memcpy(m_rows, source, 4 * sizeof(Vector4));
 	}
 
-	Matrix4 Matrix4::Add(const Matrix4 &other) const
-	{
-		Matrix4 result = Matrix4();
-
-		for (int32_t row = 0; row < 4; row++)
-		{
-			for (int32_t col = 0; col < 4; col++)
-			{
-				result[row][col] = m_rows[row][col] + other[row][col];
-			}
-		}
-
-		return result;
-	}
-
-	Matrix4 Matrix4::Subtract(const Matrix4 &other) const
-	{
-		Matrix4 result = Matrix4();
-
-		for (int32_t row = 0; row < 4; row++)
-		{
-			for (int32_t col = 0; col < 4; col++)
-			{
-				result[row][col] = m_rows[row][col] - other[row][col];
-			}
-		}
-
-		return result;
-	}
-
-	Matrix4 Matrix4::Multiply(const Matrix4 &other) const
-	{
-		Matrix4 result = Matrix4();
-
-		for (int32_t row = 0; row < 4; row++)
-		{
-			for (int32_t col = 0; col < 4; col++)
-			{
-				result[row][col] = m_rows[0][col] * other[row][0] + m_rows[1][col] * other[row][1] + m_rows[2][col] * other[row][2] + m_rows[3][col] * other[row][3];
-			}
-		}
-
-		return result;
-	}
-
-	Vector4 Matrix4::Multiply(const Vector4 &other) const
-	{
-		Vector4 result = Vector4();
-
-		for (int32_t row = 0; row < 4; row++)
-		{
-			result[row] = m_rows[0][row] * other.m_x + m_rows[1][row] * other.m_y + m_rows[2][row] * other.m_z + m_rows[3][row] * other.m_w;
-		}
-
-		return result;
-	}
-
 	Matrix4 Matrix4::Divide(const Matrix4 &other) const
 	{
 		Matrix4 result = Matrix4();
@@ -119,18 +52,6 @@ namespace acid
 		return result;
 	}
 
-	Vector4 Matrix4::Transform(const Vector4 &other) const
-	{
-		Vector4 result = Vector4();
-
-		for (int32_t row = 0; row < 4; row++)
-		{
-			result[row] = m_rows[0][row] * other.m_x + m_rows[1][row] * other.m_y + m_rows[2][row] * other.m_z + m_rows[3][row] * other.m_w;
-		}
-
-		return result;
-	}
-
 	Matrix4 Matrix4::Translate(const Vector2 &other) const
 	{
 		Matrix4 result = Matrix4(*this);
@@ -143,48 +64,6 @@ namespace acid
 		return result;
 	}
 
-	Matrix4 Matrix4::Translate(const Vector3 &other) const
-	{
-		Matrix4 result = Matrix4(*this);
-
-		for (int32_t col = 0; col < 4; col++)
-		{
-			result[3][col] += m_rows[0][col] * other.m_x + m_rows[1][col] * other.m_y + m_rows[2][col] * other.m_z;
-		}
-
-		return result;
-	}
-
-	Matrix4 Matrix4::Scale(const Vector3 &other) const
-	{
-		Matrix4 result = Matrix4(*this);
-
-		for (int32_t row = 0; row < 3; row++)
-		{
-			for (int32_t col = 0; col < 4; col++)
-			{
-				result[row][col] *= other[row];
-			}
-		}
-
-		return result;
-	}
-
-	Matrix4 Matrix4::Scale(const Vector4 &other) const
-	{
-		Matrix4 result = Matrix4(*this);
-
-		for (int32_t row = 0; row < 4; row++)
-		{
-			for (int32_t col = 0; col < 4; col++)
-			{
-				result[row][col] *= other[row];
-			}
-		}
-
-		return result;
-	}
-
 	Matrix4 Matrix4::Rotate(const float &angle, const Vector3 &axis) const
 	{
 		Matrix4 result = Matrix4(*this);
@@ -221,81 +100,6 @@ namespace acid
 		return result;
 	}
 
-	Matrix4 Matrix4::Negate() const
-	{
-		Matrix4 result = Matrix4();
-
-		for (int32_t row = 0; row < 4; row++)
-		{
-			for (int32_t col = 0; col < 4; col++)
-			{
-				result[row][col] = -m_rows[row][col];
-			}
-		}
-
-		return result;
-	}
-
-	Matrix4 Matrix4::Invert() const
-	{
-		Matrix4 result = Matrix4(*this);
-
-		float det = Determinant();
-		assert(det != 0.0f && "Determinant cannot be zero!");
-
-		for (int32_t j = 0; j < 4; j++)
-		{
-			for (int32_t i = 0; i < 4; i++)
-			{
-				// Get minor of element [j][i] - not [i][j], this is where the transpose happens.
-				Matrix3 minorSubmatrix = GetSubmatrix(j, i);
-				float minor = minorSubmatrix.Determinant();
-
-				// Multiply by (−1)^{i+j}.
-				float factor = ((i + j) % 2 == 1) ? -1.0f : 1.0f;
-				float cofactor = minor * factor;
-
-				result[i][j] = cofactor / det;
-			}
-		}
-
-		return result;
-	}
-
-	Matrix4 Matrix4::Transpose() const
-	{
-		Matrix4 result = Matrix4();
-
-		for (int32_t row = 0; row < 4; row++)
-		{
-			for (int32_t col = 0; col < 4; col++)
-			{
-				result[row][col] = m_rows[col][row];
-			}
-		}
-
-		return result;
-	}
-
-	float Matrix4::Determinant() const
-	{
-		float result = 0.0f;
-
-		for (int32_t i = 0; i < 4; i++)
-		{
-			// Get minor of element [0][i].
-			Matrix3 minorSubmatrix = GetSubmatrix(0, i);
-			float minor = minorSubmatrix.Determinant();
-
-			// If this is an odd-numbered row, negate the value.
-			float factor = (i % 2 == 1) ? -1.0f : 1.0f;
-
-			result += factor * m_rows[0][i] * minor;
-		}
-
-		return result;
-	}
-
 	Matrix3 Matrix4::GetSubmatrix(const int32_t &row, const int32_t &col) const
 	{
 		Matrix3 result = Matrix3();
@@ -475,62 +279,75 @@ namespace acid
 		return result;
 	}
 
-	void Matrix4::Decode(const Metadata &metadata)
+	void Matrix4::TransformArray(const Matrix4 &matrix, const Vector4 *source, Vector4 *destination, const std::size_t &count)
 	{
-		metadata.GetChild("m0", m_rows[0]);
-		metadata.GetChild("m1", m_rows[1]);
-		metadata.GetChild("m2", m_rows[2]);
-		metadata.GetChild("m3", m_rows[3]);
-	}
+		std::size_t i = 0;
+#if defined(ACID_SIMD_AVX)
+		// Two vectors at once, each half of the 256 bit registers holds one vector.
+		auto wideRow0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(matrix[0].m_elements));
+		auto wideRow1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(matrix[1].m_elements));
+		auto wideRow2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(matrix[2].m_elements));
+		auto wideRow3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(matrix[3].m_elements));
 
-	void Matrix4::Encode(Metadata &metadata) const
-	{
-		metadata.SetChild("m0", m_rows[0]);
-		metadata.SetChild("m1", m_rows[1]);
-		metadata.SetChild("m2", m_rows[2]);
-		metadata.SetChild("m3", m_rows[3]);
-	}
-
-	bool Matrix4::operator==(const Matrix4 &other) const
-	{
-		return m_rows[0] == other[0] && m_rows[1] == other[1] && m_rows[2] == other[2] && m_rows[3] == other[3];
-	}
-
-	bool Matrix4::operator!=(const Matrix4 &other) const
-	{
-		return !(*this == other);
-	}
+		for (; i + 2 <= count; i += 2)
+		{
+			auto weights = _mm256_loadu_ps(source[i].m_elements);
+			auto value = _mm256_mul_ps(_mm256_permute_ps(weights, 0x00), wideRow0);
+			value = _mm256_add_ps(value, _mm256_mul_ps(_mm256_permute_ps(weights, 0x55), wideRow1));
+			value = _mm256_add_ps(value, _mm256_mul_ps(_mm256_permute_ps(weights, 0xAA), wideRow2));
+			value = _mm256_add_ps(value, _mm256_mul_ps(_mm256_permute_ps(weights, 0xFF), wideRow3));
+			_mm256_storeu_ps(destination[i].m_elements, value);
+		}
+#endif
+		auto row0 = matrix[0].GetFloat4();
+		auto row1 = matrix[1].GetFloat4();
+		auto row2 = matrix[2].GetFloat4();
+		auto row3 = matrix[3].GetFloat4();
 
-	Matrix4 Matrix4::operator-() const
-	{
-		return Negate();
+		for (; i < count; i++)
+		{
+			auto weights = source[i].GetFloat4();
+			auto value = Simd::Multiply(Simd::Broadcast<0>(weights), row0);
+			value = Simd::MultiplyAdd(Simd::Broadcast<1>(weights), row1, value);
+			value = Simd::MultiplyAdd(Simd::Broadcast<2>(weights), row2, value);
+			value = Simd::MultiplyAdd(Simd::Broadcast<3>(weights), row3, value);
+			destination[i] = Vector4(value);
+		}
 	}
 
-	const Vector4 &Matrix4::operator[](const uint32_t &index) const
+	void Matrix4::MultiplyArray(const Matrix4 &left, const Matrix4 *right, Matrix4 *destination, const std::size_t &count)
 	{
-		assert(index < 4);
-		return m_rows[index];
-	}
+		if (count == 0)
+		{
+			return;
+		}
 
-	Vector4 &Matrix4::operator[](const uint32_t &index)
-	{
-		assert(index < 4);
-		return m_rows[index];
+		// Each row of a result is the rows of the left matrix weighted by a row of the right matrix, so the rows of every right matrix are transformed as one array.
+		TransformArray(left, right[0].m_rows, destination[0].m_rows, 4 * count);
 	}
 
-	Matrix4 operator+(const Matrix4 &left, const Matrix4 &right)
+	void Matrix4::MultiplyArray(const Matrix4 *left, const Matrix4 *right, Matrix4 *destination, const std::size_t &count)
 	{
-		return left.Add(right);
+		for (std::size_t i = 0; i < count; i++)
+		{
+			destination[i] = left[i].Multiply(right[i]);
+		}
 	}
 
-	Matrix4 operator-(const Matrix4 &left, const Matrix4 &right)
+	void Matrix4::Decode(const Metadata &metadata)
 	{
-		return left.Subtract(right);
+		metadata.GetChild("m0", m_rows[0]);
+		metadata.GetChild("m1", m_rows[1]);
+		metadata.GetChild("m2", m_rows[2]);
+		metadata.GetChild("m3", m_rows[3]);
 	}
 
-	Matrix4 operator*(const Matrix4 &left, const Matrix4 &right)
+	void Matrix4::Encode(Metadata &metadata) const
 	{
-		return left.Multiply(right);
+		metadata.SetChild("m0", m_rows[0]);
+		metadata.SetChild("m1", m_rows[1]);
+		metadata.SetChild("m2", m_rows[2]);
+		metadata.SetChild("m3", m_rows[3]);
 	}
 
 	Matrix4 operator/(const Matrix4 &left, const Matrix4 &right)
@@ -538,86 +355,11 @@ namespace acid
 		return left.Divide(right);
 	}
 
-	Matrix4 operator*(const Vector4 &left, const Matrix4 &right)
-	{
-		return right.Scale(left);
-	}
-
-	Matrix4 operator/(const Vector4 &left, const Matrix4 &right)
-	{
-		return right.Scale(1.0f / left);
-	}
-
-	Matrix4 operator*(const Matrix4 &left, const Vector4 &right)
-	{
-		return left.Scale(right);
-	}
-
-	Matrix4 operator/(const Matrix4 &left, const Vector4 &right)
-	{
-		return left.Scale(1.0f / right);
-	}
-
-	Matrix4 operator*(const float &left, const Matrix4 &right)
-	{
-		return right.Scale(Vector4(left, left, left, left));
-	}
-
-	Matrix4 operator/(const float &left, const Matrix4 &right)
-	{
-		return right.Scale(1.0f / Vector4(left, left, left, left));
-	}
-
-	Matrix4 operator*(const Matrix4 &left, const float &right)
-	{
-		return left.Scale(Vector4(right, right, right, right));
-	}
-
-	Matrix4 operator/(const Matrix4 &left, const float &right)
-	{
-		return left.Scale(1.0f / Vector4(right, right, right, right));
-	}
-
-	Matrix4 &Matrix4::operator+=(const Matrix4 &other)
-	{
-		return *this = Add(other);
-	}
-
-	Matrix4 &Matrix4::operator-=(const Matrix4 &other)
-	{
-		return *this = Subtract(other);
-	}
-
-	Matrix4 &Matrix4::operator*=(const Matrix4 &other)
-	{
-		return *this = Multiply(other);
-	}
-
 	Matrix4 &Matrix4::operator/=(const Matrix4 &other)
 	{
 		return *this = Divide(other);
 	}
 
-	Matrix4 &Matrix4::operator*=(const Vector4 &other)
-	{
-		return *this = Scale(other);
-	}
-
-	Matrix4 &Matrix4::operator/=(const Vector4 &other)
-	{
-		return *this = Scale(1.0f / other);
-	}
-
-	Matrix4 &Matrix4::operator*=(const float &other)
-	{
-		return *this = Scale(Vector4(other, other, other, other));
-	}
-
-	Matrix4 &Matrix4::operator/=(const float &other)
-	{
-		return *this = Scale(1.0f / Vector4(other, other, other, other));
-	}
-
 	std::ostream &operator<<(std::ostream &stream, const Matrix4 &matrix)
 	{
 		stream << matrix.ToString();
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <cassert>
 #include <ostream>
 #include <string>
 #include "Serialized/Metadata.hpp"
+#include "Simd.hpp"
 #include "Vector3.hpp"
 #include "Vector4.hpp"
 
@@ -14,7 +16,7 @@ namespace acid
 	class Vector2;
 
 	/// <summary>
-	/// Holds a row major 4x4 matrix.
+	/// Holds a row major 4x4 matrix, each row is aligned for SIMD loads.
 	/// </summary>
 	class ACID_EXPORT Matrix4
 	{
@@ -23,7 +25,10 @@ namespace acid
 		/// Constructor for Matrix4. The matrix is initialised to the identity.
 		/// </summary>
 		/// <param name="diagonal"> The value set to the diagonals. </param>
-		Matrix4(const float &diagonal = 1.0f);
+		constexpr Matrix4(const float &diagonal = 1.0f) :
+			m_rows{Vector4(diagonal, 0.0f, 0.0f, 0.0f), Vector4(0.0f, diagonal, 0.0f, 0.0f), Vector4(0.0f, 0.0f, diagonal, 0.0f), Vector4(0.0f, 0.0f, 0.0f, diagonal)}
+		{
+		}
 
 		/// <summary>
 		/// Constructor for Matrix4.
@@ -232,6 +237,33 @@ namespace acid
 		/// <returns> Returns the transformation matrix. </returns>
 		static Matrix4 LookAt(const Vector3 &camera, const Vector3 &object, const Vector3 &up = Vector3::Up);
 
+		/// <summary>
+		/// Transforms a array of vectors by one matrix, the rows of the matrix are loaded once for the whole array.
+		/// </summary>
+		/// <param name="matrix"> The matrix, like in <seealso cref="Transform"/>. </param>
+		/// <param name="source"> The vectors to transform. </param>
+		/// <param name="destination"> The transformed vectors, this may be the same array as the source. </param>
+		/// <param name="count"> The number of vectors. </param>
+		static void TransformArray(const Matrix4 &matrix, const Vector4 *source, Vector4 *destination, const std::size_t &count);
+
+		/// <summary>
+		/// Multiplies one matrix with a array of matrices, such as a view projection with the model of each instance.
+		/// </summary>
+		/// <param name="left"> The matrix on the left of every multiply. </param>
+		/// <param name="right"> The matrices on the right. </param>
+		/// <param name="destination"> The multiplied matrices, this may be the same array as the right matrices. </param>
+		/// <param name="count"> The number of matrices. </param>
+		static void MultiplyArray(const Matrix4 &left, const Matrix4 *right, Matrix4 *destination, const std::size_t &count);
+
+		/// <summary>
+		/// Multiplies two arrays of matrices element by element, such as joint transforms with their inverse bind matrices.
+		/// </summary>
+		/// <param name="left"> The matrices on the left. </param>
+		/// <param name="right"> The matrices on the right. </param>
+		/// <param name="destination"> The multiplied matrices, this may be the same array as either input. </param>
+		/// <param name="count"> The number of matrices. </param>
+		static void MultiplyArray(const Matrix4 *left, const Matrix4 *right, Matrix4 *destination, const std::size_t &count);
+
 		void Decode(const Metadata &metadata);
 
 		void Encode(Metadata &metadata) const;
@@ -246,29 +278,29 @@ namespace acid
 
 		Vector4 &operator[](const uint32_t &index);
 
-		ACID_EXPORT friend Matrix4 operator+(const Matrix4 &left, const Matrix4 &right);
+		friend Matrix4 operator+(const Matrix4 &left, const Matrix4 &right);
 
-		ACID_EXPORT friend Matrix4 operator-(const Matrix4 &left, const Matrix4 &right);
+		friend Matrix4 operator-(const Matrix4 &left, const Matrix4 &right);
 
-		ACID_EXPORT friend Matrix4 operator*(const Matrix4 &left, const Matrix4 &right);
+		friend Matrix4 operator*(const Matrix4 &left, const Matrix4 &right);
 
 		ACID_EXPORT friend Matrix4 operator/(const Matrix4 &left, const Matrix4 &right);
 
-		ACID_EXPORT friend Matrix4 operator*(const Vector4 &left, const Matrix4 &right);
+		friend Matrix4 operator*(const Vector4 &left, const Matrix4 &right);
 
-		ACID_EXPORT friend Matrix4 operator/(const Vector4 &left, const Matrix4 &right);
+		friend Matrix4 operator/(const Vector4 &left, const Matrix4 &right);
 
-		ACID_EXPORT friend Matrix4 operator*(const Matrix4 &left, const Vector4 &right);
+		friend Matrix4 operator*(const Matrix4 &left, const Vector4 &right);
 
-		ACID_EXPORT friend Matrix4 operator/(const Matrix4 &left, const Vector4 &right);
+		friend Matrix4 operator/(const Matrix4 &left, const Vector4 &right);
 
-		ACID_EXPORT friend Matrix4 operator*(const float &left, const Matrix4 &right);
+		friend Matrix4 operator*(const float &left, const Matrix4 &right);
 
-		ACID_EXPORT friend Matrix4 operator/(const float &left, const Matrix4 &right);
+		friend Matrix4 operator/(const float &left, const Matrix4 &right);
 
-		ACID_EXPORT friend Matrix4 operator*(const Matrix4 &left, const float &right);
+		friend Matrix4 operator*(const Matrix4 &left, const float &right);
 
-		ACID_EXPORT friend Matrix4 operator/(const Matrix4 &left, const float &right);
+		friend Matrix4 operator/(const Matrix4 &left, const float &right);
 
 		Matrix4 &operator+=(const Matrix4 &other);
 
@@ -305,5 +337,359 @@ namespace acid
 				float m_linear[16];
 			};
 		};
+	private:
+		/// <summary>
+		/// Multiplies two 2x2 matrices stored as the rows of packed floats.
+		/// </summary>
+		/// <returns> a * b. </returns>
+		static Simd::Float4 Multiply2x2(const Simd::Float4 &a, const Simd::Float4 &b);
+
+		/// <summary>
+		/// Multiplies the adjugate of a 2x2 matrix by another.
+		/// </summary>
+		/// <returns> The adjugate of a * b. </returns>
+		static Simd::Float4 AdjointMultiply2x2(const Simd::Float4 &a, const Simd::Float4 &b);
+
+		/// <summary>
+		/// Multiplies a 2x2 matrix by the adjugate of another.
+		/// </summary>
+		/// <returns> a * the adjugate of b. </returns>
+		static Simd::Float4 MultiplyAdjoint2x2(const Simd::Float4 &a, const Simd::Float4 &b);
 	};
+
+	inline Matrix4 Matrix4::Add(const Matrix4 &other) const
+	{
+		Matrix4 result;
+
+		for (int32_t row = 0; row < 4; row++)
+		{
+			result[row] = Vector4(Simd::Add(m_rows[row].GetFloat4(), other[row].GetFloat4()));
+		}
+
+		return result;
+	}
+
+	inline Matrix4 Matrix4::Subtract(const Matrix4 &other) const
+	{
+		Matrix4 result;
+
+		for (int32_t row = 0; row < 4; row++)
+		{
+			result[row] = Vector4(Simd::Subtract(m_rows[row].GetFloat4(), other[row].GetFloat4()));
+		}
+
+		return result;
+	}
+
+	inline Matrix4 Matrix4::Multiply(const Matrix4 &other) const
+	{
+		Matrix4 result;
+
+		// Each row of the result is the rows of this matrix weighted by a row of the other matrix.
+#if defined(ACID_SIMD_AVX)
+		// Two rows of the result at once, each half of the 256 bit registers holds one row.
+		auto row0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(m_rows[0].m_elements));
+		auto row1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(m_rows[1].m_elements));
+		auto row2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(m_rows[2].m_elements));
+		auto row3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(m_rows[3].m_elements));
+
+		for (int32_t row = 0; row < 4; row += 2)
+		{
+			auto weights = _mm256_loadu_ps(other[row].m_elements);
+			auto value = _mm256_mul_ps(_mm256_permute_ps(weights, 0x00), row0);
+			value = _mm256_add_ps(value, _mm256_mul_ps(_mm256_permute_ps(weights, 0x55), row1));
+			value = _mm256_add_ps(value, _mm256_mul_ps(_mm256_permute_ps(weights, 0xAA), row2));
+			value = _mm256_add_ps(value, _mm256_mul_ps(_mm256_permute_ps(weights, 0xFF), row3));
+			_mm256_storeu_ps(result[row].m_elements, value);
+		}
+#else
+		auto row0 = m_rows[0].GetFloat4();
+		auto row1 = m_rows[1].GetFloat4();
+		auto row2 = m_rows[2].GetFloat4();
+		auto row3 = m_rows[3].GetFloat4();
+
+		for (int32_t row = 0; row < 4; row++)
+		{
+			auto weights = other[row].GetFloat4();
+			auto value = Simd::Multiply(Simd::Broadcast<0>(weights), row0);
+			value = Simd::MultiplyAdd(Simd::Broadcast<1>(weights), row1, value);
+			value = Simd::MultiplyAdd(Simd::Broadcast<2>(weights), row2, value);
+			value = Simd::MultiplyAdd(Simd::Broadcast<3>(weights), row3, value);
+			result[row] = Vector4(value);
+		}
+#endif
+
+		return result;
+	}
+
+	inline Vector4 Matrix4::Multiply(const Vector4 &other) const
+	{
+		return Transform(other);
+	}
+
+	inline Vector4 Matrix4::Transform(const Vector4 &other) const
+	{
+		auto weights = other.GetFloat4();
+		auto value = Simd::Multiply(Simd::Broadcast<0>(weights), m_rows[0].GetFloat4());
+		value = Simd::MultiplyAdd(Simd::Broadcast<1>(weights), m_rows[1].GetFloat4(), value);
+		value = Simd::MultiplyAdd(Simd::Broadcast<2>(weights), m_rows[2].GetFloat4(), value);
+		value = Simd::MultiplyAdd(Simd::Broadcast<3>(weights), m_rows[3].GetFloat4(), value);
+		return Vector4(value);
+	}
+
+	inline Matrix4 Matrix4::Translate(const Vector3 &other) const
+	{
+		Matrix4 result = *this;
+		auto value = Simd::MultiplyAdd(Simd::Splat(other.m_x), m_rows[0].GetFloat4(), m_rows[3].GetFloat4());
+		value = Simd::MultiplyAdd(Simd::Splat(other.m_y), m_rows[1].GetFloat4(), value);
+		value = Simd::MultiplyAdd(Simd::Splat(other.m_z), m_rows[2].GetFloat4(), value);
+		result[3] = Vector4(value);
+		return result;
+	}
+
+	inline Matrix4 Matrix4::Scale(const Vector3 &other) const
+	{
+		Matrix4 result = *this;
+
+		for (int32_t row = 0; row < 3; row++)
+		{
+			result[row] = m_rows[row].Scale(other[row]);
+		}
+
+		return result;
+	}
+
+	inline Matrix4 Matrix4::Scale(const Vector4 &other) const
+	{
+		Matrix4 result;
+
+		for (int32_t row = 0; row < 4; row++)
+		{
+			result[row] = m_rows[row].Scale(other[row]);
+		}
+
+		return result;
+	}
+
+	inline Matrix4 Matrix4::Negate() const
+	{
+		Matrix4 result;
+
+		for (int32_t row = 0; row < 4; row++)
+		{
+			result[row] = m_rows[row].Negate();
+		}
+
+		return result;
+	}
+
+	inline Matrix4 Matrix4::Invert() const
+	{
+		// Inverts the four 2x2 blocks of the matrix, from Eric Zhang's block inverse.
+		// Where the matrix is | A B |, a 2x2 block is stored in one register as its rows.
+		//                     | C D |
+		auto row0 = m_rows[0].GetFloat4();
+		auto row1 = m_rows[1].GetFloat4();
+		auto row2 = m_rows[2].GetFloat4();
+		auto row3 = m_rows[3].GetFloat4();
+		auto a = Simd::Shuffle<0, 1, 0, 1>(row0, row1);
+		auto b = Simd::Shuffle<2, 3, 2, 3>(row0, row1);
+		auto c = Simd::Shuffle<0, 1, 0, 1>(row2, row3);
+		auto d = Simd::Shuffle<2, 3, 2, 3>(row2, row3);
+
+		// The determinants of A, B, C and D.
+		auto determinants = Simd::Subtract(Simd::Multiply(Simd::Shuffle<0, 2, 0, 2>(row0, row2), Simd::Shuffle<1, 3, 1, 3>(row1, row3)),
+			Simd::Multiply(Simd::Shuffle<1, 3, 1, 3>(row0, row2), Simd::Shuffle<0, 2, 0, 2>(row1, row3)));
+		auto determinantA = Simd::Broadcast<0>(determinants);
+		auto determinantB = Simd::Broadcast<1>(determinants);
+		auto determinantC = Simd::Broadcast<2>(determinants);
+		auto determinantD = Simd::Broadcast<3>(determinants);
+
+		auto adjointDC = AdjointMultiply2x2(d, c);
+		auto adjointAB = AdjointMultiply2x2(a, b);
+		auto x = Simd::Subtract(Simd::Multiply(determinantD, a), Multiply2x2(b, adjointDC));
+		auto w = Simd::Subtract(Simd::Multiply(determinantA, d), Multiply2x2(c, adjointAB));
+		auto y = Simd::Subtract(Simd::Multiply(determinantB, c), MultiplyAdjoint2x2(d, adjointAB));
+		auto z = Simd::Subtract(Simd::Multiply(determinantC, b), MultiplyAdjoint2x2(a, adjointDC));
+
+		float det = Simd::Get<0>(determinants) * Simd::Get<3>(determinants) + Simd::Get<1>(determinants) * Simd::Get<2>(determinants) -
+			Simd::Dot(adjointAB, Simd::Swizzle<0, 2, 1, 3>(adjointDC));
+		assert(det != 0.0f && "Determinant cannot be zero!");
+
+		// The adjugate of each block flips the signs of its off diagonal.
+		auto scale = Simd::Divide(Simd::Set(1.0f, -1.0f, -1.0f, 1.0f), Simd::Splat(det));
+		x = Simd::Multiply(x, scale);
+		y = Simd::Multiply(y, scale);
+		z = Simd::Multiply(z, scale);
+		w = Simd::Multiply(w, scale);
+
+		Matrix4 result;
+		result[0] = Vector4(Simd::Shuffle<3, 1, 3, 1>(x, y));
+		result[1] = Vector4(Simd::Shuffle<2, 0, 2, 0>(x, y));
+		result[2] = Vector4(Simd::Shuffle<3, 1, 3, 1>(z, w));
+		result[3] = Vector4(Simd::Shuffle<2, 0, 2, 0>(z, w));
+		return result;
+	}
+
+	inline Matrix4 Matrix4::Transpose() const
+	{
+		auto low01 = Simd::Shuffle<0, 1, 0, 1>(m_rows[0].GetFloat4(), m_rows[1].GetFloat4());
+		auto high01 = Simd::Shuffle<2, 3, 2, 3>(m_rows[0].GetFloat4(), m_rows[1].GetFloat4());
+		auto low23 = Simd::Shuffle<0, 1, 0, 1>(m_rows[2].GetFloat4(), m_rows[3].GetFloat4());
+		auto high23 = Simd::Shuffle<2, 3, 2, 3>(m_rows[2].GetFloat4(), m_rows[3].GetFloat4());
+
+		Matrix4 result;
+		result[0] = Vector4(Simd::Shuffle<0, 2, 0, 2>(low01, low23));
+		result[1] = Vector4(Simd::Shuffle<1, 3, 1, 3>(low01, low23));
+		result[2] = Vector4(Simd::Shuffle<0, 2, 0, 2>(high01, high23));
+		result[3] = Vector4(Simd::Shuffle<1, 3, 1, 3>(high01, high23));
+		return result;
+	}
+
+	inline float Matrix4::Determinant() const
+	{
+		// The block determinant used by Invert, |M| = |A||D| + |B||C| - tr((A#B)(D#C)).
+		auto row0 = m_rows[0].GetFloat4();
+		auto row1 = m_rows[1].GetFloat4();
+		auto row2 = m_rows[2].GetFloat4();
+		auto row3 = m_rows[3].GetFloat4();
+		auto determinants = Simd::Subtract(Simd::Multiply(Simd::Shuffle<0, 2, 0, 2>(row0, row2), Simd::Shuffle<1, 3, 1, 3>(row1, row3)),
+			Simd::Multiply(Simd::Shuffle<1, 3, 1, 3>(row0, row2), Simd::Shuffle<0, 2, 0, 2>(row1, row3)));
+		auto adjointDC = AdjointMultiply2x2(Simd::Shuffle<2, 3, 2, 3>(row2, row3), Simd::Shuffle<0, 1, 0, 1>(row2, row3));
+		auto adjointAB = AdjointMultiply2x2(Simd::Shuffle<0, 1, 0, 1>(row0, row1), Simd::Shuffle<2, 3, 2, 3>(row0, row1));
+		return Simd::Get<0>(determinants) * Simd::Get<3>(determinants) + Simd::Get<1>(determinants) * Simd::Get<2>(determinants) -
+			Simd::Dot(adjointAB, Simd::Swizzle<0, 2, 1, 3>(adjointDC));
+	}
+
+	inline bool Matrix4::operator==(const Matrix4 &other) const
+	{
+		return m_rows[0] == other[0] && m_rows[1] == other[1] && m_rows[2] == other[2] && m_rows[3] == other[3];
+	}
+
+	inline bool Matrix4::operator!=(const Matrix4 &other) const
+	{
+		return !(*this == other);
+	}
+
+	inline Matrix4 Matrix4::operator-() const
+	{
+		return Negate();
+	}
+
+	inline const Vector4 &Matrix4::operator[](const uint32_t &index) const
+	{
+		assert(index < 4);
+		return m_rows[index];
+	}
+
+	inline Vector4 &Matrix4::operator[](const uint32_t &index)
+	{
+		assert(index < 4);
+		return m_rows[index];
+	}
+
+	inline Matrix4 operator+(const Matrix4 &left, const Matrix4 &right)
+	{
+		return left.Add(right);
+	}
+
+	inline Matrix4 operator-(const Matrix4 &left, const Matrix4 &right)
+	{
+		return left.Subtract(right);
+	}
+
+	inline Matrix4 operator*(const Matrix4 &left, const Matrix4 &right)
+	{
+		return left.Multiply(right);
+	}
+
+	inline Matrix4 operator*(const Vector4 &left, const Matrix4 &right)
+	{
+		return right.Scale(left);
+	}
+
+	inline Matrix4 operator/(const Vector4 &left, const Matrix4 &right)
+	{
+		return right.Scale(1.0f / left);
+	}
+
+	inline Matrix4 operator*(const Matrix4 &left, const Vector4 &right)
+	{
+		return left.Scale(right);
+	}
+
+	inline Matrix4 operator/(const Matrix4 &left, const Vector4 &right)
+	{
+		return left.Scale(1.0f / right);
+	}
+
+	inline Matrix4 operator*(const float &left, const Matrix4 &right)
+	{
+		return right.Scale(Vector4(left, left, left, left));
+	}
+
+	inline Matrix4 operator/(const float &left, const Matrix4 &right)
+	{
+		return right.Scale(1.0f / Vector4(left, left, left, left));
+	}
+
+	inline Matrix4 operator*(const Matrix4 &left, const float &right)
+	{
+		return left.Scale(Vector4(right, right, right, right));
+	}
+
+	inline Matrix4 operator/(const Matrix4 &left, const float &right)
+	{
+		return left.Scale(1.0f / Vector4(right, right, right, right));
+	}
+
+	inline Matrix4 &Matrix4::operator+=(const Matrix4 &other)
+	{
+		return *this = Add(other);
+	}
+
+	inline Matrix4 &Matrix4::operator-=(const Matrix4 &other)
+	{
+		return *this = Subtract(other);
+	}
+
+	inline Matrix4 &Matrix4::operator*=(const Matrix4 &other)
+	{
+		return *this = Multiply(other);
+	}
+
+	inline Matrix4 &Matrix4::operator*=(const Vector4 &other)
+	{
+		return *this = Scale(other);
+	}
+
+	inline Matrix4 &Matrix4::operator/=(const Vector4 &other)
+	{
+		return *this = Scale(1.0f / other);
+	}
+
+	inline Matrix4 &Matrix4::operator*=(const float &other)
+	{
+		return *this = Scale(Vector4(other, other, other, other));
+	}
+
+	inline Matrix4 &Matrix4::operator/=(const float &other)
+	{
+		return *this = Scale(1.0f / Vector4(other, other, other, other));
+	}
+
+	inline Simd::Float4 Matrix4::Multiply2x2(const Simd::Float4 &a, const Simd::Float4 &b)
+	{
+		return Simd::MultiplyAdd(a, Simd::Swizzle<0, 3, 0, 3>(b), Simd::Multiply(Simd::Swizzle<1, 0, 3, 2>(a), Simd::Swizzle<2, 1, 2, 1>(b)));
+	}
+
+	inline Simd::Float4 Matrix4::AdjointMultiply2x2(const Simd::Float4 &a, const Simd::Float4 &b)
+	{
+		return Simd::Subtract(Simd::Multiply(Simd::Swizzle<3, 3, 0, 0>(a), b), Simd::Multiply(Simd::Swizzle<1, 1, 2, 2>(a), Simd::Swizzle<2, 3, 0, 1>(b)));
+	}
+
+	inline Simd::Float4 Matrix4::MultiplyAdjoint2x2(const Simd::Float4 &a, const Simd::Float4 &b)
+	{
+		return Simd::Subtract(Simd::Multiply(a, Simd::Swizzle<3, 0, 3, 0>(b)), Simd::Multiply(Simd::Swizzle<1, 0, 3, 2>(a), Simd::Swizzle<2, 1, 2, 1>(b)));
+	}
 }
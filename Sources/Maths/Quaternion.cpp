@@ -1,6 +1,5 @@
 #include "Quaternion.hpp"
 
-#include <cassert>
 #include "Matrix3.hpp"
 #include "Maths.hpp"
 
@@ -12,14 +11,6 @@ namespace acid
 	const Quaternion Quaternion::PositiveInfinity = Quaternion(+std::numeric_limits<float>::infinity(), +std::numeric_limits<float>::infinity(), +std::numeric_limits<float>::infinity(), +std::numeric_limits<float>::infinity());
 	const Quaternion Quaternion::NegativeInfinity = Quaternion(-std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity());
 
-	Quaternion::Quaternion(const float &x, const float &y, const float &z, const float &w) :
-		m_x(x),
-		m_y(y),
-		m_z(z),
-		m_w(w)
-	{
-	}
-
 	Quaternion::Quaternion(const Vector3 &source, const float &w) :
 		m_x(source.m_x),
 		m_y(source.m_y),
@@ -82,32 +73,6 @@ namespace acid
 		*this = rotation;
 	}
 
-	Quaternion Quaternion::Add(const Quaternion &other) const
-	{
-		return Quaternion(m_x + other.m_x, m_y + other.m_y, m_z + other.m_z, m_w + other.m_w);
-	}
-
-	Quaternion Quaternion::Subtract(const Quaternion &other) const
-	{
-		return Quaternion(m_x - other.m_x, m_y - other.m_y, m_z - other.m_z, m_w - other.m_w);
-	}
-
-	Quaternion Quaternion::Multiply(const Quaternion &other) const
-	{
-		return Quaternion(m_x * other.m_w + m_w * other.m_x + m_y * other.m_z - m_z * other.m_y,
-		                  m_y * other.m_w + m_w * other.m_y + m_z * other.m_x - m_x * other.m_z,
-		                  m_z * other.m_w + m_w * other.m_z + m_x * other.m_y - m_y * other.m_x,
-		                  m_w * other.m_w - m_x * other.m_x - m_y * other.m_y - m_z * other.m_z);
-	}
-
-	Vector3 Quaternion::Multiply(const Vector3 &other) const
-	{
-		Vector3 q = Vector3(m_x, m_y, m_z);
-		Vector3 cross1 = q.Cross(other);
-		Vector3 cross2 = q.Cross(cross1);
-		return other + 2.0f * (cross1 * m_w + cross2);
-	}
-
 	Quaternion Quaternion::MultiplyInverse(const Quaternion &other) const
 	{
 		float n = other.LengthSquared();
@@ -119,11 +84,6 @@ namespace acid
 			(m_w * other.m_w + m_x * other.m_x + m_y * other.m_y + m_z * other.m_z) * n);
 	}
 
-	float Quaternion::Dot(const Quaternion &other) const
-	{
-		return m_w * other.m_w + m_x * other.m_x + m_y * other.m_y + m_z * other.m_z;
-	}
-
 	Quaternion Quaternion::Slerp(const Quaternion &other, const float &progression) const
 	{
 		float cosom = m_x * other.m_x + m_y * other.m_y + m_z * other.m_z + m_w * other.m_w;
@@ -153,32 +113,6 @@ namespace acid
 		return result;
 	}
 
-	Quaternion Quaternion::Scale(const float &scalar) const
-	{
-		return Quaternion(m_x * scalar, m_y * scalar, m_z * scalar, m_w * scalar);
-	}
-
-	Quaternion Quaternion::Negate() const
-	{
-		return Quaternion(-m_x, -m_y, -m_z, -m_w);
-	}
-
-	Quaternion Quaternion::Normalize() const
-	{
-		float l = Length();
-		return Quaternion(m_x / l, m_y / l, m_z / l, m_w / l);
-	}
-
-	float Quaternion::LengthSquared() const
-	{
-		return m_x * m_x + m_y * m_y + m_z * m_z + m_w * m_w;
-	}
-
-	float Quaternion::Length() const
-	{
-		return std::sqrt(LengthSquared());
-	}
-
 	float Quaternion::MaxComponent() const
 	{
 		return std::max(m_x, std::max(m_y, std::max(m_z, m_w)));
@@ -272,16 +206,6 @@ namespace acid
 		metadata.SetChild("w", m_w);
 	}
 
-	bool Quaternion::operator==(const Quaternion &other) const
-	{
-		return m_x == other.m_x && m_y == other.m_x && m_z == other.m_z && m_w == other.m_w;
-	}
-
-	bool Quaternion::operator!=(const Quaternion &other) const
-	{
-		return !(*this == other);
-	}
-
 	bool Quaternion::operator<(const Quaternion &other) const
 	{
 		return m_x < other.m_x && m_y < other.m_y && m_z < other.m_z && m_w < other.m_w;
@@ -312,68 +236,6 @@ namespace acid
 		return !(*this == value);
 	}
 
-	Quaternion Quaternion::operator-() const
-	{
-		return Negate();
-	}
-
-	const float &Quaternion::operator[](const uint32_t &index) const
-	{
-		assert(index < 4);
-		return m_elements[index];
-	}
-
-	float &Quaternion::operator[](const uint32_t &index)
-	{
-		assert(index < 4);
-		return m_elements[index];
-	}
-
-	Quaternion operator+(const Quaternion &left, const Quaternion &right)
-	{
-		return left.Add(right);
-	}
-
-	Quaternion operator-(const Quaternion &left, const Quaternion &right)
-	{
-		return left.Subtract(right);
-	}
-
-	Quaternion operator*(const Quaternion &left, const Quaternion &right)
-	{
-		return left.Multiply(right);
-	}
-
-	Vector3 operator*(const Vector3 &left, const Quaternion &right)
-	{
-		return right.Multiply(left);
-	}
-
-	Vector3 operator*(const Quaternion &left, const Vector3 &right)
-	{
-		return left.Multiply(right);
-	}
-
-	Quaternion operator*(const float &left, const Quaternion &right)
-	{
-		return right.Scale(left);
-	}
-
-	Quaternion operator*(const Quaternion &left, const float &right)
-	{
-		return left.Scale(right);
-	}
-
-	Quaternion &Quaternion::operator*=(const Quaternion &other)
-	{
-		return *this = Multiply(other);
-	}
-
-	Quaternion &Quaternion::operator*=(const float &other)
-	{
-		return *this = Scale(other);
-	}
-
 	std::ostream &operator<<(std::ostream &stream, const Quaternion &quaternion)
 	{
 		stream << quaternion.ToString();
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <cassert>
+#include <cmath>
 #include <ostream>
 #include <string>
 #include "Serialized/Metadata.hpp"
 #include "Matrix4.hpp"
+#include "Simd.hpp"
 #include "Vector3.hpp"
 
 namespace acid
@@ -23,7 +26,13 @@ namespace acid
 		/// <param name="y"> Start y. </param>
 		/// <param name="z"> Start z. </param>
 		/// <param name="w"> Start w. </param>
-		Quaternion(const float &x = 0.0f, const float &y = 0.0f, const float &z = 0.0f, const float &w = 1.0f);
+		constexpr Quaternion(const float &x = 0.0f, const float &y = 0.0f, const float &z = 0.0f, const float &w = 1.0f) :
+			m_x(x),
+			m_y(y),
+			m_z(z),
+			m_w(w)
+		{
+		}
 
 		/// <summary>
 		/// Constructor for Quaternion.
@@ -46,6 +55,15 @@ namespace acid
 		/// <param name="axisZ"> The Z axis. </param>
 		Quaternion(const Vector3 &axisX, const Vector3 &axisY, const Vector3 &axisZ);
 
+		/// <summary>
+		/// Constructor for Quaternion.
+		/// </summary>
+		/// <param name="source"> Creates this quaternion out of packed floats. </param>
+		explicit Quaternion(const Simd::Float4 &source)
+		{
+			Simd::Store(m_elements, source);
+		}
+
 		/// <summary>
 		/// Adds this quaternion to another quaternion.
 		/// </summary>
@@ -174,6 +192,8 @@ namespace acid
 
 		void SetW(const float &w) { m_w = w; }
 
+		Simd::Float4 GetFloat4() const { return Simd::Load(m_elements); }
+
 		void Decode(const Metadata &metadata);
 
 		void Encode(Metadata &metadata) const;
@@ -200,19 +220,19 @@ namespace acid
 
 		float &operator[](const uint32_t &index);
 
-		ACID_EXPORT friend Quaternion operator+(const Quaternion &left, const Quaternion &right);
+		friend Quaternion operator+(const Quaternion &left, const Quaternion &right);
 
-		ACID_EXPORT friend Quaternion operator-(const Quaternion &left, const Quaternion &right);
+		friend Quaternion operator-(const Quaternion &left, const Quaternion &right);
 
-		ACID_EXPORT friend Quaternion operator*(const Quaternion &left, const Quaternion &right);
+		friend Quaternion operator*(const Quaternion &left, const Quaternion &right);
 
-		ACID_EXPORT friend Vector3 operator*(const Vector3 &right, const Quaternion &left);
+		friend Vector3 operator*(const Vector3 &right, const Quaternion &left);
 
-		ACID_EXPORT friend Vector3 operator*(const Quaternion &left, const Vector3 &right);
+		friend Vector3 operator*(const Quaternion &left, const Vector3 &right);
 
-		ACID_EXPORT friend Quaternion operator*(const float &left, const Quaternion &right);
+		friend Quaternion operator*(const float &left, const Quaternion &right);
 
-		ACID_EXPORT friend Quaternion operator*(const Quaternion &left, const float &right);
+		friend Quaternion operator*(const Quaternion &left, const float &right);
 
 		Quaternion &operator*=(const Quaternion &other);
 
@@ -237,8 +257,141 @@ namespace acid
 
 			struct
 			{
-				float m_elements[4];
+				alignas(16) float m_elements[4];
 			};
 		};
 	};
+
+	inline Quaternion Quaternion::Add(const Quaternion &other) const
+	{
+		return Quaternion(Simd::Add(GetFloat4(), other.GetFloat4()));
+	}
+
+	inline Quaternion Quaternion::Subtract(const Quaternion &other) const
+	{
+		return Quaternion(Simd::Subtract(GetFloat4(), other.GetFloat4()));
+	}
+
+	inline Quaternion Quaternion::Multiply(const Quaternion &other) const
+	{
+		auto a = GetFloat4();
+		auto b = other.GetFloat4();
+		// The w of the last two products is subtracted, the sign of a lane is flipped by multiplying by a constant.
+		auto signs = Simd::Set(1.0f, 1.0f, 1.0f, -1.0f);
+		auto result = Simd::Multiply(Simd::Broadcast<3>(a), b);
+		result = Simd::MultiplyAdd(Simd::Multiply(Simd::Swizzle<0, 1, 2, 0>(a), Simd::Swizzle<3, 3, 3, 0>(b)), signs, result);
+		result = Simd::MultiplyAdd(Simd::Multiply(Simd::Swizzle<1, 2, 0, 1>(a), Simd::Swizzle<2, 0, 1, 1>(b)), signs, result);
+		result = Simd::Subtract(result, Simd::Multiply(Simd::Swizzle<2, 0, 1, 2>(a), Simd::Swizzle<1, 2, 0, 2>(b)));
+		return Quaternion(result);
+	}
+
+	inline Vector3 Quaternion::Multiply(const Vector3 &other) const
+	{
+		Vector3 q = Vector3(m_x, m_y, m_z);
+		Vector3 cross1 = q.Cross(other);
+		Vector3 cross2 = q.Cross(cross1);
+		return other + 2.0f * (cross1 * m_w + cross2);
+	}
+
+	inline float Quaternion::Dot(const Quaternion &other) const
+	{
+		return Simd::Dot(GetFloat4(), other.GetFloat4());
+	}
+
+	inline Quaternion Quaternion::Scale(const float &scalar) const
+	{
+		return Quaternion(Simd::Multiply(GetFloat4(), Simd::Splat(scalar)));
+	}
+
+	inline Quaternion Quaternion::Negate() const
+	{
+		return Quaternion(Simd::Negate(GetFloat4()));
+	}
+
+	inline Quaternion Quaternion::Normalize() const
+	{
+		return Quaternion(Simd::Divide(GetFloat4(), Simd::Splat(Length())));
+	}
+
+	inline float Quaternion::LengthSquared() const
+	{
+		return Dot(*this);
+	}
+
+	inline float Quaternion::Length() const
+	{
+		return std::sqrt(LengthSquared());
+	}
+
+	inline bool Quaternion::operator==(const Quaternion &other) const
+	{
+		return m_x == other.m_x && m_y == other.m_y && m_z == other.m_z && m_w == other.m_w;
+	}
+
+	inline bool Quaternion::operator!=(const Quaternion &other) const
+	{
+		return !(*this == other);
+	}
+
+	inline Quaternion Quaternion::operator-() const
+	{
+		return Negate();
+	}
+
+	inline const float &Quaternion::operator[](const uint32_t &index) const
+	{
+		assert(index < 4);
+		return m_elements[index];
+	}
+
+	inline float &Quaternion::operator[](const uint32_t &index)
+	{
+		assert(index < 4);
+		return m_elements[index];
+	}
+
+	inline Quaternion operator+(const Quaternion &left, const Quaternion &right)
+	{
+		return left.Add(right);
+	}
+
+	inline Quaternion operator-(const Quaternion &left, const Quaternion &right)
+	{
+		return left.Subtract(right);
+	}
+
+	inline Quaternion operator*(const Quaternion &left, const Quaternion &right)
+	{
+		return left.Multiply(right);
+	}
+
+	inline Vector3 operator*(const Vector3 &left, const Quaternion &right)
+	{
+		return right.Multiply(left);
+	}
+
+	inline Vector3 operator*(const Quaternion &left, const Vector3 &right)
+	{
+		return left.Multiply(right);
+	}
+
+	inline Quaternion operator*(const float &left, const Quaternion &right)
+	{
+		return right.Scale(left);
+	}
+
+	inline Quaternion operator*(const Quaternion &left, const float &right)
+	{
+		return left.Scale(right);
+	}
+
+	inline Quaternion &Quaternion::operator*=(const Quaternion &other)
+	{
+		return *this = Multiply(other);
+	}
+
+	inline Quaternion &Quaternion::operator*=(const float &other)
+	{
+		return *this = Scale(other);
+	}
 }
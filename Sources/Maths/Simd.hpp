@@ -0,0 +1,389 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+// Defining ACID_SIMD_SCALAR disables the SIMD paths, the maths classes then use plain floats.
+#if !defined(ACID_SIMD_SCALAR)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ACID_SIMD_SSE
+#if defined(__AVX__)
+#define ACID_SIMD_AVX
+#endif
+#if defined(__FMA__)
+#define ACID_SIMD_FMA
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define ACID_SIMD_NEON
+#endif
+#endif
+
+#if defined(ACID_SIMD_SSE)
+#include <immintrin.h>
+#elif defined(ACID_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace acid
+{
+	/// <summary>
+	/// Operations on four packed floats, used by the maths classes. Each operation is SSE, NEON or scalar depending on the target,
+	/// the SSE paths use AVX and FMA when the compiler targets them.
+	/// </summary>
+	class Simd
+	{
+	public:
+#if defined(ACID_SIMD_SSE)
+		using Float4 = __m128;
+#elif defined(ACID_SIMD_NEON)
+		using Float4 = float32x4_t;
+#else
+		struct Float4
+		{
+			float m_values[4];
+		};
+#endif
+
+		/// <summary>
+		/// Loads four floats from memory aligned to 16 bytes.
+		/// </summary>
+		/// <param name="source"> The floats to load. </param>
+		/// <returns> The packed floats. </returns>
+		static Float4 Load(const float *source)
+		{
+#if defined(ACID_SIMD_SSE)
+			return _mm_load_ps(source);
+#elif defined(ACID_SIMD_NEON)
+			return vld1q_f32(source);
+#else
+			return {{source[0], source[1], source[2], source[3]}};
+#endif
+		}
+
+		/// <summary>
+		/// Stores four floats into memory aligned to 16 bytes.
+		/// </summary>
+		/// <param name="destination"> The memory to store into. </param>
+		/// <param name="value"> The packed floats. </param>
+		static void Store(float *destination, const Float4 &value)
+		{
+#if defined(ACID_SIMD_SSE)
+			_mm_store_ps(destination, value);
+#elif defined(ACID_SIMD_NEON)
+			vst1q_f32(destination, value);
+#else
+			std::copy(value.m_values, value.m_values + 4, destination);
+#endif
+		}
+
+		/// <summary>
+		/// Loads four floats from memory with any alignment.
+		/// </summary>
+		/// <param name="source"> The floats to load. </param>
+		/// <returns> The packed floats. </returns>
+		static Float4 LoadUnaligned(const float *source)
+		{
+#if defined(ACID_SIMD_SSE)
+			return _mm_loadu_ps(source);
+#elif defined(ACID_SIMD_NEON)
+			return vld1q_f32(source);
+#else
+			return {{source[0], source[1], source[2], source[3]}};
+#endif
+		}
+
+		/// <summary>
+		/// Stores four floats into memory with any alignment.
+		/// </summary>
+		/// <param name="destination"> The memory to store into. </param>
+		/// <param name="value"> The packed floats. </param>
+		static void StoreUnaligned(float *destination, const Float4 &value)
+		{
+#if defined(ACID_SIMD_SSE)
+			_mm_storeu_ps(destination, value);
+#elif defined(ACID_SIMD_NEON)
+			vst1q_f32(destination, value);
+#else
+			std::copy(value.m_values, value.m_values + 4, destination);
+#endif
+		}
+
+		static Float4 Set(const float &x, const float &y, const float &z, const float &w)
+		{
+#if defined(ACID_SIMD_SSE)
+			return _mm_setr_ps(x, y, z, w);
+#elif defined(ACID_SIMD_NEON)
+			alignas(16) float values[4] = {x, y, z, w};
+			return vld1q_f32(values);
+#else
+			return {{x, y, z, w}};
+#endif
+		}
+
+		/// <summary>
+		/// Packs a float into all four floats.
+		/// </summary>
+		/// <param name="value"> The float. </param>
+		/// <returns> The packed floats. </returns>
+		static Float4 Splat(const float &value)
+		{
+#if defined(ACID_SIMD_SSE)
+			return _mm_set1_ps(value);
+#elif defined(ACID_SIMD_NEON)
+			return vdupq_n_f32(value);
+#else
+			return {{value, value, value, value}};
+#endif
+		}
+
+		static Float4 Add(const Float4 &a, const Float4 &b)
+		{
+#if defined(ACID_SIMD_SSE)
+			return _mm_add_ps(a, b);
+#elif defined(ACID_SIMD_NEON)
+			return vaddq_f32(a, b);
+#else
+			return {{a.m_values[0] + b.m_values[0], a.m_values[1] + b.m_values[1], a.m_values[2] + b.m_values[2], a.m_values[3] + b.m_values[3]}};
+#endif
+		}
+
+		static Float4 Subtract(const Float4 &a, const Float4 &b)
+		{
+#if defined(ACID_SIMD_SSE)
+			return _mm_sub_ps(a, b);
+#elif defined(ACID_SIMD_NEON)
+			return vsubq_f32(a, b);
+#else
+			return {{a.m_values[0] - b.m_values[0], a.m_values[1] - b.m_values[1], a.m_values[2] - b.m_values[2], a.m_values[3] - b.m_values[3]}};
+#endif
+		}
+
+		static Float4 Multiply(const Float4 &a, const Float4 &b)
+		{
+#if defined(ACID_SIMD_SSE)
+			return _mm_mul_ps(a, b);
+#elif defined(ACID_SIMD_NEON)
+			return vmulq_f32(a, b);
+#else
+			return {{a.m_values[0] * b.m_values[0], a.m_values[1] * b.m_values[1], a.m_values[2] * b.m_values[2], a.m_values[3] * b.m_values[3]}};
+#endif
+		}
+
+		static Float4 Divide(const Float4 &a, const Float4 &b)
+		{
+#if defined(ACID_SIMD_SSE)
+			return _mm_div_ps(a, b);
+#elif defined(ACID_SIMD_NEON) && defined(__aarch64__)
+			return vdivq_f32(a, b);
+#elif defined(ACID_SIMD_NEON)
+			// 32 bit NEON has no divide, a reciprocal estimate is refined twice to full precision.
+			auto reciprocal = vrecpeq_f32(b);
+			reciprocal = vmulq_f32(vrecpsq_f32(b, reciprocal), reciprocal);
+			reciprocal = vmulq_f32(vrecpsq_f32(b, reciprocal), reciprocal);
+			return vmulq_f32(a, reciprocal);
+#else
+			return {{a.m_values[0] / b.m_values[0], a.m_values[1] / b.m_values[1], a.m_values[2] / b.m_values[2], a.m_values[3] / b.m_values[3]}};
+#endif
+		}
+
+		/// <summary>
+		/// Multiplies two packed floats and adds a third, fused into one instruction when the target has FMA.
+		/// </summary>
+		/// <returns> a * b + c. </returns>
+		static Float4 MultiplyAdd(const Float4 &a, const Float4 &b, const Float4 &c)
+		{
+#if defined(ACID_SIMD_FMA)
+			return _mm_fmadd_ps(a, b, c);
+#elif defined(ACID_SIMD_SSE)
+			return _mm_add_ps(_mm_mul_ps(a, b), c);
+#elif defined(ACID_SIMD_NEON) && defined(__aarch64__)
+			return vfmaq_f32(c, a, b);
+#elif defined(ACID_SIMD_NEON)
+			return vmlaq_f32(c, a, b);
+#else
+			return Add(Multiply(a, b), c);
+#endif
+		}
+
+		static Float4 Negate(const Float4 &a)
+		{
+#if defined(ACID_SIMD_SSE)
+			return _mm_xor_ps(a, _mm_set1_ps(-0.0f));
+#elif defined(ACID_SIMD_NEON)
+			return vnegq_f32(a);
+#else
+			return {{-a.m_values[0], -a.m_values[1], -a.m_values[2], -a.m_values[3]}};
+#endif
+		}
+
+		static Float4 Min(const Float4 &a, const Float4 &b)
+		{
+#if defined(ACID_SIMD_SSE)
+			return _mm_min_ps(a, b);
+#elif defined(ACID_SIMD_NEON)
+			return vminq_f32(a, b);
+#else
+			return {{std::min(a.m_values[0], b.m_values[0]), std::min(a.m_values[1], b.m_values[1]), std::min(a.m_values[2], b.m_values[2]),
+				std::min(a.m_values[3], b.m_values[3])}};
+#endif
+		}
+
+		static Float4 Max(const Float4 &a, const Float4 &b)
+		{
+#if defined(ACID_SIMD_SSE)
+			return _mm_max_ps(a, b);
+#elif defined(ACID_SIMD_NEON)
+			return vmaxq_f32(a, b);
+#else
+			return {{std::max(a.m_values[0], b.m_values[0]), std::max(a.m_values[1], b.m_values[1]), std::max(a.m_values[2], b.m_values[2]),
+				std::max(a.m_values[3], b.m_values[3])}};
+#endif
+		}
+
+		/// <summary>
+		/// Compares two packed floats, each float of the result has every bit set where a is greater than b and none where it is not.
+		/// </summary>
+		/// <returns> The comparison mask. </returns>
+		static Float4 Greater(const Float4 &a, const Float4 &b)
+		{
+#if defined(ACID_SIMD_SSE)
+			return _mm_cmpgt_ps(a, b);
+#elif defined(ACID_SIMD_NEON)
+			return vreinterpretq_f32_u32(vcgtq_f32(a, b));
+#else
+			Float4 result;
+
+			for (uint32_t i = 0; i < 4; i++)
+			{
+				uint32_t bits = a.m_values[i] > b.m_values[i] ? 0xFFFFFFFF : 0;
+				std::memcpy(&result.m_values[i], &bits, sizeof(float));
+			}
+
+			return result;
+#endif
+		}
+
+		/// <summary>
+		/// Packs the sign bit of each of the four floats into the low four bits of a integer, the first float is the lowest bit.
+		/// </summary>
+		/// <returns> The sign bits. </returns>
+		static uint32_t MoveMask(const Float4 &a)
+		{
+#if defined(ACID_SIMD_SSE)
+			return static_cast<uint32_t>(_mm_movemask_ps(a));
+#elif defined(ACID_SIMD_NEON)
+			static const int32_t shifts[4] = {0, 1, 2, 3};
+			auto bits = vshlq_u32(vshrq_n_u32(vreinterpretq_u32_f32(a), 31), vld1q_s32(shifts));
+#if defined(__aarch64__)
+			return vaddvq_u32(bits);
+#else
+			auto pairs = vadd_u32(vget_low_u32(bits), vget_high_u32(bits));
+			return vget_lane_u32(vpadd_u32(pairs, pairs), 0);
+#endif
+#else
+			uint32_t result = 0;
+
+			for (uint32_t i = 0; i < 4; i++)
+			{
+				uint32_t bits;
+				std::memcpy(&bits, &a.m_values[i], sizeof(float));
+				result |= (bits >> 31) << i;
+			}
+
+			return result;
+#endif
+		}
+
+		/// <summary>
+		/// Gets one of the four floats.
+		/// </summary>
+		/// <typeparam name="I"> The index of the float. </typeparam>
+		/// <returns> The float. </returns>
+		template<uint32_t I>
+		static float Get(const Float4 &a)
+		{
+#if defined(ACID_SIMD_SSE)
+			return _mm_cvtss_f32(_mm_shuffle_ps(a, a, _MM_SHUFFLE(I, I, I, I)));
+#elif defined(ACID_SIMD_NEON)
+			return vgetq_lane_f32(a, I);
+#else
+			return a.m_values[I];
+#endif
+		}
+
+		/// <summary>
+		/// Picks two floats from each of two packed floats, like _mm_shuffle_ps.
+		/// </summary>
+		/// <typeparam name="X"> The index of the first float, from a. </typeparam>
+		/// <typeparam name="Y"> The index of the second float, from a. </typeparam>
+		/// <typeparam name="Z"> The index of the third float, from b. </typeparam>
+		/// <typeparam name="W"> The index of the fourth float, from b. </typeparam>
+		/// <returns> The picked floats. </returns>
+		template<uint32_t X, uint32_t Y, uint32_t Z, uint32_t W>
+		static Float4 Shuffle(const Float4 &a, const Float4 &b)
+		{
+#if defined(ACID_SIMD_SSE)
+			return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+#elif defined(ACID_SIMD_NEON)
+			alignas(16) float values[4] = {vgetq_lane_f32(a, X), vgetq_lane_f32(a, Y), vgetq_lane_f32(b, Z), vgetq_lane_f32(b, W)};
+			return vld1q_f32(values);
+#else
+			return {{a.m_values[X], a.m_values[Y], b.m_values[Z], b.m_values[W]}};
+#endif
+		}
+
+		/// <summary>
+		/// Reorders the four floats.
+		/// </summary>
+		/// <returns> The reordered floats. </returns>
+		template<uint32_t X, uint32_t Y, uint32_t Z, uint32_t W>
+		static Float4 Swizzle(const Float4 &a)
+		{
+			return Shuffle<X, Y, Z, W>(a, a);
+		}
+
+		/// <summary>
+		/// Packs one of the four floats into all four.
+		/// </summary>
+		/// <typeparam name="I"> The index of the float. </typeparam>
+		/// <returns> The packed floats. </returns>
+		template<uint32_t I>
+		static Float4 Broadcast(const Float4 &a)
+		{
+#if defined(ACID_SIMD_NEON) && defined(__aarch64__)
+			return vdupq_laneq_f32(a, I);
+#else
+			return Swizzle<I, I, I, I>(a);
+#endif
+		}
+
+		/// <summary>
+		/// Adds the four floats together.
+		/// </summary>
+		/// <returns> The sum. </returns>
+		static float Sum(const Float4 &a)
+		{
+#if defined(ACID_SIMD_SSE)
+			auto pairs = _mm_add_ps(a, _mm_movehl_ps(a, a));
+			return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 1, 1, 1))));
+#elif defined(ACID_SIMD_NEON) && defined(__aarch64__)
+			return vaddvq_f32(a);
+#elif defined(ACID_SIMD_NEON)
+			auto pairs = vadd_f32(vget_low_f32(a), vget_high_f32(a));
+			return vget_lane_f32(vpadd_f32(pairs, pairs), 0);
+#else
+			return (a.m_values[0] + a.m_values[1]) + (a.m_values[2] + a.m_values[3]);
+#endif
+		}
+
+		/// <summary>
+		/// Calculates the dot product of two packed floats.
+		/// </summary>
+		/// <returns> The dot product. </returns>
+		static float Dot(const Float4 &a, const Float4 &b)
+		{
+			return Sum(Multiply(a, b));
+		}
+	};
+}
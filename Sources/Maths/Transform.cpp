@@ -99,8 +99,13 @@ namespace acid
 
 	void Transform::SetDirty(const bool &dirty) const
 	{
+		// A dirty matrix is built again when it is next used.
+		if (!dirty)
+		{
+			m_worldMatrix = Matrix4::TransformationMatrix(m_position, m_rotation, m_scaling);
+		}
+
 		m_dirty = dirty;
-		m_worldMatrix = Matrix4::TransformationMatrix(m_position, m_rotation, m_scaling);
 	}
 
 	bool Transform::operator==(const Transform &other) const
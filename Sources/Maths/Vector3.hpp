@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cassert>
+#include <cmath>
 #include <ostream>
 #include <string>
 #include "Engine/Exports.hpp"
@@ -24,7 +26,12 @@ namespace acid
 		/// <param name="x"> Start x. </param>
 		/// <param name="y"> Start y. </param>
 		/// <param name="z"> Start z. </param>
-		Vector3(const float &x = 0.0f, const float &y = 0.0f, const float &z = 0.0f);
+		constexpr Vector3(const float &x = 0.0f, const float &y = 0.0f, const float &z = 0.0f) :
+			m_x(x),
+			m_y(y),
+			m_z(z)
+		{
+		}
 
 		/// <summary>
 		/// Constructor for Vector3.
@@ -50,28 +57,28 @@ namespace acid
 		/// </summary>
 		/// <param name="other"> The other vector. </param>
 		/// <returns> The resultant vector. </returns>
-		Vector3 Add(const Vector3 &other) const;
+		constexpr Vector3 Add(const Vector3 &other) const;
 
 		/// <summary>
 		/// Subtracts this vector to another vector.
 		/// </summary>
 		/// <param name="other"> The other vector. </param>
 		/// <returns> The resultant vector. </returns>
-		Vector3 Subtract(const Vector3 &other) const;
+		constexpr Vector3 Subtract(const Vector3 &other) const;
 
 		/// <summary>
 		/// Multiplies this vector with another vector.
 		/// </summary>
 		/// <param name="other"> The other vector. </param>
 		/// <returns> The resultant vector. </returns>
-		Vector3 Multiply(const Vector3 &other) const;
+		constexpr Vector3 Multiply(const Vector3 &other) const;
 
 		/// <summary>
 		/// Divides this vector by another vector.
 		/// </summary>
 		/// <param name="other"> The other vector. </param>
 		/// <returns> The resultant vector. </returns>
-		Vector3 Divide(const Vector3 &other) const;
+		constexpr Vector3 Divide(const Vector3 &other) const;
 
 		/// <summary>
 		/// Calculates the angle between this vector and another vector.
@@ -85,14 +92,14 @@ namespace acid
 		/// </summary>
 		/// <param name="other"> The other vector. </param>
 		/// <returns> The dot product. </returns>
-		float Dot(const Vector3 &other) const;
+		constexpr float Dot(const Vector3 &other) const;
 
 		/// <summary>
 		/// Calculates the cross product of the this vector and another vector.
 		/// </summary>
 		/// <param name="other"> The other vector. </param>
 		/// <returns> The cross product. </returns>
-		Vector3 Cross(const Vector3 &other) const;
+		constexpr Vector3 Cross(const Vector3 &other) const;
 
 		/// <summary>
 		/// Calculates the linear interpolation between this vector and another vector.
@@ -100,14 +107,14 @@ namespace acid
 		/// <param name="other"> The other quaternion. </param>
 		/// <param name="progression"> The progression. </param>
 		/// <returns> Left lerp right. </returns>
-		Vector3 Lerp(const Vector3 &other, const float &progression) const;
+		constexpr Vector3 Lerp(const Vector3 &other, const float &progression) const;
 
 		/// <summary>
 		/// Scales this vector by a scalar.
 		/// </summary>
 		/// <param name="scalar"> The scalar value. </param>
 		/// <returns> The scaled vector. </returns>
-		Vector3 Scale(const float &scalar) const;
+		constexpr Vector3 Scale(const float &scalar) const;
 
 		/// <summary>
 		/// Rotates this vector by a angle around the origin.
@@ -120,7 +127,7 @@ namespace acid
 		/// Negates this vector.
 		/// </summary>
 		/// <returns> The negated vector. </returns>
-		Vector3 Negate() const;
+		constexpr Vector3 Negate() const;
 
 		/// <summary>
 		/// Normalizes this vector.
@@ -132,7 +139,7 @@ namespace acid
 		/// Gets the length squared of this vector.
 		/// </summary>
 		/// <returns> The length squared. </returns>
-		float LengthSquared() const;
+		constexpr float LengthSquared() const;
 
 		/// <summary>
 		/// Gets the length of this vector.
@@ -269,9 +276,9 @@ namespace acid
 
 		void Encode(Metadata &metadata) const;
 
-		bool operator==(const Vector3 &other) const;
+		constexpr bool operator==(const Vector3 &other) const;
 
-		bool operator!=(const Vector3 &other) const;
+		constexpr bool operator!=(const Vector3 &other) const;
 
 		bool operator<(const Vector3 &other) const;
 
@@ -285,35 +292,35 @@ namespace acid
 
 		bool operator!=(const float &value) const;
 
-		Vector3 operator-() const;
+		constexpr Vector3 operator-() const;
 
 		const float &operator[](const uint32_t &index) const;
 
 		float &operator[](const uint32_t &index);
 
-		ACID_EXPORT friend Vector3 operator+(const Vector3 &left, const Vector3 &right);
+		friend constexpr Vector3 operator+(const Vector3 &left, const Vector3 &right);
 
-		ACID_EXPORT friend Vector3 operator-(const Vector3 &left, const Vector3 &right);
+		friend constexpr Vector3 operator-(const Vector3 &left, const Vector3 &right);
 
-		ACID_EXPORT friend Vector3 operator*(const Vector3 &left, const Vector3 &right);
+		friend constexpr Vector3 operator*(const Vector3 &left, const Vector3 &right);
 
-		ACID_EXPORT friend Vector3 operator/(const Vector3 &left, const Vector3 &right);
+		friend constexpr Vector3 operator/(const Vector3 &left, const Vector3 &right);
 
-		ACID_EXPORT friend Vector3 operator+(const float &left, const Vector3 &right);
+		friend constexpr Vector3 operator+(const float &left, const Vector3 &right);
 
-		ACID_EXPORT friend Vector3 operator-(const float &left, const Vector3 &right);
+		friend constexpr Vector3 operator-(const float &left, const Vector3 &right);
 
-		ACID_EXPORT friend Vector3 operator*(const float &left, const Vector3 &right);
+		friend constexpr Vector3 operator*(const float &left, const Vector3 &right);
 
-		ACID_EXPORT friend Vector3 operator/(const float &left, const Vector3 &right);
+		friend constexpr Vector3 operator/(const float &left, const Vector3 &right);
 
-		ACID_EXPORT friend Vector3 operator+(const Vector3 &left, const float &right);
+		friend constexpr Vector3 operator+(const Vector3 &left, const float &right);
 
-		ACID_EXPORT friend Vector3 operator-(const Vector3 &left, const float &right);
+		friend constexpr Vector3 operator-(const Vector3 &left, const float &right);
 
-		ACID_EXPORT friend Vector3 operator*(const Vector3 &left, const float &right);
+		friend constexpr Vector3 operator*(const Vector3 &left, const float &right);
 
-		ACID_EXPORT friend Vector3 operator/(const Vector3 &left, const float &right);
+		friend constexpr Vector3 operator/(const Vector3 &left, const float &right);
 
 		Vector3 &operator+=(const Vector3 &other);
 
@@ -359,4 +366,192 @@ namespace acid
 			};
 		};
 	};
+
+	constexpr Vector3 Vector3::Add(const Vector3 &other) const
+	{
+		return Vector3(m_x + other.m_x, m_y + other.m_y, m_z + other.m_z);
+	}
+
+	constexpr Vector3 Vector3::Subtract(const Vector3 &other) const
+	{
+		return Vector3(m_x - other.m_x, m_y - other.m_y, m_z - other.m_z);
+	}
+
+	constexpr Vector3 Vector3::Multiply(const Vector3 &other) const
+	{
+		return Vector3(m_x * other.m_x, m_y * other.m_y, m_z * other.m_z);
+	}
+
+	constexpr Vector3 Vector3::Divide(const Vector3 &other) const
+	{
+		return Vector3(m_x / other.m_x, m_y / other.m_y, m_z / other.m_z);
+	}
+
+	constexpr float Vector3::Dot(const Vector3 &other) const
+	{
+		return m_x * other.m_x + m_y * other.m_y + m_z * other.m_z;
+	}
+
+	constexpr Vector3 Vector3::Cross(const Vector3 &other) const
+	{
+		return Vector3(m_y * other.m_z - m_z * other.m_y, other.m_x * m_z - other.m_z * m_x, m_x * other.m_y - m_y * other.m_x);
+	}
+
+	constexpr Vector3 Vector3::Lerp(const Vector3 &other, const float &progression) const
+	{
+		return Add(other.Subtract(*this).Scale(progression));
+	}
+
+	constexpr Vector3 Vector3::Scale(const float &scalar) const
+	{
+		return Vector3(m_x * scalar, m_y * scalar, m_z * scalar);
+	}
+
+	constexpr Vector3 Vector3::Negate() const
+	{
+		return Vector3(-m_x, -m_y, -m_z);
+	}
+
+	inline Vector3 Vector3::Normalize() const
+	{
+		float l = Length();
+		return Vector3(m_x / l, m_y / l, m_z / l);
+	}
+
+	constexpr float Vector3::LengthSquared() const
+	{
+		return Dot(*this);
+	}
+
+	inline float Vector3::Length() const
+	{
+		return std::sqrt(LengthSquared());
+	}
+
+	constexpr bool Vector3::operator==(const Vector3 &other) const
+	{
+		return m_x == other.m_x && m_y == other.m_y && m_z == other.m_z;
+	}
+
+	constexpr bool Vector3::operator!=(const Vector3 &other) const
+	{
+		return !(*this == other);
+	}
+
+	constexpr Vector3 Vector3::operator-() const
+	{
+		return Negate();
+	}
+
+	inline const float &Vector3::operator[](const uint32_t &index) const
+	{
+		assert(index < 3);
+		return m_elements[index];
+	}
+
+	inline float &Vector3::operator[](const uint32_t &index)
+	{
+		assert(index < 3);
+		return m_elements[index];
+	}
+
+	constexpr Vector3 operator+(const Vector3 &left, const Vector3 &right)
+	{
+		return left.Add(right);
+	}
+
+	constexpr Vector3 operator-(const Vector3 &left, const Vector3 &right)
+	{
+		return left.Subtract(right);
+	}
+
+	constexpr Vector3 operator*(const Vector3 &left, const Vector3 &right)
+	{
+		return left.Multiply(right);
+	}
+
+	constexpr Vector3 operator/(const Vector3 &left, const Vector3 &right)
+	{
+		return left.Divide(right);
+	}
+
+	constexpr Vector3 operator+(const float &left, const Vector3 &right)
+	{
+		return Vector3(left, left, left).Add(right);
+	}
+
+	constexpr Vector3 operator-(const float &left, const Vector3 &right)
+	{
+		return Vector3(left, left, left).Subtract(right);
+	}
+
+	constexpr Vector3 operator*(const float &left, const Vector3 &right)
+	{
+		return right.Scale(left);
+	}
+
+	constexpr Vector3 operator/(const float &left, const Vector3 &right)
+	{
+		return Vector3(left, left, left).Divide(right);
+	}
+
+	constexpr Vector3 operator+(const Vector3 &left, const float &right)
+	{
+		return left.Add(Vector3(right, right, right));
+	}
+
+	constexpr Vector3 operator-(const Vector3 &left, const float &right)
+	{
+		return left.Subtract(Vector3(right, right, right));
+	}
+
+	constexpr Vector3 operator*(const Vector3 &left, const float &right)
+	{
+		return left.Scale(right);
+	}
+
+	constexpr Vector3 operator/(const Vector3 &left, const float &right)
+	{
+		return left.Divide(Vector3(right, right, right));
+	}
+
+	inline Vector3 &Vector3::operator+=(const Vector3 &other)
+	{
+		return *this = Add(other);
+	}
+
+	inline Vector3 &Vector3::operator-=(const Vector3 &other)
+	{
+		return *this = Subtract(other);
+	}
+
+	inline Vector3 &Vector3::operator*=(const Vector3 &other)
+	{
+		return *this = Multiply(other);
+	}
+
+	inline Vector3 &Vector3::operator/=(const Vector3 &other)
+	{
+		return *this = Divide(other);
+	}
+
+	inline Vector3 &Vector3::operator+=(const float &other)
+	{
+		return *this = *this + other;
+	}
+
+	inline Vector3 &Vector3::operator-=(const float &other)
+	{
+		return *this = *this - other;
+	}
+
+	inline Vector3 &Vector3::operator*=(const float &other)
+	{
+		return *this = Scale(other);
+	}
+
+	inline Vector3 &Vector3::operator/=(const float &other)
+	{
+		return *this = *this / other;
+	}
 }
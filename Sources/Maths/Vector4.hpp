@@ -1,9 +1,12 @@
 #pragma once
 
+#include <cassert>
+#include <cmath>
 #include <ostream>
 #include <string>
 #include "Engine/Exports.hpp"
 #include "Serialized/Metadata.hpp"
+#include "Simd.hpp"
 
 namespace acid
 {
@@ -24,7 +27,13 @@ namespace acid
 		/// <param name="y"> Start y. </param>
 		/// <param name="z"> Start z. </param>
 		/// <param name="w"> Start w. </param>
-		Vector4(const float &x = 0.0f, const float &y = 0.0f, const float &z = 0.0f, const float &w = 1.0f);
+		constexpr Vector4(const float &x = 0.0f, const float &y = 0.0f, const float &z = 0.0f, const float &w = 1.0f) :
+			m_x(x),
+			m_y(y),
+			m_z(z),
+			m_w(w)
+		{
+		}
 
 		/// <summary>
 		/// Constructor for Vector4.
@@ -46,6 +55,15 @@ namespace acid
 		/// <param name="source"> Creates this vector out of a existing colour. </param>
 		Vector4(const Colour &source);
 
+		/// <summary>
+		/// Constructor for Vector4.
+		/// </summary>
+		/// <param name="source"> Creates this vector out of packed floats. </param>
+		explicit Vector4(const Simd::Float4 &source)
+		{
+			Simd::Store(m_elements, source);
+		}
+
 		/// <summary>
 		/// Adds this vector to another vector.
 		/// </summary>
@@ -200,6 +218,8 @@ namespace acid
 
 		void SetW(const float &w) { m_w = w; }
 
+		Simd::Float4 GetFloat4() const { return Simd::Load(m_elements); }
+
 		void Decode(const Metadata &metadata);
 
 		void Encode(Metadata &metadata) const;
@@ -226,29 +246,29 @@ namespace acid
 
 		float &operator[](const uint32_t &index);
 
-		ACID_EXPORT friend Vector4 operator+(const Vector4 &left, const Vector4 &right);
+		friend Vector4 operator+(const Vector4 &left, const Vector4 &right);
 
-		ACID_EXPORT friend Vector4 operator-(const Vector4 &left, const Vector4 &right);
+		friend Vector4 operator-(const Vector4 &left, const Vector4 &right);
 
-		ACID_EXPORT friend Vector4 operator*(const Vector4 &left, const Vector4 &right);
+		friend Vector4 operator*(const Vector4 &left, const Vector4 &right);
 
-		ACID_EXPORT friend Vector4 operator/(const Vector4 &left, const Vector4 &right);
+		friend Vector4 operator/(const Vector4 &left, const Vector4 &right);
 
-		ACID_EXPORT friend Vector4 operator+(const float &left, const Vector4 &right);
+		friend Vector4 operator+(const float &left, const Vector4 &right);
 
-		ACID_EXPORT friend Vector4 operator-(const float &left, const Vector4 &right);
+		friend Vector4 operator-(const float &left, const Vector4 &right);
 
-		ACID_EXPORT friend Vector4 operator*(const float &left, const Vector4 &right);
+		friend Vector4 operator*(const float &left, const Vector4 &right);
 
-		ACID_EXPORT friend Vector4 operator/(const float &left, const Vector4 &right);
+		friend Vector4 operator/(const float &left, const Vector4 &right);
 
-		ACID_EXPORT friend Vector4 operator+(const Vector4 &left, const float &right);
+		friend Vector4 operator+(const Vector4 &left, const float &right);
 
-		ACID_EXPORT friend Vector4 operator-(const Vector4 &left, const float &right);
+		friend Vector4 operator-(const Vector4 &left, const float &right);
 
-		ACID_EXPORT friend Vector4 operator*(const Vector4 &left, const float &right);
+		friend Vector4 operator*(const Vector4 &left, const float &right);
 
-		ACID_EXPORT friend Vector4 operator/(const Vector4 &left, const float &right);
+		friend Vector4 operator/(const Vector4 &left, const float &right);
 
 		Vector4 &operator+=(const Vector4 &other);
 
@@ -279,7 +299,7 @@ namespace acid
 		{
 			struct
 			{
-				float m_elements[4];
+				alignas(16) float m_elements[4];
 			};
 
 			struct
@@ -288,4 +308,208 @@ namespace acid
 			};
 		};
 	};
+
+	inline Vector4 Vector4::Add(const Vector4 &other) const
+	{
+		return Vector4(Simd::Add(GetFloat4(), other.GetFloat4()));
+	}
+
+	inline Vector4 Vector4::Subtract(const Vector4 &other) const
+	{
+		return Vector4(Simd::Subtract(GetFloat4(), other.GetFloat4()));
+	}
+
+	inline Vector4 Vector4::Multiply(const Vector4 &other) const
+	{
+		return Vector4(Simd::Multiply(GetFloat4(), other.GetFloat4()));
+	}
+
+	inline Vector4 Vector4::Divide(const Vector4 &other) const
+	{
+		return Vector4(Simd::Divide(GetFloat4(), other.GetFloat4()));
+	}
+
+	inline float Vector4::Dot(const Vector4 &other) const
+	{
+		return Simd::Dot(GetFloat4(), other.GetFloat4());
+	}
+
+	inline Vector4 Vector4::Lerp(const Vector4 &other, const float &progression) const
+	{
+		auto a = GetFloat4();
+		return Vector4(Simd::MultiplyAdd(Simd::Subtract(other.GetFloat4(), a), Simd::Splat(progression), a));
+	}
+
+	inline Vector4 Vector4::Scale(const float &scalar) const
+	{
+		return Vector4(Simd::Multiply(GetFloat4(), Simd::Splat(scalar)));
+	}
+
+	inline Vector4 Vector4::Negate() const
+	{
+		return Vector4(Simd::Negate(GetFloat4()));
+	}
+
+	inline Vector4 Vector4::Normalize() const
+	{
+		return Vector4(Simd::Divide(GetFloat4(), Simd::Splat(Length())));
+	}
+
+	inline float Vector4::LengthSquared() const
+	{
+		return Dot(*this);
+	}
+
+	inline float Vector4::Length() const
+	{
+		return std::sqrt(LengthSquared());
+	}
+
+	inline float Vector4::DistanceSquared(const Vector4 &other) const
+	{
+		auto distance = Simd::Subtract(GetFloat4(), other.GetFloat4());
+		return Simd::Dot(distance, distance);
+	}
+
+	inline float Vector4::Distance(const Vector4 &other) const
+	{
+		return std::sqrt(DistanceSquared(other));
+	}
+
+	inline Vector4 Vector4::MinVector(const Vector4 &a, const Vector4 &b)
+	{
+		return Vector4(Simd::Min(a.GetFloat4(), b.GetFloat4()));
+	}
+
+	inline Vector4 Vector4::MaxVector(const Vector4 &a, const Vector4 &b)
+	{
+		return Vector4(Simd::Max(a.GetFloat4(), b.GetFloat4()));
+	}
+
+	inline bool Vector4::operator==(const Vector4 &other) const
+	{
+		return m_x == other.m_x && m_y == other.m_y && m_z == other.m_z && m_w == other.m_w;
+	}
+
+	inline bool Vector4::operator!=(const Vector4 &other) const
+	{
+		return !(*this == other);
+	}
+
+	inline Vector4 Vector4::operator-() const
+	{
+		return Negate();
+	}
+
+	inline const float &Vector4::operator[](const uint32_t &index) const
+	{
+		assert(index < 4);
+		return m_elements[index];
+	}
+
+	inline float &Vector4::operator[](const uint32_t &index)
+	{
+		assert(index < 4);
+		return m_elements[index];
+	}
+
+	inline Vector4 operator+(const Vector4 &left, const Vector4 &right)
+	{
+		return left.Add(right);
+	}
+
+	inline Vector4 operator-(const Vector4 &left, const Vector4 &right)
+	{
+		return left.Subtract(right);
+	}
+
+	inline Vector4 operator*(const Vector4 &left, const Vector4 &right)
+	{
+		return left.Multiply(right);
+	}
+
+	inline Vector4 operator/(const Vector4 &left, const Vector4 &right)
+	{
+		return left.Divide(right);
+	}
+
+	inline Vector4 operator+(const float &left, const Vector4 &right)
+	{
+		return Vector4(Simd::Add(Simd::Splat(left), right.GetFloat4()));
+	}
+
+	inline Vector4 operator-(const float &left, const Vector4 &right)
+	{
+		return Vector4(Simd::Subtract(Simd::Splat(left), right.GetFloat4()));
+	}
+
+	inline Vector4 operator*(const float &left, const Vector4 &right)
+	{
+		return right.Scale(left);
+	}
+
+	inline Vector4 operator/(const float &left, const Vector4 &right)
+	{
+		return Vector4(Simd::Divide(Simd::Splat(left), right.GetFloat4()));
+	}
+
+	inline Vector4 operator+(const Vector4 &left, const float &right)
+	{
+		return Vector4(Simd::Add(left.GetFloat4(), Simd::Splat(right)));
+	}
+
+	inline Vector4 operator-(const Vector4 &left, const float &right)
+	{
+		return Vector4(Simd::Subtract(left.GetFloat4(), Simd::Splat(right)));
+	}
+
+	inline Vector4 operator*(const Vector4 &left, const float &right)
+	{
+		return left.Scale(right);
+	}
+
+	inline Vector4 operator/(const Vector4 &left, const float &right)
+	{
+		return Vector4(Simd::Divide(left.GetFloat4(), Simd::Splat(right)));
+	}
+
+	inline Vector4 &Vector4::operator+=(const Vector4 &other)
+	{
+		return *this = Add(other);
+	}
+
+	inline Vector4 &Vector4::operator-=(const Vector4 &other)
+	{
+		return *this = Subtract(other);
+	}
+
+	inline Vector4 &Vector4::operator*=(const Vector4 &other)
+	{
+		return *this = Multiply(other);
+	}
+
+	inline Vector4 &Vector4::operator/=(const Vector4 &other)
+	{
+		return *this = Divide(other);
+	}
+
+	inline Vector4 &Vector4::operator+=(const float &other)
+	{
+		return *this = *this + other;
+	}
+
+	inline Vector4 &Vector4::operator-=(const float &other)
+	{
+		return *this = *this - other;
+	}
+
+	inline Vector4 &Vector4::operator*=(const float &other)
+	{
+		return *this = Scale(other);
+	}
+
+	inline Vector4 &Vector4::operator/=(const float &other)
+	{
+		return *this = *this / other;
+	}
 }
@@ -3,71 +3,58 @@
 #include "Materials/Material.hpp"
 #include "Physics/Rigidbody.hpp"
 #include "Scenes/Entity.hpp"
-#include "Scenes/Scenes.hpp"
 
 namespace acid
 {
+	MeshRender::MeshRender() :
+		m_mesh(nullptr),
+		m_material(nullptr),
+		m_rigidbody(nullptr)
+	{
+	}
+
 	void MeshRender::Start()
 	{
 	}
 
 	void MeshRender::Update()
 	{
-		auto material = GetParent()->GetComponent<Material>();
+		// Siblings are found again every update, removed components are only destroyed when the entity next updates.
+		m_mesh = GetParent()->GetComponent<Mesh>();
+		m_material = GetParent()->GetComponent<Material>();
+		m_rigidbody = GetParent()->GetComponent<Rigidbody>();
 
-		if (material == nullptr)
+		if (m_material == nullptr)
 		{
 			return;
 		}
 
 		// Updates uniforms.
-		material->PushUniforms(m_uniformObject);
+		m_material->PushUniforms(m_uniformObject);
 	}
 
-	bool MeshRender::CmdRender(const CommandBuffer &commandBuffer, UniformHandler &uniformScene, const Pipeline::Stage &pipelineStage)
+	bool MeshRender::InFrustum(const Frustum &frustum) const
 	{
-		// Checks if the mesh is in view.
-		auto rigidbody = GetParent()->GetComponent<Rigidbody>();
-
-		if (rigidbody != nullptr)
-		{
-			if (!rigidbody->InFrustum(Scenes::Get()->GetCamera()->GetViewFrustum()))
-			{
-				return false;
-			}
-		}
-
-		// Gets required components.
-		auto material = GetParent()->GetComponent<Material>();
-		auto mesh = GetParent()->GetComponent<Mesh>();
-
-		if (material == nullptr || mesh == nullptr)
-		{
-			return false;
-		}
-
-		auto meshModel = mesh->GetModel();
-		auto materialPipeline = material->GetPipelineMaterial();
-
-		if (meshModel == nullptr || materialPipeline->GetStage() != pipelineStage)
-		{
-			return false;
-		}
-
-		// Binds the material pipeline.
-		bool bindSuccess = materialPipeline->BindPipeline(commandBuffer);
+		return m_rigidbody == nullptr || m_rigidbody->InFrustum(frustum);
+	}
 
-		if (!bindSuccess)
+	bool MeshRender::GetAabb(Vector3 &min, Vector3 &max) const
+	{
+		if (m_rigidbody == nullptr)
 		{
 			return false;
 		}
 
-		auto &pipeline = *materialPipeline->GetPipeline();
+		m_rigidbody->GetAabb(min, max);
+		return true;
+	}
 
+	bool MeshRender::CmdRender(const CommandBuffer &commandBuffer, UniformHandler &uniformScene, const PipelineGraphics &pipeline, const uint32_t &instances)
+	{
 		// Updates descriptors.
 		m_descriptorSet.Push("UboScene", uniformScene);
 		m_descriptorSet.Push("UboObject", m_uniformObject);
-		material->PushDescriptors(m_descriptorSet);
+		m_material->PushDescriptors(m_descriptorSet);
 		bool updateSuccess = m_descriptorSet.Update(pipeline);
 
 		if (!updateSuccess)
@@ -77,7 +64,7 @@ namespace acid
 
 		// Draws the object.
 		m_descriptorSet.BindDescriptor(commandBuffer, pipeline);
-		return meshModel->CmdRender(commandBuffer);
+		return m_mesh->GetModel()->CmdRender(commandBuffer, instances);
 	}
 
 	void MeshRender::Decode(const Metadata &metadata)
@@ -87,14 +74,4 @@ namespace acid
 	void MeshRender::Encode(Metadata &metadata) const
 	{
 	}
-
-	bool MeshRender::operator<(const MeshRender &other) const
-	{
-		auto camera = Scenes::Get()->GetCamera();
-
-		float thisDistance2 = (camera->GetPosition() - GetParent()->GetWorldTransform().GetPosition()).LengthSquared();
-		float otherDistance2 = (camera->GetPosition() - other.GetParent()->GetWorldTransform().GetPosition()).LengthSquared();
-
-		return thisDistance2 > otherDistance2;
-	}
 }
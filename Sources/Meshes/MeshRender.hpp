@@ -2,14 +2,21 @@
 
 #include "Renderer/Handlers/DescriptorsHandler.hpp"
 #include "Renderer/Handlers/UniformHandler.hpp"
+#include "Renderer/Pipelines/PipelineGraphics.hpp"
 #include "Mesh.hpp"
 
 namespace acid
 {
+	class Frustum;
+	class Material;
+	class Rigidbody;
+
 	class ACID_EXPORT MeshRender :
 		public Component
 	{
 	public:
+		MeshRender();
+
 		void Start() override;
 
 		void Update() override;
@@ -18,10 +25,40 @@ namespace acid
 
 		void Encode(Metadata &metadata) const override;
 
-		bool CmdRender(const CommandBuffer &commandBuffer, UniformHandler &uniformScene, const Pipeline::Stage &pipelineStage);
+		/// <summary>
+		/// Gets if the mesh is in view, meshes without a rigidbody have no bounds and are always in view.
+		/// </summary>
+		/// <param name="frustum"> The frustum to test against. </param>
+		/// <returns> If the mesh is in view. </returns>
+		bool InFrustum(const Frustum &frustum) const;
+
+		/// <summary>
+		/// Gets the world space bounds of the mesh, from its rigidbody.
+		/// </summary>
+		/// <param name="min"> The minimum corner. </param>
+		/// <param name="max"> The maximum corner. </param>
+		/// <returns> If the mesh has bounds, meshes without a rigidbody have none. </returns>
+		bool GetAabb(Vector3 &min, Vector3 &max) const;
 
-		bool operator<(const MeshRender &other) const;
+		/// <summary>
+		/// Pushes the descriptors of this mesh and draws its model, the pipeline and any instance data have already been bound by the <seealso cref="RenderQueue"/>.
+		/// </summary>
+		/// <param name="commandBuffer"> The command buffer to record into. </param>
+		/// <param name="uniformScene"> The scene uniform handler. </param>
+		/// <param name="pipeline"> The bound material pipeline. </param>
+		/// <param name="instances"> The number of instances to draw. </param>
+		/// <returns> If the model was drawn. </returns>
+		bool CmdRender(const CommandBuffer &commandBuffer, UniformHandler &uniformScene, const PipelineGraphics &pipeline, const uint32_t &instances = 1);
+
+		Mesh *GetMesh() const { return m_mesh; }
+
+		Material *GetMaterial() const { return m_material; }
 	private:
+		// Found once a update, so rendering does not look through the entities components.
+		Mesh *m_mesh;
+		Material *m_material;
+		Rigidbody *m_rigidbody;
+
 		DescriptorsHandler m_descriptorSet;
 		UniformHandler m_uniformObject;
 	};
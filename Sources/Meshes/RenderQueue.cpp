@@ -0,0 +1,327 @@
+#include "RenderQueue.hpp"
+
+#include <array>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include "Materials/Material.hpp"
+#include "Maths/Culling.hpp"
+#include "Scenes/Entity.hpp"
+#include "MeshRender.hpp"
+
+namespace acid
+{
+	// Instance data is bound after the model vertices, instanced materials add the instance input at this binding.
+	static const uint32_t INSTANCE_BINDING = 1;
+	// The key is made of 12 bits of pipeline, 20 bits of material and 16 bits of model above 16 bits of depth.
+	static const uint64_t PIPELINE_ID_MAX = (1 << 12) - 1;
+	static const uint64_t MATERIAL_ID_MAX = (1 << 20) - 1;
+	static const uint64_t MODEL_ID_MAX = (1 << 16) - 1;
+	static const uint64_t DEPTH_MAX = (1 << 16) - 1;
+
+	RenderQueue::RenderQueue(const Sort &sort) :
+		m_sort(sort),
+		m_instanceBuffer(sizeof(Instance)),
+		m_drawCount(0),
+		m_bindCount(0),
+		m_instanceCount(0)
+	{
+	}
+
+	void RenderQueue::Clear()
+	{
+		m_draws.clear();
+		m_minX.clear();
+		m_minY.clear();
+		m_minZ.clear();
+		m_maxX.clear();
+		m_maxY.clear();
+		m_maxZ.clear();
+		m_keys.clear();
+		m_pipelineIds.clear();
+		m_materialIds.clear();
+		m_modelIds.clear();
+	}
+
+	void RenderQueue::Add(MeshRender *meshRender, const Pipeline::Stage &pipelineStage)
+	{
+		auto mesh = meshRender->GetMesh();
+		auto material = meshRender->GetMaterial();
+
+		if (mesh == nullptr || material == nullptr)
+		{
+			return;
+		}
+
+		auto model = mesh->GetModel().get();
+		auto pipelineMaterial = material->GetPipelineMaterial().get();
+
+		if (model == nullptr || pipelineMaterial == nullptr || pipelineMaterial->GetStage() != pipelineStage)
+		{
+			return;
+		}
+
+		// Until the model and textures have been uploaded the mesh is skipped, the rest of the scene keeps drawing.
+		if (!model->IsLoaded() || !material->IsLoaded())
+		{
+			return;
+		}
+
+		Vector3 min;
+		Vector3 max;
+
+		if (!meshRender->GetAabb(min, max))
+		{
+			auto largest = std::numeric_limits<float>::max();
+			min = Vector3(-largest, -largest, -largest);
+			max = Vector3(largest, largest, largest);
+		}
+
+		m_minX.emplace_back(min.m_x);
+		m_minY.emplace_back(min.m_y);
+		m_minZ.emplace_back(min.m_z);
+		m_maxX.emplace_back(max.m_x);
+		m_maxY.emplace_back(max.m_y);
+		m_maxZ.emplace_back(max.m_z);
+
+		Draw draw = {};
+		draw.meshRender = meshRender;
+		draw.model = model;
+		draw.material = material;
+		draw.pipelineMaterial = pipelineMaterial;
+		draw.instanced = material->IsInstanced();
+		m_draws.emplace_back(draw);
+	}
+
+	void RenderQueue::Cull(const Frustum &frustum, const Vector3 &cameraPosition)
+	{
+		auto count = m_draws.size();
+		m_visible.resize(Culling::GetBitsetSize(count));
+		Culling::CubesInFrustum(frustum, {m_minX.data(), m_minY.data(), m_minZ.data(), m_maxX.data(), m_maxY.data(), m_maxZ.data()}, count, m_visible.data());
+
+		// Moves the visible draws to the front, only they are given ids and keys.
+		std::size_t visibleCount = 0;
+
+		for (std::size_t i = 0; i < count; i++)
+		{
+			if ((m_visible[i / 64] >> (i % 64) & 1) == 0)
+			{
+				continue;
+			}
+
+			auto &draw = m_draws[visibleCount];
+			draw = m_draws[i];
+			visibleCount++;
+
+			auto worldTransform = draw.meshRender->GetParent()->GetWorldTransform();
+
+			if (draw.instanced)
+			{
+				draw.batchKey = draw.material->GetBatchKey();
+				draw.transform = worldTransform.GetWorldMatrix();
+			}
+
+			// Instanced materials with the same key share a id, every other material is kept apart by its address.
+			auto pipelineId = GetId(m_pipelineIds, reinterpret_cast<std::size_t>(draw.pipelineMaterial), PIPELINE_ID_MAX);
+			auto materialId = GetId(m_materialIds, draw.instanced ? draw.batchKey : reinterpret_cast<std::size_t>(draw.material), MATERIAL_ID_MAX);
+			auto modelId = GetId(m_modelIds, reinterpret_cast<std::size_t>(draw.model), MODEL_ID_MAX);
+			auto state = (pipelineId << 36) | (materialId << 16) | modelId;
+
+			// Positive floats order the same as their bits, the top 16 bits keep the exponent and 7 bits of mantissa.
+			auto distance = (cameraPosition - worldTransform.GetPosition()).LengthSquared();
+			uint32_t distanceBits;
+			std::memcpy(&distanceBits, &distance, sizeof(float));
+			uint64_t depth = distanceBits >> 16;
+
+			switch (m_sort)
+			{
+			case Sort::None:
+				m_keys.emplace_back(state << 16);
+				break;
+			case Sort::Front:
+				m_keys.emplace_back((state << 16) | depth);
+				break;
+			case Sort::Back:
+				m_keys.emplace_back(((DEPTH_MAX - depth) << 48) | state);
+				break;
+			}
+		}
+
+		m_draws.resize(visibleCount);
+	}
+
+	void RenderQueue::CmdRender(const CommandBuffer &commandBuffer, UniformHandler &uniformScene)
+	{
+		m_drawCount = 0;
+		m_bindCount = 0;
+		m_instanceCount = 0;
+
+		if (m_draws.empty())
+		{
+			return;
+		}
+
+		m_order.resize(m_draws.size());
+		std::iota(m_order.begin(), m_order.end(), 0);
+		RadixSort();
+
+		// Instances are written in the sorted order, so every batch reads a contiguous range.
+		uint32_t instancedCount = 0;
+
+		for (const auto &draw : m_draws)
+		{
+			if (draw.instanced)
+			{
+				instancedCount++;
+			}
+		}
+
+		auto instances = instancedCount != 0 ? static_cast<Instance *>(m_instanceBuffer.Map(instancedCount)) : nullptr;
+		uint32_t instanceOffset = 0;
+		PipelineMaterial *boundPipeline = nullptr;
+
+		for (std::size_t i = 0; i < m_order.size();)
+		{
+			const auto &draw = m_draws[m_order[i]];
+			auto end = i + 1;
+
+			if (draw.instanced)
+			{
+				while (end < m_order.size() && IsSameBatch(draw, m_draws[m_order[end]]))
+				{
+					end++;
+				}
+			}
+
+			auto count = static_cast<uint32_t>(end - i);
+
+			// Binds the material pipeline.
+			if (draw.pipelineMaterial != boundPipeline)
+			{
+				if (!draw.pipelineMaterial->BindPipeline(commandBuffer))
+				{
+					boundPipeline = nullptr;
+					i = end;
+					continue;
+				}
+
+				boundPipeline = draw.pipelineMaterial;
+				m_bindCount++;
+			}
+
+			if (draw.instanced)
+			{
+				for (std::size_t j = i; j < end; j++)
+				{
+					instances[instanceOffset + j - i].transform = m_draws[m_order[j]].transform;
+				}
+
+				VkBuffer instanceBuffer = m_instanceBuffer.GetBuffer();
+				VkDeviceSize offset = m_instanceBuffer.GetOffset() + instanceOffset * sizeof(Instance);
+				vkCmdBindVertexBuffers(commandBuffer.GetCommandBuffer(), INSTANCE_BINDING, 1, &instanceBuffer, &offset);
+				instanceOffset += count;
+			}
+
+			// The first mesh records the batch with its own descriptors, the others push the same descriptors apart from their transform.
+			if (draw.meshRender->CmdRender(commandBuffer, uniformScene, *boundPipeline->GetPipeline(), count))
+			{
+				m_drawCount++;
+				m_bindCount++;
+				m_instanceCount += count;
+			}
+
+			i = end;
+		}
+	}
+
+	Shader::VertexInput RenderQueue::GetVertexInput(const uint32_t &binding)
+	{
+		std::vector<VkVertexInputBindingDescription> bindingDescriptions(1);
+
+		// The vertex input description.
+		bindingDescriptions[0].binding = binding;
+		bindingDescriptions[0].stride = sizeof(Instance);
+		bindingDescriptions[0].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+
+		std::vector<VkVertexInputAttributeDescription> attributeDescriptions(4);
+
+		// Transform rows attributes.
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			attributeDescriptions[i].binding = binding;
+			attributeDescriptions[i].location = i;
+			attributeDescriptions[i].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+			attributeDescriptions[i].offset = offsetof(Instance, transform) + offsetof(Matrix4, m_rows) + i * sizeof(Vector4);
+		}
+
+		return Shader::VertexInput(binding, bindingDescriptions, attributeDescriptions);
+	}
+
+	uint64_t RenderQueue::GetId(std::unordered_map<std::size_t, uint64_t> &ids, const std::size_t &key, const uint64_t &maxId)
+	{
+		auto it = ids.find(key);
+
+		if (it != ids.end())
+		{
+			return it->second;
+		}
+
+		// Past the last id everything shares it, batches are still only merged when their draws match.
+		auto id = std::min(static_cast<uint64_t>(ids.size()), maxId);
+		ids.emplace(key, id);
+		return id;
+	}
+
+	bool RenderQueue::IsSameBatch(const Draw &a, const Draw &b) const
+	{
+		return a.instanced && b.instanced && a.pipelineMaterial == b.pipelineMaterial && a.batchKey == b.batchKey && a.model == b.model;
+	}
+
+	void RenderQueue::RadixSort()
+	{
+		auto size = m_keys.size();
+		std::array<std::array<std::size_t, 256>, 8> counts = {};
+
+		for (const auto &key : m_keys)
+		{
+			for (uint32_t pass = 0; pass < 8; pass++)
+			{
+				counts[pass][(key >> (8 * pass)) & 0xFF]++;
+			}
+		}
+
+		m_scratchKeys.resize(size);
+		m_scratchOrder.resize(size);
+
+		for (uint32_t pass = 0; pass < 8; pass++)
+		{
+			auto &count = counts[pass];
+			auto shift = 8 * pass;
+
+			// Every key has the same digit, this pass would not change the order.
+			if (count[(m_keys[0] >> shift) & 0xFF] == size)
+			{
+				continue;
+			}
+
+			std::size_t offset = 0;
+
+			for (auto &bucket : count)
+			{
+				auto bucketSize = bucket;
+				bucket = offset;
+				offset += bucketSize;
+			}
+
+			for (std::size_t i = 0; i < size; i++)
+			{
+				auto destination = count[(m_keys[i] >> shift) & 0xFF]++;
+				m_scratchKeys[destination] = m_keys[i];
+				m_scratchOrder[destination] = m_order[i];
+			}
+
+			std::swap(m_keys, m_scratchKeys);
+			std::swap(m_order, m_scratchOrder);
+		}
+	}
+}
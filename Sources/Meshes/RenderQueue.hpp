@@ -0,0 +1,140 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include "Maths/Matrix4.hpp"
+#include "Renderer/Buffers/DynamicInstanceBuffer.hpp"
+#include "Renderer/Handlers/UniformHandler.hpp"
+#include "Renderer/Pipelines/Pipeline.hpp"
+
+namespace acid
+{
+	class Frustum;
+	class Material;
+	class MeshRender;
+	class Model;
+	class PipelineMaterial;
+
+	/// <summary>
+	/// Collects the visible meshes of a render stage, sorts them by a 64 bit key and records them.
+	/// The key packs the pipeline, the material and the model above the depth, so state changes are grouped together.
+	/// Neighbouring meshes with instanced materials that share a pipeline, material key and model are drawn as one instanced draw.
+	/// </summary>
+	class ACID_EXPORT RenderQueue :
+		public NonCopyable
+	{
+	public:
+		enum class Sort
+		{
+			None, Front, Back
+		};
+
+		/// <summary>
+		/// Creates a new render queue.
+		/// </summary>
+		/// <param name="sort"> How meshes are sorted by depth, front to back groups by state first while back to front groups by depth first. </param>
+		explicit RenderQueue(const Sort &sort = Sort::None);
+
+		/// <summary>
+		/// Removes every mesh added since the queue was last recorded.
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Adds a mesh to the queue if it is in the stage, meshes are culled together by <seealso cref="#Cull()"/>.
+		/// </summary>
+		/// <param name="meshRender"> The mesh render to add. </param>
+		/// <param name="pipelineStage"> The stage being recorded. </param>
+		void Add(MeshRender *meshRender, const Pipeline::Stage &pipelineStage);
+
+		/// <summary>
+		/// Removes the added meshes that are out of view in one batched test, then builds the sort keys of the meshes left.
+		/// </summary>
+		/// <param name="frustum"> The frustum to cull the meshes against. </param>
+		/// <param name="cameraPosition"> The position depth is measured from. </param>
+		void Cull(const Frustum &frustum, const Vector3 &cameraPosition);
+
+		/// <summary>
+		/// Sorts the meshes in the queue and records them.
+		/// </summary>
+		/// <param name="commandBuffer"> The command buffer to record into. </param>
+		/// <param name="uniformScene"> The scene uniform handler. </param>
+		void CmdRender(const CommandBuffer &commandBuffer, UniformHandler &uniformScene);
+
+		/// <summary>
+		/// Gets the draw calls recorded the last time the queue was recorded.
+		/// </summary>
+		/// <returns> The draw count. </returns>
+		const uint32_t &GetDrawCount() const { return m_drawCount; }
+
+		/// <summary>
+		/// Gets the pipeline and descriptor set binds recorded the last time the queue was recorded.
+		/// </summary>
+		/// <returns> The bind count. </returns>
+		const uint32_t &GetBindCount() const { return m_bindCount; }
+
+		/// <summary>
+		/// Gets the meshes drawn the last time the queue was recorded, the draw count is less than this when meshes were instanced.
+		/// </summary>
+		/// <returns> The instance count. </returns>
+		const uint32_t &GetInstanceCount() const { return m_instanceCount; }
+
+		static Shader::VertexInput GetVertexInput(const uint32_t &binding = 0);
+	private:
+		/// <summary>
+		/// The per instance data, read by instanced materials in place of the object transform uniform.
+		/// </summary>
+		struct Instance
+		{
+			Matrix4 transform;
+		};
+
+		struct Draw
+		{
+			MeshRender *meshRender;
+			Model *model;
+			Material *material;
+			PipelineMaterial *pipelineMaterial;
+			bool instanced;
+			std::size_t batchKey;
+			Matrix4 transform;
+		};
+
+		uint64_t GetId(std::unordered_map<std::size_t, uint64_t> &ids, const std::size_t &key, const uint64_t &maxId);
+
+		bool IsSameBatch(const Draw &a, const Draw &b) const;
+
+		/// <summary>
+		/// Least significant digit radix sorts the keys and order, in 8 bit passes that are skipped when every key has the same digit.
+		/// </summary>
+		void RadixSort();
+
+		Sort m_sort;
+		std::vector<Draw> m_draws;
+
+		// The bounds of each draw as a structure of arrays, meshes without bounds are given the largest box so they are never culled.
+		std::vector<float> m_minX;
+		std::vector<float> m_minY;
+		std::vector<float> m_minZ;
+		std::vector<float> m_maxX;
+		std::vector<float> m_maxY;
+		std::vector<float> m_maxZ;
+		std::vector<uint64_t> m_visible;
+
+		std::vector<uint64_t> m_keys;
+		std::vector<uint32_t> m_order;
+		std::vector<uint64_t> m_scratchKeys;
+		std::vector<uint32_t> m_scratchOrder;
+
+		// The pipelines, materials and models seen this frame, numbered in the order they were first added.
+		std::unordered_map<std::size_t, uint64_t> m_pipelineIds;
+		std::unordered_map<std::size_t, uint64_t> m_materialIds;
+		std::unordered_map<std::size_t, uint64_t> m_modelIds;
+
+		DynamicInstanceBuffer m_instanceBuffer;
+
+		uint32_t m_drawCount;
+		uint32_t m_bindCount;
+		uint32_t m_instanceCount;
+	};
+}
@@ -7,8 +7,8 @@ namespace acid
 {
 	RendererMeshes::RendererMeshes(const Pipeline::Stage &pipelineStage, const Sort &sort) :
 		RenderPipeline(pipelineStage),
-		m_sort(sort),
-		m_uniformScene(true)
+		m_uniformScene(true),
+		m_renderQueue(sort)
 	{
 	}
 
@@ -20,20 +20,15 @@ namespace acid
 		m_uniformScene.Push("cameraPos", camera->GetPosition());
 
 		auto sceneMeshRenders = Scenes::Get()->GetStructure()->QueryComponents<MeshRender>();
-
-		if (m_sort != Sort::None)
-		{
-			std::sort(sceneMeshRenders.begin(), sceneMeshRenders.end());
-
-			if (m_sort == Sort::Front)
-			{
-				std::reverse(sceneMeshRenders.begin(), sceneMeshRenders.end());
-			}
-		}
+		m_renderQueue.Clear();
 
 		for (const auto &meshRender : sceneMeshRenders)
 		{
-			meshRender->CmdRender(commandBuffer, m_uniformScene, GetStage());
+			m_renderQueue.Add(meshRender, GetStage());
 		}
+
+		m_renderQueue.Cull(camera->GetViewFrustum(), camera->GetPosition());
+
+		m_renderQueue.CmdRender(commandBuffer, m_uniformScene);
 	}
 }
@@ -3,6 +3,7 @@
 #include "Renderer/RenderPipeline.hpp"
 #include "Renderer/Handlers/UniformHandler.hpp"
 #include "Renderer/Pipelines/PipelineGraphics.hpp"
+#include "RenderQueue.hpp"
 
 namespace acid
 {
@@ -10,16 +11,21 @@ namespace acid
 		public RenderPipeline
 	{
 	public:
-		enum class Sort
-		{
-			None, Front, Back
-		};
+		using Sort = RenderQueue::Sort;
 
 		explicit RendererMeshes(const Pipeline::Stage &pipelineStage, const Sort &sort = Sort::None);
 
 		void Render(const CommandBuffer &commandBuffer) override;
+
+		bool IsParallel() const override { return true; }
+
+		/// <summary>
+		/// Gets the queue meshes are recorded from, which counts the draws, binds and instances of the last frame.
+		/// </summary>
+		/// <returns> The render queue. </returns>
+		const RenderQueue &GetRenderQueue() const { return m_renderQueue; }
 	private:
-		Sort m_sort;
 		UniformHandler m_uniformScene;
+		RenderQueue m_renderQueue;
 	};
 }
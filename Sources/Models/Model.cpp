@@ -1,6 +1,7 @@
 #include "Model.hpp"
 
 #include <cassert>
+#include "Renderer/Renderer.hpp"
 #include "Scenes/Scenes.hpp"
 #include "Resources/Resources.hpp"
 
@@ -21,12 +22,24 @@ namespace acid
 		m_indexBuffer(nullptr),
 		m_vertexCount(0),
 		m_indexCount(0),
+		m_upload(0),
 		m_radius(0.0f)
 	{
 	}
 
+	Model::~Model()
+	{
+		// The buffers can not be destroyed while a upload is still writing to them.
+		Renderer::Get()->GetUploadQueue()->Wait(m_upload);
+	}
+
 	bool Model::CmdRender(const CommandBuffer &commandBuffer, const uint32_t &instances) const
 	{
+		if (!IsLoaded())
+		{
+			return false;
+		}
+
 		if (m_vertexBuffer != nullptr && m_indexBuffer != nullptr)
 		{
 			VkBuffer vertexBuffers[] = {m_vertexBuffer->GetBuffer()};
@@ -63,6 +76,28 @@ namespace acid
 	{
 	}
 
+	std::size_t Model::GetByteSize() const
+	{
+		std::size_t result = 0;
+
+		if (m_vertexBuffer != nullptr)
+		{
+			result += m_vertexBuffer->GetSize();
+		}
+
+		if (m_indexBuffer != nullptr)
+		{
+			result += m_indexBuffer->GetSize();
+		}
+
+		return result;
+	}
+
+	bool Model::IsLoaded() const
+	{
+		return Renderer::Get()->GetUploadQueue()->IsSubmitted(m_upload);
+	}
+
 	std::vector<float> Model::GetPointCloud() const
 	{
 		if (m_vertexBuffer == nullptr)
@@ -75,4 +110,31 @@ namespace acid
 		m_vertexBuffer->Unmap();
 		return result;
 	}
+
+	void Model::InitializeBuffers(const void *vertices, const VkDeviceSize &vertexSize, const uint32_t &vertexCount, const std::vector<uint32_t> &indices)
+	{
+		auto uploadQueue = Renderer::Get()->GetUploadQueue();
+
+		// Buffers being replaced may still be the destination of a upload.
+		uploadQueue->Wait(m_upload);
+
+		m_vertexBuffer = nullptr;
+		m_indexBuffer = nullptr;
+		m_upload = 0;
+
+		if (vertexSize != 0)
+		{
+			m_vertexBuffer = std::make_unique<Buffer>(vertexSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+			m_vertexCount = vertexCount;
+			m_upload = uploadQueue->UploadBuffer(*m_vertexBuffer, vertices, vertexSize);
+		}
+
+		if (!indices.empty())
+		{
+			VkDeviceSize indexSize = sizeof(uint32_t) * indices.size();
+			m_indexBuffer = std::make_unique<Buffer>(indexSize, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+			m_indexCount = static_cast<uint32_t>(indices.size());
+			m_upload = std::max(m_upload, uploadQueue->UploadBuffer(*m_indexBuffer, indices.data(), indexSize));
+		}
+	}
 }
@@ -6,6 +6,7 @@
 #include <vector>
 #include "Maths/Vector3.hpp"
 #include "Renderer/Buffers/Buffer.hpp"
+#include "Renderer/Commands/UploadQueue.hpp"
 #include "Resources/Resource.hpp"
 #include "IVertex.hpp"
 
@@ -40,6 +41,14 @@ namespace acid
 			Initialize(vertices, indices);
 		}
 
+		~Model();
+
+		/// <summary>
+		/// Draws the model, nothing is drawn until <seealso cref="#IsLoaded()"/>.
+		/// </summary>
+		/// <param name="commandBuffer"> The command buffer to record into. </param>
+		/// <param name="instances"> The amount of instances to draw. </param>
+		/// <returns> If the model was drawn. </returns>
 		bool CmdRender(const CommandBuffer &commandBuffer, const uint32_t &instances = 1) const;
 
 		void Load() override;
@@ -48,6 +57,8 @@ namespace acid
 
 		void Encode(Metadata &metadata) const override;
 
+		std::size_t GetByteSize() const override;
+
 		std::vector<float> GetPointCloud() const;
 
 		const Vector3 &GetMinExtents() const { return m_minExtents; }
@@ -71,46 +82,19 @@ namespace acid
 		const uint32_t &GetIndexCount() const { return m_indexCount; }
 
 		VkIndexType GetIndexType() const { return VK_INDEX_TYPE_UINT32; }
+
+		/// <summary>
+		/// Gets if the vertex and index data have been submitted to the device, until then the model is not drawn.
+		/// </summary>
+		/// <returns> If the model is ready to be drawn in a frame. </returns>
+		bool IsLoaded() const;
 	protected:
 		template<typename T>
 		void Initialize(const std::vector<T> &vertices, const std::vector<uint32_t> &indices = {})
 		{
 			static_assert(std::is_base_of<IVertex, T>::value, "T must derive from IVertex!");
 
-			m_vertexBuffer = nullptr;
-			m_indexBuffer = nullptr;
-
-			if (!vertices.empty())
-			{
-				auto vertexStaging = Buffer(sizeof(T) * vertices.size(), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, vertices.data());
-				m_vertexBuffer = std::make_unique<Buffer>(sizeof(T) * vertices.size(), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-				m_vertexCount = vertices.size();
-
-				CommandBuffer commandBuffer = CommandBuffer();
-
-				VkBufferCopy copyRegion = {};
-				copyRegion.size = sizeof(T) * vertices.size();
-				vkCmdCopyBuffer(commandBuffer.GetCommandBuffer(), vertexStaging.GetBuffer(), m_vertexBuffer->GetBuffer(), 1, &copyRegion);
-
-				commandBuffer.End();
-				commandBuffer.SubmitIdle();
-			}
-
-			if (!indices.empty())
-			{
-				auto indexStaging = Buffer(sizeof(uint32_t) * indices.size(), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, indices.data());
-				m_indexBuffer = std::make_unique<Buffer>(sizeof(uint32_t) * indices.size(), VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-				m_indexCount = indices.size();
-
-				CommandBuffer commandBuffer = CommandBuffer();
-
-				VkBufferCopy copyRegion = {};
-				copyRegion.size = sizeof(uint32_t) * indices.size();
-				vkCmdCopyBuffer(commandBuffer.GetCommandBuffer(), indexStaging.GetBuffer(), m_indexBuffer->GetBuffer(), 1, &copyRegion);
-
-				commandBuffer.End();
-				commandBuffer.SubmitIdle();
-			}
+			InitializeBuffers(vertices.data(), sizeof(T) * vertices.size(), static_cast<uint32_t>(vertices.size()), indices);
 
 			m_minExtents = Vector3::PositiveInfinity;
 			m_maxExtents = Vector3::NegativeInfinity;
@@ -130,10 +114,16 @@ namespace acid
 			m_radius = std::max(min0, std::max(min1, std::max(max0, max1)));
 		}
 	private:
+		/// <summary>
+		/// Creates the device local buffers and records their copies into the upload queue, the data is staged before this returns.
+		/// </summary>
+		void InitializeBuffers(const void *vertices, const VkDeviceSize &vertexSize, const uint32_t &vertexCount, const std::vector<uint32_t> &indices);
+
 		std::unique_ptr<Buffer> m_vertexBuffer;
 		std::unique_ptr<Buffer> m_indexBuffer;
 		uint32_t m_vertexCount;
 		uint32_t m_indexCount;
+		UploadQueue::Ticket m_upload;
 
 		Vector3 m_minExtents;
 		Vector3 m_maxExtents;
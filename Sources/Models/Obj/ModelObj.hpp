@@ -1,10 +1,6 @@
 #pragma once
 
-#include <array>
-#include "Helpers/String.hpp"
 #include "Models/Model.hpp"
-#include "Models/VertexModel.hpp"
-#include "Models/VertexModelData.hpp"
 
 namespace acid
 {
@@ -40,14 +36,6 @@ namespace acid
 
 		void Encode(Metadata &metadata) const override;
 	private:
-		static VertexModelData *ProcessDataVertex(const uint32_t &vertexIndex, const std::optional<uint32_t> &uvIndex, const uint32_t &normalIndex, 
-			std::vector<std::unique_ptr<VertexModelData>> &vertices, std::vector<uint32_t> &indices);
-
-		static VertexModelData *DealWithAlreadyProcessedDataVertex(VertexModelData *previousVertex, const std::optional<uint32_t> &newUvIndex, const uint32_t &newNormalIndex,
-			std::vector<std::unique_ptr<VertexModelData>> &vertices, std::vector<uint32_t> &indices);
-
-		static void CalculateTangents(VertexModelData *v0, VertexModelData *v1, VertexModelData *v2, std::vector<Vector2> &uvs);
-
 		std::string m_filename;
 	};
 }
@@ -0,0 +1,643 @@
+#include "ObjParser.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ACID_OBJ_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace acid
+{
+	static const uint32_t MISSING_INDEX = 0xFFFFFFFF;
+
+	const std::size_t ObjParser::MinChunkSize = 1 << 20;
+
+	/// <summary>
+	/// The position, uv and normal index of a triangle corner, also used as the key when merging vertices.
+	/// </summary>
+	struct ObjCorner
+	{
+		uint32_t m_position;
+		uint32_t m_uv;
+		uint32_t m_normal;
+
+		bool operator==(const ObjCorner &other) const { return m_position == other.m_position && m_uv == other.m_uv && m_normal == other.m_normal; }
+	};
+
+	/// <summary>
+	/// A range of lines parsed by one thread. The elements in the range are counted first, so every chunk knows where to write its elements into the shared arrays.
+	/// </summary>
+	struct ObjChunk
+	{
+		const char *m_begin;
+		const char *m_end;
+		uint32_t m_positionCount;
+		uint32_t m_uvCount;
+		uint32_t m_normalCount;
+		uint32_t m_triangleCount;
+		uint32_t m_positionBase;
+		uint32_t m_uvBase;
+		uint32_t m_normalBase;
+		uint32_t m_triangleBase;
+	};
+
+	static const char *SkipSpaces(const char *it, const char *end)
+	{
+		while (it < end && (*it == ' ' || *it == '\t'))
+		{
+			++it;
+		}
+
+		return it;
+	}
+
+	static bool IsDigit(const char &c)
+	{
+		return c >= '0' && c <= '9';
+	}
+
+	/// <summary>
+	/// The kinds of OBJ line that are parsed, other lines such as objects, groups and materials are skipped.
+	/// </summary>
+	enum class ObjLine
+	{
+		Position, Uv, Normal, Face, Other
+	};
+
+	/// <summary>
+	/// Finds the kind of a line from its keyword.
+	/// </summary>
+	/// <param name="it"> The start of the line, moved past the keyword. </param>
+	/// <param name="lineEnd"> The end of the line. </param>
+	/// <returns> The kind of line. </returns>
+	static ObjLine ClassifyLine(const char *&it, const char *lineEnd)
+	{
+		auto isSpace = [lineEnd](const char *c)
+		{
+			return c < lineEnd && (*c == ' ' || *c == '\t');
+		};
+
+		it = SkipSpaces(it, lineEnd);
+
+		if (it == lineEnd)
+		{
+			return ObjLine::Other;
+		}
+
+		if (it[0] == 'f' && isSpace(it + 1))
+		{
+			it += 1;
+			return ObjLine::Face;
+		}
+
+		if (it[0] != 'v')
+		{
+			return ObjLine::Other;
+		}
+
+		if (isSpace(it + 1))
+		{
+			it += 1;
+			return ObjLine::Position;
+		}
+
+		if (it + 1 < lineEnd && isSpace(it + 2))
+		{
+			it += 2;
+			return it[-1] == 't' ? ObjLine::Uv : it[-1] == 'n' ? ObjLine::Normal : ObjLine::Other;
+		}
+
+		return ObjLine::Other;
+	}
+
+	/// <summary>
+	/// Runs a function on each chunk, each chunk is a job for the job system.
+	/// </summary>
+	static void ForEachChunk(std::vector<ObjChunk> &chunks, JobSystem *jobSystem, const std::function<void(ObjChunk &)> &function)
+	{
+		if (chunks.size() == 1)
+		{
+			function(chunks[0]);
+			return;
+		}
+
+		jobSystem->ParallelFor(0, chunks.size(), 1, [&function, &chunks](const std::size_t &begin, const std::size_t &end)
+		{
+			for (auto i = begin; i < end; i++)
+			{
+				function(chunks[i]);
+			}
+		});
+	}
+
+	/// <summary>
+	/// Calls a function for each line in a range, the line excludes the new line character.
+	/// </summary>
+	template<typename F>
+	static void ForEachLine(const char *begin, const char *end, F function)
+	{
+		for (auto it = begin; it < end;)
+		{
+			auto lineEnd = static_cast<const char *>(std::memchr(it, '\n', end - it));
+
+			if (lineEnd == nullptr)
+			{
+				lineEnd = end;
+			}
+
+			function(it, lineEnd);
+			it = lineEnd + 1;
+		}
+	}
+
+	/// <summary>
+	/// Calls a function for each corner token in the rest of a face line, stopping at the end of the line or a comment.
+	/// </summary>
+	template<typename F>
+	static void ForEachCorner(const char *it, const char *lineEnd, F function)
+	{
+		while (true)
+		{
+			it = SkipSpaces(it, lineEnd);
+
+			if (it == lineEnd || *it == '\r' || *it == '#')
+			{
+				return;
+			}
+
+			auto tokenEnd = it;
+
+			while (tokenEnd < lineEnd && *tokenEnd != ' ' && *tokenEnd != '\t' && *tokenEnd != '\r')
+			{
+				++tokenEnd;
+			}
+
+			function(it, tokenEnd);
+			it = tokenEnd;
+		}
+	}
+
+	/// <summary>
+	/// Converts a OBJ index to a index in the shared arrays, OBJ indices start at 1 and negative indices count back from the last element read.
+	/// </summary>
+	static uint32_t ResolveIndex(const int32_t &index, const uint32_t &countRead, const uint32_t &count)
+	{
+		int64_t resolved = index > 0 ? index - 1 : static_cast<int64_t>(countRead) + index;
+
+		if (index == 0 || resolved < 0 || resolved >= count)
+		{
+			return MISSING_INDEX;
+		}
+
+		return static_cast<uint32_t>(resolved);
+	}
+
+	static void CountChunk(ObjChunk &chunk)
+	{
+		ForEachLine(chunk.m_begin, chunk.m_end, [&chunk](const char *it, const char *lineEnd)
+		{
+			switch (ClassifyLine(it, lineEnd))
+			{
+			case ObjLine::Position:
+				chunk.m_positionCount++;
+				break;
+			case ObjLine::Uv:
+				chunk.m_uvCount++;
+				break;
+			case ObjLine::Normal:
+				chunk.m_normalCount++;
+				break;
+			case ObjLine::Face:
+			{
+				uint32_t corners = 0;
+				ForEachCorner(it, lineEnd, [&corners](const char *, const char *)
+				{
+					corners++;
+				});
+				chunk.m_triangleCount += corners > 2 ? corners - 2 : 0;
+				break;
+			}
+			default:
+				break;
+			}
+		});
+	}
+
+	static void ParseChunk(ObjChunk &chunk, std::vector<Vector3> &positions, std::vector<Vector2> &uvs, std::vector<Vector3> &normals, std::vector<ObjCorner> &corners)
+	{
+		auto positionsRead = chunk.m_positionBase;
+		auto uvsRead = chunk.m_uvBase;
+		auto normalsRead = chunk.m_normalBase;
+		auto cornersWritten = static_cast<std::size_t>(chunk.m_triangleBase) * 3;
+
+		ForEachLine(chunk.m_begin, chunk.m_end, [&](const char *it, const char *lineEnd)
+		{
+			switch (ClassifyLine(it, lineEnd))
+			{
+			case ObjLine::Position:
+			{
+				auto x = ObjParser::ScanFloat(it, lineEnd);
+				auto y = ObjParser::ScanFloat(it, lineEnd);
+				auto z = ObjParser::ScanFloat(it, lineEnd);
+				positions[positionsRead++] = Vector3(x, y, z);
+				break;
+			}
+			case ObjLine::Uv:
+			{
+				auto u = ObjParser::ScanFloat(it, lineEnd);
+				auto v = ObjParser::ScanFloat(it, lineEnd);
+				uvs[uvsRead++] = Vector2(u, 1.0f - v);
+				break;
+			}
+			case ObjLine::Normal:
+			{
+				auto x = ObjParser::ScanFloat(it, lineEnd);
+				auto y = ObjParser::ScanFloat(it, lineEnd);
+				auto z = ObjParser::ScanFloat(it, lineEnd);
+				normals[normalsRead++] = Vector3(x, y, z);
+				break;
+			}
+			case ObjLine::Face:
+			{
+				// Polygons are split into a fan of triangles around the first corner.
+				uint32_t cornerCount = 0;
+				ObjCorner first = {};
+				ObjCorner previous = {};
+
+				ForEachCorner(it, lineEnd, [&](const char *token, const char *tokenEnd)
+				{
+					int32_t position = ObjParser::ScanInt(token, tokenEnd);
+					int32_t uv = 0;
+					int32_t normal = 0;
+
+					if (token < tokenEnd && *token == '/')
+					{
+						++token;
+
+						if (token < tokenEnd && *token != '/')
+						{
+							uv = ObjParser::ScanInt(token, tokenEnd);
+						}
+
+						if (token < tokenEnd && *token == '/')
+						{
+							++token;
+							normal = ObjParser::ScanInt(token, tokenEnd);
+						}
+					}
+
+					ObjCorner corner = {ResolveIndex(position, positionsRead, static_cast<uint32_t>(positions.size())),
+						ResolveIndex(uv, uvsRead, static_cast<uint32_t>(uvs.size())), ResolveIndex(normal, normalsRead, static_cast<uint32_t>(normals.size()))};
+
+					if (cornerCount == 0)
+					{
+						first = corner;
+					}
+					else if (cornerCount >= 2)
+					{
+						corners[cornersWritten++] = first;
+						corners[cornersWritten++] = previous;
+						corners[cornersWritten++] = corner;
+					}
+
+					previous = corner;
+					cornerCount++;
+				});
+				break;
+			}
+			default:
+				break;
+			}
+		});
+	}
+
+	/// <summary>
+	/// Merges corners with the same position, uv and normal into one vertex, using a open addressing hash table of vertex indices.
+	/// </summary>
+	static void MergeCorners(const std::vector<ObjCorner> &corners, std::vector<ObjCorner> &uniqueCorners, std::vector<uint32_t> &indices)
+	{
+		auto hash = [](const ObjCorner &corner)
+		{
+			uint64_t key = (static_cast<uint64_t>(corner.m_position) * 0x9E3779B97F4A7C15ull) ^ (static_cast<uint64_t>(corner.m_uv) * 0xC2B2AE3D27D4EB4Full) ^
+				(static_cast<uint64_t>(corner.m_normal) * 0x165667B19E3779F9ull);
+			return static_cast<std::size_t>(key ^ (key >> 29));
+		};
+
+		std::size_t capacity = 1024;
+		std::vector<uint32_t> slots(capacity, MISSING_INDEX);
+		indices.resize(corners.size());
+
+		for (std::size_t i = 0; i < corners.size(); i++)
+		{
+			// Keeps the table at most half full, rehashing the unique corners when it grows.
+			if (uniqueCorners.size() * 2 >= capacity)
+			{
+				capacity *= 2;
+				slots.assign(capacity, MISSING_INDEX);
+
+				for (uint32_t j = 0; j < uniqueCorners.size(); j++)
+				{
+					auto slot = hash(uniqueCorners[j]) & (capacity - 1);
+
+					while (slots[slot] != MISSING_INDEX)
+					{
+						slot = (slot + 1) & (capacity - 1);
+					}
+
+					slots[slot] = j;
+				}
+			}
+
+			const auto &corner = corners[i];
+			auto slot = hash(corner) & (capacity - 1);
+
+			while (slots[slot] != MISSING_INDEX && !(uniqueCorners[slots[slot]] == corner))
+			{
+				slot = (slot + 1) & (capacity - 1);
+			}
+
+			if (slots[slot] == MISSING_INDEX)
+			{
+				slots[slot] = static_cast<uint32_t>(uniqueCorners.size());
+				uniqueCorners.emplace_back(corner);
+			}
+
+			indices[i] = slots[slot];
+		}
+	}
+
+	/// <summary>
+	/// Sums the tangent of every triangle into its vertices, triangles without uvs add nothing.
+	/// </summary>
+	static void SumTangents(const std::vector<Vector3> &positions, const std::vector<Vector2> &uvs, const std::vector<uint8_t> &hasUvs,
+		const std::vector<uint32_t> &indices, std::vector<Vector3> &tangents)
+	{
+		auto triangleCount = indices.size() / 3;
+		std::size_t triangle = 0;
+
+		auto addTangent = [&](const std::size_t &t, const float &x, const float &y, const float &z)
+		{
+			for (std::size_t corner = 0; corner < 3; corner++)
+			{
+				auto &tangent = tangents[indices[t * 3 + corner]];
+				tangent.m_x += x;
+				tangent.m_y += y;
+				tangent.m_z += z;
+			}
+		};
+
+#if defined(ACID_OBJ_SSE2)
+		// Four triangles at a time, the corners are gathered into lanes then the tangents are scattered back.
+		auto vZero = _mm_setzero_ps();
+		auto vOne = _mm_set1_ps(1.0f);
+		alignas(16) float tangentX[4], tangentY[4], tangentZ[4];
+
+		for (; triangle + 4 <= triangleCount; triangle += 4)
+		{
+			const uint32_t *i = &indices[triangle * 3];
+#define ACID_OBJ_GATHER(array, corner, member) _mm_setr_ps(array[i[corner]].member, array[i[3 + corner]].member, array[i[6 + corner]].member, array[i[9 + corner]].member)
+			auto p0x = ACID_OBJ_GATHER(positions, 0, m_x), p0y = ACID_OBJ_GATHER(positions, 0, m_y), p0z = ACID_OBJ_GATHER(positions, 0, m_z);
+			auto deltaPos1x = _mm_sub_ps(ACID_OBJ_GATHER(positions, 1, m_x), p0x);
+			auto deltaPos1y = _mm_sub_ps(ACID_OBJ_GATHER(positions, 1, m_y), p0y);
+			auto deltaPos1z = _mm_sub_ps(ACID_OBJ_GATHER(positions, 1, m_z), p0z);
+			auto deltaPos2x = _mm_sub_ps(ACID_OBJ_GATHER(positions, 2, m_x), p0x);
+			auto deltaPos2y = _mm_sub_ps(ACID_OBJ_GATHER(positions, 2, m_y), p0y);
+			auto deltaPos2z = _mm_sub_ps(ACID_OBJ_GATHER(positions, 2, m_z), p0z);
+			auto uv0x = ACID_OBJ_GATHER(uvs, 0, m_x), uv0y = ACID_OBJ_GATHER(uvs, 0, m_y);
+			auto deltaUv1x = _mm_sub_ps(ACID_OBJ_GATHER(uvs, 1, m_x), uv0x);
+			auto deltaUv1y = _mm_sub_ps(ACID_OBJ_GATHER(uvs, 1, m_y), uv0y);
+			auto deltaUv2x = _mm_sub_ps(ACID_OBJ_GATHER(uvs, 2, m_x), uv0x);
+			auto deltaUv2y = _mm_sub_ps(ACID_OBJ_GATHER(uvs, 2, m_y), uv0y);
+#undef ACID_OBJ_GATHER
+			auto textured = _mm_setr_ps(hasUvs[i[0]] & hasUvs[i[1]] & hasUvs[i[2]], hasUvs[i[3]] & hasUvs[i[4]] & hasUvs[i[5]],
+				hasUvs[i[6]] & hasUvs[i[7]] & hasUvs[i[8]], hasUvs[i[9]] & hasUvs[i[10]] & hasUvs[i[11]]);
+
+			// Triangles with degenerate uvs or without uvs get a scale of zero.
+			auto determinant = _mm_sub_ps(_mm_mul_ps(deltaUv1x, deltaUv2y), _mm_mul_ps(deltaUv1y, deltaUv2x));
+			auto valid = _mm_and_ps(_mm_cmpneq_ps(determinant, vZero), _mm_cmpeq_ps(textured, vOne));
+			auto r = _mm_and_ps(valid, _mm_div_ps(vOne, _mm_or_ps(determinant, _mm_andnot_ps(valid, vOne))));
+
+			_mm_store_ps(tangentX, _mm_mul_ps(r, _mm_sub_ps(_mm_mul_ps(deltaPos1x, deltaUv2y), _mm_mul_ps(deltaPos2x, deltaUv1y))));
+			_mm_store_ps(tangentY, _mm_mul_ps(r, _mm_sub_ps(_mm_mul_ps(deltaPos1y, deltaUv2y), _mm_mul_ps(deltaPos2y, deltaUv1y))));
+			_mm_store_ps(tangentZ, _mm_mul_ps(r, _mm_sub_ps(_mm_mul_ps(deltaPos1z, deltaUv2y), _mm_mul_ps(deltaPos2z, deltaUv1y))));
+
+			for (std::size_t lane = 0; lane < 4; lane++)
+			{
+				addTangent(triangle + lane, tangentX[lane], tangentY[lane], tangentZ[lane]);
+			}
+		}
+#endif
+
+		for (; triangle < triangleCount; triangle++)
+		{
+			auto i0 = indices[triangle * 3], i1 = indices[triangle * 3 + 1], i2 = indices[triangle * 3 + 2];
+
+			if (!hasUvs[i0] || !hasUvs[i1] || !hasUvs[i2])
+			{
+				continue;
+			}
+
+			auto deltaUv1 = uvs[i1] - uvs[i0];
+			auto deltaUv2 = uvs[i2] - uvs[i0];
+			auto determinant = deltaUv1.m_x * deltaUv2.m_y - deltaUv1.m_y * deltaUv2.m_x;
+
+			if (determinant == 0.0f)
+			{
+				continue;
+			}
+
+			auto r = 1.0f / determinant;
+			auto tangent = r * ((positions[i1] - positions[i0]) * deltaUv2.m_y - (positions[i2] - positions[i0]) * deltaUv1.m_y);
+			addTangent(triangle, tangent.m_x, tangent.m_y, tangent.m_z);
+		}
+	}
+
+	void ObjParser::Parse(const std::string_view &data, std::vector<VertexModel> &vertices, std::vector<uint32_t> &indices, JobSystem *jobSystem)
+	{
+		// Splits the text into one chunk per thread, each chunk ends after a new line.
+		std::size_t chunkCount = 1;
+
+		if (jobSystem != nullptr)
+		{
+			chunkCount = std::clamp<std::size_t>(data.size() / MinChunkSize, 1, jobSystem->GetThreadCount());
+		}
+
+		std::vector<ObjChunk> chunks(chunkCount);
+		auto begin = data.data();
+		auto end = data.data() + data.size();
+
+		for (std::size_t i = 0; i < chunkCount; i++)
+		{
+			chunks[i] = {};
+			chunks[i].m_begin = i == 0 ? begin : chunks[i - 1].m_end;
+			chunks[i].m_end = end;
+
+			if (i + 1 < chunkCount)
+			{
+				auto split = std::max(chunks[i].m_begin, begin + data.size() * (i + 1) / chunkCount);
+				auto newLine = static_cast<const char *>(std::memchr(split, '\n', end - split));
+				chunks[i].m_end = newLine == nullptr ? end : newLine + 1;
+			}
+		}
+
+		ForEachChunk(chunks, jobSystem, CountChunk);
+
+		uint32_t positionCount = 0, uvCount = 0, normalCount = 0, triangleCount = 0;
+
+		for (auto &chunk : chunks)
+		{
+			chunk.m_positionBase = positionCount;
+			chunk.m_uvBase = uvCount;
+			chunk.m_normalBase = normalCount;
+			chunk.m_triangleBase = triangleCount;
+			positionCount += chunk.m_positionCount;
+			uvCount += chunk.m_uvCount;
+			normalCount += chunk.m_normalCount;
+			triangleCount += chunk.m_triangleCount;
+		}
+
+		std::vector<Vector3> positions(positionCount);
+		std::vector<Vector2> uvs(uvCount);
+		std::vector<Vector3> normals(normalCount);
+		std::vector<ObjCorner> corners(static_cast<std::size_t>(triangleCount) * 3);
+
+		ForEachChunk(chunks, jobSystem, [&](ObjChunk &chunk)
+		{
+			ParseChunk(chunk, positions, uvs, normals, corners);
+		});
+
+		std::vector<ObjCorner> uniqueCorners;
+		uniqueCorners.reserve(positionCount);
+		MergeCorners(corners, uniqueCorners, indices);
+
+		std::vector<Vector3> vertexPositions(uniqueCorners.size());
+		std::vector<Vector2> vertexUvs(uniqueCorners.size());
+		std::vector<uint8_t> hasUvs(uniqueCorners.size());
+		std::vector<Vector3> tangents(uniqueCorners.size());
+
+		for (std::size_t i = 0; i < uniqueCorners.size(); i++)
+		{
+			const auto &corner = uniqueCorners[i];
+			vertexPositions[i] = corner.m_position == MISSING_INDEX ? Vector3::Zero : positions[corner.m_position];
+			vertexUvs[i] = corner.m_uv == MISSING_INDEX ? Vector2::Zero : uvs[corner.m_uv];
+			hasUvs[i] = corner.m_uv != MISSING_INDEX;
+		}
+
+		SumTangents(vertexPositions, vertexUvs, hasUvs, indices, tangents);
+
+		vertices.clear();
+		vertices.reserve(uniqueCorners.size());
+
+		for (std::size_t i = 0; i < uniqueCorners.size(); i++)
+		{
+			auto normal = uniqueCorners[i].m_normal == MISSING_INDEX ? Vector3::Zero : normals[uniqueCorners[i].m_normal];
+			auto tangent = tangents[i].Length() != 0.0f ? tangents[i].Normalize() : tangents[i];
+			vertices.emplace_back(vertexPositions[i], vertexUvs[i], normal, tangent);
+		}
+	}
+
+	float ObjParser::ScanFloat(const char *&it, const char *end)
+	{
+		// Powers of ten that are exact as doubles.
+		static const double powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+		it = SkipSpaces(it, end);
+		auto negative = false;
+
+		if (it < end && (*it == '-' || *it == '+'))
+		{
+			negative = *it == '-';
+			++it;
+		}
+
+		// Digits past what fits in the mantissa only change the exponent.
+		uint64_t mantissa = 0;
+		int32_t exponent = 0;
+
+		for (; it < end && IsDigit(*it); ++it)
+		{
+			if (mantissa < 100000000000000000ull)
+			{
+				mantissa = mantissa * 10 + (*it - '0');
+			}
+			else
+			{
+				exponent++;
+			}
+		}
+
+		if (it < end && *it == '.')
+		{
+			for (++it; it < end && IsDigit(*it); ++it)
+			{
+				if (mantissa < 100000000000000000ull)
+				{
+					mantissa = mantissa * 10 + (*it - '0');
+					exponent--;
+				}
+			}
+		}
+
+		if (it < end && (*it == 'e' || *it == 'E'))
+		{
+			auto exponentIt = it + 1;
+			auto exponentNegative = false;
+
+			if (exponentIt < end && (*exponentIt == '-' || *exponentIt == '+'))
+			{
+				exponentNegative = *exponentIt == '-';
+				++exponentIt;
+			}
+
+			if (exponentIt < end && IsDigit(*exponentIt))
+			{
+				int32_t value = 0;
+
+				for (; exponentIt < end && IsDigit(*exponentIt); ++exponentIt)
+				{
+					value = std::min(value * 10 + (*exponentIt - '0'), 1000);
+				}
+
+				exponent += exponentNegative ? -value : value;
+				it = exponentIt;
+			}
+		}
+
+		auto result = static_cast<double>(mantissa);
+
+		if (exponent < 0)
+		{
+			result = -exponent <= 22 ? result / powers[-exponent] : result * std::pow(10.0, exponent);
+		}
+		else if (exponent > 0)
+		{
+			result = exponent <= 22 ? result * powers[exponent] : result * std::pow(10.0, exponent);
+		}
+
+		return static_cast<float>(negative ? -result : result);
+	}
+
+	int32_t ObjParser::ScanInt(const char *&it, const char *end)
+	{
+		it = SkipSpaces(it, end);
+		auto negative = false;
+
+		if (it < end && (*it == '-' || *it == '+'))
+		{
+			negative = *it == '-';
+			++it;
+		}
+
+		int64_t result = 0;
+
+		for (; it < end && IsDigit(*it); ++it)
+		{
+			result = std::min<int64_t>(result * 10 + (*it - '0'), INT32_MAX);
+		}
+
+		return static_cast<int32_t>(negative ? -result : result);
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+#include "Threads/JobSystem.hpp"
+#include "Models/VertexModel.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// A parser for Wavefront OBJ text that builds the vertices and indices of a model.
+	/// Large files are split at line boundaries into chunks that are parsed in parallel, numbers are read with a scanner that does not allocate,
+	/// and vertices with the same position, uv and normal are merged through a hash table. Polygons are triangulated as fans.
+	/// </summary>
+	class ACID_EXPORT ObjParser
+	{
+	public:
+		/// <summary>
+		/// Files smaller than this are parsed on the calling thread.
+		/// </summary>
+		static const std::size_t MinChunkSize;
+
+		/// <summary>
+		/// Parses OBJ text.
+		/// </summary>
+		/// <param name="data"> The OBJ text. </param>
+		/// <param name="vertices"> The vector to write the merged vertices into. </param>
+		/// <param name="indices"> The vector to write the triangle indices into. </param>
+		/// <param name="jobSystem"> The job system used to parse chunks in parallel, or nullptr to parse on this thread. </param>
+		static void Parse(const std::string_view &data, std::vector<VertexModel> &vertices, std::vector<uint32_t> &indices, JobSystem *jobSystem = nullptr);
+
+		/// <summary>
+		/// Scans a float, such as "-1.5e-3", skipping leading spaces.
+		/// </summary>
+		/// <param name="it"> The position to scan from, moved past the number. </param>
+		/// <param name="end"> The end of the text. </param>
+		/// <returns> The number, or 0 if there is no number. </returns>
+		static float ScanFloat(const char *&it, const char *end);
+
+		/// <summary>
+		/// Scans a signed integer, skipping leading spaces.
+		/// </summary>
+		/// <param name="it"> The position to scan from, moved past the number. </param>
+		/// <param name="end"> The end of the text. </param>
+		/// <returns> The number, or 0 if there is no number. </returns>
+		static int32_t ScanInt(const char *&it, const char *end);
+	};
+}
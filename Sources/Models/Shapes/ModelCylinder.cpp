@@ -8,15 +8,15 @@ namespace acid
 {
 	std::shared_ptr<ModelCylinder> ModelCylinder::Create(const Metadata &metadata)
 	{
-		auto resource = Resources::Get()->Find(metadata);
+		auto resource = Resources::Get()->Find<ModelCylinder>(metadata);
 
 		if (resource != nullptr)
 		{
-			return std::dynamic_pointer_cast<ModelCylinder>(resource);
+			return resource;
 		}
 
 		auto result = std::make_shared<ModelCylinder>(0.0f, 0.0f);
-		Resources::Get()->Add(metadata, std::dynamic_pointer_cast<Resource>(result));
+		Resources::Get()->Add(metadata, result);
 		result->Decode(metadata);
 		result->Load();
 		return result;
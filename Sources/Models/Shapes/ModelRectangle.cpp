@@ -7,15 +7,15 @@ namespace acid
 {
 	std::shared_ptr<ModelRectangle> ModelRectangle::Create(const Metadata &metadata)
 	{
-		auto resource = Resources::Get()->Find(metadata);
+		auto resource = Resources::Get()->Find<ModelRectangle>(metadata);
 
 		if (resource != nullptr)
 		{
-			return std::dynamic_pointer_cast<ModelRectangle>(resource);
+			return resource;
 		}
 
 		auto result = std::make_shared<ModelRectangle>(0.0f, 0.0f);
-		Resources::Get()->Add(metadata, std::dynamic_pointer_cast<Resource>(result));
+		Resources::Get()->Add(metadata, result);
 		result->Decode(metadata);
 		result->Load();
 		return result;
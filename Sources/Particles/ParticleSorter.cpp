@@ -0,0 +1,176 @@
+#include "ParticleSorter.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace acid
+{
+	static const float KEY_MAX = static_cast<float>(std::numeric_limits<uint16_t>::max());
+	static const uint32_t TAKEN_BIT = 1 << 16;
+	// Particles that are not being sorted start taken, so they are dropped from the previous order.
+	static const uint32_t UNSORTED_KEY = TAKEN_BIT;
+	// The previous order is only fixed up when at most one in this many neighbours are out of order.
+	static const std::size_t NEARLY_SORTED_RATIO = 16;
+
+	const std::vector<uint32_t> &ParticleSorter::Sort(const std::vector<float> &distances, const std::vector<uint32_t> &indices)
+	{
+		if (indices.size() < 2)
+		{
+			m_order = indices;
+			return m_order;
+		}
+
+		// Quantizes linear depth over the range of the sorted particles, the furthest particle gets the smallest key.
+		auto minDistance = std::numeric_limits<float>::max();
+		auto maxDistance = 0.0f;
+
+		for (const auto &index : indices)
+		{
+			minDistance = std::min(minDistance, distances[index]);
+			maxDistance = std::max(maxDistance, distances[index]);
+		}
+
+		auto nearDepth = std::sqrt(minDistance);
+		auto farDepth = std::sqrt(maxDistance);
+		auto scale = farDepth > nearDepth ? KEY_MAX / (farDepth - nearDepth) : 0.0f;
+
+		// Keys are found in index order, so only the previous order is read out of order.
+		m_particleKeys.assign(distances.size(), UNSORTED_KEY);
+
+		for (const auto &index : indices)
+		{
+			auto quantized = std::min((std::sqrt(distances[index]) - nearDepth) * scale, KEY_MAX);
+			m_particleKeys[index] = static_cast<uint16_t>(KEY_MAX - quantized);
+		}
+
+		// Starts from the previous order, keeping indices that are still being sorted and appending the new ones.
+		m_scratchOrder.clear();
+		m_keys.clear();
+
+		for (const auto &index : m_order)
+		{
+			if (index < m_particleKeys.size() && (m_particleKeys[index] & TAKEN_BIT) == 0)
+			{
+				m_scratchOrder.emplace_back(index);
+				m_keys.emplace_back(static_cast<uint16_t>(m_particleKeys[index]));
+				m_particleKeys[index] |= TAKEN_BIT;
+			}
+		}
+
+		for (const auto &index : indices)
+		{
+			if ((m_particleKeys[index] & TAKEN_BIT) == 0)
+			{
+				m_scratchOrder.emplace_back(index);
+				m_keys.emplace_back(static_cast<uint16_t>(m_particleKeys[index]));
+				m_particleKeys[index] |= TAKEN_BIT;
+			}
+		}
+
+		std::swap(m_order, m_scratchOrder);
+		std::size_t descents = 0;
+
+		for (std::size_t i = 1; i < m_keys.size(); i++)
+		{
+			if (m_keys[i - 1] > m_keys[i])
+			{
+				descents++;
+			}
+		}
+
+		if (descents == 0)
+		{
+			return m_order;
+		}
+
+		if (descents * NEARLY_SORTED_RATIO > m_order.size() || !InsertionSort(m_order.size()))
+		{
+			RadixSort();
+		}
+
+		return m_order;
+	}
+
+	bool ParticleSorter::InsertionSort(const std::size_t &maxMoves)
+	{
+		std::size_t moves = 0;
+
+		for (std::size_t i = 1; i < m_keys.size(); i++)
+		{
+			auto key = m_keys[i];
+
+			if (m_keys[i - 1] <= key)
+			{
+				continue;
+			}
+
+			auto index = m_order[i];
+			auto j = i;
+
+			for (; j > 0 && m_keys[j - 1] > key; j--)
+			{
+				m_keys[j] = m_keys[j - 1];
+				m_order[j] = m_order[j - 1];
+			}
+
+			m_keys[j] = key;
+			m_order[j] = index;
+			moves += i - j;
+
+			if (moves > maxMoves)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void ParticleSorter::RadixSort()
+	{
+		auto size = m_keys.size();
+		std::array<std::array<std::size_t, 256>, 2> counts = {};
+
+		for (const auto &key : m_keys)
+		{
+			counts[0][key & 0xFF]++;
+			counts[1][key >> 8]++;
+		}
+
+		m_scratchKeys.resize(size);
+		m_scratchOrder.resize(size);
+
+		for (uint32_t pass = 0; pass < 2; pass++)
+		{
+			auto &count = counts[pass];
+			auto shift = 8 * pass;
+
+			// Every key has the same digit, this pass would not change the order.
+			if (count[(m_keys[0] >> shift) & 0xFF] == size)
+			{
+				continue;
+			}
+
+			std::size_t offset = 0;
+
+			for (auto &bucket : count)
+			{
+				auto bucketSize = bucket;
+				bucket = offset;
+				offset += bucketSize;
+			}
+
+			for (std::size_t i = 0; i < size; i++)
+			{
+				auto destination = count[(m_keys[i] >> shift) & 0xFF]++;
+				m_scratchKeys[destination] = m_keys[i];
+				m_scratchOrder[destination] = m_order[i];
+			}
+
+			std::swap(m_keys, m_scratchKeys);
+			std::swap(m_order, m_scratchOrder);
+		}
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Engine/Exports.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// Sorts particle indices back to front for alpha blending, using 16 bit quantized depths.
+	/// The order from the previous sort is used as the starting order, if it is still nearly sorted it is fixed up with a
+	/// bounded insertion sort, otherwise the indices are radix sorted.
+	/// </summary>
+	class ACID_EXPORT ParticleSorter
+	{
+	public:
+		ParticleSorter() = default;
+
+		/// <summary>
+		/// Sorts the indices back to front.
+		/// </summary>
+		/// <param name="distances"> The distance from the camera of every particle, only the ordering of distances is used. </param>
+		/// <param name="indices"> The indices of the particles to sort, in any order. </param>
+		/// <returns> The sorted indices, valid until the next sort. </returns>
+		const std::vector<uint32_t> &Sort(const std::vector<float> &distances, const std::vector<uint32_t> &indices);
+
+		/// <summary>
+		/// Forgets the previous order, the next sort will be a full radix sort.
+		/// </summary>
+		void Reset() { m_order.clear(); }
+	private:
+		/// <summary>
+		/// Insertion sorts the keys and order, giving up when more than a number of elements have been moved.
+		/// </summary>
+		/// <param name="maxMoves"> The most elements that can be moved before giving up. </param>
+		/// <returns> If the keys and order are sorted. </returns>
+		bool InsertionSort(const std::size_t &maxMoves);
+
+		/// <summary>
+		/// Least significant digit radix sorts the keys and order, in two 8 bit passes.
+		/// </summary>
+		void RadixSort();
+
+		std::vector<uint32_t> m_order;
+		std::vector<uint16_t> m_keys;
+		std::vector<uint32_t> m_scratchOrder;
+		std::vector<uint16_t> m_scratchKeys;
+		// The key of every particle by index, with a bit set once the index has been added to the order.
+		std::vector<uint32_t> m_particleKeys;
+	};
+}
@@ -0,0 +1,202 @@
+#include "ParticleStore.hpp"
+
+#include <algorithm>
+#include <cmath>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ACID_PARTICLES_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace acid
+{
+	static const float FADE_TIME = 1.0f;
+	static const float GRAVITY = -10.0f;
+
+	const std::size_t ParticleStore::ChunkSize = 16384;
+
+	std::vector<float> ParticleStore::*const ParticleStore::Columns[] = {
+		&ParticleStore::m_positionX, &ParticleStore::m_positionY, &ParticleStore::m_positionZ,
+		&ParticleStore::m_velocityX, &ParticleStore::m_velocityY, &ParticleStore::m_velocityZ,
+		&ParticleStore::m_lifeLength, &ParticleStore::m_stageCycles, &ParticleStore::m_rotation, &ParticleStore::m_scale, &ParticleStore::m_gravityEffect,
+		&ParticleStore::m_elapsedTime, &ParticleStore::m_transparency, &ParticleStore::m_textureBlendFactor, &ParticleStore::m_distanceToCamera,
+		&ParticleStore::m_textureOffset1X, &ParticleStore::m_textureOffset1Y, &ParticleStore::m_textureOffset2X, &ParticleStore::m_textureOffset2Y
+	};
+
+	void ParticleStore::Add(const Particle &particle)
+	{
+		m_positionX.emplace_back(particle.GetPosition().m_x);
+		m_positionY.emplace_back(particle.GetPosition().m_y);
+		m_positionZ.emplace_back(particle.GetPosition().m_z);
+		m_velocityX.emplace_back(particle.GetVelocity().m_x);
+		m_velocityY.emplace_back(particle.GetVelocity().m_y);
+		m_velocityZ.emplace_back(particle.GetVelocity().m_z);
+		m_lifeLength.emplace_back(particle.GetLifeLength());
+		m_stageCycles.emplace_back(particle.GetStageCycles());
+		m_rotation.emplace_back(particle.GetRotation());
+		m_scale.emplace_back(particle.GetScale());
+		m_gravityEffect.emplace_back(particle.GetGravityEffect());
+		m_elapsedTime.emplace_back(0.0f);
+		m_transparency.emplace_back(1.0f);
+		m_textureBlendFactor.emplace_back(0.0f);
+		m_distanceToCamera.emplace_back(0.0f);
+		m_textureOffset1X.emplace_back(0.0f);
+		m_textureOffset1Y.emplace_back(0.0f);
+		m_textureOffset2X.emplace_back(0.0f);
+		m_textureOffset2Y.emplace_back(0.0f);
+	}
+
+	void ParticleStore::Update(const UpdateInfo &info, JobSystem *jobSystem)
+	{
+		auto size = GetSize();
+
+		if (jobSystem == nullptr)
+		{
+			UpdateRange(info, 0, size);
+		}
+		else
+		{
+			// Each job updates a contiguous run of particles.
+			jobSystem->ParallelFor(0, size, ChunkSize, [this, &info](const std::size_t &begin, const std::size_t &end)
+			{
+				UpdateRange(info, begin, end);
+			});
+		}
+
+		for (std::size_t i = 0; i < m_transparency.size();)
+		{
+			if (m_transparency[i] > 0.0f)
+			{
+				i++;
+				continue;
+			}
+
+			SwapRemove(i);
+		}
+	}
+
+	void ParticleStore::Clear()
+	{
+		for (const auto &column : Columns)
+		{
+			(this->*column).clear();
+		}
+	}
+
+	void ParticleStore::UpdateRange(const UpdateInfo &info, const std::size_t &begin, const std::size_t &end)
+	{
+		auto delta = info.m_delta;
+		auto gravityStep = GRAVITY * delta;
+		auto fadeStep = delta / FADE_TIME;
+		auto rows = static_cast<float>(info.m_numberOfRows);
+		auto stageCount = rows * rows;
+		auto i = begin;
+
+#if defined(ACID_PARTICLES_SSE2)
+		auto vDelta = _mm_set1_ps(delta);
+		auto vGravityStep = _mm_set1_ps(gravityStep);
+		auto vFadeStep = _mm_set1_ps(fadeStep);
+		auto vFadeTime = _mm_set1_ps(FADE_TIME);
+		auto vCameraX = _mm_set1_ps(info.m_cameraPosition.m_x);
+		auto vCameraY = _mm_set1_ps(info.m_cameraPosition.m_y);
+		auto vCameraZ = _mm_set1_ps(info.m_cameraPosition.m_z);
+		auto vRows = _mm_set1_ps(rows);
+		auto vStageCount = _mm_set1_ps(stageCount);
+		auto vLastStage = _mm_set1_ps(stageCount - 1.0f);
+		auto vOne = _mm_set1_ps(1.0f);
+
+		for (; i + 4 <= end; i += 4)
+		{
+			auto velocityX = _mm_loadu_ps(&m_velocityX[i]);
+			auto velocityY = _mm_add_ps(_mm_loadu_ps(&m_velocityY[i]), _mm_mul_ps(_mm_loadu_ps(&m_gravityEffect[i]), vGravityStep));
+			auto velocityZ = _mm_loadu_ps(&m_velocityZ[i]);
+			_mm_storeu_ps(&m_velocityY[i], velocityY);
+
+			auto positionX = _mm_add_ps(_mm_loadu_ps(&m_positionX[i]), _mm_mul_ps(velocityX, vDelta));
+			auto positionY = _mm_add_ps(_mm_loadu_ps(&m_positionY[i]), _mm_mul_ps(velocityY, vDelta));
+			auto positionZ = _mm_add_ps(_mm_loadu_ps(&m_positionZ[i]), _mm_mul_ps(velocityZ, vDelta));
+			_mm_storeu_ps(&m_positionX[i], positionX);
+			_mm_storeu_ps(&m_positionY[i], positionY);
+			_mm_storeu_ps(&m_positionZ[i], positionZ);
+
+			auto lifeLength = _mm_loadu_ps(&m_lifeLength[i]);
+			auto elapsedTime = _mm_add_ps(_mm_loadu_ps(&m_elapsedTime[i]), vDelta);
+			_mm_storeu_ps(&m_elapsedTime[i], elapsedTime);
+
+			auto fading = _mm_cmpgt_ps(elapsedTime, _mm_sub_ps(lifeLength, vFadeTime));
+			_mm_storeu_ps(&m_transparency[i], _mm_sub_ps(_mm_loadu_ps(&m_transparency[i]), _mm_and_ps(fading, vFadeStep)));
+
+			auto toCameraX = _mm_sub_ps(vCameraX, positionX);
+			auto toCameraY = _mm_sub_ps(vCameraY, positionY);
+			auto toCameraZ = _mm_sub_ps(vCameraZ, positionZ);
+			_mm_storeu_ps(&m_distanceToCamera[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(toCameraX, toCameraX), _mm_mul_ps(toCameraY, toCameraY)),
+				_mm_mul_ps(toCameraZ, toCameraZ)));
+
+			if (!info.m_textured)
+			{
+				continue;
+			}
+
+			// Progression is never negative, so truncation is the same as floor.
+			auto lifeFactor = _mm_div_ps(_mm_mul_ps(_mm_loadu_ps(&m_stageCycles[i]), elapsedTime), lifeLength);
+			auto progression = _mm_mul_ps(lifeFactor, vStageCount);
+			auto index1 = _mm_cvtepi32_ps(_mm_cvttps_epi32(progression));
+			auto index2 = _mm_add_ps(index1, _mm_and_ps(_mm_cmplt_ps(index1, vLastStage), vOne));
+			_mm_storeu_ps(&m_textureBlendFactor[i], _mm_sub_ps(progression, index1));
+
+			auto row1 = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_div_ps(index1, vRows)));
+			auto row2 = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_div_ps(index2, vRows)));
+			_mm_storeu_ps(&m_textureOffset1X[i], _mm_div_ps(_mm_sub_ps(index1, _mm_mul_ps(row1, vRows)), vRows));
+			_mm_storeu_ps(&m_textureOffset1Y[i], _mm_div_ps(row1, vRows));
+			_mm_storeu_ps(&m_textureOffset2X[i], _mm_div_ps(_mm_sub_ps(index2, _mm_mul_ps(row2, vRows)), vRows));
+			_mm_storeu_ps(&m_textureOffset2Y[i], _mm_div_ps(row2, vRows));
+		}
+#endif
+
+		for (; i < end; i++)
+		{
+			m_velocityY[i] += m_gravityEffect[i] * gravityStep;
+			m_positionX[i] += m_velocityX[i] * delta;
+			m_positionY[i] += m_velocityY[i] * delta;
+			m_positionZ[i] += m_velocityZ[i] * delta;
+			m_elapsedTime[i] += delta;
+
+			if (m_elapsedTime[i] > m_lifeLength[i] - FADE_TIME)
+			{
+				m_transparency[i] -= fadeStep;
+			}
+
+			auto toCameraX = info.m_cameraPosition.m_x - m_positionX[i];
+			auto toCameraY = info.m_cameraPosition.m_y - m_positionY[i];
+			auto toCameraZ = info.m_cameraPosition.m_z - m_positionZ[i];
+			m_distanceToCamera[i] = toCameraX * toCameraX + toCameraY * toCameraY + toCameraZ * toCameraZ;
+
+			if (!info.m_textured)
+			{
+				continue;
+			}
+
+			auto lifeFactor = m_stageCycles[i] * m_elapsedTime[i] / m_lifeLength[i];
+			auto progression = lifeFactor * stageCount;
+			auto index1 = std::floor(progression);
+			auto index2 = index1 < stageCount - 1.0f ? index1 + 1.0f : index1;
+			m_textureBlendFactor[i] = progression - index1;
+
+			auto row1 = std::floor(index1 / rows);
+			auto row2 = std::floor(index2 / rows);
+			m_textureOffset1X[i] = (index1 - row1 * rows) / rows;
+			m_textureOffset1Y[i] = row1 / rows;
+			m_textureOffset2X[i] = (index2 - row2 * rows) / rows;
+			m_textureOffset2Y[i] = row2 / rows;
+		}
+	}
+
+	void ParticleStore::SwapRemove(const std::size_t &index)
+	{
+		for (const auto &column : Columns)
+		{
+			auto &values = this->*column;
+			values[index] = values.back();
+			values.pop_back();
+		}
+	}
+}
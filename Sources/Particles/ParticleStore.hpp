@@ -0,0 +1,112 @@
+#pragma once
+
+#include <vector>
+#include "Maths/Culling.hpp"
+#include "Maths/Vector2.hpp"
+#include "Maths/Vector3.hpp"
+#include "Threads/JobSystem.hpp"
+#include "Particle.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// The live particles of one particle type, stored as a structure of arrays so they can be updated with SIMD.
+	/// Dead particles are removed by swapping in the last particle, so the order of particles is not kept.
+	/// </summary>
+	class ACID_EXPORT ParticleStore
+	{
+	public:
+		/// <summary>
+		/// The values that are the same for every particle in a update.
+		/// </summary>
+		struct UpdateInfo
+		{
+			float m_delta;
+			Vector3 m_cameraPosition;
+			uint32_t m_numberOfRows;
+			bool m_textured;
+		};
+
+		/// <summary>
+		/// Particles are updated in chunks of at least this size, each chunk is a job for the job system.
+		/// </summary>
+		static const std::size_t ChunkSize;
+
+		ParticleStore() = default;
+
+		void Add(const Particle &particle);
+
+		/// <summary>
+		/// Integrates every particle and removes the dead ones.
+		/// </summary>
+		/// <param name="info"> The values for this update. </param>
+		/// <param name="jobSystem"> The job system used to update large stores in parallel chunks, or nullptr to update on this thread. </param>
+		void Update(const UpdateInfo &info, JobSystem *jobSystem = nullptr);
+
+		void Clear();
+
+		std::size_t GetSize() const { return m_transparency.size(); }
+
+		bool IsEmpty() const { return m_transparency.empty(); }
+
+		Vector3 GetPosition(const std::size_t &index) const { return Vector3(m_positionX[index], m_positionY[index], m_positionZ[index]); }
+
+		Vector3 GetVelocity(const std::size_t &index) const { return Vector3(m_velocityX[index], m_velocityY[index], m_velocityZ[index]); }
+
+		Vector2 GetTextureOffset1(const std::size_t &index) const { return Vector2(m_textureOffset1X[index], m_textureOffset1Y[index]); }
+
+		Vector2 GetTextureOffset2(const std::size_t &index) const { return Vector2(m_textureOffset2X[index], m_textureOffset2Y[index]); }
+
+		const std::vector<float> &GetRotations() const { return m_rotation; }
+
+		const std::vector<float> &GetScales() const { return m_scale; }
+
+		const std::vector<float> &GetTransparencies() const { return m_transparency; }
+
+		const std::vector<float> &GetTextureBlendFactors() const { return m_textureBlendFactor; }
+
+		/// <summary>
+		/// Gets the particles as spheres for <seealso cref="Culling"/>, the radius of each sphere is the particle scale.
+		/// </summary>
+		/// <returns> The spheres, valid until particles are added or removed. </returns>
+		Culling::Spheres GetSpheres() const { return {m_positionX.data(), m_positionY.data(), m_positionZ.data(), m_scale.data()}; }
+
+		/// <summary>
+		/// Gets the squared distances from the camera, as of the last update.
+		/// </summary>
+		/// <returns> The squared distances. </returns>
+		const std::vector<float> &GetDistancesToCamera() const { return m_distanceToCamera; }
+	private:
+		/// <summary>
+		/// Updates a range of particles, the kernel that is run by each chunk.
+		/// </summary>
+		void UpdateRange(const UpdateInfo &info, const std::size_t &begin, const std::size_t &end);
+
+		void SwapRemove(const std::size_t &index);
+
+		static std::vector<float> ParticleStore::*const Columns[];
+
+		std::vector<float> m_positionX;
+		std::vector<float> m_positionY;
+		std::vector<float> m_positionZ;
+		std::vector<float> m_velocityX;
+		std::vector<float> m_velocityY;
+		std::vector<float> m_velocityZ;
+
+		std::vector<float> m_lifeLength;
+		std::vector<float> m_stageCycles;
+		std::vector<float> m_rotation;
+		std::vector<float> m_scale;
+		std::vector<float> m_gravityEffect;
+
+		std::vector<float> m_elapsedTime;
+		std::vector<float> m_transparency;
+		std::vector<float> m_textureBlendFactor;
+		std::vector<float> m_distanceToCamera;
+
+		std::vector<float> m_textureOffset1X;
+		std::vector<float> m_textureOffset1Y;
+		std::vector<float> m_textureOffset2X;
+		std::vector<float> m_textureOffset2Y;
+	};
+}
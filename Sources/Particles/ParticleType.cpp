@@ -4,42 +4,39 @@
 #include "Resources/Resources.hpp"
 #include "Maths/Maths.hpp"
 #include "Models/Shapes/ModelRectangle.hpp"
-#include "Scenes/Scenes.hpp"
-#include "Particle.hpp"
+#include "ParticleStore.hpp"
 
 namespace acid
 {
-	static const uint32_t MAX_INSTANCES = 1024;
-//	static const uint32_t INSTANCE_STEPS = 128;
 	static const float FRUSTUM_BUFFER = 1.4f;
 
 	std::shared_ptr<ParticleType> ParticleType::Create(const Metadata &metadata)
 	{
-		auto resource = Resources::Get()->Find(metadata);
+		auto resource = Resources::Get()->Find<ParticleType>(metadata);
 
 		if (resource != nullptr)
 		{
-			return std::dynamic_pointer_cast<ParticleType>(resource);
+			return resource;
 		}
 
 		auto result = std::make_shared<ParticleType>(nullptr);
-		Resources::Get()->Add(metadata, std::dynamic_pointer_cast<Resource>(result));
+		Resources::Get()->Add(metadata, result);
 		result->Decode(metadata);
 		result->Load();
 		return result;
 	}
 
 	std::shared_ptr<ParticleType> ParticleType::Create(const std::shared_ptr<Texture> &texture, const uint32_t &numberOfRows, const Colour &colourOffset, 
-		const float &lifeLength, const float &stageCycles, const float &scale)
+		const float &lifeLength, const float &stageCycles, const float &scale, const bool &additive)
 	{
-		auto temp = ParticleType(texture, numberOfRows, colourOffset, lifeLength, stageCycles, scale);
+		auto temp = ParticleType(texture, numberOfRows, colourOffset, lifeLength, stageCycles, scale, additive);
 		Metadata metadata = Metadata();
 		temp.Encode(metadata);
 		return Create(metadata);
 	}
 
 	ParticleType::ParticleType(std::shared_ptr<Texture> texture, const uint32_t &numberOfRows, const Colour &colourOffset,
-		const float &lifeLength, const float &stageCycles, const float &scale) :
+		const float &lifeLength, const float &stageCycles, const float &scale, const bool &additive) :
 		m_texture(std::move(texture)),
 		m_model(ModelRectangle::Create(-0.5f, 0.5f)),
 		m_numberOfRows(numberOfRows),
@@ -47,75 +44,51 @@ namespace acid
 		m_lifeLength(lifeLength),
 		m_stageCycles(stageCycles),
 		m_scale(scale),
-		m_maxInstances(0),
-		m_instances(0),
-		m_instanceBuffer(sizeof(ParticleTypeData) * MAX_INSTANCES)
+		m_additive(additive),
+		m_instanceBuffer(sizeof(ParticleInstance))
 	{
 	}
 
-	void ParticleType::Update(const std::vector<Particle> &particles)
+	bool ParticleType::CmdRender(const CommandBuffer &commandBuffer, const PipelineGraphics &pipeline, UniformHandler &uniformScene, const ParticleStore &particles,
+		const Frustum &frustum)
 	{
-		// Calculates a max instance count over the time of the type. TODO: Allow decreasing max using a timer and average count over the delay.
-	//	uint32_t instances = INSTANCE_STEPS * static_cast<uint32_t>(std::ceil(static_cast<float>(particles.size()) / static_cast<float>(INSTANCE_STEPS)));
-	//	m_maxInstances = std::max(m_maxInstances, instances);
-		m_maxInstances = MAX_INSTANCES;
-		m_instances = 0;
+		// Culls before sorting, so only visible particles are sorted and packed.
+		m_visible.clear();
+		Culling::SpheresInFrustum(frustum, particles.GetSpheres(), particles.GetSize(), m_visible, FRUSTUM_BUFFER);
 
-		if (particles.empty())
+		if (m_visible.empty())
 		{
-			return;
+			return false;
 		}
 
-		ParticleTypeData *particleInstances;
-		m_instanceBuffer.Map(reinterpret_cast<void **>(&particleInstances));
-
-		for (const auto &particle : particles)
-		{
-			if (m_instances >= m_maxInstances)
-			{
-				break;
-			}
-
-			if (!Scenes::Get()->GetCamera()->GetViewFrustum().SphereInFrustum(particle.GetPosition(), FRUSTUM_BUFFER *particle.GetScale()))
-			{
-				continue;
-			}
-
-			auto viewMatrix = Scenes::Get()->GetCamera()->GetViewMatrix();
-			ParticleTypeData *instance = &particleInstances[m_instances];
-			instance->modelMatrix = Matrix4::Identity.Translate(particle.GetPosition());
-
-			for (int32_t row = 0; row < 3; row++)
-			{
-				for (int32_t col = 0; col < 3; col++)
-				{
-					instance->modelMatrix[row][col] = viewMatrix[col][row];
-				}
-			}
-
-			instance->modelMatrix = instance->modelMatrix.Rotate(particle.GetRotation() * Maths::DegToRad, Vector3::Front);
-			instance->modelMatrix = instance->modelMatrix.Scale(particle.GetScale() * Vector3::One);
-			// TODO: Multiply MVP by View and Projection (And run update every frame?)
-
-			instance->colourOffset = particle.GetParticleType()->m_colourOffset;
-			instance->offsets = Vector4(particle.GetTextureOffset1(), particle.GetTextureOffset2());
-			instance->blend = Vector3(particle.GetTextureBlendFactor(), particle.GetTransparency(),
-				static_cast<float>(particle.GetParticleType()->m_numberOfRows));
-			m_instances++;
-		}
+		// Sorts back to front for alpha blending, additive blending gives the same result in any order.
+		const auto &order = m_additive ? m_visible : m_sorter.Sort(particles.GetDistancesToCamera(), m_visible);
 
-		m_instanceBuffer.Unmap();
-	}
+		// Packs straight into this frames mapped range, which is sized to fit every visible particle.
+		auto instances = static_cast<uint32_t>(order.size());
+		auto particleInstances = static_cast<ParticleInstance *>(m_instanceBuffer.Map(instances));
+		const auto &scales = particles.GetScales();
+		const auto &rotations = particles.GetRotations();
+		const auto &blendFactors = particles.GetTextureBlendFactors();
+		const auto &transparencies = particles.GetTransparencies();
 
-	bool ParticleType::CmdRender(const CommandBuffer &commandBuffer, const PipelineGraphics &pipeline, UniformHandler &uniformScene)
-	{
-		if (m_instances == 0)
+		for (uint32_t i = 0; i < instances; i++)
 		{
-			return false;
+			auto index = order[i];
+			auto &instance = particleInstances[i];
+			instance.position = particles.GetPosition(index);
+			instance.rotation = rotations[index] * Maths::DegToRad;
+			instance.offsets = Vector4(particles.GetTextureOffset1(index), particles.GetTextureOffset2(index));
+			instance.blend = Vector3(blendFactors[index], transparencies[index], scales[index]);
 		}
 
+		// Updates uniforms.
+		m_uniformObject.Push("colourOffset", m_colourOffset);
+		m_uniformObject.Push("numberOfRows", static_cast<float>(m_numberOfRows));
+
 		// Updates descriptors.
 		m_descriptorSet.Push("UboScene", uniformScene);
+		m_descriptorSet.Push("UboObject", m_uniformObject);
 		m_descriptorSet.Push("samplerColour", m_texture);
 		bool updateSuccess = m_descriptorSet.Update(pipeline);
 
@@ -128,10 +101,10 @@ namespace acid
 		m_descriptorSet.BindDescriptor(commandBuffer, pipeline);
 
 		VkBuffer vertexBuffers[] = {m_model->GetVertexBuffer()->GetBuffer(), m_instanceBuffer.GetBuffer()};
-		VkDeviceSize offsets[] = {0, 0};
+		VkDeviceSize offsets[] = {0, m_instanceBuffer.GetOffset()};
 		vkCmdBindVertexBuffers(commandBuffer.GetCommandBuffer(), 0, 2, vertexBuffers, offsets);
 		vkCmdBindIndexBuffer(commandBuffer.GetCommandBuffer(), m_model->GetIndexBuffer()->GetBuffer(), 0, m_model->GetIndexType());
-		vkCmdDrawIndexed(commandBuffer.GetCommandBuffer(), m_model->GetIndexCount(), m_instances, 0, 0, 0);
+		vkCmdDrawIndexed(commandBuffer.GetCommandBuffer(), m_model->GetIndexCount(), instances, 0, 0, 0);
 		return true;
 	}
 
@@ -143,6 +116,7 @@ namespace acid
 		metadata.GetChild("Life Length", m_lifeLength);
 		metadata.GetChild("Stage Cycles", m_stageCycles);
 		metadata.GetChild("Scale", m_scale);
+		metadata.GetChild("Additive", m_additive);
 	}
 
 	void ParticleType::Encode(Metadata &metadata) const
@@ -153,6 +127,7 @@ namespace acid
 		metadata.SetChild("Life Length", m_lifeLength);
 		metadata.SetChild("Stage Cycles", m_stageCycles);
 		metadata.SetChild("Scale", m_scale);
+		metadata.SetChild("Additive", m_additive);
 	}
 
 	Shader::VertexInput ParticleType::GetVertexInput(const uint32_t &binding)
@@ -161,52 +136,34 @@ namespace acid
 
 		// The vertex input description.
 		bindingDescriptions[0].binding = binding;
-		bindingDescriptions[0].stride = sizeof(ParticleTypeData);
+		bindingDescriptions[0].stride = sizeof(ParticleInstance);
 		bindingDescriptions[0].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
 
-		std::vector<VkVertexInputAttributeDescription> attributeDescriptions(7);
+		std::vector<VkVertexInputAttributeDescription> attributeDescriptions(4);
 
-		// Model matrix row 0 attribute.
+		// Position attribute.
 		attributeDescriptions[0].binding = binding;
 		attributeDescriptions[0].location = 0;
-		attributeDescriptions[0].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-		attributeDescriptions[0].offset = offsetof(ParticleTypeData, modelMatrix) + offsetof(Matrix4, m_rows[0]);
+		attributeDescriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;
+		attributeDescriptions[0].offset = offsetof(ParticleInstance, position);
 
-		// Model matrix row 1 attribute.
+		// Rotation attribute.
 		attributeDescriptions[1].binding = binding;
 		attributeDescriptions[1].location = 1;
-		attributeDescriptions[1].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-		attributeDescriptions[1].offset = offsetof(ParticleTypeData, modelMatrix) + offsetof(Matrix4, m_rows[1]);
+		attributeDescriptions[1].format = VK_FORMAT_R32_SFLOAT;
+		attributeDescriptions[1].offset = offsetof(ParticleInstance, rotation);
 
-		// Model matrix row 2 attribute.
+		// Offsets attribute.
 		attributeDescriptions[2].binding = binding;
 		attributeDescriptions[2].location = 2;
 		attributeDescriptions[2].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-		attributeDescriptions[2].offset = offsetof(ParticleTypeData, modelMatrix) + offsetof(Matrix4, m_rows[2]);
+		attributeDescriptions[2].offset = offsetof(ParticleInstance, offsets);
 
-		// Model matrix row 3 attribute.
+		// Blend attribute.
 		attributeDescriptions[3].binding = binding;
 		attributeDescriptions[3].location = 3;
-		attributeDescriptions[3].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-		attributeDescriptions[3].offset = offsetof(ParticleTypeData, modelMatrix) + offsetof(Matrix4, m_rows[3]);
-
-		// Colour offset attribute.
-		attributeDescriptions[4].binding = binding;
-		attributeDescriptions[4].location = 4;
-		attributeDescriptions[4].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-		attributeDescriptions[4].offset = offsetof(ParticleTypeData, colourOffset);
-
-		// Offsets attribute.
-		attributeDescriptions[5].binding = binding;
-		attributeDescriptions[5].location = 5;
-		attributeDescriptions[5].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-		attributeDescriptions[5].offset = offsetof(ParticleTypeData, offsets);
-
-		// Blend attribute.
-		attributeDescriptions[6].binding = binding;
-		attributeDescriptions[6].location = 6;
-		attributeDescriptions[6].format = VK_FORMAT_R32G32B32_SFLOAT;
-		attributeDescriptions[6].offset = offsetof(ParticleTypeData, blend);
+		attributeDescriptions[3].format = VK_FORMAT_R32G32B32_SFLOAT;
+		attributeDescriptions[3].offset = offsetof(ParticleInstance, blend);
 
 		return Shader::VertexInput(binding, bindingDescriptions, attributeDescriptions);
 	}
@@ -1,19 +1,21 @@
 ﻿#pragma once
 
 #include "Maths/Colour.hpp"
-#include "Maths/Matrix4.hpp"
 #include "Maths/Vector4.hpp"
 #include "Maths/Vector3.hpp"
 #include "Models/Model.hpp"
-#include "Renderer/Buffers/InstanceBuffer.hpp"
+#include "Physics/Frustum.hpp"
+#include "Renderer/Buffers/DynamicInstanceBuffer.hpp"
 #include "Renderer/Handlers/DescriptorsHandler.hpp"
+#include "Renderer/Handlers/UniformHandler.hpp"
 #include "Renderer/Pipelines/PipelineGraphics.hpp"
 #include "Resources/Resource.hpp"
 #include "Textures/Texture.hpp"
+#include "ParticleSorter.hpp"
 
 namespace acid
 {
-	class Particle;
+	class ParticleStore;
 
 	/// <summary>
 	/// A definition for what a particle should act and look like.
@@ -37,8 +39,9 @@ namespace acid
 		/// <param name="lifeLength"> The averaged life length for the particle. </param>
 		/// <param name="stageCycles"> The amount of times stages will be shown. </param>
 		/// <param name="scale"> The averaged scale for the particle. </param>
+		/// <param name="additive"> If the particles are blended additively, additive particles do not need to be depth sorted. </param>
 		static std::shared_ptr<ParticleType> Create(const std::shared_ptr<Texture> &texture, const uint32_t &numberOfRows = 1, const Colour &colourOffset = Colour::Black,
-			const float &lifeLength = 10.0f, const float &stageCycles = 1.0f, const float &scale = 1.0f);
+			const float &lifeLength = 10.0f, const float &stageCycles = 1.0f, const float &scale = 1.0f, const bool &additive = false);
 
 		/// <summary>
 		/// Creates a new particle type.
@@ -49,12 +52,21 @@ namespace acid
 		/// <param name="lifeLength"> The averaged life length for the particle. </param>
 		/// <param name="stageCycles"> The amount of times stages will be shown. </param>
 		/// <param name="scale"> The averaged scale for the particle. </param>
+		/// <param name="additive"> If the particles are blended additively, additive particles do not need to be depth sorted. </param>
 		explicit ParticleType(std::shared_ptr<Texture> texture, const uint32_t &numberOfRows = 1, const Colour &colourOffset = Colour::Black,
-			const float &lifeLength = 10.0f, const float &stageCycles = 1.0f, const float &scale = 1.0f);
+			const float &lifeLength = 10.0f, const float &stageCycles = 1.0f, const float &scale = 1.0f, const bool &additive = false);
 
-		void Update(const std::vector<Particle> &particles);
-
-		bool CmdRender(const CommandBuffer &commandBuffer, const PipelineGraphics &pipeline, UniformHandler &uniformScene);
+		/// <summary>
+		/// Culls the particles against the frustum, sorts them back to front unless blended additively, packs them into this frames instance buffer and draws them.
+		/// </summary>
+		/// <param name="commandBuffer"> The command buffer to record into. </param>
+		/// <param name="pipeline"> The particle pipeline. </param>
+		/// <param name="uniformScene"> The scene uniform handler. </param>
+		/// <param name="particles"> The live particles of this type. </param>
+		/// <param name="frustum"> The frustum to cull particles against. </param>
+		/// <returns> If any particles were drawn. </returns>
+		bool CmdRender(const CommandBuffer &commandBuffer, const PipelineGraphics &pipeline, UniformHandler &uniformScene, const ParticleStore &particles,
+			const Frustum &frustum);
 
 		void Decode(const Metadata &metadata) override;
 
@@ -85,11 +97,18 @@ namespace acid
 		const float &GetScale() const { return m_scale; }
 
 		void SetScale(const float &scale) { m_scale = scale; }
+
+		const bool &IsAdditive() const { return m_additive; }
+
+		void SetAdditive(const bool &additive) { m_additive = additive; }
 	private:
-		struct ParticleTypeData
+		/// <summary>
+		/// The per particle instance data, the quad is billboarded and rotated in the vertex shader.
+		/// </summary>
+		struct ParticleInstance
 		{
-			Matrix4 modelMatrix;
-			Colour colourOffset;
+			Vector3 position;
+			float rotation;
 			Vector4 offsets;
 			Vector3 blend;
 		};
@@ -101,11 +120,14 @@ namespace acid
 		float m_lifeLength;
 		float m_stageCycles;
 		float m_scale;
+		bool m_additive;
 
-		uint32_t m_maxInstances;
-		uint32_t m_instances;
+		// Visible particle indices, kept between frames to reuse the allocation.
+		std::vector<uint32_t> m_visible;
+		ParticleSorter m_sorter;
 
 		DescriptorsHandler m_descriptorSet;
-		InstanceBuffer m_instanceBuffer;
+		UniformHandler m_uniformObject;
+		DynamicInstanceBuffer m_instanceBuffer;
 	};
 }
@@ -1,6 +1,7 @@
 #include "Particles.hpp"
 
 #include "Scenes/Scenes.hpp"
+#include "Threads/JobSystem.hpp"
 
 namespace acid
 {
@@ -15,44 +16,33 @@ namespace acid
 			return;
 		}
 
-		for (auto it = m_particles.begin(); it != m_particles.end();)
-		{
-			for (auto it1 = (*it).second.begin(); it1 != (*it).second.end();)
-			{
-				(*it1).Update();
+		ParticleStore::UpdateInfo info = {};
+		info.m_delta = Engine::Get()->GetDelta().AsSeconds();
 
-				if (!(*it1).IsAlive())
-				{
-					it1 = (*it).second.erase(it1);
-					continue;
-				}
+		if (Scenes::Get()->GetCamera() != nullptr)
+		{
+			info.m_cameraPosition = Scenes::Get()->GetCamera()->GetPosition();
+		}
 
-				++it1;
-			}
+		for (auto it = m_particles.begin(); it != m_particles.end();)
+		{
+			info.m_numberOfRows = (*it).first->GetNumberOfRows();
+			info.m_textured = (*it).first->GetTexture() != nullptr;
+			(*it).second.Update(info, JobSystem::Get());
 
-			if (it->second.empty())
+			if ((*it).second.IsEmpty())
 			{
 				it = m_particles.erase(it);
 				continue;
 			}
 
-			std::sort((*it).second.begin(), (*it).second.end());
-			(*it).first->Update((*it).second);
 			++it;
 		}
 	}
 
 	void Particles::AddParticle(const Particle &particle)
 	{
-		auto it = m_particles.find(particle.GetParticleType());
-
-		if (it == m_particles.end())
-		{
-			m_particles.emplace(particle.GetParticleType(), std::vector<Particle>());
-			it = m_particles.find(particle.GetParticleType());
-		}
-
-		(*it).second.emplace_back(particle);
+		m_particles[particle.GetParticleType()].Add(particle);
 	}
 
 	/*void Particles::RemoveParticle(const Particle &particle)
@@ -4,6 +4,7 @@
 #include <vector>
 #include "Engine/Engine.hpp"
 #include "Particle.hpp"
+#include "ParticleStore.hpp"
 
 namespace acid
 {
@@ -34,11 +35,11 @@ namespace acid
 		void Clear();
 
 		/// <summary>
-		/// Gets a list of all particles.
+		/// Gets the live particles of each particle type.
 		/// </summary>
 		/// <returns> All particles. </returns>
-		const std::map<std::shared_ptr<ParticleType>, std::vector<Particle>> &GetParticles() const { return m_particles; }
+		const std::map<std::shared_ptr<ParticleType>, ParticleStore> &GetParticles() const { return m_particles; }
 	private:
-		std::map<std::shared_ptr<ParticleType>, std::vector<Particle>> m_particles;
+		std::map<std::shared_ptr<ParticleType>, ParticleStore> m_particles;
 	};
 }
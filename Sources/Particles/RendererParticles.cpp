@@ -9,7 +9,11 @@ namespace acid
 	RendererParticles::RendererParticles(const Pipeline::Stage &pipelineStage) :
 		RenderPipeline(pipelineStage),
 		m_pipeline(pipelineStage, {"Shaders/Particles/Particle.vert", "Shaders/Particles/Particle.frag"}, {VertexModel::GetVertexInput(0), ParticleType::GetVertexInput(1)},
-			PipelineGraphics::Mode::Polygon, PipelineGraphics::Depth::Read, VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, VK_POLYGON_MODE_FILL, VK_CULL_MODE_FRONT_BIT, false, {})
+			PipelineGraphics::Mode::Polygon, PipelineGraphics::Depth::Read, VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, VK_POLYGON_MODE_FILL, VK_CULL_MODE_FRONT_BIT, false, {}),
+		m_pipelineAdditive(pipelineStage, {"Shaders/Particles/Particle.vert", "Shaders/Particles/Particle.frag"}, {VertexModel::GetVertexInput(0), ParticleType::GetVertexInput(1)},
+			PipelineGraphics::Mode::Polygon, PipelineGraphics::Depth::Read, VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, VK_POLYGON_MODE_FILL, VK_CULL_MODE_FRONT_BIT, false, {},
+			PipelineGraphics::Blend::Additive),
+		m_uniformScene(true)
 	{
 	}
 
@@ -19,13 +23,30 @@ namespace acid
 		m_uniformScene.Push("projection", camera->GetProjectionMatrix());
 		m_uniformScene.Push("view", camera->GetViewMatrix());
 
-		auto particles = Particles::Get()->GetParticles();
+		const auto &particles = Particles::Get()->GetParticles();
+		const auto &frustum = camera->GetViewFrustum();
 
-		m_pipeline.BindPipeline(commandBuffer);
-
-		for (auto &[type, typeParticles] : particles)
+		// Alpha blended types are drawn first, then additive types which do not need to be sorted.
+		for (const auto &pipeline : {&m_pipeline, &m_pipelineAdditive})
 		{
-			type->CmdRender(commandBuffer, m_pipeline, m_uniformScene);
+			auto additive = pipeline == &m_pipelineAdditive;
+			auto bound = false;
+
+			for (auto &[type, typeParticles] : particles)
+			{
+				if (type->IsAdditive() != additive)
+				{
+					continue;
+				}
+
+				if (!bound)
+				{
+					pipeline->BindPipeline(commandBuffer);
+					bound = true;
+				}
+
+				type->CmdRender(commandBuffer, *pipeline, m_uniformScene, typeParticles, frustum);
+			}
 		}
 	}
 }
@@ -13,8 +13,11 @@ namespace acid
 		explicit RendererParticles(const Pipeline::Stage &pipelineStage);
 
 		void Render(const CommandBuffer &commandBuffer) override;
+
+		bool IsParallel() const override { return true; }
 	private:
 		PipelineGraphics m_pipeline;
+		PipelineGraphics m_pipelineAdditive;
 		UniformHandler m_uniformScene;
 	};
 }
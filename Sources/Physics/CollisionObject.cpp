@@ -6,6 +6,7 @@
 #include "Scenes/Entity.hpp"
 #include "Scenes/Scenes.hpp"
 #include "Colliders/Collider.hpp"
+#include "Frustum.hpp"
 
 namespace acid
 {
@@ -22,6 +23,14 @@ namespace acid
 	{
 	}
 
+	bool CollisionObject::InFrustum(const Frustum &frustum)
+	{
+		Vector3 min;
+		Vector3 max;
+		GetAabb(min, max);
+		return frustum.CubeInFrustum(min, max);
+	}
+
 	Force *CollisionObject::AddForce(Force *force)
 	{
 		m_forces.emplace_back(force);
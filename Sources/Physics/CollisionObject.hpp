@@ -32,12 +32,19 @@ namespace acid
 
 		virtual ~CollisionObject();
 
+		/// <summary>
+		/// Gets the world space axis aligned bounds of the shape, the bounds are a point at the origin until the shape is created.
+		/// </summary>
+		/// <param name="min"> The minimum corner. </param>
+		/// <param name="max"> The maximum corner. </param>
+		virtual void GetAabb(Vector3 &min, Vector3 &max) = 0;
+
 		/// <summary>
 		/// Gets if the shape is partially in the view frustum.
 		/// </summary>
 		/// <param name="frustum"> The view frustum. </param>
 		/// <returns> If the shape is partially in the view frustum. </returns>
-		virtual bool InFrustum(const Frustum &frustum) = 0;
+		bool InFrustum(const Frustum &frustum);
 
 		Force *AddForce(Force *force);
 
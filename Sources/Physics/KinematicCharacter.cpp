@@ -69,7 +69,9 @@ namespace acid
 
 		auto &transform = GetParent()->GetLocalTransform();
 		btTransform worldTransform = m_ghostObject->getWorldTransform();
-		transform = Collider::Convert(worldTransform, transform.GetScaling());
+		auto bodyTransform = Collider::Convert(worldTransform);
+		transform.SetPosition(bodyTransform.GetPosition());
+		transform.SetRotation(bodyTransform.GetRotation());
 	}
 
 	void KinematicCharacter::Decode(const Metadata &metadata)
@@ -98,17 +100,18 @@ namespace acid
 		metadata.SetChild("Interpolate", m_interpolate);
 	}
 
-	bool KinematicCharacter::InFrustum(const Frustum &frustum)
+	void KinematicCharacter::GetAabb(Vector3 &min, Vector3 &max)
 	{
-		btVector3 min = btVector3();
-		btVector3 max = btVector3();
+		btVector3 worldMin = btVector3(0.0f, 0.0f, 0.0f);
+		btVector3 worldMax = btVector3(0.0f, 0.0f, 0.0f);
 
 		if (m_body != nullptr && m_shape != nullptr)
 		{
-			m_shape->getAabb(Collider::Convert(GetParent()->GetWorldTransform()), min, max);
+			m_shape->getAabb(Collider::Convert(GetParent()->GetWorldTransform()), worldMin, worldMax);
 		}
 
-		return frustum.CubeInFrustum(Collider::Convert(min), Collider::Convert(max));
+		min = Collider::Convert(worldMin);
+		max = Collider::Convert(worldMax);
 	}
 
 	void KinematicCharacter::ClearForces()
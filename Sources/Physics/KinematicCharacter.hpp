@@ -32,7 +32,7 @@ namespace acid
 
 		void Encode(Metadata &metadata) const override;
 
-		bool InFrustum(const Frustum &frustum) override;
+		void GetAabb(Vector3 &min, Vector3 &max) override;
 
 		void ClearForces() override;
 
@@ -49,6 +49,8 @@ namespace acid
 		m_motionState = std::make_unique<btDefaultMotionState>(worldTransform);
 		m_rigidBody = CreateRigidBody(m_mass, m_motionState.get(), m_shape.get());
 		m_rigidBody->setWorldTransform(worldTransform);
+		m_previousPosition = Collider::Convert(worldTransform.getOrigin());
+		m_previousRotation = Collider::Convert(worldTransform.getRotation());
 	//	m_rigidBody->setContactStiffnessAndDamping(1000.0f, 0.1f);
 		m_rigidBody->setFriction(m_friction);
 		m_rigidBody->setRollingFriction(m_frictionRolling);
@@ -85,9 +87,20 @@ namespace acid
 		}
 
 		auto &transform = GetParent()->GetLocalTransform();
-		btTransform motionTransform;
-		m_rigidBody->getMotionState()->getWorldTransform(motionTransform);
-		transform = Collider::Convert(motionTransform, transform.GetScaling());
+		auto worldTransform = m_rigidBody->getWorldTransform();
+
+		// Moving bodies are drawn between their last two steps, sleeping and static bodies have not moved since the last step.
+		if (m_rigidBody->isActive() && !m_rigidBody->isStaticOrKinematicObject())
+		{
+			auto interpolation = Scenes::Get()->GetPhysics()->GetInterpolation();
+			worldTransform.setOrigin(Collider::Convert(m_previousPosition).lerp(worldTransform.getOrigin(), interpolation));
+			worldTransform.setRotation(Collider::Convert(m_previousRotation).slerp(worldTransform.getRotation(), interpolation));
+		}
+
+		// The setters only mark the transform dirty when it changed, so bodies that have not moved are not moved in the scene tree.
+		auto bodyTransform = Collider::Convert(worldTransform);
+		transform.SetPosition(bodyTransform.GetPosition());
+		transform.SetRotation(bodyTransform.GetRotation());
 
 		m_shape->setLocalScaling(Collider::Convert(transform.GetScaling()));
 	//	m_rigidBody->getMotionState()->setWorldTransform(Collider::Convert(transform));
@@ -115,17 +128,18 @@ namespace acid
 		metadata.SetChild("Angular Factor", m_angularFactor);
 	}
 
-	bool Rigidbody::InFrustum(const Frustum &frustum)
+	void Rigidbody::GetAabb(Vector3 &min, Vector3 &max)
 	{
-		btVector3 min = btVector3();
-		btVector3 max = btVector3();
+		btVector3 worldMin = btVector3(0.0f, 0.0f, 0.0f);
+		btVector3 worldMax = btVector3(0.0f, 0.0f, 0.0f);
 
 		if (m_body != nullptr && m_shape != nullptr)
 		{
-			m_rigidBody->getAabb(min, max);
+			m_rigidBody->getAabb(worldMin, worldMax);
 		}
 
-		return frustum.CubeInFrustum(Collider::Convert(min), Collider::Convert(max));
+		min = Collider::Convert(worldMin);
+		max = Collider::Convert(worldMax);
 	}
 
 	void Rigidbody::ClearForces()
@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include "Maths/Quaternion.hpp"
 #include "Maths/Vector3.hpp"
 #include "Scenes/Entity.hpp"
 #include "CollisionObject.hpp"
@@ -35,7 +36,7 @@ namespace acid
 
 		void Encode(Metadata &metadata) const override;
 
-		bool InFrustum(const Frustum &frustum) override;
+		void GetAabb(Vector3 &min, Vector3 &max) override;
 
 		void ClearForces() override;
 
@@ -65,6 +66,8 @@ namespace acid
 	protected:
 		void RecalculateMass() override;
 	private:
+		friend class ScenePhysics;
+
 		static btRigidBody *CreateRigidBody(float mass, btDefaultMotionState *motionState, btCollisionShape *shape);
 
 		float m_mass;
@@ -78,5 +81,9 @@ namespace acid
 
 		std::unique_ptr<btDefaultMotionState> m_motionState;
 		btRigidBody *m_rigidBody;
+
+		// The transform before the last physics step, blended with the current transform by the physics interpolation.
+		Vector3 m_previousPosition;
+		Quaternion m_previousRotation;
 	};
 }
@@ -2,6 +2,7 @@
 
 #include <vulkan/vulkan.h>
 #include "Renderer/Descriptors/DescriptorSet.hpp"
+#include "Renderer/Memory/MemoryAllocator.hpp"
 
 namespace acid
 {
@@ -24,15 +25,24 @@ namespace acid
 
 		virtual ~Buffer();
 
+		/// <summary>
+		/// Gets the mapped memory of a host visible buffer, the memory stays mapped for the life of the buffer.
+		/// </summary>
+		/// <param name="data"> Set to the mapped memory. </param>
 		void Map(void **data);
 
+		/// <summary>
+		/// Ends writing to the mapped memory, flushing the writes if the memory is not host coherent.
+		/// </summary>
 		void Unmap();
 
 		const VkDeviceSize &GetSize() const { return m_size; }
 
 		const VkBuffer &GetBuffer() const { return m_buffer; }
 
-		const VkDeviceMemory &GetBufferMemory() const { return m_bufferMemory; }
+		const VkDeviceMemory &GetBufferMemory() const { return m_allocation.GetMemory(); }
+
+		const MemoryAllocation &GetAllocation() const { return m_allocation; }
 
 		static uint32_t FindMemoryType(const uint32_t &typeFilter, const VkMemoryPropertyFlags &requiredProperties);
 
@@ -40,6 +50,6 @@ namespace acid
 	protected:
 		VkDeviceSize m_size;
 		VkBuffer m_buffer;
-		VkDeviceMemory m_bufferMemory;
+		MemoryAllocation m_allocation;
 	};
 }
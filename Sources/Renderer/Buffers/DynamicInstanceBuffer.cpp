@@ -0,0 +1,18 @@
+#include "DynamicInstanceBuffer.hpp"
+
+#include "Renderer/Renderer.hpp"
+
+namespace acid
+{
+	DynamicInstanceBuffer::DynamicInstanceBuffer(const VkDeviceSize &stride) :
+		m_stride(stride),
+		m_region{VK_NULL_HANDLE, 0, 0, nullptr}
+	{
+	}
+
+	void *DynamicInstanceBuffer::Map(const uint32_t &instances)
+	{
+		m_region = Renderer::Get()->GetFrameAllocator()->Allocate(m_stride * instances);
+		return m_region.m_mapped;
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Renderer/Memory/RingAllocator.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// Instance storage taken from the renderers frame allocator every frame,
+	/// so instances can be written while the GPU reads the previous frames. The range grows to fit the instances written to it.
+	/// </summary>
+	class ACID_EXPORT DynamicInstanceBuffer
+	{
+	public:
+		/// <summary>
+		/// Creates a new dynamic instance buffer, storage is taken the first time it is mapped.
+		/// </summary>
+		/// <param name="stride"> The size of a instance in bytes. </param>
+		explicit DynamicInstanceBuffer(const VkDeviceSize &stride);
+
+		/// <summary>
+		/// Takes storage for the instances of this frame from the frame allocator.
+		/// Should only be called while recording the frame, after the frames fence has been waited on.
+		/// </summary>
+		/// <param name="instances"> The number of instances that will be written. </param>
+		/// <returns> The mapped memory, coherent so no flush is needed. </returns>
+		void *Map(const uint32_t &instances);
+
+		/// <summary>
+		/// Gets the buffer holding the storage last returned by <seealso cref="#Map()"/>.
+		/// </summary>
+		/// <returns> The current frames buffer. </returns>
+		const VkBuffer &GetBuffer() const { return m_region.m_buffer; }
+
+		/// <summary>
+		/// Gets the offset into <seealso cref="#GetBuffer()"/> that the instances start at, used when binding the buffer.
+		/// </summary>
+		/// <returns> The offset in bytes. </returns>
+		const VkDeviceSize &GetOffset() const { return m_region.m_offset; }
+
+		const VkDeviceSize &GetStride() const { return m_stride; }
+	private:
+		VkDeviceSize m_stride;
+		RingAllocator::Region m_region;
+	};
+}
@@ -12,12 +12,10 @@ namespace acid
 
 	void InstanceBuffer::Update(const CommandBuffer &commandBuffer, const void *newData)
 	{
-		auto logicalDevice = Renderer::Get()->GetLogicalDevice();
-
-		// Copies the data to the buffer.
+		// Copies the data to the persistently mapped buffer.
 		void *data;
-		Renderer::CheckVk(vkMapMemory(logicalDevice->GetLogicalDevice(), GetBufferMemory(), 0, m_size, 0, &data));
+		Map(&data);
 		memcpy(data, newData, static_cast<std::size_t>(m_size));
-		vkUnmapMemory(logicalDevice->GetLogicalDevice(), GetBufferMemory());
+		Unmap();
 	}
 }
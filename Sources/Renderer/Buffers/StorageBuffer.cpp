@@ -12,13 +12,11 @@ namespace acid
 
 	void StorageBuffer::Update(const void *newData)
 	{
-		auto logicalDevice = Renderer::Get()->GetLogicalDevice();
-
-		// Copies the data to the buffer.
+		// Copies the data to the persistently mapped buffer.
 		void *data;
-		vkMapMemory(logicalDevice->GetLogicalDevice(), m_bufferMemory, 0, m_size, 0, &data);
+		Map(&data);
 		memcpy(data, newData, static_cast<std::size_t>(m_size));
-		vkUnmapMemory(logicalDevice->GetLogicalDevice(), m_bufferMemory);
+		Unmap();
 	}
 
 	VkDescriptorSetLayoutBinding StorageBuffer::GetDescriptorSetLayout(const uint32_t &binding, const VkDescriptorType &descriptorType,
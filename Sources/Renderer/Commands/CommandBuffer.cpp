@@ -4,17 +4,17 @@
 
 namespace acid
 {
-	CommandBuffer::CommandBuffer(const bool &begin, const VkQueueFlagBits &queueType, const VkCommandBufferLevel &bufferLevel) :
+	CommandBuffer::CommandBuffer(const bool &begin, const VkQueueFlagBits &queueType, const VkCommandBufferLevel &bufferLevel, const VkCommandPool &commandPool) :
 		m_queueType(queueType),
+		m_commandPool(commandPool == VK_NULL_HANDLE ? Renderer::Get()->GetCommandPool() : commandPool),
 		m_commandBuffer(nullptr),
 		m_running(false)
 	{
 		auto logicalDevice = Renderer::Get()->GetLogicalDevice();
-		auto commandPool = Renderer::Get()->GetCommandPool();
 
 		VkCommandBufferAllocateInfo commandBufferAllocateInfo = {};
 		commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-		commandBufferAllocateInfo.commandPool = commandPool;
+		commandBufferAllocateInfo.commandPool = m_commandPool;
 		commandBufferAllocateInfo.level = bufferLevel;
 		commandBufferAllocateInfo.commandBufferCount = 1;
 		Renderer::CheckVk(vkAllocateCommandBuffers(logicalDevice->GetLogicalDevice(), &commandBufferAllocateInfo, &m_commandBuffer));
@@ -28,16 +28,16 @@ namespace acid
 	CommandBuffer::~CommandBuffer()
 	{
 		auto logicalDevice = Renderer::Get()->GetLogicalDevice();
-		auto commandPool = Renderer::Get()->GetCommandPool();
 
-		vkFreeCommandBuffers(logicalDevice->GetLogicalDevice(), commandPool, 1, &m_commandBuffer);
+		vkFreeCommandBuffers(logicalDevice->GetLogicalDevice(), m_commandPool, 1, &m_commandBuffer);
 	}
 
-	void CommandBuffer::Begin(const VkCommandBufferUsageFlags &usage)
+	void CommandBuffer::Begin(const VkCommandBufferUsageFlags &usage, const VkCommandBufferInheritanceInfo *inheritanceInfo)
 	{
 		VkCommandBufferBeginInfo beginInfo = {};
 		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 		beginInfo.flags = usage;
+		beginInfo.pInheritanceInfo = inheritanceInfo;
 		Renderer::CheckVk(vkBeginCommandBuffer(m_commandBuffer, &beginInfo));
 
 		m_running = true;
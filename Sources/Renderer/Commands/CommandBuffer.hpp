@@ -14,8 +14,9 @@ namespace acid
 		/// <param name="begin"> If recording will start right away, if true <seealso cref="#Begin()"/> is called. </param>
 		/// <param name="queueType"> The queue to run this command buffer on. </param>
 		/// <param name="bufferLevel"> The buffer level. </param>
+		/// <param name="commandPool"> The pool to allocate from, if null the renderers command pool is used. </param>
 		explicit CommandBuffer(const bool &begin = true, const VkQueueFlagBits &queueType = VK_QUEUE_GRAPHICS_BIT, 
-			const VkCommandBufferLevel &bufferLevel = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+			const VkCommandBufferLevel &bufferLevel = VK_COMMAND_BUFFER_LEVEL_PRIMARY, const VkCommandPool &commandPool = VK_NULL_HANDLE);
 
 		~CommandBuffer();
 
@@ -23,7 +24,8 @@ namespace acid
 		/// Begins the recording state for this command buffer.
 		/// </summary>
 		/// <param name="usage"> How this command buffer will be used. </param>
-		void Begin(const VkCommandBufferUsageFlags &usage = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+		/// <param name="inheritanceInfo"> The renderpass state a secondary command buffer continues, or nullptr. </param>
+		void Begin(const VkCommandBufferUsageFlags &usage = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, const VkCommandBufferInheritanceInfo *inheritanceInfo = nullptr);
 
 		/// <summary>
 		/// Ends the recording state for this command buffer.
@@ -50,6 +52,7 @@ namespace acid
 		VkQueue GetQueue() const;
 
 		VkQueueFlagBits m_queueType;
+		VkCommandPool m_commandPool;
 		VkCommandBuffer m_commandBuffer;
 		bool m_running;
 	};
@@ -0,0 +1,52 @@
+#include "CommandPool.hpp"
+
+#include "Renderer/Renderer.hpp"
+
+namespace acid
+{
+	CommandPool::CommandPool(const VkCommandBufferLevel &bufferLevel) :
+		m_bufferLevel(bufferLevel),
+		m_commandPool(VK_NULL_HANDLE),
+		m_used(0)
+	{
+		auto logicalDevice = Renderer::Get()->GetLogicalDevice();
+
+		// Buffers are only reset with the whole pool, so they do not need to be reset on their own.
+		VkCommandPoolCreateInfo commandPoolCreateInfo = {};
+		commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+		commandPoolCreateInfo.queueFamilyIndex = logicalDevice->GetGraphicsFamily();
+		Renderer::CheckVk(vkCreateCommandPool(logicalDevice->GetLogicalDevice(), &commandPoolCreateInfo, nullptr, &m_commandPool));
+	}
+
+	CommandPool::~CommandPool()
+	{
+		auto logicalDevice = Renderer::Get()->GetLogicalDevice();
+
+		m_commandBuffers.clear();
+		vkDestroyCommandPool(logicalDevice->GetLogicalDevice(), m_commandPool, nullptr);
+	}
+
+	void CommandPool::Reset()
+	{
+		if (m_used == 0)
+		{
+			return;
+		}
+
+		auto logicalDevice = Renderer::Get()->GetLogicalDevice();
+
+		Renderer::CheckVk(vkResetCommandPool(logicalDevice->GetLogicalDevice(), m_commandPool, 0));
+		m_used = 0;
+	}
+
+	CommandBuffer &CommandPool::Next()
+	{
+		if (m_used == m_commandBuffers.size())
+		{
+			m_commandBuffers.emplace_back(std::make_unique<CommandBuffer>(false, VK_QUEUE_GRAPHICS_BIT, m_bufferLevel, m_commandPool));
+		}
+
+		return *m_commandBuffers[m_used++];
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "Helpers/NonCopyable.hpp"
+#include "CommandBuffer.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// A command pool used by one thread at a time, command buffers are taken from it while a frame is recorded and all given back at once with <seealso cref="#Reset()"/>.
+	/// A command pool must not be used by two threads at the same time, so each job recording a frame has its own pool for each frame in flight.
+	/// </summary>
+	class ACID_EXPORT CommandPool :
+		public NonCopyable
+	{
+	public:
+		/// <summary>
+		/// Creates a new command pool on the graphics queue family.
+		/// </summary>
+		/// <param name="bufferLevel"> The level of the command buffers taken from the pool. </param>
+		explicit CommandPool(const VkCommandBufferLevel &bufferLevel = VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+
+		~CommandPool();
+
+		/// <summary>
+		/// Resets every command buffer taken from the pool, should be called once the device has completed the frame that executed them.
+		/// </summary>
+		void Reset();
+
+		/// <summary>
+		/// Takes a command buffer that has not been used since the pool was last reset, allocating a new one if they are all in use.
+		/// </summary>
+		/// <returns> The command buffer, not yet begun. </returns>
+		CommandBuffer &Next();
+
+		const VkCommandPool &GetCommandPool() const { return m_commandPool; }
+	private:
+		VkCommandBufferLevel m_bufferLevel;
+		VkCommandPool m_commandPool;
+		std::vector<std::unique_ptr<CommandBuffer>> m_commandBuffers;
+		std::size_t m_used;
+	};
+}
@@ -0,0 +1,406 @@
+#include "UploadQueue.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include "Devices/LogicalDevice.hpp"
+#include "Renderer/Renderer.hpp"
+
+namespace acid
+{
+	static const uint32_t BATCH_COUNT = 4;
+	static const VkDeviceSize STAGING_CAPACITY = 16 * 1024 * 1024;
+	static const VkDeviceSize DEDICATED_STAGING_SIZE = 4 * 1024 * 1024;
+	static const VkDeviceSize FLUSH_SIZE = 8 * 1024 * 1024;
+
+	UploadQueue::UploadQueue(const LogicalDevice *logicalDevice) :
+		m_logicalDevice(logicalDevice),
+		m_submitThread(std::this_thread::get_id()),
+		m_separateTransfer(logicalDevice->GetTransferFamily() != logicalDevice->GetGraphicsFamily()),
+		m_graphicsPool(VK_NULL_HANDLE),
+		m_transferPool(VK_NULL_HANDLE),
+		m_batches(BATCH_COUNT),
+		m_staging(STAGING_CAPACITY, VK_BUFFER_USAGE_TRANSFER_SRC_BIT),
+		m_recording(false),
+		m_recordedSize(0),
+		m_recordedBuffers(0),
+		m_submitted(0),
+		m_completed(0)
+	{
+		VkCommandPoolCreateInfo commandPoolCreateInfo = {};
+		commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+		commandPoolCreateInfo.queueFamilyIndex = m_logicalDevice->GetGraphicsFamily();
+		Renderer::CheckVk(vkCreateCommandPool(m_logicalDevice->GetLogicalDevice(), &commandPoolCreateInfo, nullptr, &m_graphicsPool));
+
+		if (m_separateTransfer)
+		{
+			commandPoolCreateInfo.queueFamilyIndex = m_logicalDevice->GetTransferFamily();
+			Renderer::CheckVk(vkCreateCommandPool(m_logicalDevice->GetLogicalDevice(), &commandPoolCreateInfo, nullptr, &m_transferPool));
+		}
+
+		VkCommandBufferAllocateInfo commandBufferAllocateInfo = {};
+		commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		commandBufferAllocateInfo.commandBufferCount = 1;
+
+		VkSemaphoreCreateInfo semaphoreCreateInfo = {};
+		semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+		VkFenceCreateInfo fenceCreateInfo = {};
+		fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+		for (auto &batch : m_batches)
+		{
+			commandBufferAllocateInfo.commandPool = m_graphicsPool;
+			Renderer::CheckVk(vkAllocateCommandBuffers(m_logicalDevice->GetLogicalDevice(), &commandBufferAllocateInfo, &batch.m_graphicsCommands));
+			batch.m_transferCommands = batch.m_graphicsCommands;
+			batch.m_semaphore = VK_NULL_HANDLE;
+
+			if (m_separateTransfer)
+			{
+				commandBufferAllocateInfo.commandPool = m_transferPool;
+				Renderer::CheckVk(vkAllocateCommandBuffers(m_logicalDevice->GetLogicalDevice(), &commandBufferAllocateInfo, &batch.m_transferCommands));
+				Renderer::CheckVk(vkCreateSemaphore(m_logicalDevice->GetLogicalDevice(), &semaphoreCreateInfo, nullptr, &batch.m_semaphore));
+			}
+
+			Renderer::CheckVk(vkCreateFence(m_logicalDevice->GetLogicalDevice(), &fenceCreateInfo, nullptr, &batch.m_fence));
+			batch.m_ticket = 0;
+		}
+	}
+
+	UploadQueue::~UploadQueue()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		for (auto &batch : m_batches)
+		{
+			// A batch still being recorded was never submitted, so its fence will not signal.
+			if (batch.m_ticket != 0 && IsSubmitted(batch.m_ticket) && !IsComplete(batch.m_ticket))
+			{
+				Renderer::CheckVk(vkWaitForFences(m_logicalDevice->GetLogicalDevice(), 1, &batch.m_fence, VK_TRUE, std::numeric_limits<uint64_t>::max()));
+			}
+
+			batch.m_staging.clear();
+			vkDestroyFence(m_logicalDevice->GetLogicalDevice(), batch.m_fence, nullptr);
+
+			if (batch.m_semaphore != VK_NULL_HANDLE)
+			{
+				vkDestroySemaphore(m_logicalDevice->GetLogicalDevice(), batch.m_semaphore, nullptr);
+			}
+		}
+
+		vkDestroyCommandPool(m_logicalDevice->GetLogicalDevice(), m_graphicsPool, nullptr);
+
+		if (m_transferPool != VK_NULL_HANDLE)
+		{
+			vkDestroyCommandPool(m_logicalDevice->GetLogicalDevice(), m_transferPool, nullptr);
+		}
+	}
+
+	UploadQueue::Ticket UploadQueue::UploadBuffer(const Buffer &buffer, const void *data, const VkDeviceSize &size, const VkDeviceSize &offset)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto &batch = BeginBatch();
+		auto ticket = batch.m_ticket;
+		auto region = AllocateStaging(batch, data, size);
+
+		VkBufferCopy copyRegion = {};
+		copyRegion.srcOffset = region.m_offset;
+		copyRegion.dstOffset = offset;
+		copyRegion.size = size;
+		vkCmdCopyBuffer(batch.m_transferCommands, region.m_buffer, buffer.GetBuffer(), 1, &copyRegion);
+
+		// Ownership is passed to the graphics queue family, the barriers of a batch are recorded together when it is submitted.
+		if (m_separateTransfer)
+		{
+			VkBufferMemoryBarrier bufferMemoryBarrier = {};
+			bufferMemoryBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+			bufferMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			bufferMemoryBarrier.dstAccessMask = 0;
+			bufferMemoryBarrier.srcQueueFamilyIndex = m_logicalDevice->GetTransferFamily();
+			bufferMemoryBarrier.dstQueueFamilyIndex = m_logicalDevice->GetGraphicsFamily();
+			bufferMemoryBarrier.buffer = buffer.GetBuffer();
+			bufferMemoryBarrier.offset = offset;
+			bufferMemoryBarrier.size = size;
+			m_bufferReleases.emplace_back(bufferMemoryBarrier);
+
+			bufferMemoryBarrier.srcAccessMask = 0;
+			bufferMemoryBarrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+			m_bufferAcquires.emplace_back(bufferMemoryBarrier);
+		}
+
+		m_recordedBuffers++;
+		EndUpload();
+		return ticket;
+	}
+
+	UploadQueue::Ticket UploadQueue::UploadImage(const VkImage &image, const void *pixels, const VkDeviceSize &size, const uint32_t &width, const uint32_t &height,
+		const uint32_t &mipLevels, const uint32_t &baseArrayLayer, const uint32_t &layerCount, const std::function<void(const VkCommandBuffer &)> &finish)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto &batch = BeginBatch();
+		auto ticket = batch.m_ticket;
+
+		if (pixels != nullptr)
+		{
+			auto region = AllocateStaging(batch, pixels, size);
+
+			VkImageMemoryBarrier imageMemoryBarrier = {};
+			imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+			imageMemoryBarrier.srcAccessMask = 0;
+			imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+			imageMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			imageMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			imageMemoryBarrier.image = image;
+			imageMemoryBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			imageMemoryBarrier.subresourceRange.baseMipLevel = 0;
+			imageMemoryBarrier.subresourceRange.levelCount = mipLevels;
+			imageMemoryBarrier.subresourceRange.baseArrayLayer = baseArrayLayer;
+			imageMemoryBarrier.subresourceRange.layerCount = layerCount;
+			vkCmdPipelineBarrier(batch.m_transferCommands, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+
+			VkBufferImageCopy copyRegion = {};
+			copyRegion.bufferOffset = region.m_offset;
+			copyRegion.bufferRowLength = 0;
+			copyRegion.bufferImageHeight = 0;
+			copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			copyRegion.imageSubresource.mipLevel = 0;
+			copyRegion.imageSubresource.baseArrayLayer = baseArrayLayer;
+			copyRegion.imageSubresource.layerCount = layerCount;
+			copyRegion.imageOffset = {0, 0, 0};
+			copyRegion.imageExtent = {width, height, 1};
+			vkCmdCopyBufferToImage(batch.m_transferCommands, region.m_buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
+
+			// The layout is kept while ownership is passed to the graphics queue family, where the barriers recorded by finish continue from the copy.
+			if (m_separateTransfer)
+			{
+				imageMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+				imageMemoryBarrier.dstAccessMask = 0;
+				imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+				imageMemoryBarrier.srcQueueFamilyIndex = m_logicalDevice->GetTransferFamily();
+				imageMemoryBarrier.dstQueueFamilyIndex = m_logicalDevice->GetGraphicsFamily();
+				vkCmdPipelineBarrier(batch.m_transferCommands, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+
+				imageMemoryBarrier.srcAccessMask = 0;
+				imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+				vkCmdPipelineBarrier(batch.m_graphicsCommands, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+			}
+		}
+
+		finish(batch.m_graphicsCommands);
+		EndUpload();
+		return ticket;
+	}
+
+	void UploadQueue::Update()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		// Batches complete in the order they were submitted, so polling stops at the first batch still running.
+		while (m_completed < m_submitted)
+		{
+			auto &batch = GetBatch(m_completed + 1);
+
+			if (vkGetFenceStatus(m_logicalDevice->GetLogicalDevice(), batch.m_fence) != VK_SUCCESS)
+			{
+				break;
+			}
+
+			Retire(batch.m_ticket);
+		}
+
+		FlushBatch();
+	}
+
+	void UploadQueue::Flush()
+	{
+		if (std::this_thread::get_id() != m_submitThread)
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		FlushBatch();
+	}
+
+	void UploadQueue::Wait(const Ticket &ticket)
+	{
+		if (IsComplete(ticket))
+		{
+			return;
+		}
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		if (!IsSubmitted(ticket))
+		{
+			if (std::this_thread::get_id() == m_submitThread)
+			{
+				FlushBatch();
+			}
+			else
+			{
+				m_submittedCondition.wait(lock, [this, ticket]()
+				{
+					return IsSubmitted(ticket);
+				});
+			}
+		}
+
+		if (IsComplete(ticket))
+		{
+			return;
+		}
+
+		auto &batch = GetBatch(ticket);
+		Renderer::CheckVk(vkWaitForFences(m_logicalDevice->GetLogicalDevice(), 1, &batch.m_fence, VK_TRUE, std::numeric_limits<uint64_t>::max()));
+		Retire(ticket);
+	}
+
+	UploadQueue::Batch &UploadQueue::BeginBatch()
+	{
+		auto ticket = m_submitted + 1;
+		auto &batch = GetBatch(ticket);
+
+		if (m_recording)
+		{
+			return batch;
+		}
+
+		// When every batch is in flight the oldest is waited on, this only happens when uploads are recorded faster than the device copies them.
+		if (batch.m_ticket != 0 && !IsComplete(batch.m_ticket))
+		{
+			Renderer::CheckVk(vkWaitForFences(m_logicalDevice->GetLogicalDevice(), 1, &batch.m_fence, VK_TRUE, std::numeric_limits<uint64_t>::max()));
+			Retire(batch.m_ticket);
+		}
+
+		Renderer::CheckVk(vkResetFences(m_logicalDevice->GetLogicalDevice(), 1, &batch.m_fence));
+		batch.m_ticket = ticket;
+
+		// The ring takes back the staging memory of the batch last recorded into this slot, which has completed.
+		m_staging.BeginFrame((ticket - 1) % m_batches.size());
+
+		VkCommandBufferBeginInfo beginInfo = {};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		Renderer::CheckVk(vkBeginCommandBuffer(batch.m_graphicsCommands, &beginInfo));
+
+		if (m_separateTransfer)
+		{
+			Renderer::CheckVk(vkBeginCommandBuffer(batch.m_transferCommands, &beginInfo));
+		}
+
+		m_recording = true;
+		return batch;
+	}
+
+	LinearAllocator::Region UploadQueue::AllocateStaging(Batch &batch, const void *data, const VkDeviceSize &size)
+	{
+		LinearAllocator::Region region;
+
+		// Large uploads are staged in their own buffer, so the ring does not grow to fit a single texture.
+		if (size > DEDICATED_STAGING_SIZE)
+		{
+			batch.m_staging.emplace_back(std::make_unique<LinearAllocator>(size));
+			region = *batch.m_staging.back()->Allocate(size);
+		}
+		else
+		{
+			region = m_staging.Allocate(size);
+		}
+
+		std::memcpy(region.m_mapped, data, static_cast<std::size_t>(size));
+		m_recordedSize += size;
+		return region;
+	}
+
+	void UploadQueue::EndUpload()
+	{
+		// While loading without rendering frames, batches are submitted once they are large enough to keep the device busy.
+		if (m_recordedSize >= FLUSH_SIZE && std::this_thread::get_id() == m_submitThread)
+		{
+			FlushBatch();
+		}
+	}
+
+	void UploadQueue::FlushBatch()
+	{
+		if (!m_recording)
+		{
+			return;
+		}
+
+		auto &batch = GetBatch(m_submitted + 1);
+
+		if (m_separateTransfer)
+		{
+			if (!m_bufferReleases.empty())
+			{
+				vkCmdPipelineBarrier(batch.m_transferCommands, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr,
+					static_cast<uint32_t>(m_bufferReleases.size()), m_bufferReleases.data(), 0, nullptr);
+				vkCmdPipelineBarrier(batch.m_graphicsCommands, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr,
+					static_cast<uint32_t>(m_bufferAcquires.size()), m_bufferAcquires.data(), 0, nullptr);
+			}
+
+			Renderer::CheckVk(vkEndCommandBuffer(batch.m_transferCommands));
+		}
+		else if (m_recordedBuffers != 0)
+		{
+			// One barrier makes every buffer copy in the batch visible to the frames submitted after it.
+			VkMemoryBarrier memoryBarrier = {};
+			memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+			memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			memoryBarrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+			vkCmdPipelineBarrier(batch.m_graphicsCommands, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+		}
+
+		Renderer::CheckVk(vkEndCommandBuffer(batch.m_graphicsCommands));
+
+		VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+		VkSubmitInfo submitInfo = {};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.commandBufferCount = 1;
+
+		if (m_separateTransfer)
+		{
+			submitInfo.pCommandBuffers = &batch.m_transferCommands;
+			submitInfo.signalSemaphoreCount = 1;
+			submitInfo.pSignalSemaphores = &batch.m_semaphore;
+			Renderer::CheckVk(vkQueueSubmit(m_logicalDevice->GetTransferQueue(), 1, &submitInfo, VK_NULL_HANDLE));
+
+			submitInfo.signalSemaphoreCount = 0;
+			submitInfo.pSignalSemaphores = nullptr;
+			submitInfo.waitSemaphoreCount = 1;
+			submitInfo.pWaitSemaphores = &batch.m_semaphore;
+			submitInfo.pWaitDstStageMask = &waitStage;
+		}
+
+		submitInfo.pCommandBuffers = &batch.m_graphicsCommands;
+		Renderer::CheckVk(vkQueueSubmit(m_logicalDevice->GetGraphicsQueue(), 1, &submitInfo, batch.m_fence));
+
+		m_submitted = batch.m_ticket;
+		m_recording = false;
+		m_recordedSize = 0;
+		m_recordedBuffers = 0;
+		m_bufferReleases.clear();
+		m_bufferAcquires.clear();
+		m_submittedCondition.notify_all();
+	}
+
+	void UploadQueue::Retire(const Ticket &ticket)
+	{
+		m_completed = std::max(m_completed.load(), ticket);
+
+		for (auto &batch : m_batches)
+		{
+			if (batch.m_ticket != 0 && batch.m_ticket <= ticket)
+			{
+				batch.m_staging.clear();
+			}
+		}
+	}
+}
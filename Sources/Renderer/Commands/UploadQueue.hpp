@@ -0,0 +1,138 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Renderer/Memory/RingAllocator.hpp"
+
+namespace acid
+{
+	class LogicalDevice;
+
+	/// <summary>
+	/// Records copies into device local buffers and images, and submits them in batches without the calling thread waiting on the device.
+	/// Staging data is written into a ring buffer that is taken back as batches complete, uploads too large for the ring are given their own staging buffer.
+	/// When the device has a separate transfer queue family the copies run on it, ownership is then passed to the graphics queue where mipmaps and layouts are recorded.
+	/// </summary>
+	class ACID_EXPORT UploadQueue :
+		public NonCopyable
+	{
+	public:
+		/// <summary>
+		/// Identifies the batch a upload was recorded into, a ticket of zero has nothing left to upload.
+		/// </summary>
+		using Ticket = uint64_t;
+
+		/// <summary>
+		/// Creates a new upload queue, batches are submitted from the thread it is created on.
+		/// </summary>
+		/// <param name="logicalDevice"> The logical device to record and submit with. </param>
+		explicit UploadQueue(const LogicalDevice *logicalDevice);
+
+		~UploadQueue();
+
+		/// <summary>
+		/// Records a copy into a buffer, the buffer must have been created with the transfer destination usage. This can be called from any thread.
+		/// </summary>
+		/// <param name="buffer"> The buffer to copy into. </param>
+		/// <param name="data"> The data to copy, copied into staging memory before this returns. </param>
+		/// <param name="size"> The size of the data in bytes. </param>
+		/// <param name="offset"> The offset into the buffer to copy to. </param>
+		/// <returns> The ticket of the batch the copy was recorded into. </returns>
+		Ticket UploadBuffer(const Buffer &buffer, const void *data, const VkDeviceSize &size, const VkDeviceSize &offset = 0);
+
+		/// <summary>
+		/// Records a copy into the first mip level of colour image layers, the layers are tightly packed in the pixels. This can be called from any thread.
+		/// After the copy the image is in the transfer destination layout, finish then records mipmaps or the transition to the final layout on the graphics queue.
+		/// Without pixels nothing is copied and finish is given the image in the layout it was created with.
+		/// </summary>
+		/// <param name="image"> The image to copy into. </param>
+		/// <param name="pixels"> The pixels to copy, or nullptr. </param>
+		/// <param name="size"> The size of the pixels in bytes. </param>
+		/// <param name="width"> The width of the first mip level. </param>
+		/// <param name="height"> The height of the first mip level. </param>
+		/// <param name="mipLevels"> The mip level count of the image. </param>
+		/// <param name="baseArrayLayer"> The first layer to copy into. </param>
+		/// <param name="layerCount"> The amount of layers to copy into. </param>
+		/// <param name="finish"> Records the commands run on the graphics queue once the copy has completed, called before this returns. </param>
+		/// <returns> The ticket of the batch the upload was recorded into. </returns>
+		Ticket UploadImage(const VkImage &image, const void *pixels, const VkDeviceSize &size, const uint32_t &width, const uint32_t &height, const uint32_t &mipLevels,
+			const uint32_t &baseArrayLayer, const uint32_t &layerCount, const std::function<void(const VkCommandBuffer &)> &finish);
+
+		/// <summary>
+		/// Takes back the staging memory of completed batches and submits the batch being recorded, called by the renderer before a frame is recorded.
+		/// </summary>
+		void Update();
+
+		/// <summary>
+		/// Submits the batch being recorded. The queues are shared with the renderer, so this does nothing when called from a different thread than the queue was created on.
+		/// </summary>
+		void Flush();
+
+		/// <summary>
+		/// Holds the current thread until the device has completed a upload.
+		/// If the batch is still being recorded it is submitted first, or on other threads the wait lasts until the renderer has submitted it.
+		/// </summary>
+		/// <param name="ticket"> The ticket of the upload to wait on. </param>
+		void Wait(const Ticket &ticket);
+
+		/// <summary>
+		/// Gets if a upload has been submitted, commands submitted after it on the graphics queue will see the uploaded data.
+		/// </summary>
+		/// <param name="ticket"> The ticket of the upload. </param>
+		/// <returns> If the upload has been submitted. </returns>
+		bool IsSubmitted(const Ticket &ticket) const { return ticket <= m_submitted; }
+
+		/// <summary>
+		/// Gets if the device has completed a upload.
+		/// </summary>
+		/// <param name="ticket"> The ticket of the upload. </param>
+		/// <returns> If the upload has completed. </returns>
+		bool IsComplete(const Ticket &ticket) const { return ticket <= m_completed; }
+	private:
+		struct Batch
+		{
+			VkCommandBuffer m_transferCommands;
+			VkCommandBuffer m_graphicsCommands;
+			VkSemaphore m_semaphore;
+			VkFence m_fence;
+			Ticket m_ticket;
+			std::vector<std::unique_ptr<LinearAllocator>> m_staging;
+		};
+
+		Batch &GetBatch(const Ticket &ticket) { return m_batches[(ticket - 1) % m_batches.size()]; }
+
+		Batch &BeginBatch();
+
+		LinearAllocator::Region AllocateStaging(Batch &batch, const void *data, const VkDeviceSize &size);
+
+		void EndUpload();
+
+		void FlushBatch();
+
+		void Retire(const Ticket &ticket);
+
+		const LogicalDevice *m_logicalDevice;
+		std::thread::id m_submitThread;
+		bool m_separateTransfer;
+		VkCommandPool m_graphicsPool;
+		VkCommandPool m_transferPool;
+		std::vector<Batch> m_batches;
+		RingAllocator m_staging;
+
+		bool m_recording;
+		VkDeviceSize m_recordedSize;
+		uint32_t m_recordedBuffers;
+		std::vector<VkBufferMemoryBarrier> m_bufferReleases;
+		std::vector<VkBufferMemoryBarrier> m_bufferAcquires;
+
+		std::mutex m_mutex;
+		std::condition_variable m_submittedCondition;
+		std::atomic<Ticket> m_submitted;
+		std::atomic<Ticket> m_completed;
+	};
+}
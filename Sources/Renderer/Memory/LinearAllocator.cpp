@@ -0,0 +1,25 @@
+#include "LinearAllocator.hpp"
+
+namespace acid
+{
+	LinearAllocator::LinearAllocator(const VkDeviceSize &capacity, const VkBufferUsageFlags &usage) :
+		m_buffer(capacity, usage, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
+		m_mapped(nullptr),
+		m_offset(0)
+	{
+		m_buffer.Map(&m_mapped);
+	}
+
+	std::optional<LinearAllocator::Region> LinearAllocator::Allocate(const VkDeviceSize &size, const VkDeviceSize &alignment)
+	{
+		auto offset = (m_offset + alignment - 1) & ~(alignment - 1);
+
+		if (offset + size > m_buffer.GetSize())
+		{
+			return std::nullopt;
+		}
+
+		m_offset = offset + size;
+		return Region{m_buffer.GetBuffer(), offset, size, static_cast<char *>(m_mapped) + offset};
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <optional>
+#include "Renderer/Buffers/Buffer.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// Gives out ranges of one mapped buffer front to back, and takes them all back at once with <seealso cref="#Reset()"/>.
+	/// Used for staging data that is only needed until a transfer has completed.
+	/// </summary>
+	class ACID_EXPORT LinearAllocator :
+		public NonCopyable
+	{
+	public:
+		/// <summary>
+		/// A range of a buffer, written through its mapped memory.
+		/// </summary>
+		struct Region
+		{
+			VkBuffer m_buffer;
+			VkDeviceSize m_offset;
+			VkDeviceSize m_size;
+			void *m_mapped;
+		};
+
+		/// <summary>
+		/// Creates a new linear allocator over a host visible and coherent buffer.
+		/// </summary>
+		/// <param name="capacity"> The size of the buffer in bytes. </param>
+		/// <param name="usage"> Usage flag bitmask for the buffer. </param>
+		LinearAllocator(const VkDeviceSize &capacity, const VkBufferUsageFlags &usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+
+		/// <summary>
+		/// Takes the next range of the buffer.
+		/// </summary>
+		/// <param name="size"> The size of the range in bytes. </param>
+		/// <param name="alignment"> The alignment of the range offset, a power of two. </param>
+		/// <returns> The range, or nothing if the rest of the buffer is too small. </returns>
+		std::optional<Region> Allocate(const VkDeviceSize &size, const VkDeviceSize &alignment = 16);
+
+		/// <summary>
+		/// Takes back every range, should only be called once the device has finished reading them.
+		/// </summary>
+		void Reset() { m_offset = 0; }
+
+		const Buffer &GetBuffer() const { return m_buffer; }
+
+		const VkDeviceSize &GetCapacity() const { return m_buffer.GetSize(); }
+
+		const VkDeviceSize &GetOffset() const { return m_offset; }
+	private:
+		Buffer m_buffer;
+		void *m_mapped;
+		VkDeviceSize m_offset;
+	};
+}
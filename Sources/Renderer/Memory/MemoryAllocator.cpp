@@ -0,0 +1,260 @@
+#include "MemoryAllocator.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include "Devices/LogicalDevice.hpp"
+#include "Devices/PhysicalDevice.hpp"
+#include "Engine/Log.hpp"
+#include "Renderer/Renderer.hpp"
+
+namespace acid
+{
+	static const VkDeviceSize SMALL_HEAP_SIZE = 1024 * 1024 * 1024;
+
+	const VkDeviceSize MemoryAllocator::BlockSize = 64 * 1024 * 1024;
+
+	MemoryAllocator::MemoryAllocator(const PhysicalDevice *physicalDevice, const LogicalDevice *logicalDevice) :
+		m_physicalDevice(physicalDevice),
+		m_logicalDevice(logicalDevice)
+	{
+	}
+
+	MemoryAllocator::~MemoryAllocator()
+	{
+		uint32_t leaked = 0;
+
+		for (const auto &blocks : m_blocks)
+		{
+			for (const auto &block : blocks)
+			{
+				leaked += block->GetAllocationCount();
+				DestroyBlock(*block);
+			}
+		}
+
+		if (leaked != 0)
+		{
+			Log::Error("%i device memory allocations were not freed\n", leaked);
+		}
+	}
+
+	MemoryAllocation MemoryAllocator::Allocate(const VkMemoryRequirements &requirements, const VkMemoryPropertyFlags &properties, const Tiling &tiling)
+	{
+		auto memoryType = FindMemoryType(requirements.memoryTypeBits, properties);
+		auto size = requirements.size;
+		auto alignment = requirements.alignment;
+
+		// Non coherent memory is flushed in whole atoms, allocations are padded to atoms so a flush never touches another allocation.
+		if (!IsCoherent(memoryType))
+		{
+			auto atomSize = m_physicalDevice->GetProperties().limits.nonCoherentAtomSize;
+			size = (size + atomSize - 1) & ~(atomSize - 1);
+			alignment = std::max(alignment, atomSize);
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto &blocks = GetBlocks(memoryType, tiling);
+		auto blockSize = GetBlockSize(memoryType);
+		auto dedicated = size > blockSize / 2;
+
+		MemoryBlock *block = nullptr;
+		std::optional<VkDeviceSize> offset;
+
+		if (!dedicated)
+		{
+			for (const auto &candidate : blocks)
+			{
+				if (candidate->IsDedicated())
+				{
+					continue;
+				}
+
+				offset = candidate->Allocate(size, alignment);
+
+				if (offset)
+				{
+					block = candidate.get();
+					break;
+				}
+			}
+		}
+
+		if (block == nullptr)
+		{
+			blocks.emplace_back(CreateBlock(dedicated ? size : blockSize, memoryType, dedicated));
+			block = blocks.back().get();
+			offset = block->Allocate(size, alignment);
+		}
+
+		MemoryAllocation allocation;
+		allocation.m_block = block;
+		allocation.m_tiling = tiling;
+		allocation.m_memory = block->GetMemory();
+		allocation.m_offset = *offset;
+		allocation.m_size = size;
+
+		if (block->GetMapped() != nullptr)
+		{
+			allocation.m_mapped = static_cast<char *>(block->GetMapped()) + *offset;
+		}
+
+		return allocation;
+	}
+
+	void MemoryAllocator::Free(MemoryAllocation &allocation)
+	{
+		if (!allocation.IsValid())
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto block = allocation.m_block;
+		block->Free(allocation.m_offset, allocation.m_size);
+
+		if (block->IsEmpty())
+		{
+			auto &blocks = GetBlocks(block->GetMemoryType(), allocation.m_tiling);
+
+			// One empty shared block is kept, so a resource that is recreated every so often does not free and allocate a block each time.
+			auto sharedCount = std::count_if(blocks.begin(), blocks.end(), [](const std::unique_ptr<MemoryBlock> &b)
+			{
+				return !b->IsDedicated();
+			});
+
+			if (block->IsDedicated() || sharedCount > 1)
+			{
+				DestroyBlock(*block);
+				blocks.erase(std::find_if(blocks.begin(), blocks.end(), [block](const std::unique_ptr<MemoryBlock> &b)
+				{
+					return b.get() == block;
+				}));
+			}
+		}
+
+		allocation = MemoryAllocation();
+	}
+
+	void MemoryAllocator::Flush(const MemoryAllocation &allocation) const
+	{
+		if (!allocation.IsValid() || IsCoherent(allocation.m_block->GetMemoryType()))
+		{
+			return;
+		}
+
+		VkMappedMemoryRange mappedMemoryRange = {};
+		mappedMemoryRange.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+		mappedMemoryRange.memory = allocation.m_memory;
+		mappedMemoryRange.offset = allocation.m_offset;
+		mappedMemoryRange.size = allocation.m_size;
+		Renderer::CheckVk(vkFlushMappedMemoryRanges(m_logicalDevice->GetLogicalDevice(), 1, &mappedMemoryRange));
+	}
+
+	uint32_t MemoryAllocator::FindMemoryType(const uint32_t &typeFilter, const VkMemoryPropertyFlags &requiredProperties) const
+	{
+		auto &memoryProperties = m_physicalDevice->GetMemoryProperties();
+
+		for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++)
+		{
+			uint32_t memoryTypeBits = 1 << i;
+			bool isRequiredMemoryType = typeFilter & memoryTypeBits;
+
+			auto properties = memoryProperties.memoryTypes[i].propertyFlags;
+			bool hasRequiredProperties = (properties & requiredProperties) == requiredProperties;
+
+			if (isRequiredMemoryType && hasRequiredProperties)
+			{
+				return i;
+			}
+		}
+
+		assert(false && "Failed to find a valid memory type for buffer!");
+		return 0;
+	}
+
+	MemoryAllocator::Statistics MemoryAllocator::GetStatistics() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		Statistics statistics = {};
+		VkDeviceSize largestFreeRanges = 0;
+
+		for (const auto &blocks : m_blocks)
+		{
+			for (const auto &block : blocks)
+			{
+				statistics.m_blockCount++;
+				statistics.m_dedicatedBlockCount += block->IsDedicated() ? 1 : 0;
+				statistics.m_allocationCount += block->GetAllocationCount();
+				statistics.m_reservedBytes += block->GetSize();
+				statistics.m_usedBytes += block->GetUsed();
+				statistics.m_freeRangeCount += block->GetFreeRangeCount();
+				statistics.m_largestFreeRange = std::max(statistics.m_largestFreeRange, block->GetLargestFreeRange());
+				largestFreeRanges += block->GetLargestFreeRange();
+			}
+		}
+
+		auto freeBytes = statistics.m_reservedBytes - statistics.m_usedBytes;
+
+		if (freeBytes != 0)
+		{
+			statistics.m_fragmentation = 1.0f - static_cast<float>(largestFreeRanges) / static_cast<float>(freeBytes);
+		}
+
+		return statistics;
+	}
+
+	std::vector<std::unique_ptr<MemoryBlock>> &MemoryAllocator::GetBlocks(const uint32_t &memoryType, const Tiling &tiling)
+	{
+		return m_blocks[2 * memoryType + static_cast<uint32_t>(tiling)];
+	}
+
+	VkDeviceSize MemoryAllocator::GetBlockSize(const uint32_t &memoryType) const
+	{
+		auto &memoryProperties = m_physicalDevice->GetMemoryProperties();
+		auto heapSize = memoryProperties.memoryHeaps[memoryProperties.memoryTypes[memoryType].heapIndex].size;
+
+		// Small heaps, like the host visible device memory of discrete cards, are split into smaller blocks.
+		if (heapSize <= SMALL_HEAP_SIZE)
+		{
+			return std::min(BlockSize, heapSize / 8);
+		}
+
+		return BlockSize;
+	}
+
+	bool MemoryAllocator::IsCoherent(const uint32_t &memoryType) const
+	{
+		auto properties = m_physicalDevice->GetMemoryProperties().memoryTypes[memoryType].propertyFlags;
+		return (properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) == 0 || (properties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+	}
+
+	std::unique_ptr<MemoryBlock> MemoryAllocator::CreateBlock(const VkDeviceSize &size, const uint32_t &memoryType, const bool &dedicated) const
+	{
+		VkMemoryAllocateInfo memoryAllocateInfo = {};
+		memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		memoryAllocateInfo.allocationSize = size;
+		memoryAllocateInfo.memoryTypeIndex = memoryType;
+
+		VkDeviceMemory memory;
+		Renderer::CheckVk(vkAllocateMemory(m_logicalDevice->GetLogicalDevice(), &memoryAllocateInfo, nullptr, &memory));
+
+		void *mapped = nullptr;
+
+		if (m_physicalDevice->GetMemoryProperties().memoryTypes[memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+		{
+			Renderer::CheckVk(vkMapMemory(m_logicalDevice->GetLogicalDevice(), memory, 0, VK_WHOLE_SIZE, 0, &mapped));
+		}
+
+		return std::make_unique<MemoryBlock>(memory, size, memoryType, mapped, dedicated);
+	}
+
+	void MemoryAllocator::DestroyBlock(const MemoryBlock &block) const
+	{
+		if (block.GetMapped() != nullptr)
+		{
+			vkUnmapMemory(m_logicalDevice->GetLogicalDevice(), block.GetMemory());
+		}
+
+		vkFreeMemory(m_logicalDevice->GetLogicalDevice(), block.GetMemory(), nullptr);
+	}
+}
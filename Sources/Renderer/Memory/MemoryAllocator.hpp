@@ -0,0 +1,139 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "MemoryBlock.hpp"
+
+namespace acid
+{
+	class LogicalDevice;
+	class MemoryAllocation;
+	class PhysicalDevice;
+
+	/// <summary>
+	/// Gives out ranges of a few large device memory blocks, instead of a device allocation for every resource.
+	/// Blocks are kept for each memory type, buffers and optimal tiled images use separate blocks so the buffer image granularity never has to be padded for.
+	/// Host visible blocks are mapped once when they are allocated, and stay mapped until they are freed.
+	/// </summary>
+	class ACID_EXPORT MemoryAllocator :
+		public NonCopyable
+	{
+	public:
+		/// <summary>
+		/// How a resource lays out its memory, buffers and linear images are linear.
+		/// </summary>
+		enum class Tiling
+		{
+			Linear = 0, Optimal = 1
+		};
+
+		/// <summary>
+		/// The state of every block, used to see how much memory is reserved and how badly the free memory is split up.
+		/// </summary>
+		struct Statistics
+		{
+			uint32_t m_blockCount;
+			uint32_t m_dedicatedBlockCount;
+			uint32_t m_allocationCount;
+			VkDeviceSize m_reservedBytes;
+			VkDeviceSize m_usedBytes;
+			std::size_t m_freeRangeCount;
+			VkDeviceSize m_largestFreeRange;
+			/// The part of the free memory that is outside of the largest free range of its block, from 0 to 1.
+			/// Packing the allocations of a block together would give this much more contiguous memory.
+			float m_fragmentation;
+		};
+
+		/// <summary>
+		/// The size of a shared block, resources larger than half a block get a dedicated block.
+		/// </summary>
+		static const VkDeviceSize BlockSize;
+
+		MemoryAllocator(const PhysicalDevice *physicalDevice, const LogicalDevice *logicalDevice);
+
+		~MemoryAllocator();
+
+		/// <summary>
+		/// Allocates memory for a resource, it is mapped if the memory type is host visible.
+		/// </summary>
+		/// <param name="requirements"> The memory requirements of the resource. </param>
+		/// <param name="properties"> The memory properties the memory type must have. </param>
+		/// <param name="tiling"> How the resource lays out its memory. </param>
+		/// <returns> The allocation, the resource is bound to its memory at its offset. </returns>
+		MemoryAllocation Allocate(const VkMemoryRequirements &requirements, const VkMemoryPropertyFlags &properties, const Tiling &tiling);
+
+		/// <summary>
+		/// Returns a allocation to its block, and releases the block if it is no longer needed.
+		/// </summary>
+		/// <param name="allocation"> The allocation to free, it is reset so it can not be freed twice. </param>
+		void Free(MemoryAllocation &allocation);
+
+		/// <summary>
+		/// Makes host writes to a mapped allocation visible to the device, does nothing for host coherent memory.
+		/// </summary>
+		/// <param name="allocation"> The allocation that was written. </param>
+		void Flush(const MemoryAllocation &allocation) const;
+
+		uint32_t FindMemoryType(const uint32_t &typeFilter, const VkMemoryPropertyFlags &requiredProperties) const;
+
+		Statistics GetStatistics() const;
+	private:
+		std::vector<std::unique_ptr<MemoryBlock>> &GetBlocks(const uint32_t &memoryType, const Tiling &tiling);
+
+		VkDeviceSize GetBlockSize(const uint32_t &memoryType) const;
+
+		bool IsCoherent(const uint32_t &memoryType) const;
+
+		std::unique_ptr<MemoryBlock> CreateBlock(const VkDeviceSize &size, const uint32_t &memoryType, const bool &dedicated) const;
+
+		void DestroyBlock(const MemoryBlock &block) const;
+
+		const PhysicalDevice *m_physicalDevice;
+		const LogicalDevice *m_logicalDevice;
+
+		std::array<std::vector<std::unique_ptr<MemoryBlock>>, 2 * VK_MAX_MEMORY_TYPES> m_blocks;
+		mutable std::mutex m_mutex;
+	};
+
+	/// <summary>
+	/// A range of device memory given out by the <seealso cref="MemoryAllocator"/>.
+	/// </summary>
+	class ACID_EXPORT MemoryAllocation
+	{
+	public:
+		MemoryAllocation() :
+			m_block(nullptr),
+			m_tiling(MemoryAllocator::Tiling::Linear),
+			m_memory(VK_NULL_HANDLE),
+			m_offset(0),
+			m_size(0),
+			m_mapped(nullptr)
+		{
+		}
+
+		bool IsValid() const { return m_block != nullptr; }
+
+		const VkDeviceMemory &GetMemory() const { return m_memory; }
+
+		const VkDeviceSize &GetOffset() const { return m_offset; }
+
+		const VkDeviceSize &GetSize() const { return m_size; }
+
+		/// <summary>
+		/// Gets the mapped memory at the start of this allocation.
+		/// </summary>
+		/// <returns> The mapped memory, or nullptr if the memory is not host visible. </returns>
+		void *GetMapped() const { return m_mapped; }
+	private:
+		friend class MemoryAllocator;
+
+		MemoryBlock *m_block;
+		MemoryAllocator::Tiling m_tiling;
+		VkDeviceMemory m_memory;
+		VkDeviceSize m_offset;
+		VkDeviceSize m_size;
+		void *m_mapped;
+	};
+}
@@ -0,0 +1,112 @@
+#include "MemoryBlock.hpp"
+
+#include <cassert>
+#include <iterator>
+
+namespace acid
+{
+	MemoryBlock::MemoryBlock(const VkDeviceMemory &memory, const VkDeviceSize &size, const uint32_t &memoryType, void *mapped, const bool &dedicated) :
+		m_memory(memory),
+		m_size(size),
+		m_memoryType(memoryType),
+		m_mapped(mapped),
+		m_dedicated(dedicated),
+		m_used(0),
+		m_allocationCount(0)
+	{
+		InsertFree(0, size);
+	}
+
+	std::optional<VkDeviceSize> MemoryBlock::Allocate(const VkDeviceSize &size, const VkDeviceSize &alignment)
+	{
+		// Padding from the alignment can stop the smallest range from fitting, so larger ranges are tried until one fits.
+		for (auto it = m_freeSizes.lower_bound(size); it != m_freeSizes.end(); ++it)
+		{
+			auto rangeOffset = it->second;
+			auto rangeEnd = rangeOffset + it->first;
+			auto offset = (rangeOffset + alignment - 1) & ~(alignment - 1);
+
+			if (offset + size > rangeEnd)
+			{
+				continue;
+			}
+
+			EraseFree(m_freeOffsets.find(rangeOffset));
+
+			if (offset > rangeOffset)
+			{
+				InsertFree(rangeOffset, offset - rangeOffset);
+			}
+
+			if (offset + size < rangeEnd)
+			{
+				InsertFree(offset + size, rangeEnd - offset - size);
+			}
+
+			m_used += size;
+			m_allocationCount++;
+			return offset;
+		}
+
+		return std::nullopt;
+	}
+
+	void MemoryBlock::Free(const VkDeviceSize &offset, const VkDeviceSize &size)
+	{
+		assert(m_allocationCount > 0 && offset + size <= m_size && "Range was not allocated from this block!");
+
+		m_used -= size;
+		m_allocationCount--;
+
+		auto begin = offset;
+		auto end = offset + size;
+		auto next = m_freeOffsets.lower_bound(offset);
+
+		if (next != m_freeOffsets.begin())
+		{
+			auto previous = std::prev(next);
+			assert(previous->first + previous->second <= begin && "Range overlaps a free range!");
+
+			if (previous->first + previous->second == begin)
+			{
+				begin = previous->first;
+				EraseFree(previous);
+			}
+		}
+
+		if (next != m_freeOffsets.end())
+		{
+			assert(end <= next->first && "Range overlaps a free range!");
+
+			if (next->first == end)
+			{
+				end += next->second;
+				EraseFree(next);
+			}
+		}
+
+		InsertFree(begin, end - begin);
+	}
+
+	void MemoryBlock::InsertFree(const VkDeviceSize &offset, const VkDeviceSize &size)
+	{
+		m_freeOffsets.emplace(offset, size);
+		m_freeSizes.emplace(size, offset);
+	}
+
+	void MemoryBlock::EraseFree(const std::map<VkDeviceSize, VkDeviceSize>::iterator &it)
+	{
+		auto [first, last] = m_freeSizes.equal_range(it->second);
+
+		for (auto sized = first; sized != last; ++sized)
+		{
+			if (sized->second == it->first)
+			{
+				m_freeSizes.erase(sized);
+				break;
+			}
+		}
+
+		m_freeOffsets.erase(it);
+	}
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <vulkan/vulkan.h>
+#include "Helpers/NonCopyable.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// A device memory allocation that is split into ranges for many resources.
+	/// Free ranges are indexed by offset, to merge neighbours when a range is freed, and by size, to find the best fit.
+	/// The block only keeps the books, the device memory is allocated and freed by the <seealso cref="MemoryAllocator"/>.
+	/// </summary>
+	class ACID_EXPORT MemoryBlock :
+		public NonCopyable
+	{
+	public:
+		/// <summary>
+		/// Creates a new memory block with all of its memory free.
+		/// </summary>
+		/// <param name="memory"> The device memory backing the block. </param>
+		/// <param name="size"> The size of the block in bytes. </param>
+		/// <param name="memoryType"> The memory type the block was allocated from. </param>
+		/// <param name="mapped"> The persistently mapped memory, or nullptr if the block is not host visible. </param>
+		/// <param name="dedicated"> If the block holds a single resource, and is released with it. </param>
+		MemoryBlock(const VkDeviceMemory &memory, const VkDeviceSize &size, const uint32_t &memoryType, void *mapped = nullptr, const bool &dedicated = false);
+
+		/// <summary>
+		/// Takes a range from the smallest free range that fits it.
+		/// </summary>
+		/// <param name="size"> The size of the range in bytes. </param>
+		/// <param name="alignment"> The alignment of the range offset, a power of two. </param>
+		/// <returns> The offset of the range, or nothing if no free range fits. </returns>
+		std::optional<VkDeviceSize> Allocate(const VkDeviceSize &size, const VkDeviceSize &alignment);
+
+		/// <summary>
+		/// Returns a range, merging it with the free ranges next to it.
+		/// </summary>
+		/// <param name="offset"> The offset given by <seealso cref="#Allocate()"/>. </param>
+		/// <param name="size"> The size the range was allocated with. </param>
+		void Free(const VkDeviceSize &offset, const VkDeviceSize &size);
+
+		const VkDeviceMemory &GetMemory() const { return m_memory; }
+
+		const VkDeviceSize &GetSize() const { return m_size; }
+
+		const uint32_t &GetMemoryType() const { return m_memoryType; }
+
+		void *GetMapped() const { return m_mapped; }
+
+		const bool &IsDedicated() const { return m_dedicated; }
+
+		const VkDeviceSize &GetUsed() const { return m_used; }
+
+		const uint32_t &GetAllocationCount() const { return m_allocationCount; }
+
+		bool IsEmpty() const { return m_allocationCount == 0; }
+
+		std::size_t GetFreeRangeCount() const { return m_freeOffsets.size(); }
+
+		VkDeviceSize GetLargestFreeRange() const { return m_freeSizes.empty() ? 0 : m_freeSizes.rbegin()->first; }
+	private:
+		void InsertFree(const VkDeviceSize &offset, const VkDeviceSize &size);
+
+		void EraseFree(const std::map<VkDeviceSize, VkDeviceSize>::iterator &it);
+
+		VkDeviceMemory m_memory;
+		VkDeviceSize m_size;
+		uint32_t m_memoryType;
+		void *m_mapped;
+		bool m_dedicated;
+
+		VkDeviceSize m_used;
+		uint32_t m_allocationCount;
+		std::map<VkDeviceSize, VkDeviceSize> m_freeOffsets;
+		std::multimap<VkDeviceSize, VkDeviceSize> m_freeSizes;
+	};
+}
@@ -0,0 +1,134 @@
+#include "RingAllocator.hpp"
+
+#include <algorithm>
+
+namespace acid
+{
+	RingAllocator::RingAllocator(const VkDeviceSize &capacity, const VkBufferUsageFlags &usage) :
+		m_capacity(capacity),
+		m_usage(usage),
+		m_buffer(nullptr),
+		m_mapped(nullptr),
+		m_head(0),
+		m_tail(0),
+		m_allocated(0),
+		m_released(0),
+		m_frame(0),
+		m_serial(0)
+	{
+	}
+
+	void RingAllocator::BeginFrame(const std::size_t &frame)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (m_serial != 0)
+		{
+			m_pending.emplace_back(Marker{m_frame, m_serial, m_head, m_allocated});
+		}
+
+		// Frames finish in the order they were submitted, so every frame recorded before the last recording of this frame has been read too.
+		auto last = std::find_if(m_pending.begin(), m_pending.end(), [frame](const Marker &marker)
+		{
+			return marker.m_frame == frame;
+		});
+
+		if (last != m_pending.end())
+		{
+			auto serial = last->m_serial;
+			m_tail = last->m_head;
+			m_released = last->m_allocated;
+			m_pending.erase(m_pending.begin(), last + 1);
+			m_retired.erase(std::remove_if(m_retired.begin(), m_retired.end(), [serial](const Retired &retired)
+			{
+				return retired.m_serial <= serial;
+			}), m_retired.end());
+		}
+
+		m_frame = frame;
+		m_serial++;
+	}
+
+	RingAllocator::Region RingAllocator::Allocate(const VkDeviceSize &size, const VkDeviceSize &alignment)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto offset = TryAllocate(size, alignment);
+
+		if (!offset)
+		{
+			Grow(size);
+			offset = TryAllocate(size, alignment);
+		}
+
+		return Region{m_buffer->GetBuffer(), *offset, size, static_cast<char *>(m_mapped) + *offset};
+	}
+
+	std::optional<VkDeviceSize> RingAllocator::TryAllocate(const VkDeviceSize &size, const VkDeviceSize &alignment)
+	{
+		if (m_buffer == nullptr)
+		{
+			return std::nullopt;
+		}
+
+		auto capacity = m_buffer->GetSize();
+		auto offset = (m_head + alignment - 1) & ~(alignment - 1);
+		VkDeviceSize end;
+
+		if (m_head < m_tail)
+		{
+			// The free memory is between the head and the tail.
+			if (offset + size > m_tail)
+			{
+				return std::nullopt;
+			}
+
+			end = offset + size;
+		}
+		else if (m_head == m_tail && GetUsed() != 0)
+		{
+			return std::nullopt;
+		}
+		else if (offset + size <= capacity)
+		{
+			end = offset + size;
+		}
+		else if (size <= m_tail)
+		{
+			// Wraps around, the end of the buffer is skipped and released with this frame.
+			offset = 0;
+			end = capacity + size;
+		}
+		else
+		{
+			return std::nullopt;
+		}
+
+		m_allocated += end - m_head;
+		m_head = offset + size;
+		return offset;
+	}
+
+	void RingAllocator::Grow(const VkDeviceSize &size)
+	{
+		auto capacity = std::max(m_buffer == nullptr ? m_capacity : 2 * m_buffer->GetSize(), size);
+
+		if (m_buffer != nullptr)
+		{
+			m_retired.emplace_back(Retired{std::move(m_buffer), m_serial});
+		}
+
+		m_buffer = std::make_unique<Buffer>(capacity, m_usage, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+		m_buffer->Map(&m_mapped);
+
+		// The ranges in the old buffer are released with their frames, the new buffer starts empty.
+		m_head = 0;
+		m_tail = 0;
+		m_released = m_allocated;
+
+		for (auto &marker : m_pending)
+		{
+			marker.m_head = 0;
+			marker.m_allocated = m_allocated;
+		}
+	}
+}
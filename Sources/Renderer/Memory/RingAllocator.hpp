@@ -0,0 +1,89 @@
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "LinearAllocator.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// Gives out ranges of a mapped buffer for data that is written every frame, such as instances.
+	/// Ranges are taken back a whole frame at a time, once the frames fence shows the device has read them.
+	/// When a frame needs more than is free the buffer is replaced by one twice as large, the old buffer is kept until the frames using it are released.
+	/// Ranges can be taken from any thread while a frame is recorded.
+	/// </summary>
+	class ACID_EXPORT RingAllocator :
+		public NonCopyable
+	{
+	public:
+		using Region = LinearAllocator::Region;
+
+		/// <summary>
+		/// Creates a new ring allocator, the buffer is created with the first range.
+		/// </summary>
+		/// <param name="capacity"> The starting size of the buffer in bytes. </param>
+		/// <param name="usage"> Usage flag bitmask for the buffer. </param>
+		RingAllocator(const VkDeviceSize &capacity, const VkBufferUsageFlags &usage);
+
+		/// <summary>
+		/// Starts recording a frame, taking back the ranges given out the last time the frame was recorded.
+		/// Should be called after the frames fence has been waited on.
+		/// </summary>
+		/// <param name="frame"> The index of the frame in flight. </param>
+		void BeginFrame(const std::size_t &frame);
+
+		/// <summary>
+		/// Takes a range for the frame being recorded, growing the buffer if there is not enough free.
+		/// </summary>
+		/// <param name="size"> The size of the range in bytes. </param>
+		/// <param name="alignment"> The alignment of the range offset, a power of two. </param>
+		/// <returns> The range, valid until the frame is recorded again. </returns>
+		Region Allocate(const VkDeviceSize &size, const VkDeviceSize &alignment = 16);
+
+		VkDeviceSize GetCapacity() const { return m_buffer == nullptr ? m_capacity : m_buffer->GetSize(); }
+
+		/// <summary>
+		/// Gets the bytes held by frames that have not been released, including alignment padding.
+		/// </summary>
+		/// <returns> The used bytes. </returns>
+		VkDeviceSize GetUsed() const { return m_allocated - m_released; }
+	private:
+		/// <summary>
+		/// Where a recorded frame stopped, releasing the frame moves the tail up to its head.
+		/// </summary>
+		struct Marker
+		{
+			std::size_t m_frame;
+			uint64_t m_serial;
+			VkDeviceSize m_head;
+			VkDeviceSize m_allocated;
+		};
+
+		struct Retired
+		{
+			std::unique_ptr<Buffer> m_buffer;
+			uint64_t m_serial;
+		};
+
+		std::optional<VkDeviceSize> TryAllocate(const VkDeviceSize &size, const VkDeviceSize &alignment);
+
+		void Grow(const VkDeviceSize &size);
+
+		VkDeviceSize m_capacity;
+		VkBufferUsageFlags m_usage;
+		std::unique_ptr<Buffer> m_buffer;
+		void *m_mapped;
+		std::vector<Retired> m_retired;
+
+		std::deque<Marker> m_pending;
+		VkDeviceSize m_head;
+		VkDeviceSize m_tail;
+		VkDeviceSize m_allocated;
+		VkDeviceSize m_released;
+		std::size_t m_frame;
+		uint64_t m_serial;
+		std::mutex m_mutex;
+	};
+}
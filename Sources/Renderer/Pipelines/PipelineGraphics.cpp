@@ -16,7 +16,7 @@ namespace acid
 
 	PipelineGraphics::PipelineGraphics(Stage stage, std::vector<std::string> shaderStages, std::vector<Shader::VertexInput> vertexInputs, 
 		const Mode &mode, const Depth &depth, const VkPrimitiveTopology &topology, const VkPolygonMode &polygonMode, const VkCullModeFlags &cullMode, 
-		const bool &pushDescriptors, std::vector<Shader::Define> defines) :
+		const bool &pushDescriptors, std::vector<Shader::Define> defines, const Blend &blend) :
 		m_stage(std::move(stage)),
 		m_shaderStages(std::move(shaderStages)),
 		m_vertexInputs(std::move(vertexInputs)),
@@ -27,6 +27,7 @@ namespace acid
 		m_cullMode(cullMode),
 		m_pushDescriptors(pushDescriptors),
 		m_defines(std::move(defines)),
+		m_blend(blend),
 		m_shader(std::make_unique<Shader>(m_shaderStages.back())),
 		m_dynamicStates(std::vector<VkDynamicState>(DYNAMIC_STATES)),
 		m_descriptorSetLayout(VK_NULL_HANDLE),
@@ -256,7 +257,7 @@ namespace acid
 
 		m_blendAttachmentStates[0].blendEnable = VK_TRUE;
 		m_blendAttachmentStates[0].srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
-		m_blendAttachmentStates[0].dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+		m_blendAttachmentStates[0].dstColorBlendFactor = m_blend == Blend::Additive ? VK_BLEND_FACTOR_ONE : VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
 		m_blendAttachmentStates[0].colorBlendOp = VK_BLEND_OP_ADD;
 		m_blendAttachmentStates[0].srcAlphaBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
 		m_blendAttachmentStates[0].dstAlphaBlendFactor = VK_BLEND_FACTOR_DST_ALPHA;
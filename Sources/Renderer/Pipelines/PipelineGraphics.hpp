@@ -35,6 +35,11 @@ namespace acid
 			ReadWrite = Read | Write
 		};
 
+		enum class Blend
+		{
+			Alpha, Additive
+		};
+
 		/// <summary>
 		/// Creates a new pipeline.
 		/// </summary>
@@ -48,10 +53,11 @@ namespace acid
 		/// <param name="cullMode"> The vertex cull mode. </param>
 		/// <param name="pushDescriptors"> If no actual descriptor sets are allocated but instead pushed. </param>
 		/// <param name="defines"> A list of defines added to the top of each shader. </param>
+		/// <param name="blend"> How colours are blended onto the attachment, in polygon mode. </param>
 		PipelineGraphics(Stage stage, std::vector<std::string> shaderStages, std::vector<Shader::VertexInput> vertexInputs,
 			const Mode &mode = Mode::Polygon, const Depth &depthMode = Depth::ReadWrite, const VkPrimitiveTopology &topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, 
 			const VkPolygonMode &polygonMode = VK_POLYGON_MODE_FILL, const VkCullModeFlags &cullMode = VK_CULL_MODE_BACK_BIT,
-			const bool &pushDescriptors = false, std::vector<Shader::Define> defines = {});
+			const bool &pushDescriptors = false, std::vector<Shader::Define> defines = {}, const Blend &blend = Blend::Alpha);
 
 		~PipelineGraphics();
 
@@ -118,6 +124,8 @@ namespace acid
 
 		const std::vector<Shader::Define> &GetDefines() const { return m_defines; }
 
+		const Blend &GetBlend() const { return m_blend; }
+
 		const Shader *GetShaderProgram() const override { return m_shader.get(); }
 
 		const VkDescriptorSetLayout &GetDescriptorSetLayout() const override { return m_descriptorSetLayout; }
@@ -156,6 +164,7 @@ namespace acid
 		VkCullModeFlags m_cullMode;
 		bool m_pushDescriptors;
 		std::vector<Shader::Define> m_defines;
+		Blend m_blend;
 
 		std::unique_ptr<Shader> m_shader;
 
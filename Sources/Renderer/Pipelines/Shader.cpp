@@ -1,11 +1,15 @@
 #include "Shader.hpp"
 
+#include <cstring>
+#include <fstream>
 #include <utility>
 #include <SPIRV/GlslangToSpv.h>
 #include <glslang/Public/ShaderLang.h>
 #include "Renderer/Renderer.hpp"
 #include "Files/FileSystem.hpp"
+#include "Files/MappedFile.hpp"
 #include "Helpers/String.hpp"
+#include "Serialized/Binary/Binary.hpp"
 #include "Renderer/Buffers/StorageBuffer.hpp"
 #include "Renderer/Buffers/UniformBuffer.hpp"
 #include "Textures/Cubemap.hpp"
@@ -13,12 +17,40 @@
 
 namespace acid
 {
+	/// <summary>
+	/// Is hashed into every cache key, changing how stages are compiled or reflected should change this so old caches are ignored.
+	/// </summary>
+	static const uint32_t CACHE_VERSION = 1;
+	static const uint32_t SPIRV_MAGIC = 0x07230203;
+
+	std::string Shader::CACHE_DIRECTORY = "Cache";
+
+	Shader::Compiler::Compiler()
+	{
+		glslang::InitializeProcess();
+	}
+
+	Shader::Compiler::~Compiler()
+	{
+		glslang::FinalizeProcess();
+	}
+
 	Shader::Shader(std::string name) :
 		m_name(std::move(name)),
 		m_lastDescriptorBinding(0)
 	{
 	}
 
+	const std::string &Shader::GetCacheDirectory()
+	{
+		return CACHE_DIRECTORY;
+	}
+
+	void Shader::SetCacheDirectory(const std::string &cacheDirectory)
+	{
+		CACHE_DIRECTORY = cacheDirectory;
+	}
+
 	bool Shader::ReportedNotFound(const std::string &name, const bool &reportIfFound) const
 	{
 		if (std::find(m_notFoundNames.begin(), m_notFoundNames.end(), name) == m_notFoundNames.end())
@@ -437,63 +469,94 @@ namespace acid
 		return resources;
 	}
 
-	VkShaderModule Shader::ProcessShader(const std::string &shaderCode, const VkShaderStageFlags &stageFlag)
+	/// <summary>
+	/// Hashes bytes with 64 bit FNV-1a, the hash is the same on every platform and run so it can name files.
+	/// </summary>
+	static uint64_t HashBytes(const void *data, const std::size_t &size, uint64_t hash = 14695981039346656037ull)
 	{
-		auto logicalDevice = Renderer::Get()->GetLogicalDevice();
+		auto bytes = static_cast<const uint8_t *>(data);
 
-		// Starts converting GLSL to SPIR-V.
-		EShLanguage language = GetEshLanguage(stageFlag);
-		glslang::TProgram program;
-		glslang::TShader shader(language);
-		TBuiltInResource resources = GetResources();
+		for (std::size_t i = 0; i < size; i++)
+		{
+			hash = (hash ^ bytes[i]) * 1099511628211ull;
+		}
 
-		// Enable SPIR-V and Vulkan rules when parsing GLSL.
-		auto messages = static_cast<EShMessages>(EShMsgSpvRules | EShMsgVulkanRules | EShMsgDefault);
+		return hash;
+	}
+
+	std::vector<uint32_t> Shader::CompileStage(const std::string &shaderCode, const VkShaderStageFlags &stageFlag)
+	{
+		Shader stage(m_name);
+
+		if (CACHE_DIRECTORY.empty())
+		{
+			auto spirv = stage.CompileSpirv(shaderCode, stageFlag);
+			AddStage(stage);
+			return spirv;
+		}
+
+		// Debug builds compile differently, so they are cached separately.
 #if defined(ACID_VERBOSE)
-		messages = static_cast<EShMessages>(messages | EShMsgDebugInfo);
+		const uint32_t verbose = 1;
+#else
+		const uint32_t verbose = 0;
 #endif
+		auto key = HashBytes(shaderCode.data(), shaderCode.size());
+		key = HashBytes(&stageFlag, sizeof(stageFlag), key);
+		key = HashBytes(&verbose, sizeof(verbose), key);
+		key = HashBytes(&CACHE_VERSION, sizeof(CACHE_VERSION), key);
 
-		const char *shaderSource = shaderCode.c_str();
-		shader.setStrings(&shaderSource, 1);
+		char keyName[17];
+		std::snprintf(keyName, sizeof(keyName), "%016llx", static_cast<unsigned long long>(key));
+		auto spirvFilename = FileSystem::JoinPath({CACHE_DIRECTORY, std::string(keyName) + ".spv"});
+		auto reflectionFilename = FileSystem::JoinPath({CACHE_DIRECTORY, std::string(keyName) + Binary::Extension});
 
-		shader.setEnvInput(glslang::EShSourceGlsl, language, glslang::EShClientVulkan, 110);
-		shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_1);
-		shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_3);
+		// The reflection is written last and records the code size, so a entry that was not completely written is never used.
+		Binary reflection;
 
-		const int defaultVersion = glslang::EShTargetOpenGL_450;
-
-		if (!shader.parse(&resources, defaultVersion, false, messages))
+		if (FileSystem::Exists(reflectionFilename) && Binary::Load(&reflection, reflectionFilename))
 		{
-			Log::Out("%s\n", shader.getInfoLog());
-			Log::Out("%s\n", shader.getInfoDebugLog());
-			Log::Error("SPRIV shader compile failed!\n");
+			MappedFile spirvFile(spirvFilename);
+			auto wordCount = reflection.GetChild<uint32_t>("WordCount");
+
+			if (spirvFile.IsOpen() && spirvFile.GetSize() == wordCount * sizeof(uint32_t) && wordCount > 0)
+			{
+				std::vector<uint32_t> spirv(wordCount);
+				std::memcpy(spirv.data(), spirvFile.GetData(), spirvFile.GetSize());
+
+				if (spirv[0] == SPIRV_MAGIC)
+				{
+					stage.Decode(reflection);
+					AddStage(stage);
+					return spirv;
+				}
+			}
 		}
 
-		program.addShader(&shader);
+		auto spirv = stage.CompileSpirv(shaderCode, stageFlag);
+		AddStage(stage);
 
-		if (!program.link(messages) || !program.mapIO())
+		FileSystem::Create(spirvFilename);
+		std::ofstream spirvStream(spirvFilename, std::ios::binary | std::ios::trunc);
+		spirvStream.write(reinterpret_cast<const char *>(spirv.data()), spirv.size() * sizeof(uint32_t));
+		spirvStream.close();
+
+		if (!spirvStream.fail())
 		{
-			Log::Error("Error while linking shader program.\n");
+			Binary document;
+			stage.Encode(document);
+			document.SetChild("WordCount", static_cast<uint32_t>(spirv.size()));
+			std::ofstream reflectionStream(reflectionFilename, std::ios::binary | std::ios::trunc);
+			Binary::Write(document, &reflectionStream);
 		}
 
-		program.buildReflection();
-	//	program.dumpReflection();
-		LoadProgram(program, stageFlag);
-
-		glslang::SpvOptions spvOptions;
-#if defined(ACID_VERBOSE)
-		spvOptions.generateDebugInfo = true;
-		spvOptions.disableOptimizer = true;
-		spvOptions.optimizeSize = false;
-#else
-		spvOptions.generateDebugInfo = false;
-		spvOptions.disableOptimizer = false;
-		spvOptions.optimizeSize = true;
-#endif
+		return spirv;
+	}
 
-		spv::SpvBuildLogger logger;
-		std::vector<uint32_t> spirv;
-		GlslangToSpv(*program.getIntermediate((EShLanguage)language), spirv, &logger, &spvOptions);
+	VkShaderModule Shader::ProcessShader(const std::string &shaderCode, const VkShaderStageFlags &stageFlag)
+	{
+		auto logicalDevice = Renderer::Get()->GetLogicalDevice();
+		auto spirv = CompileStage(shaderCode, stageFlag);
 
 		VkShaderModuleCreateInfo shaderModuleCreateInfo = {};
 		shaderModuleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
@@ -505,6 +568,104 @@ namespace acid
 		return shaderModule;
 	}
 
+	void Shader::Decode(const Metadata &metadata)
+	{
+		m_uniforms.clear();
+		m_uniformBlocks.clear();
+		m_attributes.clear();
+
+		auto decodeUniform = [](const Metadata *node)
+		{
+			return std::make_unique<Uniform>(node->GetChild<int32_t>("Binding"), node->GetChild<int32_t>("Offset"), node->GetChild<int32_t>("Size"),
+				node->GetChild<int32_t>("GlType"), node->GetChild<bool>("ReadOnly"), node->GetChild<bool>("WriteOnly"), node->GetChild<VkShaderStageFlags>("StageFlags"));
+		};
+
+		if (auto uniforms = metadata.FindChild("Uniforms", false); uniforms != nullptr)
+		{
+			for (const auto &node : uniforms->GetChildren())
+			{
+				m_uniforms.emplace(node->GetName(), decodeUniform(node.get()));
+			}
+		}
+
+		if (auto uniformBlocks = metadata.FindChild("UniformBlocks", false); uniformBlocks != nullptr)
+		{
+			for (const auto &node : uniformBlocks->GetChildren())
+			{
+				auto uniformBlock = std::make_unique<UniformBlock>(node->GetChild<int32_t>("Binding"), node->GetChild<int32_t>("Size"),
+					node->GetChild<VkShaderStageFlags>("StageFlags"), static_cast<UniformBlock::Type>(node->GetChild<int32_t>("Type")));
+
+				if (auto uniforms = node->FindChild("Uniforms", false); uniforms != nullptr)
+				{
+					for (const auto &uniformNode : uniforms->GetChildren())
+					{
+						uniformBlock->m_uniforms.emplace(uniformNode->GetName(), decodeUniform(uniformNode.get()));
+					}
+				}
+
+				m_uniformBlocks.emplace(node->GetName(), std::move(uniformBlock));
+			}
+		}
+
+		if (auto attributes = metadata.FindChild("Attributes", false); attributes != nullptr)
+		{
+			for (const auto &node : attributes->GetChildren())
+			{
+				m_attributes.emplace(node->GetName(), std::make_unique<Attribute>(node->GetChild<int32_t>("Set"), node->GetChild<int32_t>("Location"),
+					node->GetChild<int32_t>("Size"), node->GetChild<int32_t>("GlType")));
+			}
+		}
+	}
+
+	void Shader::Encode(Metadata &metadata) const
+	{
+		auto encodeUniform = [](Metadata *node, const Uniform &uniform)
+		{
+			node->SetChild("Binding", uniform.m_binding);
+			node->SetChild("Offset", uniform.m_offset);
+			node->SetChild("Size", uniform.m_size);
+			node->SetChild("GlType", uniform.m_glType);
+			node->SetChild("ReadOnly", uniform.m_readOnly);
+			node->SetChild("WriteOnly", uniform.m_writeOnly);
+			node->SetChild("StageFlags", uniform.m_stageFlags);
+		};
+
+		auto uniforms = metadata.CreateChild("Uniforms");
+
+		for (const auto &[uniformName, uniform] : m_uniforms)
+		{
+			encodeUniform(uniforms->CreateChild(uniformName), *uniform);
+		}
+
+		auto uniformBlocks = metadata.CreateChild("UniformBlocks");
+
+		for (const auto &[uniformBlockName, uniformBlock] : m_uniformBlocks)
+		{
+			auto node = uniformBlocks->CreateChild(uniformBlockName);
+			node->SetChild("Binding", uniformBlock->m_binding);
+			node->SetChild("Size", uniformBlock->m_size);
+			node->SetChild("StageFlags", uniformBlock->m_stageFlags);
+			node->SetChild("Type", static_cast<int32_t>(uniformBlock->m_type));
+			auto blockUniforms = node->CreateChild("Uniforms");
+
+			for (const auto &[uniformName, uniform] : uniformBlock->m_uniforms)
+			{
+				encodeUniform(blockUniforms->CreateChild(uniformName), *uniform);
+			}
+		}
+
+		auto attributes = metadata.CreateChild("Attributes");
+
+		for (const auto &[attributeName, attribute] : m_attributes)
+		{
+			auto node = attributes->CreateChild(attributeName);
+			node->SetChild("Set", attribute->m_set);
+			node->SetChild("Location", attribute->m_location);
+			node->SetChild("Size", attribute->m_size);
+			node->SetChild("GlType", attribute->m_glType);
+		}
+	}
+
 	std::string Shader::ToString() const
 	{
 		std::stringstream result;
@@ -566,6 +727,106 @@ namespace acid
 		}
 	}
 
+	std::vector<uint32_t> Shader::CompileSpirv(const std::string &shaderCode, const VkShaderStageFlags &stageFlag)
+	{
+		// Starts converting GLSL to SPIR-V.
+		EShLanguage language = GetEshLanguage(stageFlag);
+		glslang::TProgram program;
+		glslang::TShader shader(language);
+		TBuiltInResource resources = GetResources();
+
+		// Enable SPIR-V and Vulkan rules when parsing GLSL.
+		auto messages = static_cast<EShMessages>(EShMsgSpvRules | EShMsgVulkanRules | EShMsgDefault);
+#if defined(ACID_VERBOSE)
+		messages = static_cast<EShMessages>(messages | EShMsgDebugInfo);
+#endif
+
+		const char *shaderSource = shaderCode.c_str();
+		shader.setStrings(&shaderSource, 1);
+
+		shader.setEnvInput(glslang::EShSourceGlsl, language, glslang::EShClientVulkan, 110);
+		shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_1);
+		shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_3);
+
+		const int defaultVersion = glslang::EShTargetOpenGL_450;
+
+		if (!shader.parse(&resources, defaultVersion, false, messages))
+		{
+			Log::Out("%s\n", shader.getInfoLog());
+			Log::Out("%s\n", shader.getInfoDebugLog());
+			Log::Error("SPRIV shader compile failed!\n");
+		}
+
+		program.addShader(&shader);
+
+		if (!program.link(messages) || !program.mapIO())
+		{
+			Log::Error("Error while linking shader program.\n");
+		}
+
+		program.buildReflection();
+	//	program.dumpReflection();
+		LoadProgram(program, stageFlag);
+
+		glslang::SpvOptions spvOptions;
+#if defined(ACID_VERBOSE)
+		spvOptions.generateDebugInfo = true;
+		spvOptions.disableOptimizer = true;
+		spvOptions.optimizeSize = false;
+#else
+		spvOptions.generateDebugInfo = false;
+		spvOptions.disableOptimizer = false;
+		spvOptions.optimizeSize = true;
+#endif
+
+		spv::SpvBuildLogger logger;
+		std::vector<uint32_t> spirv;
+		GlslangToSpv(*program.getIntermediate((EShLanguage)language), spirv, &logger, &spvOptions);
+		return spirv;
+	}
+
+	void Shader::AddStage(const Shader &stage)
+	{
+		for (const auto &[uniformBlockName, stageBlock] : stage.m_uniformBlocks)
+		{
+			auto it = m_uniformBlocks.find(uniformBlockName);
+
+			if (it == m_uniformBlocks.end())
+			{
+				it = m_uniformBlocks.emplace(uniformBlockName, std::make_unique<UniformBlock>(stageBlock->m_binding, stageBlock->m_size,
+					stageBlock->m_stageFlags, stageBlock->m_type)).first;
+			}
+			else
+			{
+				it->second->m_stageFlags |= stageBlock->m_stageFlags;
+			}
+
+			for (const auto &[uniformName, uniform] : stageBlock->m_uniforms)
+			{
+				it->second->m_uniforms.emplace(uniformName, std::make_unique<Uniform>(*uniform));
+			}
+		}
+
+		for (const auto &[uniformName, stageUniform] : stage.m_uniforms)
+		{
+			auto it = m_uniforms.find(uniformName);
+
+			if (it == m_uniforms.end())
+			{
+				m_uniforms.emplace(uniformName, std::make_unique<Uniform>(*stageUniform));
+			}
+			else
+			{
+				it->second->m_stageFlags |= stageUniform->m_stageFlags;
+			}
+		}
+
+		for (const auto &[attributeName, attribute] : stage.m_attributes)
+		{
+			m_attributes.emplace(attributeName, std::make_unique<Attribute>(*attribute));
+		}
+	}
+
 	void Shader::LoadProgram(const glslang::TProgram &program, const VkShaderStageFlags &stageFlag)
 	{
 		for (int32_t i = program.getNumLiveUniformBlocks() - 1; i >= 0; i--)
@@ -8,6 +8,7 @@
 #include <vector>
 #include <vulkan/vulkan.h>
 #include "Helpers/NonCopyable.hpp"
+#include "Serialized/Metadata.hpp"
 
 namespace glslang
 {
@@ -204,8 +205,32 @@ namespace acid
 			int32_t m_glType;
 		};
 
+		/// <summary>
+		/// Keeps the GLSL compiler initialized while a instance exists, the renderer holds one for its lifetime.
+		/// </summary>
+		class ACID_EXPORT Compiler :
+			public NonCopyable
+		{
+		public:
+			Compiler();
+
+			~Compiler();
+		};
+
 		explicit Shader(std::string name);
 
+		/// <summary>
+		/// Gets the directory compiled shaders and the pipeline cache are stored in.
+		/// </summary>
+		/// <returns> The cache directory, empty if caching is disabled. </returns>
+		static const std::string &GetCacheDirectory();
+
+		/// <summary>
+		/// Sets the directory compiled shaders and the pipeline cache are stored in.
+		/// </summary>
+		/// <param name="cacheDirectory"> The cache directory, or empty to disable caching. </param>
+		static void SetCacheDirectory(const std::string &cacheDirectory);
+
 		const std::string &GetName() const { return m_name; }
 
 		bool ReportedNotFound(const std::string &name, const bool &reportIfFound) const;
@@ -246,10 +271,31 @@ namespace acid
 
 		static std::string ProcessIncludes(const std::string &shaderCode);
 
+		/// <summary>
+		/// Gets the SPIR-V of a stage, the shader cache is keyed by a hash of the processed code and the stage.
+		/// A stage missing from the cache is compiled and added to it, either way its reflection is added to this shader.
+		/// </summary>
+		/// <param name="shaderCode"> The GLSL code, with defines and includes already processed. </param>
+		/// <param name="stageFlag"> The stage the code is for. </param>
+		/// <returns> The SPIR-V code. </returns>
+		std::vector<uint32_t> CompileStage(const std::string &shaderCode, const VkShaderStageFlags &stageFlag);
+
 		VkShaderModule ProcessShader(const std::string &shaderCode, const VkShaderStageFlags &stageFlag);
 
+		void Decode(const Metadata &metadata);
+
+		void Encode(Metadata &metadata) const;
+
 		std::string ToString() const;
 	private:
+		std::vector<uint32_t> CompileSpirv(const std::string &shaderCode, const VkShaderStageFlags &stageFlag);
+
+		/// <summary>
+		/// Adds the reflection of a single stage to this shader, values found in earlier stages are shared with the new stage.
+		/// </summary>
+		/// <param name="stage"> The reflection of the stage. </param>
+		void AddStage(const Shader &stage);
+
 		static void IncrementDescriptorPool(std::map<VkDescriptorType, uint32_t> &descriptorPoolCounts, const VkDescriptorType &type);
 
 		void LoadProgram(const glslang::TProgram &program, const VkShaderStageFlags &stageFlag);
@@ -277,5 +323,7 @@ namespace acid
 		std::vector<VkVertexInputAttributeDescription> m_attributeDescriptions;
 
 		mutable std::vector<std::string> m_notFoundNames;
+
+		static ACID_STATE std::string CACHE_DIRECTORY;
 	};
 }
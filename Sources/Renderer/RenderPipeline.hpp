@@ -29,6 +29,13 @@ namespace acid
 		/// <param name="commandBuffer"> The command buffer to record render command into. </param>
 		virtual void Render(const CommandBuffer &commandBuffer) = 0;
 
+		/// <summary>
+		/// Gets if this can be recorded on a worker thread at the same time as the other render pipelines in its subpass.
+		/// Only render pipelines that do not change state shared with other render pipelines should return true.
+		/// </summary>
+		/// <returns> If this can be recorded in parallel. </returns>
+		virtual bool IsParallel() const { return false; }
+
 		const Pipeline::Stage &GetStage() const { return m_stage; }
 
 		const bool &IsEnabled() const { return m_enabled; };
@@ -1,25 +1,53 @@
 #include "Renderer.hpp"
 
+#include <algorithm>
 #include <cassert>
-#include <SPIRV/GlslangToSpv.h>
+#include <cstring>
+#include <fstream>
 #include "Files/FileSystem.hpp"
+#include "Threads/JobSystem.hpp"
 #include "RenderPipeline.hpp"
 
 namespace acid
 {
+	static const VkDeviceSize FRAME_ALLOCATOR_CAPACITY = 4 * 1024 * 1024;
+
+	/// <summary>
+	/// Sets the viewport and scissor to cover a render area, secondary command buffers do not inherit them so each sets its own.
+	/// </summary>
+	static void CmdSetViewport(const VkCommandBuffer &commandBuffer, const VkExtent2D &extent)
+	{
+		VkViewport viewport = {};
+		viewport.x = 0.0f;
+		viewport.y = 0.0f;
+		viewport.width = static_cast<float>(extent.width);
+		viewport.height = static_cast<float>(extent.height);
+		viewport.minDepth = 0.0f;
+		viewport.maxDepth = 1.0f;
+		vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+		VkRect2D scissor = {};
+		scissor.offset = {0, 0};
+		scissor.extent = extent;
+		vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+	}
+
 	Renderer::Renderer() :
 		m_renderManager(nullptr),
 		m_swapchain(nullptr),
 		m_pipelineCache(VK_NULL_HANDLE),
 		m_commandPool(VK_NULL_HANDLE),
 		m_currentFrame(0),
+		m_multithreaded(false),
+		m_recordTime(Time::Zero),
 		m_instance(std::make_unique<Instance>()),
 		m_physicalDevice(std::make_unique<PhysicalDevice>(m_instance.get())),
 		m_surface(std::make_unique<Surface>(m_instance.get(), m_physicalDevice.get())),
-		m_logicalDevice(std::make_unique<LogicalDevice>(m_instance.get(), m_physicalDevice.get(), m_surface.get()))
+		m_logicalDevice(std::make_unique<LogicalDevice>(m_instance.get(), m_physicalDevice.get(), m_surface.get())),
+		m_memoryAllocator(std::make_unique<MemoryAllocator>(m_physicalDevice.get(), m_logicalDevice.get())),
+		m_frameAllocator(std::make_unique<RingAllocator>(FRAME_ALLOCATOR_CAPACITY, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT)),
+		m_uploadQueue(std::make_unique<UploadQueue>(m_logicalDevice.get()))
 	{
-		glslang::InitializeProcess();
-
 		CreateCommandPool();
 		CreatePipelineCache();
 	}
@@ -30,8 +58,7 @@ namespace acid
 
 		CheckVk(vkQueueWaitIdle(graphicsQueue));
 
-		glslang::FinalizeProcess();
-
+		SavePipelineCache();
 		vkDestroyPipelineCache(m_logicalDevice->GetLogicalDevice(), m_pipelineCache, nullptr);
 
 		for (size_t i = 0; i < m_flightFences.size(); i++)
@@ -41,11 +68,22 @@ namespace acid
 			vkDestroySemaphore(m_logicalDevice->GetLogicalDevice(), m_presentCompletes[i], nullptr);
 		}
 
+		m_commandPools.clear();
 		vkDestroyCommandPool(m_logicalDevice->GetLogicalDevice(), m_commandPool, nullptr);
+
+		// Everything holding device memory is destroyed before the memory allocator.
+		m_uploadQueue = nullptr;
+		m_renderManager = nullptr;
+		m_renderStages.clear();
+		m_swapchain = nullptr;
+		m_frameAllocator = nullptr;
 	}
 
 	void Renderer::Update()
 	{
+		// Uploads recorded since the last frame are submitted ahead of it, so the frame can draw with them.
+		m_uploadQueue->Update();
+
 		if (m_renderManager == nullptr || Window::Get()->IsIconified())
 		{
 			return;
@@ -76,6 +114,11 @@ namespace acid
 			return;
 		}
 
+		// Subpasses recorded on worker threads can only contain secondary command buffers, so the choice is kept for the whole frame.
+		auto multithreaded = m_multithreaded;
+		auto subpassContents = multithreaded ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE;
+		m_recordTime = Time::Zero;
+
 		for (auto &[key, renderPipelines] : stages)
 		{
 			if (renderpass != key.first)
@@ -92,7 +135,7 @@ namespace acid
 				// Starts the next renderpass.
 				auto renderStage = GetRenderStage(*renderpass);
 				renderStage->Update();
-				auto startResult = StartRenderpass(*renderStage);
+				auto startResult = StartRenderpass(*renderStage, subpassContents);
 
 				if (!startResult)
 				{
@@ -114,22 +157,14 @@ namespace acid
 
 				for (uint32_t d = 0; d < difference; d++)
 				{
-					vkCmdNextSubpass(m_commandBuffers[m_swapchain->GetActiveImageIndex()]->GetCommandBuffer(), VK_SUBPASS_CONTENTS_INLINE);
+					vkCmdNextSubpass(m_commandBuffers[m_swapchain->GetActiveImageIndex()]->GetCommandBuffer(), subpassContents);
 				}
 
 				subpass = key.second;
 			}
 
 			// Renders subpass render pipeline.
-			for (auto &renderPipeline : renderPipelines)
-			{
-				if (!renderPipeline->IsEnabled())
-				{
-					continue;
-				}
-
-				renderPipeline->Render(*m_commandBuffers[m_swapchain->GetActiveImageIndex()]);
-			}
+			RecordSubpass(*renderStage, subpass, renderPipelines, multithreaded);
 		}
 
 		// Ends the last renderpass.
@@ -231,7 +266,7 @@ namespace acid
 
 		VkImage srcImage = m_swapchain->GetActiveImage();
 		VkImage dstImage;
-		VkDeviceMemory dstImageMemory;
+		MemoryAllocation dstImageMemory;
 		bool supportsBlit = Texture::CopyImage(srcImage, dstImage, dstImageMemory, width, height, true, 0, 1);
 
 		// Get layout of the image (including row pitch).
@@ -244,10 +279,8 @@ namespace acid
 		// Creates the screenshot image file.
 		FileSystem::Create(filename);
 
-		// Map image memory so we can start copying from it.
-		char *data;
-		vkMapMemory(m_logicalDevice->GetLogicalDevice(), dstImageMemory, 0, VK_WHOLE_SIZE, 0, (void **)&data);
-		data += subresourceLayout.offset;
+		// The image memory is mapped by the allocator, copies start at the subresource.
+		auto data = static_cast<char *>(dstImageMemory.GetMapped()) + subresourceLayout.offset;
 
 		// If source is BGR (destination is always RGB) and we can't use blit (which does automatic conversion), we'll have to manually swizzle color components
 		bool colourSwizzle = false;
@@ -281,9 +314,8 @@ namespace acid
 		Texture::WritePixels(filename, pixels.get(), width, height, 4);
 
 		// Clean up resources.
-		vkUnmapMemory(m_logicalDevice->GetLogicalDevice(), dstImageMemory);
-		vkFreeMemory(m_logicalDevice->GetLogicalDevice(), dstImageMemory, nullptr);
 		vkDestroyImage(m_logicalDevice->GetLogicalDevice(), dstImage, nullptr);
+		m_memoryAllocator->Free(dstImageMemory);
 
 #if defined(ACID_VERBOSE)
 		auto debugEnd = Engine::GetTime();
@@ -342,6 +374,16 @@ namespace acid
 
 				m_commandBuffers[i] = std::make_unique<CommandBuffer>(false);
 			}
+
+			m_commandPools.resize(m_swapchain->GetImageCount());
+
+			for (auto &commandPools : m_commandPools)
+			{
+				while (commandPools.size() < JobSystem::Get()->GetThreadCount() + 1)
+				{
+					commandPools.emplace_back(std::make_unique<CommandPool>());
+				}
+			}
 		}
 
 		for (const auto &renderStage : renderStages)
@@ -376,13 +418,84 @@ namespace acid
 		CheckVk(vkCreateCommandPool(m_logicalDevice->GetLogicalDevice(), &commandPoolCreateInfo, nullptr, &m_commandPool));
 	}
 
+	/// <summary>
+	/// Gets the file the pipeline cache is saved to, or a empty string if caching is disabled.
+	/// </summary>
+	static std::string GetPipelineCacheFilename()
+	{
+		if (Shader::GetCacheDirectory().empty())
+		{
+			return "";
+		}
+
+		return FileSystem::JoinPath({Shader::GetCacheDirectory(), "Pipelines.cache"});
+	}
+
 	void Renderer::CreatePipelineCache()
 	{
+		auto filename = GetPipelineCacheFilename();
+		std::optional<std::vector<char>> data;
+
+		if (!filename.empty() && FileSystem::Exists(filename))
+		{
+			data = FileSystem::ReadBinaryFile(filename);
+		}
+
+		// Drivers are not required to reject a cache from a different device, so the header is checked before it is used.
+		auto &properties = m_physicalDevice->GetProperties();
+
+		if (data)
+		{
+			// The header is the header size, header version, vendor id and device id, followed by the cache UUID.
+			uint32_t header[4] = {};
+
+			if (data->size() < sizeof(header) + VK_UUID_SIZE)
+			{
+				data = {};
+			}
+			else
+			{
+				std::memcpy(header, data->data(), sizeof(header));
+
+				if (header[1] != VK_PIPELINE_CACHE_HEADER_VERSION_ONE || header[2] != properties.vendorID || header[3] != properties.deviceID ||
+					std::memcmp(data->data() + sizeof(header), properties.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+				{
+					data = {};
+				}
+			}
+		}
+
 		VkPipelineCacheCreateInfo pipelineCacheCreateInfo = {};
 		pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+
+		if (data)
+		{
+			pipelineCacheCreateInfo.initialDataSize = data->size();
+			pipelineCacheCreateInfo.pInitialData = data->data();
+		}
+
 		CheckVk(vkCreatePipelineCache(m_logicalDevice->GetLogicalDevice(), &pipelineCacheCreateInfo, nullptr, &m_pipelineCache));
 	}
 
+	void Renderer::SavePipelineCache() const
+	{
+		auto filename = GetPipelineCacheFilename();
+
+		if (filename.empty())
+		{
+			return;
+		}
+
+		std::size_t size = 0;
+		CheckVk(vkGetPipelineCacheData(m_logicalDevice->GetLogicalDevice(), m_pipelineCache, &size, nullptr));
+		std::vector<char> data(size);
+		CheckVk(vkGetPipelineCacheData(m_logicalDevice->GetLogicalDevice(), m_pipelineCache, &size, data.data()));
+
+		FileSystem::Create(filename);
+		std::ofstream outStream(filename, std::ios::binary | std::ios::trunc);
+		outStream.write(data.data(), size);
+	}
+
 	void Renderer::RecreatePass(RenderStage &renderStage)
 	{
 		auto graphicsQueue = m_logicalDevice->GetGraphicsQueue();
@@ -416,7 +529,7 @@ namespace acid
 		}
 	}
 
-	bool Renderer::StartRenderpass(RenderStage &renderStage)
+	bool Renderer::StartRenderpass(RenderStage &renderStage, const VkSubpassContents &contents)
 	{
 		if (renderStage.IsOutOfDate())
 		{
@@ -427,6 +540,13 @@ namespace acid
 		if (!m_commandBuffers[m_swapchain->GetActiveImageIndex()]->IsRunning())
 		{
 			CheckVk(vkWaitForFences(m_logicalDevice->GetLogicalDevice(), 1, &m_flightFences[m_currentFrame], VK_TRUE, std::numeric_limits<uint64_t>::max()));
+			m_frameAllocator->BeginFrame(m_currentFrame);
+
+			for (auto &commandPool : m_commandPools[m_currentFrame])
+			{
+				commandPool->Reset();
+			}
+
 			m_commandBuffers[m_swapchain->GetActiveImageIndex()]->Begin(VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT);
 		}
 
@@ -437,19 +557,7 @@ namespace acid
 			renderStage.GetHeight()
 		};
 
-		VkViewport viewport = {};
-		viewport.x = 0.0f;
-		viewport.y = 0.0f;
-		viewport.width = static_cast<float>(renderArea.extent.width);
-		viewport.height = static_cast<float>(renderArea.extent.height);
-		viewport.minDepth = 0.0f;
-		viewport.maxDepth = 1.0f;
-		vkCmdSetViewport(m_commandBuffers[m_swapchain->GetActiveImageIndex()]->GetCommandBuffer(), 0, 1, &viewport);
-
-		VkRect2D scissor = {};
-		scissor.offset = {0, 0};
-		scissor.extent = renderArea.extent;
-		vkCmdSetScissor(m_commandBuffers[m_swapchain->GetActiveImageIndex()]->GetCommandBuffer(), 0, 1, &scissor);
+		CmdSetViewport(m_commandBuffers[m_swapchain->GetActiveImageIndex()]->GetCommandBuffer(), renderArea.extent);
 
 		auto clearValues = renderStage.GetClearValues();
 
@@ -460,7 +568,7 @@ namespace acid
 		renderPassBeginInfo.renderArea = renderArea;
 		renderPassBeginInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
 		renderPassBeginInfo.pClearValues = clearValues.data();
-		vkCmdBeginRenderPass(m_commandBuffers[m_swapchain->GetActiveImageIndex()]->GetCommandBuffer(), &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+		vkCmdBeginRenderPass(m_commandBuffers[m_swapchain->GetActiveImageIndex()]->GetCommandBuffer(), &renderPassBeginInfo, contents);
 
 		return true;
 	}
@@ -492,4 +600,99 @@ namespace acid
 
 		m_currentFrame = (m_currentFrame + 1) % m_swapchain->GetImageCount();
 	}
+	void Renderer::RecordSubpass(RenderStage &renderStage, const uint32_t &subpass, const std::vector<std::unique_ptr<RenderPipeline>> &renderPipelines,
+		const bool &multithreaded)
+	{
+		auto recordStart = Engine::GetTime();
+		auto &commandBuffer = *m_commandBuffers[m_swapchain->GetActiveImageIndex()];
+
+		if (!multithreaded)
+		{
+			for (auto &renderPipeline : renderPipelines)
+			{
+				if (!renderPipeline->IsEnabled())
+				{
+					continue;
+				}
+
+				renderPipeline->Render(commandBuffer);
+			}
+
+			m_recordTime += Engine::GetTime() - recordStart;
+			return;
+		}
+
+		VkCommandBufferInheritanceInfo inheritanceInfo = {};
+		inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		inheritanceInfo.renderPass = renderStage.GetRenderpass()->GetRenderpass();
+		inheritanceInfo.subpass = subpass;
+		inheritanceInfo.framebuffer = renderStage.GetActiveFramebuffer(m_swapchain->GetActiveImageIndex());
+
+		VkExtent2D extent = {
+			renderStage.GetWidth(),
+			renderStage.GetHeight()
+		};
+
+		auto jobSystem = JobSystem::Get();
+		auto &commandPools = m_commandPools[m_currentFrame];
+		std::vector<VkCommandBuffer> secondaries(renderPipelines.size(), VK_NULL_HANDLE);
+
+		// Each render pipeline gets its own secondary command buffer, so they are executed in the same order whichever thread recorded them.
+		auto record = [&](CommandPool &commandPool, const std::size_t &index)
+		{
+			auto &secondary = commandPool.Next();
+			secondary.Begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT, &inheritanceInfo);
+			CmdSetViewport(secondary.GetCommandBuffer(), extent);
+			renderPipelines[index]->Render(secondary);
+			secondary.End();
+			secondaries[index] = secondary.GetCommandBuffer();
+		};
+
+		std::vector<std::size_t> parallel;
+
+		for (std::size_t i = 0; i < renderPipelines.size(); i++)
+		{
+			if (renderPipelines[i]->IsEnabled() && renderPipelines[i]->IsParallel())
+			{
+				parallel.emplace_back(i);
+			}
+		}
+
+		// A command pool is only used by one job at a time, so each job records every jobCount'th parallel render pipeline into its own pool.
+		auto jobCount = std::min(parallel.size(), commandPools.size() - 1);
+		JobCounter counter;
+
+		for (std::size_t job = 0; job < jobCount; job++)
+		{
+			jobSystem->Run([&record, &parallel, &commandPools, job, jobCount]()
+			{
+				for (auto i = job; i < parallel.size(); i += jobCount)
+				{
+					record(*commandPools[job], parallel[i]);
+				}
+			}, &counter);
+		}
+
+		// Render pipelines that share state are recorded here in order, while the jobs record the rest.
+		for (std::size_t i = 0; i < renderPipelines.size(); i++)
+		{
+			if (!renderPipelines[i]->IsEnabled() || renderPipelines[i]->IsParallel())
+			{
+				continue;
+			}
+
+			record(*commandPools.back(), i);
+		}
+
+		jobSystem->Wait(counter);
+
+		secondaries.erase(std::remove(secondaries.begin(), secondaries.end(), VK_NULL_HANDLE), secondaries.end());
+
+		if (!secondaries.empty())
+		{
+			vkCmdExecuteCommands(commandBuffer.GetCommandBuffer(), static_cast<uint32_t>(secondaries.size()), secondaries.data());
+		}
+
+		m_recordTime += Engine::GetTime() - recordStart;
+	}
 }
@@ -3,11 +3,16 @@
 #include <vulkan/vulkan.h>
 #include "Engine/Engine.hpp"
 #include "Commands/CommandBuffer.hpp"
+#include "Commands/CommandPool.hpp"
+#include "Commands/UploadQueue.hpp"
 #include "Devices/Instance.hpp"
 #include "Devices/LogicalDevice.hpp"
 #include "Devices/PhysicalDevice.hpp"
 #include "Devices/Surface.hpp"
 #include "Devices/Window.hpp"
+#include "Memory/MemoryAllocator.hpp"
+#include "Memory/RingAllocator.hpp"
+#include "Pipelines/Shader.hpp"
 #include "RenderManager.hpp"
 #include "RenderStage.hpp"
 
@@ -65,24 +70,80 @@ namespace acid
 
 		const VkPipelineCache &GetPipelineCache() const { return m_pipelineCache; }
 
+		/// <summary>
+		/// Gets the index of the frame in flight being recorded, resources written each frame can be buffered by this index.
+		/// </summary>
+		/// <returns> The current frame, less than the swapchain image count. </returns>
+		const size_t &GetCurrentFrame() const { return m_currentFrame; }
+
 		const PhysicalDevice *GetPhysicalDevice() const { return m_physicalDevice.get(); }
 
 		const Surface *GetSurface() const { return m_surface.get(); }
 
 		const LogicalDevice *GetLogicalDevice() const { return m_logicalDevice.get(); }
+
+		/// <summary>
+		/// Gets the allocator that buffer and image memory is taken from.
+		/// </summary>
+		/// <returns> The memory allocator. </returns>
+		MemoryAllocator *GetMemoryAllocator() const { return m_memoryAllocator.get(); }
+
+		/// <summary>
+		/// Gets the ring allocator for vertex data written every frame, its ranges are released when the frame is next recorded.
+		/// </summary>
+		/// <returns> The frame allocator. </returns>
+		RingAllocator *GetFrameAllocator() const { return m_frameAllocator.get(); }
+
+		/// <summary>
+		/// Gets the queue buffer and image data is uploaded through, its batches are submitted before each frame is recorded.
+		/// </summary>
+		/// <returns> The upload queue. </returns>
+		UploadQueue *GetUploadQueue() const { return m_uploadQueue.get(); }
+
+		/// <summary>
+		/// Gets if the render pipelines of each subpass are recorded into secondary command buffers on worker threads.
+		/// </summary>
+		/// <returns> If recording is multithreaded. </returns>
+		const bool &IsMultithreaded() const { return m_multithreaded; }
+
+		/// <summary>
+		/// Sets if the render pipelines of each subpass are recorded into secondary command buffers on worker threads, and executed in order.
+		/// Render pipelines that are not parallel are still recorded one after another, on the thread updating the renderer.
+		/// </summary>
+		/// <param name="multithreaded"> If recording is multithreaded, takes effect from the next frame. </param>
+		void SetMultithreaded(const bool &multithreaded) { m_multithreaded = multithreaded; }
+
+		/// <summary>
+		/// Gets the time the CPU spent recording render pipelines in the last frame, summed over every subpass.
+		/// </summary>
+		/// <returns> The record time. </returns>
+		const Time &GetRecordTime() const { return m_recordTime; }
 	private:
 		void CreateCommandPool();
 
+		/// <summary>
+		/// Creates the pipeline cache, filled with the cache saved by the last run if it was saved by the same device and driver.
+		/// </summary>
 		void CreatePipelineCache();
 
+		void SavePipelineCache() const;
+
 		void RecreatePass(RenderStage &renderStage);
 
 		void RecreateAttachmentsMap();
 
-		bool StartRenderpass(RenderStage &renderStage);
+		bool StartRenderpass(RenderStage &renderStage, const VkSubpassContents &contents);
 
 		void EndRenderpass(RenderStage &renderStage);
 
+		/// <summary>
+		/// Records the enabled render pipelines of a subpass, straight into the frames command buffer or into secondary command buffers that it executes.
+		/// </summary>
+		void RecordSubpass(RenderStage &renderStage, const uint32_t &subpass, const std::vector<std::unique_ptr<RenderPipeline>> &renderPipelines,
+			const bool &multithreaded);
+
+		Shader::Compiler m_shaderCompiler;
+
 		std::unique_ptr<RenderManager> m_renderManager;
 		std::vector<std::unique_ptr<RenderStage>> m_renderStages;
 		std::map<std::string, const Descriptor *> m_attachments;
@@ -97,9 +158,17 @@ namespace acid
 
 		std::vector<std::unique_ptr<CommandBuffer>> m_commandBuffers;
 
+		bool m_multithreaded;
+		Time m_recordTime;
+		// A pool for each recording job and one for the updating thread, for each frame in flight.
+		std::vector<std::vector<std::unique_ptr<CommandPool>>> m_commandPools;
+
 		std::unique_ptr<Instance> m_instance;
 		std::unique_ptr<PhysicalDevice> m_physicalDevice;
 		std::unique_ptr<Surface> m_surface;
 		std::unique_ptr<LogicalDevice> m_logicalDevice;
+		std::unique_ptr<MemoryAllocator> m_memoryAllocator;
+		std::unique_ptr<RingAllocator> m_frameAllocator;
+		std::unique_ptr<UploadQueue> m_uploadQueue;
 	};
 }
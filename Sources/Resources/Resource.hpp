@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include "Engine/Exports.hpp"
 
 namespace acid
@@ -38,5 +39,11 @@ namespace acid
 		virtual void Encode(Metadata &metadata) const
 		{
 		}
+
+		/// <summary>
+		/// Gets the approximate amount of memory held by this resource, used for cache statistics.
+		/// </summary>
+		/// <returns> The size in bytes. </returns>
+		virtual std::size_t GetByteSize() const { return 0; }
 	};
 }
@@ -3,6 +3,9 @@
 namespace acid
 {
 	Resources::Resources() :
+		m_hits(0),
+		m_misses(0),
+		m_purged(0),
 		m_timerPurge(Time::Seconds(4.0f))
 	{
 	}
@@ -13,58 +16,102 @@ namespace acid
 		{
 			m_timerPurge.ResetStartTime();
 
-			for (auto it = m_resources.begin(); it != m_resources.end();)
+			std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+			for (auto &[typeIndex, resources] : m_resources)
 			{
-				if ((*it).second.use_count() <= 1)
+				for (auto it = resources.begin(); it != resources.end();)
 				{
-					it = m_resources.erase(it);
-					continue;
-				}
+					if ((*it).second.m_resource.use_count() <= 1)
+					{
+						it = resources.erase(it);
+						m_purged++;
+						continue;
+					}
 
-				++it;
+					++it;
+				}
 			}
 		}
 	}
 
-	std::shared_ptr<Resource> Resources::Find(const Metadata &metadata) const
+	std::shared_ptr<Resource> Resources::Find(const std::type_index &typeIndex, const Metadata &metadata) const
 	{
-		for (const auto &[key, resource] : m_resources)
+		auto hash = metadata.GetHash();
+
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		auto it = m_resources.find(typeIndex);
+
+		if (it != m_resources.end())
 		{
-			if (*key == metadata)
+			auto [first, last] = (*it).second.equal_range(hash);
+
+			for (auto it1 = first; it1 != last; ++it1)
 			{
-				return resource;
+				if (*(*it1).second.m_metadata == metadata)
+				{
+					m_hits++;
+					return (*it1).second.m_resource;
+				}
 			}
 		}
 
+		m_misses++;
 		return nullptr;
-		/*auto it = m_resources.find(metadata);
+	}
 
-		if (it == m_resources.end())
+	void Resources::Add(const std::type_index &typeIndex, const Metadata &metadata, const std::shared_ptr<Resource> &resource)
+	{
+		auto hash = metadata.GetHash();
+
+		std::unique_lock<std::shared_mutex> lock(m_mutex);
+		auto &resources = m_resources[typeIndex];
+		auto [first, last] = resources.equal_range(hash);
+
+		for (auto it = first; it != last; ++it)
 		{
-			return nullptr;
+			if (*(*it).second.m_metadata == metadata)
+			{
+				return;
+			}
 		}
 
-		return it->second;*/
+		resources.emplace(hash, Entry{std::unique_ptr<Metadata>(metadata.Clone()), resource});
 	}
 
-	void Resources::Add(const Metadata &metadata, const std::shared_ptr<Resource> &resource)
+	void Resources::Remove(const std::shared_ptr<Resource> &resource)
 	{
-		if (Find(metadata) != nullptr)
+		std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+		for (auto &[typeIndex, resources] : m_resources)
 		{
-			return;
-		}
+			for (auto it = resources.begin(); it != resources.end();)
+			{
+				if ((*it).second.m_resource == resource)
+				{
+					it = resources.erase(it);
+					continue;
+				}
 
-		m_resources.emplace(metadata.Clone(), resource);
+				++it;
+			}
+		}
 	}
 
-	void Resources::Remove(const std::shared_ptr<Resource> &resource)
+	Resources::Statistics Resources::GetStatistics() const
 	{
-		for (auto it = m_resources.begin(); it != m_resources.end(); ++it) // TODO: Clean remove.
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		Statistics statistics = {m_hits, m_misses, m_purged, 0, 0};
+
+		for (const auto &[typeIndex, resources] : m_resources)
 		{
-			if ((*it).second == resource)
+			for (const auto &[hash, entry] : resources)
 			{
-				m_resources.erase(it);
+				statistics.m_resourceCount++;
+				statistics.m_bytesHeld += entry.m_resource->GetByteSize();
 			}
 		}
+
+		return statistics;
 	}
 }
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
-#include <map>
+#include <shared_mutex>
+#include <typeindex>
+#include <unordered_map>
 #include "Engine/Engine.hpp"
 #include "Maths/Timer.hpp"
 #include "Serialized/Metadata.hpp"
@@ -10,12 +13,24 @@
 namespace acid
 {
 	/// <summary>
-	/// A module used for managing resources.
+	/// A module used for managing resources, resources are cached per type and keyed by the hash of the metadata they were created from.
 	/// </summary>
 	class ACID_EXPORT Resources :
 		public Module
 	{
 	public:
+		/// <summary>
+		/// A snapshot of the resource cache counters.
+		/// </summary>
+		struct Statistics
+		{
+			uint64_t m_hits;
+			uint64_t m_misses;
+			uint64_t m_purged;
+			uint32_t m_resourceCount;
+			std::size_t m_bytesHeld;
+		};
+
 		/// <summary>
 		/// Gets this engine instance.
 		/// </summary>
@@ -26,13 +41,53 @@ namespace acid
 
 		void Update() override;
 
-		std::shared_ptr<Resource> Find(const Metadata &metadata) const;
+		/// <summary>
+		/// Finds a cached resource of a type that was created from equal metadata, this can be called from any thread.
+		/// </summary>
+		/// <param name="metadata"> The metadata the resource was created from. </param>
+		/// <param name="T"> The resource type to look for. </param>
+		/// <returns> The found resource, or nullptr. </returns>
+		template<typename T>
+		std::shared_ptr<T> Find(const Metadata &metadata) const
+		{
+			return std::dynamic_pointer_cast<T>(Find(typeid(T), metadata));
+		}
 
-		void Add(const Metadata &metadata, const std::shared_ptr<Resource> &resource);
+		std::shared_ptr<Resource> Find(const std::type_index &typeIndex, const Metadata &metadata) const;
+
+		/// <summary>
+		/// Adds a resource to the cache of its type, if a resource with equal metadata is already cached this does nothing.
+		/// </summary>
+		/// <param name="metadata"> The metadata the resource was created from. </param>
+		/// <param name="resource"> The resource to cache. </param>
+		/// <param name="T"> The resource type to cache under. </param>
+		template<typename T>
+		void Add(const Metadata &metadata, const std::shared_ptr<T> &resource)
+		{
+			Add(typeid(T), metadata, std::static_pointer_cast<Resource>(resource));
+		}
+
+		void Add(const std::type_index &typeIndex, const Metadata &metadata, const std::shared_ptr<Resource> &resource);
 
 		void Remove(const std::shared_ptr<Resource> &resource);
+
+		/// <summary>
+		/// Gets the current cache counters, the bytes held is collected from <seealso cref="Resource#GetByteSize()"/>.
+		/// </summary>
+		/// <returns> The cache statistics. </returns>
+		Statistics GetStatistics() const;
 	private:
-		std::map<std::unique_ptr<Metadata>, std::shared_ptr<Resource>> m_resources;
+		struct Entry
+		{
+			std::unique_ptr<Metadata> m_metadata;
+			std::shared_ptr<Resource> m_resource;
+		};
+
+		std::unordered_map<std::type_index, std::unordered_multimap<std::size_t, Entry>> m_resources;
+		mutable std::shared_mutex m_mutex;
+		mutable std::atomic<uint64_t> m_hits;
+		mutable std::atomic<uint64_t> m_misses;
+		uint64_t m_purged;
 		Timer m_timerPurge;
 	};
 }
@@ -0,0 +1,170 @@
+#include "Archetype.hpp"
+
+#include <algorithm>
+
+namespace acid
+{
+	/// <summary>
+	/// The alignment of each chunk, which is also the largest component alignment supported.
+	/// </summary>
+	static const std::size_t CHUNK_ALIGNMENT = ComponentTypes::MaxAlignment;
+
+	const std::size_t Archetype::ChunkSize = 16384;
+
+	static std::size_t AlignUp(const std::size_t &offset, const std::size_t &alignment)
+	{
+		return (offset + alignment - 1) / alignment * alignment;
+	}
+
+	Archetype::Archetype(std::vector<ComponentTypeId> types) :
+		m_types(std::move(types)),
+		m_chunkBytes(0),
+		m_chunkCapacity(0),
+		m_size(0)
+	{
+		std::size_t rowBytes = sizeof(EntityId);
+
+		for (const auto &type : m_types)
+		{
+			m_mask.set(type);
+			m_columns.emplace_back(Column{ComponentTypes::GetInfo(type), 0});
+			rowBytes += m_columns.back().m_info.m_size;
+		}
+
+		// Fits as many rows as possible into a chunk, the entity array is first then each column is aligned after it.
+		m_chunkCapacity = static_cast<uint32_t>(std::max<std::size_t>(ChunkSize / rowBytes, 1));
+
+		while (true)
+		{
+			auto offset = sizeof(EntityId) * m_chunkCapacity;
+
+			for (auto &column : m_columns)
+			{
+				offset = AlignUp(offset, column.m_info.m_alignment);
+				column.m_offset = offset;
+				offset += column.m_info.m_size * m_chunkCapacity;
+			}
+
+			if (offset <= ChunkSize || m_chunkCapacity == 1)
+			{
+				m_chunkBytes = AlignUp(offset, CHUNK_ALIGNMENT);
+				break;
+			}
+
+			m_chunkCapacity--;
+		}
+	}
+
+	Archetype::~Archetype()
+	{
+		for (uint32_t row = 0; row < m_size; row++)
+		{
+			Destroy(row);
+		}
+	}
+
+	int32_t Archetype::FindColumn(const ComponentTypeId &type) const
+	{
+		auto it = std::lower_bound(m_types.begin(), m_types.end(), type);
+
+		if (it == m_types.end() || *it != type)
+		{
+			return -1;
+		}
+
+		return static_cast<int32_t>(it - m_types.begin());
+	}
+
+	uint32_t Archetype::Push(const EntityId &entity)
+	{
+		if (m_size == m_chunks.size() * m_chunkCapacity)
+		{
+			m_chunks.emplace_back(static_cast<uint8_t *>(::operator new[](m_chunkBytes, std::align_val_t(CHUNK_ALIGNMENT))));
+		}
+
+		auto row = m_size++;
+		auto entities = reinterpret_cast<EntityId *>(m_chunks[row / m_chunkCapacity].get());
+		entities[row % m_chunkCapacity] = entity;
+		return row;
+	}
+
+	EntityId Archetype::Erase(const uint32_t &row)
+	{
+		auto last = m_size - 1;
+		auto entities = reinterpret_cast<EntityId *>(m_chunks[row / m_chunkCapacity].get());
+		auto lastEntities = reinterpret_cast<EntityId *>(m_chunks[last / m_chunkCapacity].get());
+		auto moved = lastEntities[last % m_chunkCapacity];
+
+		if (row != last)
+		{
+			entities[row % m_chunkCapacity] = moved;
+
+			for (uint32_t column = 0; column < m_columns.size(); column++)
+			{
+				const auto &info = m_columns[column].m_info;
+				info.m_moveConstruct(Get(row, column), Get(last, column));
+				info.m_destroy(Get(last, column));
+			}
+		}
+
+		m_size--;
+
+		if (m_size == (m_chunks.size() - 1) * m_chunkCapacity)
+		{
+			m_chunks.pop_back();
+		}
+
+		return moved;
+	}
+
+	void Archetype::Destroy(const uint32_t &row)
+	{
+		for (uint32_t column = 0; column < m_columns.size(); column++)
+		{
+			m_columns[column].m_info.m_destroy(Get(row, column));
+		}
+	}
+
+	void Archetype::MoveTo(const uint32_t &row, Archetype &other, const uint32_t &otherRow)
+	{
+		for (uint32_t column = 0; column < m_columns.size(); column++)
+		{
+			auto otherColumn = other.FindColumn(m_types[column]);
+
+			if (otherColumn != -1)
+			{
+				m_columns[column].m_info.m_moveConstruct(other.Get(otherRow, otherColumn), Get(row, column));
+			}
+
+			m_columns[column].m_info.m_destroy(Get(row, column));
+		}
+	}
+
+	Archetype *Archetype::GetEdge(const ComponentTypeId &type) const
+	{
+		for (const auto &[edgeType, archetype] : m_edges)
+		{
+			if (edgeType == type)
+			{
+				return archetype;
+			}
+		}
+
+		return nullptr;
+	}
+
+	void Archetype::SetEdge(const ComponentTypeId &type, Archetype *archetype)
+	{
+		m_edges.emplace_back(type, archetype);
+	}
+
+	void Archetype::ChunkDeleter::operator()(uint8_t *chunk) const
+	{
+		::operator delete[](chunk, std::align_val_t(CHUNK_ALIGNMENT));
+	}
+
+	void *Archetype::Get(const uint32_t &row, const uint32_t &column) const
+	{
+		return m_chunks[row / m_chunkCapacity].get() + m_columns[column].m_offset + m_columns[column].m_info.m_size * (row % m_chunkCapacity);
+	}
+}
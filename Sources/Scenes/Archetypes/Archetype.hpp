@@ -0,0 +1,145 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "Helpers/NonCopyable.hpp"
+#include "ComponentType.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// A handle to a entity in a <seealso cref="ArchetypeStorage"/>, the generation changes when a index is reused so old handles can be detected.
+	/// </summary>
+	struct ACID_EXPORT EntityId
+	{
+		uint32_t m_index;
+		uint32_t m_generation;
+
+		bool operator==(const EntityId &other) const { return m_index == other.m_index && m_generation == other.m_generation; }
+
+		bool operator!=(const EntityId &other) const { return !(*this == other); }
+	};
+
+	/// <summary>
+	/// All entities with exactly the same set of component types. Entities are stored in fixed size chunks,
+	/// each chunk has a contiguous array of entity ids and a contiguous array for each component type.
+	/// Rows are kept packed, removing a row moves the last row into its place.
+	/// </summary>
+	class ACID_EXPORT Archetype :
+		public NonCopyable
+	{
+	public:
+		/// <summary>
+		/// The size in bytes of each chunk, chunks are made larger if a single row does not fit.
+		/// </summary>
+		static const std::size_t ChunkSize;
+
+		/// <summary>
+		/// Creates a new archetype.
+		/// </summary>
+		/// <param name="types"> The component types, sorted by id. </param>
+		explicit Archetype(std::vector<ComponentTypeId> types);
+
+		~Archetype();
+
+		const std::vector<ComponentTypeId> &GetTypes() const { return m_types; }
+
+		const ComponentMask &GetMask() const { return m_mask; }
+
+		/// <summary>
+		/// Finds the column of a component type.
+		/// </summary>
+		/// <param name="type"> The component type. </param>
+		/// <returns> The column, or -1 if the archetype does not have the type. </returns>
+		int32_t FindColumn(const ComponentTypeId &type) const;
+
+		/// <summary>
+		/// Adds a row for a entity, the components of the row are not constructed.
+		/// </summary>
+		/// <param name="entity"> The entity. </param>
+		/// <returns> The new row. </returns>
+		uint32_t Push(const EntityId &entity);
+
+		/// <summary>
+		/// Removes a row whose components are already destroyed or moved out, the last row is moved into its place.
+		/// </summary>
+		/// <param name="row"> The row to remove. </param>
+		/// <returns> The entity that was moved into the row, or the removed entity if it was the last row. </returns>
+		EntityId Erase(const uint32_t &row);
+
+		/// <summary>
+		/// Destroys every component in a row.
+		/// </summary>
+		/// <param name="row"> The row. </param>
+		void Destroy(const uint32_t &row);
+
+		/// <summary>
+		/// Moves the components of a row into a row of another archetype, components the other archetype does not have are destroyed.
+		/// The row is left to be removed with <seealso cref="#Erase()"/>.
+		/// </summary>
+		/// <param name="row"> The row in this archetype. </param>
+		/// <param name="other"> The archetype to move into. </param>
+		/// <param name="otherRow"> The row in the other archetype. </param>
+		void MoveTo(const uint32_t &row, Archetype &other, const uint32_t &otherRow);
+
+		/// <summary>
+		/// Gets a component in a row.
+		/// </summary>
+		/// <param name="row"> The row. </param>
+		/// <param name="column"> The column of the component type. </param>
+		/// <returns> The component. </returns>
+		void *Get(const uint32_t &row, const uint32_t &column) const;
+
+		uint32_t GetSize() const { return m_size; }
+
+		uint32_t GetChunkCapacity() const { return m_chunkCapacity; }
+
+		uint32_t GetChunkCount() const { return static_cast<uint32_t>(m_chunks.size()); }
+
+		/// <summary>
+		/// Gets the count of rows in a chunk, every chunk is full except the last.
+		/// </summary>
+		/// <param name="chunk"> The chunk. </param>
+		/// <returns> The count of rows. </returns>
+		uint32_t GetChunkSize(const uint32_t &chunk) const { return chunk + 1 < m_chunks.size() ? m_chunkCapacity : m_size - chunk * m_chunkCapacity; }
+
+		const EntityId *GetEntities(const uint32_t &chunk) const { return reinterpret_cast<const EntityId *>(m_chunks[chunk].get()); }
+
+		/// <summary>
+		/// Gets the array of a column in a chunk.
+		/// </summary>
+		/// <param name="chunk"> The chunk. </param>
+		/// <param name="column"> The column. </param>
+		/// <returns> The first component of the array. </returns>
+		void *GetArray(const uint32_t &chunk, const uint32_t &column) const { return m_chunks[chunk].get() + m_columns[column].m_offset; }
+
+		/// <summary>
+		/// Gets the archetype that has the component types of this archetype with one type added or removed, when it has been found before.
+		/// </summary>
+		/// <param name="type"> The type added or removed. </param>
+		/// <returns> The archetype, or nullptr if it has not been found yet. </returns>
+		Archetype *GetEdge(const ComponentTypeId &type) const;
+
+		void SetEdge(const ComponentTypeId &type, Archetype *archetype);
+	private:
+		struct Column
+		{
+			ComponentTypes::Info m_info;
+			std::size_t m_offset;
+		};
+
+		struct ChunkDeleter
+		{
+			void operator()(uint8_t *chunk) const;
+		};
+
+		std::vector<ComponentTypeId> m_types;
+		ComponentMask m_mask;
+		std::vector<Column> m_columns;
+		std::size_t m_chunkBytes;
+		uint32_t m_chunkCapacity;
+		std::vector<std::unique_ptr<uint8_t[], ChunkDeleter>> m_chunks;
+		uint32_t m_size;
+		std::vector<std::pair<ComponentTypeId, Archetype *>> m_edges;
+	};
+}
@@ -0,0 +1,131 @@
+#include "ArchetypeStorage.hpp"
+
+namespace acid
+{
+	ArchetypeStorage::ArchetypeStorage() :
+		m_emptyArchetype(nullptr),
+		m_size(0)
+	{
+		m_emptyArchetype = FindArchetype({});
+	}
+
+	EntityId ArchetypeStorage::Create()
+	{
+		return Allocate(m_emptyArchetype);
+	}
+
+	void ArchetypeStorage::Destroy(const EntityId &entity)
+	{
+		if (!IsAlive(entity))
+		{
+			return;
+		}
+
+		auto &location = m_locations[entity.m_index];
+		location.m_archetype->Destroy(location.m_row);
+		Erase(location.m_archetype, location.m_row);
+		location.m_archetype = nullptr;
+		location.m_generation++;
+		m_freeIndices.emplace_back(entity.m_index);
+		m_size--;
+	}
+
+	bool ArchetypeStorage::IsAlive(const EntityId &entity) const
+	{
+		return entity.m_index < m_locations.size() && m_locations[entity.m_index].m_generation == entity.m_generation &&
+			m_locations[entity.m_index].m_archetype != nullptr;
+	}
+
+	void ArchetypeStorage::Clear()
+	{
+		for (auto &archetype : m_archetypes)
+		{
+			while (archetype->GetSize() != 0)
+			{
+				auto row = archetype->GetSize() - 1;
+				auto entity = archetype->GetEntities(row / archetype->GetChunkCapacity())[row % archetype->GetChunkCapacity()];
+				Destroy(entity);
+			}
+		}
+	}
+
+	EntityId ArchetypeStorage::Allocate(Archetype *archetype)
+	{
+		uint32_t index;
+
+		if (!m_freeIndices.empty())
+		{
+			index = m_freeIndices.back();
+			m_freeIndices.pop_back();
+		}
+		else
+		{
+			index = static_cast<uint32_t>(m_locations.size());
+			m_locations.emplace_back(Location{nullptr, 0, 0});
+		}
+
+		EntityId entity = {index, m_locations[index].m_generation};
+		m_locations[index].m_archetype = archetype;
+		m_locations[index].m_row = archetype->Push(entity);
+		m_size++;
+		return entity;
+	}
+
+	Archetype *ArchetypeStorage::FindArchetype(const std::vector<ComponentTypeId> &types)
+	{
+		auto it = m_archetypeLookup.find(types);
+
+		if (it != m_archetypeLookup.end())
+		{
+			return it->second;
+		}
+
+		auto archetype = m_archetypes.emplace_back(std::make_unique<Archetype>(types)).get();
+		m_archetypeLookup.emplace(types, archetype);
+		return archetype;
+	}
+
+	Archetype *ArchetypeStorage::FindEdge(Archetype *archetype, const ComponentTypeId &type)
+	{
+		auto edge = archetype->GetEdge(type);
+
+		if (edge != nullptr)
+		{
+			return edge;
+		}
+
+		auto types = archetype->GetTypes();
+		auto it = std::lower_bound(types.begin(), types.end(), type);
+
+		if (it != types.end() && *it == type)
+		{
+			types.erase(it);
+		}
+		else
+		{
+			types.insert(it, type);
+		}
+
+		// Edges go both ways, adding a type and removing it again.
+		edge = FindArchetype(types);
+		archetype->SetEdge(type, edge);
+		edge->SetEdge(type, archetype);
+		return edge;
+	}
+
+	void ArchetypeStorage::Move(const EntityId &entity, Archetype *archetype)
+	{
+		auto &location = m_locations[entity.m_index];
+		auto row = archetype->Push(entity);
+		location.m_archetype->MoveTo(location.m_row, *archetype, row);
+		Erase(location.m_archetype, location.m_row);
+		location.m_archetype = archetype;
+		location.m_row = row;
+	}
+
+	void ArchetypeStorage::Erase(Archetype *archetype, const uint32_t &row)
+	{
+		auto moved = archetype->Erase(row);
+		m_locations[moved.m_index].m_row = row;
+	}
+}
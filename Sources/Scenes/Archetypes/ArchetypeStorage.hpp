@@ -0,0 +1,208 @@
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include "Archetype.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// A data oriented store of entities made from plain data components, kept next to the <seealso cref="SceneStructure"/> for scenes with large counts of simple entities.
+	/// Entities with the same set of component types are packed together in a <seealso cref="Archetype"/>,
+	/// adding or removing a component moves the entity into the archetype for its new set of types.
+	/// Components are found by type id instead of RTTI, and are iterated with a <seealso cref="View"/>.
+	/// </summary>
+	class ACID_EXPORT ArchetypeStorage :
+		public NonCopyable
+	{
+	public:
+		ArchetypeStorage();
+
+		/// <summary>
+		/// Creates a entity without any components.
+		/// </summary>
+		/// <returns> The new entity. </returns>
+		EntityId Create();
+
+		/// <summary>
+		/// Creates a entity with components, the entity is placed straight into the archetype for the component types.
+		/// </summary>
+		/// <param name="components"> The components, each must be a different type. </param>
+		/// <returns> The new entity. </returns>
+		template<typename... Ts>
+		EntityId Create(Ts &&... components)
+		{
+			std::vector<ComponentTypeId> types = {ComponentTypes::Get<std::decay_t<Ts>>()...};
+			std::sort(types.begin(), types.end());
+			auto archetype = FindArchetype(types);
+			auto entity = Allocate(archetype);
+			auto row = m_locations[entity.m_index].m_row;
+			(Construct<std::decay_t<Ts>>(archetype, row, std::forward<Ts>(components)), ...);
+			return entity;
+		}
+
+		/// <summary>
+		/// Destroys a entity and all of its components.
+		/// </summary>
+		/// <param name="entity"> The entity. </param>
+		void Destroy(const EntityId &entity);
+
+		/// <summary>
+		/// Gets if a handle points to a entity that has not been destroyed.
+		/// </summary>
+		/// <param name="entity"> The entity. </param>
+		/// <returns> If the entity is alive. </returns>
+		bool IsAlive(const EntityId &entity) const;
+
+		/// <summary>
+		/// Adds a component to a entity, replacing the component of the same type if the entity already has one.
+		/// </summary>
+		/// <param name="entity"> The entity. </param>
+		/// <param name="args"> The component constructor arguments. </param>
+		/// <param name="T"> The component type. </param>
+		/// <returns> The added component, it is valid until the entities components are next changed, or nullptr if the entity is not alive. </returns>
+		template<typename T, typename... Args>
+		T *Add(const EntityId &entity, Args &&... args)
+		{
+			if (!IsAlive(entity))
+			{
+				return nullptr;
+			}
+
+			auto type = ComponentTypes::Get<T>();
+			auto &location = m_locations[entity.m_index];
+			auto column = location.m_archetype->FindColumn(type);
+
+			if (column != -1)
+			{
+				auto component = static_cast<T *>(location.m_archetype->Get(location.m_row, column));
+				component->~T();
+				return Construct<T>(location.m_archetype, location.m_row, std::forward<Args>(args)...);
+			}
+
+			auto archetype = FindEdge(location.m_archetype, type);
+			Move(entity, archetype);
+			return Construct<T>(archetype, m_locations[entity.m_index].m_row, std::forward<Args>(args)...);
+		}
+
+		/// <summary>
+		/// Removes a component from a entity, if it is alive and has the component.
+		/// </summary>
+		/// <param name="entity"> The entity. </param>
+		/// <param name="T"> The component type. </param>
+		template<typename T>
+		void Remove(const EntityId &entity)
+		{
+			if (!IsAlive(entity))
+			{
+				return;
+			}
+
+			auto type = ComponentTypes::Get<T>();
+			auto &location = m_locations[entity.m_index];
+
+			if (location.m_archetype->FindColumn(type) == -1)
+			{
+				return;
+			}
+
+			Move(entity, FindEdge(location.m_archetype, type));
+		}
+
+		/// <summary>
+		/// Gets a component of a entity.
+		/// </summary>
+		/// <param name="entity"> The entity. </param>
+		/// <param name="T"> The component type. </param>
+		/// <returns> The component, or nullptr if the entity is not alive or does not have it. </returns>
+		template<typename T>
+		T *Get(const EntityId &entity) const
+		{
+			if (!IsAlive(entity))
+			{
+				return nullptr;
+			}
+
+			const auto &location = m_locations[entity.m_index];
+			auto column = location.m_archetype->FindColumn(ComponentTypes::Get<T>());
+
+			if (column == -1)
+			{
+				return nullptr;
+			}
+
+			return static_cast<T *>(location.m_archetype->Get(location.m_row, column));
+		}
+
+		template<typename T>
+		bool Has(const EntityId &entity) const { return IsAlive(entity) && m_locations[entity.m_index].m_archetype->GetMask().test(ComponentTypes::Get<T>()); }
+
+		/// <summary>
+		/// Destroys every entity, the archetypes are kept so views stay valid.
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Gets the count of entities alive.
+		/// </summary>
+		/// <returns> The count of entities. </returns>
+		uint32_t GetSize() const { return m_size; }
+
+		/// <summary>
+		/// Gets every archetype that has been created, archetypes are only ever added to the end.
+		/// </summary>
+		/// <returns> The archetypes. </returns>
+		const std::vector<std::unique_ptr<Archetype>> &GetArchetypes() const { return m_archetypes; }
+	private:
+		struct Location
+		{
+			Archetype *m_archetype;
+			uint32_t m_row;
+			uint32_t m_generation;
+		};
+
+		/// <summary>
+		/// Constructs a component in a row, plain structs without constructors are brace initialized.
+		/// </summary>
+		template<typename T, typename... Args>
+		static T *Construct(Archetype *archetype, const uint32_t &row, Args &&... args)
+		{
+			auto component = archetype->Get(row, archetype->FindColumn(ComponentTypes::Get<T>()));
+
+			if constexpr (std::is_aggregate_v<T>)
+			{
+				return new(component) T{std::forward<Args>(args)...};
+			}
+			else
+			{
+				return new(component) T(std::forward<Args>(args)...);
+			}
+		}
+
+		EntityId Allocate(Archetype *archetype);
+
+		Archetype *FindArchetype(const std::vector<ComponentTypeId> &types);
+
+		/// <summary>
+		/// Finds the archetype with a type added to or removed from the types of a archetype.
+		/// </summary>
+		Archetype *FindEdge(Archetype *archetype, const ComponentTypeId &type);
+
+		/// <summary>
+		/// Moves a entity into another archetype, the components the archetype does not have are destroyed and the new components are left to be constructed.
+		/// </summary>
+		void Move(const EntityId &entity, Archetype *archetype);
+
+		/// <summary>
+		/// Removes a row from a archetype, updating the location of the entity moved into the row.
+		/// </summary>
+		void Erase(Archetype *archetype, const uint32_t &row);
+
+		std::vector<Location> m_locations;
+		std::vector<uint32_t> m_freeIndices;
+		std::vector<std::unique_ptr<Archetype>> m_archetypes;
+		std::map<std::vector<ComponentTypeId>, Archetype *> m_archetypeLookup;
+		Archetype *m_emptyArchetype;
+		uint32_t m_size;
+	};
+}
@@ -0,0 +1,59 @@
+#include "ComponentType.hpp"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <deque>
+#include "Engine/Log.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// The registered types, kept in a function so it is created before any static component id is. Infos are in a deque so references to them stay valid.
+	/// </summary>
+	struct ComponentTypeRegister
+	{
+		std::mutex m_mutex;
+		std::unordered_map<std::string, ComponentTypeId> m_ids;
+		std::deque<ComponentTypes::Info> m_infos;
+	};
+
+	static ComponentTypeRegister &GetRegister()
+	{
+		static ComponentTypeRegister result;
+		return result;
+	}
+
+	const ComponentTypes::Info &ComponentTypes::GetInfo(const ComponentTypeId &id)
+	{
+		auto &types = GetRegister();
+		std::lock_guard<std::mutex> lock(types.m_mutex);
+		return types.m_infos[id];
+	}
+
+	uint32_t ComponentTypes::GetCount()
+	{
+		auto &types = GetRegister();
+		std::lock_guard<std::mutex> lock(types.m_mutex);
+		return static_cast<uint32_t>(types.m_infos.size());
+	}
+
+	ComponentTypeId ComponentTypes::Register(const std::string_view &name, const Info &info)
+	{
+		auto &types = GetRegister();
+		std::lock_guard<std::mutex> lock(types.m_mutex);
+		auto [it, inserted] = types.m_ids.emplace(std::string(name), static_cast<ComponentTypeId>(types.m_infos.size()));
+
+		if (inserted)
+		{
+			if (types.m_infos.size() >= ComponentMask().size())
+			{
+				Log::Error("Component type limit of %i reached\n", static_cast<int>(ComponentMask().size()));
+			}
+
+			types.m_infos.emplace_back(info);
+		}
+
+		return it->second;
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "Engine/Exports.hpp"
+
+namespace acid
+{
+	using ComponentTypeId = uint32_t;
+
+	/// <summary>
+	/// A set of component types, with one bit for each type id.
+	/// </summary>
+	using ComponentMask = std::bitset<256>;
+
+	/// <summary>
+	/// Gives each plain data component type a small id, used to find the column of a component type in a archetype without RTTI.
+	/// Ids are assigned the first time a type is used, and are looked up by a name the compiler generates for the type, so every module agrees on the id of a type.
+	/// </summary>
+	class ACID_EXPORT ComponentTypes
+	{
+	public:
+		/// <summary>
+		/// The functions and layout needed to store a component type in type erased arrays.
+		/// </summary>
+		struct Info
+		{
+			std::size_t m_size;
+			std::size_t m_alignment;
+			void (*m_moveConstruct)(void *destination, void *source);
+			void (*m_destroy)(void *component);
+		};
+
+		/// <summary>
+		/// The largest alignment a component type can have, archetype chunks are allocated with this alignment.
+		/// </summary>
+		static constexpr std::size_t MaxAlignment = 64;
+
+		/// <summary>
+		/// Gets the id of a component type.
+		/// </summary>
+		/// <param name="T"> The component type, it must be movable. </param>
+		/// <returns> The type id. </returns>
+		template<typename T>
+		static ComponentTypeId Get()
+		{
+			static_assert(std::is_move_constructible<T>::value, "T must be move constructible!");
+			static_assert(alignof(T) <= MaxAlignment, "T must not be aligned to more than MaxAlignment!");
+			static const ComponentTypeId id = Register(GetName<T>(), {sizeof(T), alignof(T), [](void *destination, void *source)
+			{
+				new(destination) T(std::move(*static_cast<T *>(source)));
+			}, [](void *component)
+			{
+				static_cast<T *>(component)->~T();
+			}});
+			return id;
+		}
+
+		/// <summary>
+		/// Gets the storage info of a component type.
+		/// </summary>
+		/// <param name="id"> The type id. </param>
+		/// <returns> The type info. </returns>
+		static const Info &GetInfo(const ComponentTypeId &id);
+
+		/// <summary>
+		/// Gets the count of component types that have been given a id.
+		/// </summary>
+		/// <returns> The count of types. </returns>
+		static uint32_t GetCount();
+	private:
+		template<typename T>
+		static std::string_view GetName()
+		{
+#if defined(_MSC_VER)
+			return __FUNCSIG__;
+#else
+			return __PRETTY_FUNCTION__;
+#endif
+		}
+
+		static ComponentTypeId Register(const std::string_view &name, const Info &info);
+	};
+}
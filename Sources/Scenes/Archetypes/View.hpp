@@ -0,0 +1,117 @@
+#pragma once
+
+#include <array>
+#include <utility>
+#include "ArchetypeStorage.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// A query over every entity in a <seealso cref="ArchetypeStorage"/> that has all of a set of component types.
+	/// The archetypes that match, and the column of each type in them, are cached when the view is first iterated;
+	/// later iterations only check archetypes created since the last iteration, so a view should be kept and reused.
+	/// Components can be read and written while iterating, but entities must not be created, destroyed, or have components added or removed.
+	/// </summary>
+	/// <param name="Ts"> The component types, a type can be const to only read it. </param>
+	template<typename... Ts>
+	class View
+	{
+	public:
+		/// <summary>
+		/// Creates a new view.
+		/// </summary>
+		/// <param name="storage"> The storage to query, must outlive the view. </param>
+		explicit View(const ArchetypeStorage *storage) :
+			m_storage(storage),
+			m_checked(0)
+		{
+			(m_mask.set(ComponentTypes::Get<std::remove_const_t<Ts>>()), ...);
+		}
+
+		/// <summary>
+		/// Calls a function for every entity matching this view.
+		/// </summary>
+		/// <param name="function"> The function, called with the entity id and a reference to each component. </param>
+		template<typename F>
+		void Each(F &&function)
+		{
+			EachChunk([&function](const uint32_t &count, const EntityId *entities, Ts *... arrays)
+			{
+				for (uint32_t i = 0; i < count; i++)
+				{
+					function(entities[i], arrays[i]...);
+				}
+			});
+		}
+
+		/// <summary>
+		/// Calls a function for every chunk of entities matching this view, each component type is passed as a contiguous array.
+		/// </summary>
+		/// <param name="function"> The function, called with the count of entities in the chunk, the entity ids, and the array of each component. </param>
+		template<typename F>
+		void EachChunk(F &&function)
+		{
+			Refresh();
+
+			for (const auto &match : m_matches)
+			{
+				EachChunk(match, function, std::index_sequence_for<Ts...>());
+			}
+		}
+
+		/// <summary>
+		/// Gets the count of entities matching this view.
+		/// </summary>
+		/// <returns> The count of entities. </returns>
+		uint32_t GetSize()
+		{
+			Refresh();
+			uint32_t size = 0;
+
+			for (const auto &match : m_matches)
+			{
+				size += match.m_archetype->GetSize();
+			}
+
+			return size;
+		}
+	private:
+		struct Match
+		{
+			Archetype *m_archetype;
+			std::array<uint32_t, sizeof...(Ts)> m_columns;
+		};
+
+		void Refresh()
+		{
+			const auto &archetypes = m_storage->GetArchetypes();
+
+			for (; m_checked < archetypes.size(); m_checked++)
+			{
+				auto archetype = archetypes[m_checked].get();
+
+				if ((archetype->GetMask() & m_mask) != m_mask)
+				{
+					continue;
+				}
+
+				m_matches.emplace_back(Match{archetype, {static_cast<uint32_t>(archetype->FindColumn(ComponentTypes::Get<std::remove_const_t<Ts>>()))...}});
+			}
+		}
+
+		template<typename F, std::size_t... Is>
+		static void EachChunk(const Match &match, F &function, std::index_sequence<Is...>)
+		{
+			for (uint32_t chunk = 0; chunk < match.m_archetype->GetChunkCount(); chunk++)
+			{
+				function(match.m_archetype->GetChunkSize(chunk), match.m_archetype->GetEntities(chunk),
+					static_cast<Ts *>(match.m_archetype->GetArray(chunk, match.m_columns[Is]))...);
+			}
+		}
+
+		const ArchetypeStorage *m_storage;
+		ComponentMask m_mask;
+		std::vector<Match> m_matches;
+		std::size_t m_checked;
+	};
+}
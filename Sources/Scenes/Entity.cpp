@@ -3,6 +3,8 @@
 #include "Files/FileSystem.hpp"
 #include "Scenes.hpp"
 #include "EntityPrefab.hpp"
+#include "SpatialTree.hpp"
+#include "TransformHierarchy.hpp"
 
 namespace acid
 {
@@ -10,7 +12,10 @@ namespace acid
 		m_name(""),
 		m_localTransform(transform),
 		m_parent(nullptr),
-		m_removed(false)
+		m_removed(false),
+		m_hierarchy(nullptr),
+		m_node(0),
+		m_leaf(SpatialTree::NullNode)
 	{
 	}
 
@@ -26,7 +31,7 @@ namespace acid
 				continue;
 			}
 
-			auto component = Scenes::Get()->GetComponentRegister().Create(child->GetName());
+			auto component = Scenes::Get()->GetComponentRegister().Create(std::string(child->GetName()));
 
 			if (component == nullptr)
 			{
@@ -42,39 +47,54 @@ namespace acid
 
 	Entity::~Entity()
 	{
+		if (m_hierarchy != nullptr)
+		{
+			m_hierarchy->Remove(this);
+		}
+
 		if (m_parent != nullptr)
 		{
 			m_parent->RemoveChild(this);
 		}
+
+		// Children are left without a parent, they become roots of their hierarchy.
+		for (auto &child : m_children)
+		{
+			child->m_parent = nullptr;
+			child->m_localTransform.SetDirty(true);
+
+			if (child->m_hierarchy != nullptr)
+			{
+				child->m_hierarchy->Invalidate();
+			}
+		}
 	}
 
 	void Entity::Update()
 	{
-		for (auto it = m_components.begin(); it != m_components.end();)
+		// Removed components are erased before any are updated, so pointers to siblings found during a update stay valid until the next update.
+		m_components.erase(std::remove_if(m_components.begin(), m_components.end(), [](std::unique_ptr<Component> &component)
 		{
-			if ((*it)->IsRemoved())
-			{
-				it = m_components.erase(it);
-				continue;
-			}
+			return component->IsRemoved();
+		}), m_components.end());
 
-			if ((*it)->GetParent() != this)
+		for (auto &component : m_components)
+		{
+			if (component->GetParent() != this)
 			{
-				(*it)->SetParent(this);
+				component->SetParent(this);
 			}
 
-			if ((*it)->IsEnabled())
+			if (component->IsEnabled())
 			{
-				if (!(*it)->m_started)
+				if (!component->m_started)
 				{
-					(*it)->Start();
-					(*it)->m_started = true;
+					component->Start();
+					component->m_started = true;
 				}
 
-				(*it)->Update();
+				component->Update();
 			}
-
-			++it;
 		}
 	}
 
@@ -92,47 +112,56 @@ namespace acid
 
 	void Entity::RemoveComponent(Component *component)
 	{
-		m_components.erase(std::remove_if(m_components.begin(), m_components.end(), [&](std::unique_ptr<Component> &c)
+		for (auto &c : m_components)
 		{
-			return c.get() == component;
-		}), m_components.end());
+			if (c.get() == component)
+			{
+				c->SetRemoved(true);
+			}
+		}
 	}
 
 	void Entity::RemoveComponent(const std::string &name)
 	{
-		m_components.erase(std::remove_if(m_components.begin(), m_components.end(), [&](std::unique_ptr<Component> &c)
+		for (auto &c : m_components)
 		{
 			auto componentName = Scenes::Get()->GetComponentRegister().FindName(c.get());
-			return componentName && name == *componentName;
-		}), m_components.end());
+
+			if (componentName && name == *componentName)
+			{
+				c->SetRemoved(true);
+			}
+		}
+	}
+
+	void Entity::SetLocalTransform(const Transform &localTransform)
+	{
+		m_localTransform = localTransform;
+		m_localTransform.SetDirty(true);
 	}
 
 	Transform Entity::GetWorldTransform() const
 	{
-		if (m_localTransform.IsDirty())
+		if (IsWorldCurrent())
 		{
-			if (m_parent != nullptr)
-			{
-				m_worldTransform = m_parent->GetWorldTransform() * m_localTransform;
-			}
-			else
-			{
-				m_worldTransform = m_localTransform;
-			}
-
-			for (const auto &child : m_children)
-			{
-				child->m_localTransform.SetDirty(true);
-			}
+			return m_hierarchy->GetWorldTransform(m_node);
+		}
 
-			m_localTransform.SetDirty(false);
+		if (m_parent != nullptr)
+		{
+			return m_parent->GetWorldTransform() * m_localTransform;
 		}
 
-		return m_worldTransform;
+		return m_localTransform;
 	}
 
 	Matrix4 Entity::GetWorldMatrix() const
 	{
+		if (IsWorldCurrent())
+		{
+			return m_hierarchy->GetWorldMatrix(m_node);
+		}
+
 		return GetWorldTransform().GetWorldMatrix();
 	}
 
@@ -149,6 +178,13 @@ namespace acid
 		{
 			m_parent->AddChild(this);
 		}
+
+		m_localTransform.SetDirty(true);
+
+		if (m_hierarchy != nullptr)
+		{
+			m_hierarchy->Invalidate();
+		}
 	}
 
 	void Entity::AddChild(Entity *child)
@@ -160,4 +196,22 @@ namespace acid
 	{
 		m_children.erase(std::remove(m_children.begin(), m_children.end(), child), m_children.end());
 	}
+
+	bool Entity::IsWorldCurrent() const
+	{
+		if (m_hierarchy == nullptr || !m_hierarchy->IsSorted())
+		{
+			return false;
+		}
+
+		for (auto entity = this; entity != nullptr; entity = entity->m_parent)
+		{
+			if (entity->m_localTransform.IsDirty())
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
 }
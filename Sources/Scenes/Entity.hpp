@@ -8,6 +8,9 @@
 
 namespace acid
 {
+	class SpatialTree;
+	class TransformHierarchy;
+
 	/// <summary>
 	/// A class that represents a objects that acts as a component container.
 	/// </summary>
@@ -57,6 +60,11 @@ namespace acid
 
 			for (const auto &component : m_components)
 			{
+				if (component->IsRemoved())
+				{
+					continue;
+				}
+
 				auto casted = dynamic_cast<T *>(component.get());
 
 				if (casted != nullptr)
@@ -87,6 +95,11 @@ namespace acid
 
 			for (const auto &component : m_components)
 			{
+				if (component->IsRemoved())
+				{
+					continue;
+				}
+
 				auto casted = dynamic_cast<T *>(component.get());
 
 				if (casted != nullptr)
@@ -126,35 +139,32 @@ namespace acid
 		}
 
 		/// <summary>
-		/// Removes a component from this entity.
+		/// Removes a component from this entity, the component is destroyed at the start of the entities next update.
 		/// </summary>
 		/// <param name="component"> The component to remove. </param>
 		/// <returns> If the component was removed. </returns>
 		void RemoveComponent(Component *component);
 
 		/// <summary>
-		/// Removes a component from this entity.
+		/// Removes a component from this entity, the component is destroyed at the start of the entities next update.
 		/// </summary>
 		/// <param name="name"> The name of the component to remove. </param>
 		/// <returns> If the component was removed. </returns>
 		void RemoveComponent(const std::string &name);
 
 		/// <summary>
-		/// Removes a component by type from this entity.
+		/// Removes a component by type from this entity, the component is destroyed at the start of the entities next update.
 		/// </summary>
 		/// <param name="T"> The type of component to remove. </param>
 		/// <returns> If the component was removed. </returns>
 		template<typename T>
 		void RemoveComponent()
 		{
-			for (auto it = m_components.begin(); it != m_components.end(); ++it)
+			for (auto &component : m_components)
 			{
-				auto casted = dynamic_cast<T *>((*it).get());
-
-				if (casted != nullptr)
+				if (dynamic_cast<T *>(component.get()) != nullptr)
 				{
-					(*it)->SetParent(nullptr);
-					m_components.erase(it);
+					component->SetRemoved(true);
 				}
 			}
 		}
@@ -165,12 +175,27 @@ namespace acid
 
 		Transform &GetLocalTransform() { return m_localTransform; }
 
-		void SetLocalTransform(const Transform &localTransform) { m_localTransform = localTransform; }
+		void SetLocalTransform(const Transform &localTransform);
 
+		/// <summary>
+		/// Gets the world transform, read from the <seealso cref="TransformHierarchy"/> of the entity.
+		/// When this entity or one of its parents moved since the hierarchy was last updated it is built from the parents instead.
+		/// </summary>
+		/// <returns> The world transform. </returns>
 		Transform GetWorldTransform() const;
 
+		/// <summary>
+		/// Gets the world matrix, read from the <seealso cref="TransformHierarchy"/> of the entity like <seealso cref="#GetWorldTransform()"/>.
+		/// </summary>
+		/// <returns> The world matrix. </returns>
 		Matrix4 GetWorldMatrix() const;
 
+		/// <summary>
+		/// Gets the hierarchy that stores the world transform of this entity.
+		/// </summary>
+		/// <returns> The hierarchy, or nullptr if the entity is not in a scene structure. </returns>
+		TransformHierarchy *GetHierarchy() const { return m_hierarchy; }
+
 		const bool &IsRemoved() const { return m_removed; }
 
 		void SetRemoved(const bool &removed) { m_removed = removed; }
@@ -185,12 +210,23 @@ namespace acid
 
 		void RemoveChild(Entity *child);
 	private:
+		friend class SpatialTree;
+		friend class TransformHierarchy;
+
+		/// <summary>
+		/// Gets if the world transform in the hierarchy is up to date, the local transform of this entity and its parents have not changed since it was updated.
+		/// </summary>
+		/// <returns> If the stored world transform can be used. </returns>
+		bool IsWorldCurrent() const;
+
 		std::string m_name;
 		Transform m_localTransform;
-		mutable Transform m_worldTransform;
 		std::vector<std::unique_ptr<Component>> m_components;
 		Entity *m_parent;
 		std::vector<Entity *> m_children;
 		bool m_removed;
+		TransformHierarchy *m_hierarchy;
+		uint32_t m_node;
+		uint32_t m_leaf;
 	};
 }
@@ -14,15 +14,15 @@ namespace acid
 {
 	std::shared_ptr<EntityPrefab> EntityPrefab::Create(const Metadata &metadata)
 	{
-		auto resource = Resources::Get()->Find(metadata);
+		auto resource = Resources::Get()->Find<EntityPrefab>(metadata);
 
 		if (resource != nullptr)
 		{
-			return std::dynamic_pointer_cast<EntityPrefab>(resource);
+			return resource;
 		}
 
 		auto result = std::make_shared<EntityPrefab>("");
-		Resources::Get()->Add(metadata, std::dynamic_pointer_cast<Resource>(result));
+		Resources::Get()->Add(metadata, result);
 		result->Decode(metadata);
 		result->Load();
 		return result;
@@ -90,6 +90,11 @@ namespace acid
 
 		for (const auto &component : entity.GetComponents())
 		{
+			if (component->IsRemoved())
+			{
+				continue;
+			}
+
 			auto componentName = Scenes::Get()->GetComponentRegister().FindName(component.get());
 
 			if (!componentName)
@@ -17,10 +17,11 @@ namespace acid
 		/// Creates a new scene.
 		/// </summary>
 		/// <param name="camera"> The scenes camera. </param>
-		explicit Scene(Camera *camera) :
+		/// <param name="multithreadedPhysics"> If the physics world is simulated on worker threads. </param>
+		explicit Scene(Camera *camera, const bool &multithreadedPhysics = false) :
 			m_camera(camera),
 			m_structure(std::make_unique<SceneStructure>()),
-			m_physics(std::make_unique<ScenePhysics>()),
+			m_physics(std::make_unique<ScenePhysics>(multithreadedPhysics)),
 			m_started(false)
 		{
 		}
@@ -1,36 +1,391 @@
 #include "ScenePhysics.hpp"
 
+#include <cassert>
+#include <mutex>
 #include <BulletCollision/BroadphaseCollision/btBroadphaseInterface.h>
 #include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
 #include <BulletCollision/CollisionDispatch/btCollisionDispatcher.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
 #include <BulletCollision/CollisionDispatch/btCollisionObject.h>
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
 #include <BulletCollision/CollisionShapes/btCollisionShape.h>
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+#include <BulletCollision/CollisionShapes/btConcaveShape.h>
+#include <BulletCollision/CollisionShapes/btSphereShape.h>
+#include <BulletCollision/CollisionShapes/btTriangleCallback.h>
+#include <BulletCollision/CollisionShapes/btTriangleShape.h>
+#include <BulletCollision/NarrowPhaseCollision/btGjkEpaPenetrationDepthSolver.h>
+#include <BulletCollision/NarrowPhaseCollision/btGjkPairDetector.h>
+#include <BulletCollision/NarrowPhaseCollision/btPointCollector.h>
+#include <BulletCollision/NarrowPhaseCollision/btVoronoiSimplexSolver.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
 #include <BulletDynamics/Dynamics/btRigidBody.h>
 #include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
 #include <BulletSoftBody/btSoftBodyRigidBodyCollisionConfiguration.h>
 #include <BulletSoftBody/btSoftRigidDynamicsWorld.h>
 #include <LinearMath/btAlignedObjectArray.h>
+#include <LinearMath/btThreads.h>
 #include "Engine/Engine.hpp"
 #include "Scenes/Entity.hpp"
 #include "Physics/Colliders/Collider.hpp"
 #include "Physics/CollisionObject.hpp"
+#include "Physics/Rigidbody.hpp"
+#include "Threads/JobSystem.hpp"
 
 namespace acid
 {
-	ScenePhysics::ScenePhysics() :
+	/// <summary>
+	/// Runs the parallel loops of Bullet on the engine job system, the thread stepping the world runs the first range of each loop itself.
+	/// Any thread of the job system may run a range, and Bullet indexes its per thread arrays by the number it gives each thread,
+	/// so the thread count always matches the job system.
+	/// </summary>
+	class PhysicsTaskScheduler :
+		public btITaskScheduler
+	{
+	public:
+		PhysicsTaskScheduler() :
+			btITaskScheduler("Acid"),
+			m_threadCount(static_cast<int>(JobSystem::Get()->GetThreadCount()))
+		{
+			assert(m_threadCount <= BT_MAX_THREAD_COUNT && "The job system has more threads than Bullet supports!");
+
+			if (m_threadCount > BT_MAX_THREAD_COUNT)
+			{
+				Log::Warning("The job system has %i threads, Bullet supports %i, physics loops run on one thread\n", m_threadCount, BT_MAX_THREAD_COUNT);
+				m_threadCount = 1;
+			}
+		}
+
+		int getMaxNumThreads() const override { return m_threadCount; }
+
+		int getNumThreads() const override { return m_threadCount; }
+
+		// Ranges run on whichever thread of the job system takes them, so the thread count cannot be changed.
+		void setNumThreads(int numThreads) override {}
+
+		void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody &body) override
+		{
+			ParallelFor(iBegin, iEnd, grainSize, [&body](const std::size_t &begin, const std::size_t &end)
+			{
+				body.forLoop(static_cast<int>(begin), static_cast<int>(end));
+			});
+		}
+
+		btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody &body) override
+		{
+			std::mutex mutex;
+			btScalar sum = 0.0f;
+			ParallelFor(iBegin, iEnd, grainSize, [&body, &mutex, &sum](const std::size_t &begin, const std::size_t &end)
+			{
+				auto rangeSum = body.sumLoop(static_cast<int>(begin), static_cast<int>(end));
+				std::lock_guard<std::mutex> lock(mutex);
+				sum += rangeSum;
+			});
+			return sum;
+		}
+
+		/// <summary>
+		/// Splits a loop into ranges no smaller than the grain size, loops run on this thread when Bullet is limited to one thread.
+		/// </summary>
+		template<typename F>
+		void ParallelFor(const int &iBegin, const int &iEnd, const int &grainSize, const F &function)
+		{
+			if (m_threadCount <= 1)
+			{
+				function(iBegin, iEnd);
+				return;
+			}
+
+			JobSystem::Get()->ParallelFor(iBegin, iEnd, std::max(grainSize, 1), function);
+		}
+	private:
+		int m_threadCount;
+	};
+
+	/// <summary>
+	/// Gets the scheduler used by multithreaded worlds. Bullet numbers threads the first time they call into it and never reuses a number,
+	/// so every scene shares the scheduler and the threads of the engine job system.
+	/// </summary>
+	static PhysicsTaskScheduler *GetTaskScheduler()
+	{
+		static PhysicsTaskScheduler taskScheduler;
+		return &taskScheduler;
+	}
+
+	// Batched queries are split into ranges of at least this many queries.
+	static const std::size_t QUERY_GRAIN_SIZE = 64;
+
+	/// <summary>
+	/// Runs a function over ranges of a batch of queries. Broadphase ray tests keep a stack for each Bullet thread,
+	/// those stacks only exist when Bullet is thread safe (see ACID_BULLET_THREADSAFE), otherwise the batch runs on the calling thread.
+	/// Batches go through the physics scheduler, so they use the same threads as the world and never more than Bullet supports.
+	/// </summary>
+	template<typename F>
+	static void ForEachQuery(const std::size_t &count, const F &function)
+	{
+#if BT_THREADSAFE
+		GetTaskScheduler()->ParallelFor(0, static_cast<int>(count), static_cast<int>(QUERY_GRAIN_SIZE), function);
+#else
+		if (count > QUERY_GRAIN_SIZE)
+		{
+			static std::once_flag warned;
+			std::call_once(warned, []()
+			{
+				Log::Warning("Bullet was not built with BT_THREADSAFE, batched physics queries run on one thread\n");
+			});
+		}
+
+		function(0, count);
+#endif
+	}
+
+	/// <summary>
+	/// A hit found by a query, before it is converted and written.
+	/// </summary>
+	struct QueryResult
+	{
+		const btCollisionObject *m_collisionObject;
+		btVector3 m_pointWorld;
+		btVector3 m_normalWorld;
+		btScalar m_fraction;
+	};
+
+	/// <summary>
+	/// Writes the closest results of a query into its hits, the slots left over are cleared.
+	/// </summary>
+	static void WriteHits(std::vector<QueryResult> &results, const uint32_t &stride, QueryHit *hits, uint32_t *hitCount)
+	{
+		auto count = std::min(results.size(), static_cast<std::size_t>(stride));
+		std::partial_sort(results.begin(), results.begin() + count, results.end(), [](const QueryResult &a, const QueryResult &b)
+		{
+			return a.m_fraction < b.m_fraction;
+		});
+
+		for (std::size_t i = 0; i < stride; i++)
+		{
+			hits[i] = QueryHit();
+
+			if (i < count)
+			{
+				hits[i].m_hasHit = true;
+				hits[i].m_collisionObject = static_cast<CollisionObject *>(results[i].m_collisionObject->getUserPointer());
+				hits[i].m_pointWorld = Collider::Convert(results[i].m_pointWorld);
+				hits[i].m_normalWorld = Collider::Convert(results[i].m_normalWorld);
+				hits[i].m_fraction = results[i].m_fraction;
+			}
+		}
+
+		if (hitCount != nullptr)
+		{
+			*hitCount = static_cast<uint32_t>(count);
+		}
+	}
+
+	/// <summary>
+	/// Keeps every object a swept shape hits, Bullet only has a callback for the closest hit.
+	/// </summary>
+	class AllHitsConvexResultCallback :
+		public btCollisionWorld::ConvexResultCallback
+	{
+	public:
+		explicit AllHitsConvexResultCallback(std::vector<QueryResult> &results) :
+			m_results(results)
+		{
+		}
+
+		btScalar addSingleResult(btCollisionWorld::LocalConvexResult &convexResult, bool normalInWorldSpace) override
+		{
+			auto normal = normalInWorldSpace ? convexResult.m_hitNormalLocal :
+				convexResult.m_hitCollisionObject->getWorldTransform().getBasis() * convexResult.m_hitNormalLocal;
+			// The hit point of a convex result is already in world space.
+			m_results.emplace_back(QueryResult{convexResult.m_hitCollisionObject, convexResult.m_hitPointLocal, normal, convexResult.m_hitFraction});
+			return m_closestHitFraction;
+		}
+	private:
+		std::vector<QueryResult> &m_results;
+	};
+
+	/// <summary>
+	/// Collects the objects with bounds overlapping a box that pass a query filter.
+	/// </summary>
+	class OverlapAabbCallback :
+		public btBroadphaseAabbCallback
+	{
+	public:
+		OverlapAabbCallback(const QueryFilter &filter, std::vector<const btCollisionObject *> &collisionObjects) :
+			m_filter(filter),
+			m_collisionObjects(collisionObjects)
+		{
+		}
+
+		bool process(const btBroadphaseProxy *proxy) override
+		{
+			if ((proxy->m_collisionFilterGroup & m_filter.m_mask) != 0 && (m_filter.m_group & proxy->m_collisionFilterMask) != 0)
+			{
+				m_collisionObjects.emplace_back(static_cast<const btCollisionObject *>(proxy->m_clientObject));
+			}
+
+			return true;
+		}
+	private:
+		const QueryFilter &m_filter;
+		std::vector<const btCollisionObject *> &m_collisionObjects;
+	};
+
+	/// <summary>
+	/// Tests if a sphere overlaps a convex shape, the closest point on the shape is kept when they do.
+	/// </summary>
+	static bool SphereOverlapsConvex(const btSphereShape &sphere, const btTransform &sphereTransform, const btConvexShape *shape, const btTransform &transform,
+		QueryResult &result)
+	{
+		btVoronoiSimplexSolver simplexSolver;
+		btGjkEpaPenetrationDepthSolver penetrationSolver;
+		btGjkPairDetector detector(&sphere, shape, &simplexSolver, &penetrationSolver);
+
+		btGjkPairDetector::ClosestPointInput input;
+		input.m_transformA = sphereTransform;
+		input.m_transformB = transform;
+		btPointCollector output;
+		detector.getClosestPoints(input, output, nullptr);
+
+		if (!output.m_hasResult || output.m_distance > 0.0f)
+		{
+			return false;
+		}
+
+		result.m_pointWorld = output.m_pointInWorld;
+		result.m_normalWorld = output.m_normalOnBInWorld;
+		return true;
+	}
+
+	/// <summary>
+	/// Tests the triangles of a concave shape near a sphere until one overlaps it.
+	/// </summary>
+	class OverlapTriangleCallback :
+		public btTriangleCallback
+	{
+	public:
+		OverlapTriangleCallback(const btSphereShape &sphere, const btTransform &sphereTransform, const btTransform &transform, QueryResult &result) :
+			m_sphere(sphere),
+			m_sphereTransform(sphereTransform),
+			m_transform(transform),
+			m_result(result),
+			m_overlaps(false)
+		{
+		}
+
+		void processTriangle(btVector3 *triangle, int partId, int triangleIndex) override
+		{
+			if (m_overlaps)
+			{
+				return;
+			}
+
+			btTriangleShape triangleShape(triangle[0], triangle[1], triangle[2]);
+			m_overlaps = SphereOverlapsConvex(m_sphere, m_sphereTransform, &triangleShape, m_transform, m_result);
+		}
+
+		const bool &Overlaps() const { return m_overlaps; }
+	private:
+		const btSphereShape &m_sphere;
+		const btTransform &m_sphereTransform;
+		const btTransform &m_transform;
+		QueryResult &m_result;
+		bool m_overlaps;
+	};
+
+	/// <summary>
+	/// Tests if a sphere overlaps a collision shape, compound shapes are tested by their children and concave shapes by their triangles.
+	/// </summary>
+	static bool SphereOverlaps(const btSphereShape &sphere, const btTransform &sphereTransform, const btCollisionShape *shape, const btTransform &transform,
+		QueryResult &result)
+	{
+		if (shape->isCompound())
+		{
+			auto compoundShape = static_cast<const btCompoundShape *>(shape);
+
+			for (int32_t i = 0; i < compoundShape->getNumChildShapes(); i++)
+			{
+				if (SphereOverlaps(sphere, sphereTransform, compoundShape->getChildShape(i), transform * compoundShape->getChildTransform(i), result))
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		if (shape->isConvex())
+		{
+			return SphereOverlapsConvex(sphere, sphereTransform, static_cast<const btConvexShape *>(shape), transform, result);
+		}
+
+		// Soft bodies do not give their triangles to callbacks.
+		if (shape->isConcave() && !shape->isSoftBody())
+		{
+			// Only the triangles inside the bounds of the sphere, in the space of the shape, are tested.
+			auto localCenter = transform.invXform(sphereTransform.getOrigin());
+			auto extents = btVector3(sphere.getRadius(), sphere.getRadius(), sphere.getRadius());
+			OverlapTriangleCallback callback(sphere, sphereTransform, transform, result);
+			static_cast<const btConcaveShape *>(shape)->processAllTriangles(&callback, localCenter - extents, localCenter + extents);
+			return callback.Overlaps();
+		}
+
+		return false;
+	}
+
+	ScenePhysics::ScenePhysics(const bool &multithreaded) :
+		m_multithreaded(multithreaded),
 		m_collisionConfiguration(std::make_unique<btSoftBodyRigidBodyCollisionConfiguration>()),
 		m_broadphase(std::make_unique<btDbvtBroadphase>()),
-		m_dispatcher(std::make_unique<btCollisionDispatcher>(m_collisionConfiguration.get())),
-		m_solver(std::make_unique<btSequentialImpulseConstraintSolver>()),
-		m_dynamicsWorld(std::make_unique<btSoftRigidDynamicsWorld>(m_dispatcher.get(), m_broadphase.get(), m_solver.get(), m_collisionConfiguration.get())),
 		m_collisionShapes(std::make_unique<btAlignedObjectArray<btCollisionShape *>>()),
 		m_gravity(0.0f, -9.81f, 0.0f),
-		m_airDensity(1.2f)
+		m_airDensity(1.2f),
+		m_timestep(Time::Seconds(1.0f / 60.0f)),
+		m_maxSubsteps(4),
+		m_accumulator(0.0f),
+		m_interpolation(1.0f)
 	{
+#if !BT_THREADSAFE
+		// Bullet was built without thread safety, its parallel loops would assert or run on one thread.
+		if (m_multithreaded)
+		{
+			Log::Warning("Bullet was not built with BT_THREADSAFE, the physics world is single threaded\n");
+			m_multithreaded = false;
+		}
+#endif
+
+		if (m_multithreaded)
+		{
+			// The dispatcher and solver pool are sized by the scheduler, so it is set first.
+			btSetTaskScheduler(GetTaskScheduler());
+			m_dispatcher = std::make_unique<btCollisionDispatcherMt>(m_collisionConfiguration.get());
+			m_solverPool = std::make_unique<btConstraintSolverPoolMt>(GetTaskScheduler()->getMaxNumThreads());
+			m_solver = std::make_unique<btSequentialImpulseConstraintSolverMt>();
+			m_dynamicsWorld = std::make_unique<btDiscreteDynamicsWorldMt>(m_dispatcher.get(), m_broadphase.get(), m_solverPool.get(), m_solver.get(),
+				m_collisionConfiguration.get());
+		}
+		else
+		{
+			m_dispatcher = std::make_unique<btCollisionDispatcher>(m_collisionConfiguration.get());
+			m_solver = std::make_unique<btSequentialImpulseConstraintSolver>();
+			m_dynamicsWorld = std::make_unique<btSoftRigidDynamicsWorld>(m_dispatcher.get(), m_broadphase.get(), m_solver.get(), m_collisionConfiguration.get());
+		}
+
 		m_dynamicsWorld->setGravity(Collider::Convert(m_gravity));
 		m_dynamicsWorld->getDispatchInfo().m_enableSPU = true;
 		m_dynamicsWorld->getSolverInfo().m_minimumSolverBatchSize = 128;
 		m_dynamicsWorld->getSolverInfo().m_globalCfm = 0.00001f;
+		m_dynamicsWorld->setInternalTickCallback([](btDynamicsWorld *world, btScalar timeStep)
+		{
+			static_cast<ScenePhysics *>(world->getWorldUserInfo())->StorePreviousTransforms();
+		}, this, true);
+
+		if (m_multithreaded)
+		{
+			return;
+		}
 
 		auto softDynamicsWorld = static_cast<btSoftRigidDynamicsWorld *>(m_dynamicsWorld.get());
 		softDynamicsWorld->getWorldInfo().water_density = 0.0f;
@@ -59,7 +414,28 @@ namespace acid
 
 	void ScenePhysics::Update()
 	{
-		m_dynamicsWorld->stepSimulation(Engine::Get()->GetDelta().AsSeconds());
+		Simulate(Engine::Get()->GetDelta());
+	}
+
+	void ScenePhysics::Simulate(const Time &delta)
+	{
+		if (m_multithreaded)
+		{
+			btSetTaskScheduler(GetTaskScheduler());
+		}
+
+		// The world keeps the time left over after its steps, this follows the same sums to know how far that time is into the next step.
+		auto timeStep = m_timestep.AsSeconds();
+		m_accumulator += delta.AsSeconds();
+
+		if (m_accumulator >= timeStep)
+		{
+			auto steps = static_cast<int32_t>(m_accumulator / timeStep);
+			m_accumulator -= steps * timeStep;
+		}
+
+		m_dynamicsWorld->stepSimulation(delta.AsSeconds(), static_cast<int32_t>(m_maxSubsteps), timeStep);
+		m_interpolation = std::clamp(m_accumulator / timeStep, 0.0f, 1.0f);
 		CheckForCollisionEvents();
 	}
 
@@ -73,6 +449,134 @@ namespace acid
 		return Raycast(result.hasHit(), Collider::Convert(result.m_hitPointWorld), result.m_collisionObject != nullptr ? static_cast<CollisionObject *>(result.m_collisionObject->getUserPointer()) : nullptr);
 	}
 
+	void ScenePhysics::Raytest(const RayQuery *rays, const std::size_t &count, QueryHit *hits, uint32_t *hitCounts, const QueryFilter &filter)
+	{
+		auto collisionWorld = m_dynamicsWorld->getCollisionWorld();
+		auto stride = filter.GetHitStride();
+
+		ForEachQuery(count, [&](const std::size_t &begin, const std::size_t &end)
+		{
+			std::vector<QueryResult> results;
+
+			for (auto i = begin; i < end; i++)
+			{
+				auto from = Collider::Convert(rays[i].m_start);
+				auto to = Collider::Convert(rays[i].m_end);
+				results.clear();
+
+				if (filter.m_allHits)
+				{
+					btCollisionWorld::AllHitsRayResultCallback result(from, to);
+					result.m_collisionFilterGroup = filter.m_group;
+					result.m_collisionFilterMask = filter.m_mask;
+					collisionWorld->rayTest(from, to, result);
+
+					for (int32_t j = 0; j < result.m_collisionObjects.size(); j++)
+					{
+						results.emplace_back(QueryResult{result.m_collisionObjects[j], result.m_hitPointWorld[j], result.m_hitNormalWorld[j], result.m_hitFractions[j]});
+					}
+				}
+				else
+				{
+					btCollisionWorld::ClosestRayResultCallback result(from, to);
+					result.m_collisionFilterGroup = filter.m_group;
+					result.m_collisionFilterMask = filter.m_mask;
+					collisionWorld->rayTest(from, to, result);
+
+					if (result.hasHit())
+					{
+						results.emplace_back(QueryResult{result.m_collisionObject, result.m_hitPointWorld, result.m_hitNormalWorld, result.m_closestHitFraction});
+					}
+				}
+
+				WriteHits(results, stride, hits + i * stride, hitCounts != nullptr ? hitCounts + i : nullptr);
+			}
+		});
+	}
+
+	void ScenePhysics::SphereSweep(const SweepQuery *sweeps, const std::size_t &count, QueryHit *hits, uint32_t *hitCounts, const QueryFilter &filter)
+	{
+		auto collisionWorld = m_dynamicsWorld->getCollisionWorld();
+		auto stride = filter.GetHitStride();
+
+		ForEachQuery(count, [&](const std::size_t &begin, const std::size_t &end)
+		{
+			std::vector<QueryResult> results;
+
+			for (auto i = begin; i < end; i++)
+			{
+				btSphereShape sphere(sweeps[i].m_radius);
+				auto from = btTransform(btQuaternion::getIdentity(), Collider::Convert(sweeps[i].m_start));
+				auto to = btTransform(btQuaternion::getIdentity(), Collider::Convert(sweeps[i].m_end));
+				results.clear();
+
+				if (filter.m_allHits)
+				{
+					AllHitsConvexResultCallback result(results);
+					result.m_collisionFilterGroup = filter.m_group;
+					result.m_collisionFilterMask = filter.m_mask;
+					collisionWorld->convexSweepTest(&sphere, from, to, result);
+				}
+				else
+				{
+					btCollisionWorld::ClosestConvexResultCallback result(from.getOrigin(), to.getOrigin());
+					result.m_collisionFilterGroup = filter.m_group;
+					result.m_collisionFilterMask = filter.m_mask;
+					collisionWorld->convexSweepTest(&sphere, from, to, result);
+
+					if (result.hasHit())
+					{
+						results.emplace_back(QueryResult{result.m_hitCollisionObject, result.m_hitPointWorld, result.m_hitNormalWorld, result.m_closestHitFraction});
+					}
+				}
+
+				WriteHits(results, stride, hits + i * stride, hitCounts != nullptr ? hitCounts + i : nullptr);
+			}
+		});
+	}
+
+	void ScenePhysics::Overlap(const OverlapQuery *overlaps, const std::size_t &count, QueryHit *hits, uint32_t *hitCounts, const QueryFilter &filter)
+	{
+		auto broadphase = m_broadphase.get();
+		auto stride = filter.GetHitStride();
+
+		ForEachQuery(count, [&](const std::size_t &begin, const std::size_t &end)
+		{
+			std::vector<const btCollisionObject *> collisionObjects;
+			std::vector<QueryResult> results;
+
+			for (auto i = begin; i < end; i++)
+			{
+				btSphereShape sphere(overlaps[i].m_radius);
+				auto sphereTransform = btTransform(btQuaternion::getIdentity(), Collider::Convert(overlaps[i].m_position));
+				auto extents = btVector3(overlaps[i].m_radius, overlaps[i].m_radius, overlaps[i].m_radius);
+				collisionObjects.clear();
+				results.clear();
+
+				// The broadphase finds the objects with bounds near the sphere, then each is tested against the sphere until enough overlap.
+				OverlapAabbCallback callback(filter, collisionObjects);
+				broadphase->aabbTest(sphereTransform.getOrigin() - extents, sphereTransform.getOrigin() + extents, callback);
+
+				for (const auto &collisionObject : collisionObjects)
+				{
+					QueryResult result = {collisionObject, btVector3(), btVector3(), 0.0f};
+
+					if (SphereOverlaps(sphere, sphereTransform, collisionObject->getCollisionShape(), collisionObject->getWorldTransform(), result))
+					{
+						results.emplace_back(result);
+
+						if (results.size() == stride)
+						{
+							break;
+						}
+					}
+				}
+
+				WriteHits(results, stride, hits + i * stride, hitCounts != nullptr ? hitCounts + i : nullptr);
+			}
+		});
+	}
+
 	void ScenePhysics::SetGravity(const Vector3 &gravity)
 	{
 		m_gravity = gravity;
@@ -82,11 +586,37 @@ namespace acid
 	void ScenePhysics::SetAirDensity(const float &airDensity)
 	{
 		m_airDensity = airDensity;
+
+		if (m_multithreaded)
+		{
+			return;
+		}
+
 		auto softDynamicsWorld = static_cast<btSoftRigidDynamicsWorld *>(m_dynamicsWorld.get());
 		softDynamicsWorld->getWorldInfo().air_density = m_airDensity;
 		softDynamicsWorld->getWorldInfo().m_sparsesdf.Initialize();
 	}
 
+	void ScenePhysics::StorePreviousTransforms()
+	{
+		auto &collisionObjects = m_dynamicsWorld->getCollisionObjectArray();
+
+		for (int32_t i = 0; i < collisionObjects.size(); i++)
+		{
+			auto body = btRigidBody::upcast(collisionObjects[i]);
+
+			// Only bodies that can move between steps are interpolated, rigid bodies are created by rigidbody components.
+			if (body == nullptr || body->getUserPointer() == nullptr || body->isStaticOrKinematicObject() || !body->isActive())
+			{
+				continue;
+			}
+
+			auto rigidbody = static_cast<Rigidbody *>(body->getUserPointer());
+			rigidbody->m_previousPosition = Collider::Convert(body->getWorldTransform().getOrigin());
+			rigidbody->m_previousRotation = Collider::Convert(body->getWorldTransform().getRotation());
+		}
+	}
+
 	void ScenePhysics::CheckForCollisionEvents()
 	{
 		// Keep a list of the collision pairs found during the current update.
@@ -126,7 +656,10 @@ namespace acid
 				auto collisionObjectA = static_cast<CollisionObject *>(sortedBodyA->getUserPointer());
 				auto collisionObjectB = static_cast<CollisionObject *>(sortedBodyB->getUserPointer());
 
-				collisionObjectA->GetOnCollision()(collisionObjectB);
+				if (collisionObjectA != nullptr && collisionObjectB != nullptr)
+				{
+					collisionObjectA->GetOnCollision()(collisionObjectB);
+				}
 			}
 		}
 
@@ -145,7 +678,10 @@ namespace acid
 			auto collisionObjectA = static_cast<CollisionObject *>(removedPair.first->getUserPointer());
 			auto collisionObjectB = static_cast<CollisionObject *>(removedPair.second->getUserPointer());
 
-			collisionObjectA->GetOnSeparation()(collisionObjectB);
+			if (collisionObjectA != nullptr && collisionObjectB != nullptr)
+			{
+				collisionObjectA->GetOnSeparation()(collisionObjectB);
+			}
 		}
 
 		// In the next iteration we'll want to compare against the pairs we found in this iteration.
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <algorithm>
 #include <set>
 #include <memory>
 #include <optional>
+#include "Maths/Time.hpp"
 #include "Maths/Vector3.hpp"
 
 class btCollisionObject;
@@ -10,6 +12,7 @@ class btCollisionConfiguration;
 class btBroadphaseInterface;
 class btCollisionDispatcher;
 class btConstraintSolver;
+class btConstraintSolverPoolMt;
 class btDiscreteDynamicsWorld;
 class btCollisionShape;
 template<typename T>
@@ -44,17 +47,126 @@ namespace acid
 		CollisionObject *m_collisionObject;
 	};
 
+	/// <summary>
+	/// A ray cast from a start to a end point in a batched query.
+	/// </summary>
+	struct RayQuery
+	{
+		Vector3 m_start;
+		Vector3 m_end;
+	};
+
+	/// <summary>
+	/// A sphere swept from a start to a end point in a batched query.
+	/// </summary>
+	struct SweepQuery
+	{
+		Vector3 m_start;
+		Vector3 m_end;
+		float m_radius;
+	};
+
+	/// <summary>
+	/// A sphere tested for the objects it overlaps in a batched query.
+	/// </summary>
+	struct OverlapQuery
+	{
+		Vector3 m_position;
+		float m_radius;
+	};
+
+	/// <summary>
+	/// Which objects the queries in a batch can hit, and how many hits are kept for each query.
+	/// The groups and masks are the broadphase filter groups objects were added to the world with.
+	/// </summary>
+	struct QueryFilter
+	{
+		/// <summary>
+		/// Gets the number of hits written for each query, the closest hit only unless all hits are kept.
+		/// </summary>
+		/// <returns> The hit stride. </returns>
+		uint32_t GetHitStride() const { return m_allHits ? std::max(m_maxHits, 1u) : 1; }
+
+		int32_t m_group = 1;
+		int32_t m_mask = -1;
+		bool m_allHits = false;
+		uint32_t m_maxHits = 16;
+	};
+
+	/// <summary>
+	/// A hit written by a batched query, the fraction is how far along the query the hit is and is 0 for overlaps.
+	/// </summary>
+	struct QueryHit
+	{
+		bool m_hasHit = false;
+		CollisionObject *m_collisionObject = nullptr;
+		Vector3 m_pointWorld;
+		Vector3 m_normalWorld;
+		float m_fraction = 1.0f;
+	};
+
+	/// <summary>
+	/// The physics world of a scene, stepped at a fixed rate no matter how often it is updated.
+	/// Rigidbodies blend their transforms from the last two steps by <seealso cref="#GetInterpolation()"/>, so motion stays smooth when the update and step rates differ.
+	/// </summary>
 	class ACID_EXPORT ScenePhysics
 	{
 	public:
-		ScenePhysics();
+		/// <summary>
+		/// Creates a new physics world.
+		/// </summary>
+		/// <param name="multithreaded"> If the world collides, solves and integrates on worker threads, soft bodies and air density are not supported by this world.
+		/// Ignored with a warning when Bullet was not built with BT_THREADSAFE. </param>
+		explicit ScenePhysics(const bool &multithreaded = false);
 
 		~ScenePhysics();
 
+		/// <summary>
+		/// Simulates the world by the engine delta.
+		/// </summary>
 		void Update();
 
+		/// <summary>
+		/// Simulates the world by a amount of time, stepping it as many times as fit into the time carried over from the last update.
+		/// </summary>
+		/// <param name="delta"> The time passed since the world was last simulated. </param>
+		void Simulate(const Time &delta);
+
 		Raycast Raytest(const Vector3 &start, const Vector3 &end);
 
+		/// <summary>
+		/// Casts a batch of rays, the rays are split into jobs.
+		/// The world must not be simulated or changed until the batch returns.
+		/// </summary>
+		/// <param name="rays"> The rays to cast. </param>
+		/// <param name="count"> The number of rays. </param>
+		/// <param name="hits"> Filled with <seealso cref="QueryFilter#GetHitStride()"/> hits for each ray closest first, slots past the last hit of a ray have no hit. </param>
+		/// <param name="hitCounts"> Filled with the number of hits written for each ray, or nullptr. </param>
+		/// <param name="filter"> The objects that can be hit and if every hit is kept. </param>
+		void Raytest(const RayQuery *rays, const std::size_t &count, QueryHit *hits, uint32_t *hitCounts = nullptr, const QueryFilter &filter = QueryFilter());
+
+		/// <summary>
+		/// Sweeps a batch of spheres, the sweeps are split into jobs.
+		/// The world must not be simulated or changed until the batch returns.
+		/// </summary>
+		/// <param name="sweeps"> The spheres to sweep. </param>
+		/// <param name="count"> The number of sweeps. </param>
+		/// <param name="hits"> Filled with <seealso cref="QueryFilter#GetHitStride()"/> hits for each sweep closest first, slots past the last hit of a sweep have no hit. </param>
+		/// <param name="hitCounts"> Filled with the number of hits written for each sweep, or nullptr. </param>
+		/// <param name="filter"> The objects that can be hit and if every hit is kept. </param>
+		void SphereSweep(const SweepQuery *sweeps, const std::size_t &count, QueryHit *hits, uint32_t *hitCounts = nullptr, const QueryFilter &filter = QueryFilter());
+
+		/// <summary>
+		/// Finds the objects overlapping a batch of spheres, the tests are split into jobs.
+		/// The world must not be simulated or changed until the batch returns.
+		/// </summary>
+		/// <param name="overlaps"> The spheres to test. </param>
+		/// <param name="count"> The number of spheres. </param>
+		/// <param name="hits"> Filled with <seealso cref="QueryFilter#GetHitStride()"/> hits for each sphere, the first object found is kept unless all hits are kept. </param>
+		/// <param name="hitCounts"> Filled with the number of hits written for each sphere, or nullptr. </param>
+		/// <param name="filter"> The objects that can be hit and if every hit is kept. </param>
+		void Overlap(const OverlapQuery *overlaps, const std::size_t &count, QueryHit *hits, uint32_t *hitCounts = nullptr, const QueryFilter &filter = QueryFilter());
+
 		const Vector3 &GetGravity() const { return m_gravity; }
 
 		void SetGravity(const Vector3 &gravity);
@@ -63,17 +175,48 @@ namespace acid
 
 		void SetAirDensity(const float &airDensity);
 
+		const bool &IsMultithreaded() const { return m_multithreaded; }
+
+		/// <summary>
+		/// Gets the time the world is moved by in each step.
+		/// </summary>
+		/// <returns> The fixed timestep. </returns>
+		const Time &GetTimestep() const { return m_timestep; }
+
+		void SetTimestep(const Time &timestep) { m_timestep = timestep; }
+
+		/// <summary>
+		/// Gets the most steps taken in one update, time that would need more steps is dropped so a slow frame does not slow down the next ones.
+		/// </summary>
+		/// <returns> The max substeps. </returns>
+		const uint32_t &GetMaxSubsteps() const { return m_maxSubsteps; }
+
+		void SetMaxSubsteps(const uint32_t &maxSubsteps) { m_maxSubsteps = std::max(maxSubsteps, 1u); }
+
+		/// <summary>
+		/// Gets how far the time simulated is between the last step and the next, from 0 to 1.
+		/// </summary>
+		/// <returns> The interpolation factor. </returns>
+		const float &GetInterpolation() const { return m_interpolation; }
+
 		btBroadphaseInterface *GetBroadphase() { return m_broadphase.get(); }
 
 		btDiscreteDynamicsWorld *GetDynamicsWorld() { return m_dynamicsWorld.get(); }
 
 		btAlignedObjectArray<btCollisionShape *> *GetCollisionShapes() { return m_collisionShapes.get(); }
 	private:
+		/// <summary>
+		/// Keeps the transform of each moving rigidbody before a step, called by the world before every step it takes.
+		/// </summary>
+		void StorePreviousTransforms();
+
 		void CheckForCollisionEvents();
 
+		bool m_multithreaded;
 		std::unique_ptr<btCollisionConfiguration> m_collisionConfiguration;
 		std::unique_ptr<btBroadphaseInterface> m_broadphase;
 		std::unique_ptr<btCollisionDispatcher> m_dispatcher;
+		std::unique_ptr<btConstraintSolverPoolMt> m_solverPool;
 		std::unique_ptr<btConstraintSolver> m_solver;
 		std::unique_ptr<btDiscreteDynamicsWorld> m_dynamicsWorld;
 		std::unique_ptr<btAlignedObjectArray<btCollisionShape *>> m_collisionShapes;
@@ -81,5 +224,10 @@ namespace acid
 
 		Vector3 m_gravity;
 		float m_airDensity;
+
+		Time m_timestep;
+		uint32_t m_maxSubsteps;
+		float m_accumulator;
+		float m_interpolation;
 	};
 }
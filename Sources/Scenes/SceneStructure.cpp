@@ -1,6 +1,7 @@
 ﻿#include "SceneStructure.hpp"
 
 #include "Physics/Rigidbody.hpp"
+#include "Threads/JobSystem.hpp"
 
 namespace acid
 {
@@ -12,6 +13,7 @@ namespace acid
 	{
 		auto entity = new Entity(transform);
 		m_objects.emplace_back(entity);
+		m_hierarchy.Add(entity);
 		return entity;
 	}
 
@@ -19,21 +21,25 @@ namespace acid
 	{
 		auto entity = new Entity(filename, transform);
 		m_objects.emplace_back(entity);
+		m_hierarchy.Add(entity);
 		return entity;
 	}
 
 	void SceneStructure::Add(Entity *object)
 	{
 		m_objects.emplace_back(object);
+		m_hierarchy.Add(object);
 	}
 
 	void SceneStructure::Add(std::unique_ptr<Entity> object)
 	{
+		m_hierarchy.Add(object.get());
 		m_objects.emplace_back(std::move(object));
 	}
 
 	void SceneStructure::Remove(Entity *object)
 	{
+		m_tree.Remove(object);
 		m_objects.erase(std::remove_if(m_objects.begin(), m_objects.end(), [object](std::unique_ptr<Entity> &e)
 		{
 			return e.get() == object;
@@ -49,13 +55,16 @@ namespace acid
 				continue;
 			}
 
+			m_tree.Remove(object);
 			structure.Add(std::move(*it));
 			m_objects.erase(it);
+			return;
 		}
 	}
 
 	void SceneStructure::Clear()
 	{
+		m_tree.Clear();
 		m_objects.clear();
 	}
 
@@ -65,6 +74,7 @@ namespace acid
 		{
 			if ((*it)->IsRemoved())
 			{
+				m_tree.Remove(it->get());
 				it = m_objects.erase(it);
 				continue;
 			}
@@ -72,6 +82,9 @@ namespace acid
 			(*it)->Update();
 			++it;
 		}
+
+		m_hierarchy.Update(JobSystem::Get());
+		UpdateTree();
 	}
 
 	std::vector<Entity *> SceneStructure::QueryAll()
@@ -94,34 +107,34 @@ namespace acid
 	std::vector<Entity *> SceneStructure::QueryFrustum(const Frustum &range)
 	{
 		std::vector<Entity *> result = {};
+		m_tree.QueryFrustum(range, result);
+		EraseRemoved(result);
+		return result;
+	}
 
-		for (const auto &object : m_objects)
-		{
-			if (object->IsRemoved())
-			{
-				continue;
-			}
-
-			auto rigidbody = object->GetComponent<Rigidbody>();
-
-			if (rigidbody == nullptr || rigidbody->InFrustum(range))
-			{
-				result.emplace_back(object.get());
-			}
-		}
-
+	std::vector<Entity *> SceneStructure::QuerySphere(const Vector3 &centre, const float &radius)
+	{
+		std::vector<Entity *> result = {};
+		m_tree.QuerySphere(centre, radius, result);
+		EraseRemoved(result);
 		return result;
 	}
 
-	/*std::vector<Entity *> SceneStructure::QuerySphere(const Vector3 &centre, const Vector3 &radius)
+	std::vector<Entity *> SceneStructure::QueryCube(const Vector3 &min, const Vector3 &max)
 	{
-		return std::vector<Entity *>();
-	}*/
+		std::vector<Entity *> result = {};
+		m_tree.QueryCube(min, max, result);
+		EraseRemoved(result);
+		return result;
+	}
 
-	/*std::vector<Entity *> SceneStructure::QueryCube(const Vector3 &min, const Vector3 &max)
+	std::vector<Entity *> SceneStructure::QueryRay(const Ray &ray, const float &distance)
 	{
-		return std::vector<Entity *>();
-	}*/
+		std::vector<Entity *> result = {};
+		m_tree.QueryRay(ray.GetOrigin(), ray.GetCurrentRay(), distance, result);
+		EraseRemoved(result);
+		return result;
+	}
 
 	bool SceneStructure::Contains(Entity *object)
 	{
@@ -135,4 +148,42 @@ namespace acid
 
 		return false;
 	}
+
+	void SceneStructure::UpdateTree()
+	{
+		const auto &entities = m_hierarchy.GetEntities();
+
+		for (uint32_t i = 0; i < entities.size(); i++)
+		{
+			if (!m_hierarchy.IsMoved(i))
+			{
+				continue;
+			}
+
+			// Entities without a collision object are kept in the tree as a point at their world position.
+			auto collisionObject = entities[i]->GetComponent<CollisionObject>();
+			Vector3 min;
+			Vector3 max;
+
+			if (collisionObject != nullptr)
+			{
+				collisionObject->GetAabb(min, max);
+			}
+			else
+			{
+				min = m_hierarchy.GetWorldTransform(i).GetPosition();
+				max = min;
+			}
+
+			m_tree.Move(entities[i], min, max);
+		}
+	}
+
+	void SceneStructure::EraseRemoved(std::vector<Entity *> &result)
+	{
+		result.erase(std::remove_if(result.begin(), result.end(), [](Entity *entity)
+		{
+			return entity->IsRemoved();
+		}), result.end());
+	}
 }
@@ -1,8 +1,12 @@
 ﻿#pragma once
 
 #include <vector>
+#include "Physics/Ray.hpp"
 #include "Physics/Rigidbody.hpp"
+#include "Archetypes/ArchetypeStorage.hpp"
 #include "Entity.hpp"
+#include "SpatialTree.hpp"
+#include "TransformHierarchy.hpp"
 
 namespace acid
 {
@@ -64,7 +68,7 @@ namespace acid
 		void Clear();
 
 		/// <summary>
-		/// Updates all of the entity.
+		/// Updates all of the entity, then updates the world transforms and the spatial tree bounds of the entities that moved.
 		/// </summary>
 		void Update();
 
@@ -83,15 +87,36 @@ namespace acid
 
 		/// <summary>
 		/// Returns a set of all objects in a spatial objects contained in a frustum.
+		/// The spatial queries use the bounds of the objects from the last update, the collision object bounds or otherwise the world position.
 		/// </summary>
 		/// <param name="range"> The frustum range of space being queried. </param>
 		/// </param>
 		/// <returns> The list of all object in range. </returns>
 		std::vector<Entity *> QueryFrustum(const Frustum &range);
 
-	//	std::vector<Entity *> QuerySphere(const Vector3 &centre, const Vector3 &radius);
+		/// <summary>
+		/// Returns a set of all objects with bounds intersecting a sphere.
+		/// </summary>
+		/// <param name="centre"> The centre of the sphere. </param>
+		/// <param name="radius"> The radius of the sphere. </param>
+		/// <returns> The list of all object in range. </returns>
+		std::vector<Entity *> QuerySphere(const Vector3 &centre, const float &radius);
+
+		/// <summary>
+		/// Returns a set of all objects with bounds intersecting a box.
+		/// </summary>
+		/// <param name="min"> The minimum corner of the box. </param>
+		/// <param name="max"> The maximum corner of the box. </param>
+		/// <returns> The list of all object in range. </returns>
+		std::vector<Entity *> QueryCube(const Vector3 &min, const Vector3 &max);
 
-	//	std::vector<Entity *> QueryCube(const Vector3 &min, const Vector3 &max);
+		/// <summary>
+		/// Returns a set of all objects with bounds hit by a ray, in no particular order.
+		/// </summary>
+		/// <param name="ray"> The ray, from its origin along its current direction. </param>
+		/// <param name="distance"> The length of the ray. </param>
+		/// <returns> The list of all object hit. </returns>
+		std::vector<Entity *> QueryRay(const Ray &ray, const float &distance);
 
 		/// <summary>
 		/// Returns a set of all components of a type in the spatial structure.
@@ -147,7 +172,39 @@ namespace acid
 		/// </param>
 		/// <returns> If the structure contains the object. </returns>
 		bool Contains(Entity *object);
+
+		/// <summary>
+		/// Gets the data oriented storage for entities made of plain data components, iterated with a <seealso cref="View"/> instead of the component queries above.
+		/// </summary>
+		/// <returns> The archetype storage. </returns>
+		ArchetypeStorage &GetStorage() { return m_storage; }
+
+		/// <summary>
+		/// Gets the flattened world transforms of the entities in this structure.
+		/// </summary>
+		/// <returns> The transform hierarchy. </returns>
+		TransformHierarchy &GetHierarchy() { return m_hierarchy; }
+
+		/// <summary>
+		/// Gets the spatial tree of entity bounds the spatial queries use.
+		/// </summary>
+		/// <returns> The spatial tree. </returns>
+		const SpatialTree &GetTree() const { return m_tree; }
 	private:
+		/// <summary>
+		/// Moves the spatial tree bounds of every entity with a world transform that changed in the last hierarchy update.
+		/// </summary>
+		void UpdateTree();
+
+		/// <summary>
+		/// Erases the entities marked as removed from a list of query results, they stay in the tree until the next update.
+		/// </summary>
+		/// <param name="result"> The query results. </param>
+		static void EraseRemoved(std::vector<Entity *> &result);
+
 		std::vector<std::unique_ptr<Entity>> m_objects;
+		ArchetypeStorage m_storage;
+		TransformHierarchy m_hierarchy;
+		SpatialTree m_tree;
 	};
 }
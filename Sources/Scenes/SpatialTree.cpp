@@ -0,0 +1,557 @@
+#include "SpatialTree.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include "Physics/Frustum.hpp"
+#include "Entity.hpp"
+
+namespace acid
+{
+	const uint32_t SpatialTree::NullNode = std::numeric_limits<uint32_t>::max();
+
+	// Half of the surface area of a box, the cost of a node is how likely a query is to enter it.
+	static float Area(const Vector3 &min, const Vector3 &max)
+	{
+		auto size = max - min;
+		return size.m_x * size.m_y + size.m_y * size.m_z + size.m_z * size.m_x;
+	}
+
+	static bool Contains(const Vector3 &outerMin, const Vector3 &outerMax, const Vector3 &min, const Vector3 &max)
+	{
+		return outerMin.m_x <= min.m_x && outerMin.m_y <= min.m_y && outerMin.m_z <= min.m_z &&
+			max.m_x <= outerMax.m_x && max.m_y <= outerMax.m_y && max.m_z <= outerMax.m_z;
+	}
+
+	// Clips the range of a ray on one axis to the slab of a box, returns false once the range is empty.
+	static bool ClipSlab(const float &origin, const float &direction, const float &inverse, const float &min, const float &max, float &enter, float &leave)
+	{
+		if (direction == 0.0f)
+		{
+			return origin >= min && origin <= max;
+		}
+
+		auto t1 = (min - origin) * inverse;
+		auto t2 = (max - origin) * inverse;
+
+		if (t1 > t2)
+		{
+			std::swap(t1, t2);
+		}
+
+		enter = std::max(enter, t1);
+		leave = std::min(leave, t2);
+		return enter <= leave;
+	}
+
+	SpatialTree::SpatialTree(const float &margin) :
+		m_root(NullNode),
+		m_freeList(NullNode),
+		m_leafCount(0),
+		m_margin(margin)
+	{
+	}
+
+	SpatialTree::~SpatialTree()
+	{
+		Clear();
+	}
+
+	void SpatialTree::Add(Entity *entity, const Vector3 &min, const Vector3 &max)
+	{
+		if (Contains(entity))
+		{
+			Move(entity, min, max);
+			return;
+		}
+
+		auto leaf = AllocateNode();
+		auto &node = m_nodes[leaf];
+		node.min = min - m_margin;
+		node.max = max + m_margin;
+		node.entityMin = min;
+		node.entityMax = max;
+		node.entity = entity;
+		node.height = 0;
+		entity->m_leaf = leaf;
+
+		InsertLeaf(leaf);
+		m_leafCount++;
+	}
+
+	void SpatialTree::Remove(Entity *entity)
+	{
+		if (!Contains(entity))
+		{
+			return;
+		}
+
+		auto leaf = entity->m_leaf;
+		RemoveLeaf(leaf);
+		FreeNode(leaf);
+		entity->m_leaf = NullNode;
+		m_leafCount--;
+	}
+
+	bool SpatialTree::Move(Entity *entity, const Vector3 &min, const Vector3 &max)
+	{
+		if (!Contains(entity))
+		{
+			Add(entity, min, max);
+			return true;
+		}
+
+		auto leaf = entity->m_leaf;
+		auto &node = m_nodes[leaf];
+		node.entityMin = min;
+		node.entityMax = max;
+
+		if (acid::Contains(node.min, node.max, min, max))
+		{
+			return false;
+		}
+
+		RemoveLeaf(leaf);
+		node.min = min - m_margin;
+		node.max = max + m_margin;
+		InsertLeaf(leaf);
+		return true;
+	}
+
+	bool SpatialTree::Contains(Entity *entity) const
+	{
+		auto leaf = entity->m_leaf;
+		return leaf < m_nodes.size() && m_nodes[leaf].entity == entity;
+	}
+
+	void SpatialTree::Clear()
+	{
+		for (const auto &node : m_nodes)
+		{
+			if (node.entity != nullptr)
+			{
+				node.entity->m_leaf = NullNode;
+			}
+		}
+
+		m_nodes.clear();
+		m_root = NullNode;
+		m_freeList = NullNode;
+		m_leafCount = 0;
+	}
+
+	template<typename F>
+	void SpatialTree::Query(const F &overlaps, std::vector<Entity *> &result) const
+	{
+		if (m_root == NullNode)
+		{
+			return;
+		}
+
+		std::vector<uint32_t> stack;
+		stack.reserve(64);
+		stack.emplace_back(m_root);
+
+		while (!stack.empty())
+		{
+			const auto &node = m_nodes[stack.back()];
+			stack.pop_back();
+
+			if (node.IsLeaf())
+			{
+				if (overlaps(node.entityMin, node.entityMax))
+				{
+					result.emplace_back(node.entity);
+				}
+
+				continue;
+			}
+
+			if (overlaps(node.min, node.max))
+			{
+				stack.emplace_back(node.left);
+				stack.emplace_back(node.right);
+			}
+		}
+	}
+
+	void SpatialTree::QueryFrustum(const Frustum &frustum, std::vector<Entity *> &result) const
+	{
+		if (m_root == NullNode)
+		{
+			return;
+		}
+
+		const auto &planes = frustum.GetPlanes();
+
+		// Each node is entered with a mask of the planes its parent was not fully inside of, a node inside every plane adds its whole subtree.
+		std::vector<std::pair<uint32_t, uint32_t>> stack;
+		stack.reserve(64);
+		stack.emplace_back(m_root, 0x3f);
+
+		while (!stack.empty())
+		{
+			auto index = stack.back().first;
+			auto mask = stack.back().second;
+			stack.pop_back();
+
+			const auto &node = m_nodes[index];
+			const auto &min = node.IsLeaf() ? node.entityMin : node.min;
+			const auto &max = node.IsLeaf() ? node.entityMax : node.max;
+			bool outside = false;
+
+			for (uint32_t i = 0; i < 6 && mask != 0; i++)
+			{
+				if ((mask & (1 << i)) == 0)
+				{
+					continue;
+				}
+
+				const auto &plane = planes[i];
+
+				// The corner furthest along the plane normal is behind the plane only when the whole box is.
+				auto furthest = plane[0] * (plane[0] > 0.0f ? max.m_x : min.m_x) + plane[1] * (plane[1] > 0.0f ? max.m_y : min.m_y) +
+					plane[2] * (plane[2] > 0.0f ? max.m_z : min.m_z) + plane[3];
+
+				if (furthest <= 0.0f)
+				{
+					outside = true;
+					break;
+				}
+
+				auto nearest = plane[0] * (plane[0] > 0.0f ? min.m_x : max.m_x) + plane[1] * (plane[1] > 0.0f ? min.m_y : max.m_y) +
+					plane[2] * (plane[2] > 0.0f ? min.m_z : max.m_z) + plane[3];
+
+				if (nearest > 0.0f)
+				{
+					mask &= ~(1 << i);
+				}
+			}
+
+			if (outside)
+			{
+				continue;
+			}
+
+			if (node.IsLeaf())
+			{
+				result.emplace_back(node.entity);
+				continue;
+			}
+
+			stack.emplace_back(node.left, mask);
+			stack.emplace_back(node.right, mask);
+		}
+	}
+
+	void SpatialTree::QuerySphere(const Vector3 &centre, const float &radius, std::vector<Entity *> &result) const
+	{
+		auto radiusSquared = radius * radius;
+
+		Query([&](const Vector3 &min, const Vector3 &max)
+		{
+			auto closest = Vector3::MaxVector(min, Vector3::MinVector(centre, max));
+			return (closest - centre).LengthSquared() <= radiusSquared;
+		}, result);
+	}
+
+	void SpatialTree::QueryCube(const Vector3 &min, const Vector3 &max, std::vector<Entity *> &result) const
+	{
+		Query([&](const Vector3 &nodeMin, const Vector3 &nodeMax)
+		{
+			return nodeMin.m_x <= max.m_x && nodeMin.m_y <= max.m_y && nodeMin.m_z <= max.m_z &&
+				min.m_x <= nodeMax.m_x && min.m_y <= nodeMax.m_y && min.m_z <= nodeMax.m_z;
+		}, result);
+	}
+
+	void SpatialTree::QueryRay(const Vector3 &origin, const Vector3 &direction, const float &distance, std::vector<Entity *> &result) const
+	{
+		auto length = direction.Length();
+
+		if (length == 0.0f)
+		{
+			return;
+		}
+
+		auto normal = direction / length;
+		auto inverse = Vector3(1.0f / normal.m_x, 1.0f / normal.m_y, 1.0f / normal.m_z);
+
+		Query([&](const Vector3 &min, const Vector3 &max)
+		{
+			float enter = 0.0f;
+			float leave = distance;
+			return ClipSlab(origin.m_x, normal.m_x, inverse.m_x, min.m_x, max.m_x, enter, leave) &&
+				ClipSlab(origin.m_y, normal.m_y, inverse.m_y, min.m_y, max.m_y, enter, leave) &&
+				ClipSlab(origin.m_z, normal.m_z, inverse.m_z, min.m_z, max.m_z, enter, leave);
+		}, result);
+	}
+
+	int32_t SpatialTree::GetHeight() const
+	{
+		return m_root != NullNode ? m_nodes[m_root].height : 0;
+	}
+
+	uint32_t SpatialTree::AllocateNode()
+	{
+		uint32_t index;
+
+		if (m_freeList != NullNode)
+		{
+			index = m_freeList;
+			m_freeList = m_nodes[index].parent;
+		}
+		else
+		{
+			index = static_cast<uint32_t>(m_nodes.size());
+			m_nodes.emplace_back();
+		}
+
+		auto &node = m_nodes[index];
+		node.entity = nullptr;
+		node.parent = NullNode;
+		node.left = NullNode;
+		node.right = NullNode;
+		node.height = 0;
+		return index;
+	}
+
+	void SpatialTree::FreeNode(const uint32_t &node)
+	{
+		m_nodes[node].entity = nullptr;
+		m_nodes[node].parent = m_freeList;
+		m_nodes[node].height = -1;
+		m_freeList = node;
+	}
+
+	void SpatialTree::InsertLeaf(const uint32_t &leaf)
+	{
+		if (m_root == NullNode)
+		{
+			m_root = leaf;
+			m_nodes[leaf].parent = NullNode;
+			return;
+		}
+
+		// Walks down to the sibling that makes the new parent cheapest, the cost of a node is the area added to the tree.
+		auto leafMin = m_nodes[leaf].min;
+		auto leafMax = m_nodes[leaf].max;
+		auto index = m_root;
+
+		auto descendCost = [&](const Node &child)
+		{
+			auto area = Area(Vector3::MinVector(leafMin, child.min), Vector3::MaxVector(leafMax, child.max));
+			return child.IsLeaf() ? area : area - Area(child.min, child.max);
+		};
+
+		while (!m_nodes[index].IsLeaf())
+		{
+			const auto &node = m_nodes[index];
+			auto area = Area(node.min, node.max);
+			auto combinedArea = Area(Vector3::MinVector(leafMin, node.min), Vector3::MaxVector(leafMax, node.max));
+
+			// Cost of a new parent for this node and the leaf, and the cost added to every node above when going further down.
+			auto cost = 2.0f * combinedArea;
+			auto inheritanceCost = 2.0f * (combinedArea - area);
+			auto costLeft = descendCost(m_nodes[node.left]) + inheritanceCost;
+			auto costRight = descendCost(m_nodes[node.right]) + inheritanceCost;
+
+			if (cost < costLeft && cost < costRight)
+			{
+				break;
+			}
+
+			index = costLeft < costRight ? node.left : node.right;
+		}
+
+		auto sibling = index;
+		auto oldParent = m_nodes[sibling].parent;
+		auto newParent = AllocateNode();
+
+		auto &parentNode = m_nodes[newParent];
+		parentNode.parent = oldParent;
+		parentNode.min = Vector3::MinVector(leafMin, m_nodes[sibling].min);
+		parentNode.max = Vector3::MaxVector(leafMax, m_nodes[sibling].max);
+		parentNode.height = m_nodes[sibling].height + 1;
+		parentNode.left = sibling;
+		parentNode.right = leaf;
+		m_nodes[sibling].parent = newParent;
+		m_nodes[leaf].parent = newParent;
+
+		if (oldParent == NullNode)
+		{
+			m_root = newParent;
+		}
+		else if (m_nodes[oldParent].left == sibling)
+		{
+			m_nodes[oldParent].left = newParent;
+		}
+		else
+		{
+			m_nodes[oldParent].right = newParent;
+		}
+
+		// Fixes the heights and bounds of every node above the leaf.
+		index = m_nodes[leaf].parent;
+
+		while (index != NullNode)
+		{
+			index = Balance(index);
+
+			auto &node = m_nodes[index];
+			const auto &left = m_nodes[node.left];
+			const auto &right = m_nodes[node.right];
+			node.height = 1 + std::max(left.height, right.height);
+			node.min = Vector3::MinVector(left.min, right.min);
+			node.max = Vector3::MaxVector(left.max, right.max);
+			index = node.parent;
+		}
+	}
+
+	void SpatialTree::RemoveLeaf(const uint32_t &leaf)
+	{
+		if (leaf == m_root)
+		{
+			m_root = NullNode;
+			return;
+		}
+
+		// The sibling of the leaf takes the place of their parent.
+		auto parent = m_nodes[leaf].parent;
+		auto grandParent = m_nodes[parent].parent;
+		auto sibling = m_nodes[parent].left == leaf ? m_nodes[parent].right : m_nodes[parent].left;
+		FreeNode(parent);
+		m_nodes[sibling].parent = grandParent;
+
+		if (grandParent == NullNode)
+		{
+			m_root = sibling;
+			return;
+		}
+
+		if (m_nodes[grandParent].left == parent)
+		{
+			m_nodes[grandParent].left = sibling;
+		}
+		else
+		{
+			m_nodes[grandParent].right = sibling;
+		}
+
+		auto index = grandParent;
+
+		while (index != NullNode)
+		{
+			index = Balance(index);
+
+			auto &node = m_nodes[index];
+			const auto &left = m_nodes[node.left];
+			const auto &right = m_nodes[node.right];
+			node.height = 1 + std::max(left.height, right.height);
+			node.min = Vector3::MinVector(left.min, right.min);
+			node.max = Vector3::MaxVector(left.max, right.max);
+			index = node.parent;
+		}
+	}
+
+	uint32_t SpatialTree::Balance(const uint32_t &node)
+	{
+		auto &a = m_nodes[node];
+
+		if (a.IsLeaf() || a.height < 2)
+		{
+			return node;
+		}
+
+		auto indexB = a.left;
+		auto indexC = a.right;
+		auto &b = m_nodes[indexB];
+		auto &c = m_nodes[indexC];
+		auto balance = c.height - b.height;
+
+		if (balance > 1)
+		{
+			// Rotates C up into the place of A, A takes the shorter child of C.
+			auto indexF = c.left;
+			auto indexG = c.right;
+			auto &f = m_nodes[indexF];
+			auto &g = m_nodes[indexG];
+
+			c.left = node;
+			c.parent = a.parent;
+			a.parent = indexC;
+
+			if (c.parent == NullNode)
+			{
+				m_root = indexC;
+			}
+			else if (m_nodes[c.parent].left == node)
+			{
+				m_nodes[c.parent].left = indexC;
+			}
+			else
+			{
+				m_nodes[c.parent].right = indexC;
+			}
+
+			auto &taller = f.height > g.height ? f : g;
+			auto &shorter = f.height > g.height ? g : f;
+			auto indexTaller = f.height > g.height ? indexF : indexG;
+			auto indexShorter = f.height > g.height ? indexG : indexF;
+
+			c.right = indexTaller;
+			a.right = indexShorter;
+			shorter.parent = node;
+			a.min = Vector3::MinVector(b.min, shorter.min);
+			a.max = Vector3::MaxVector(b.max, shorter.max);
+			c.min = Vector3::MinVector(a.min, taller.min);
+			c.max = Vector3::MaxVector(a.max, taller.max);
+			a.height = 1 + std::max(b.height, shorter.height);
+			c.height = 1 + std::max(a.height, taller.height);
+			return indexC;
+		}
+
+		if (balance < -1)
+		{
+			// Rotates B up into the place of A, A takes the shorter child of B.
+			auto indexD = b.left;
+			auto indexE = b.right;
+			auto &d = m_nodes[indexD];
+			auto &e = m_nodes[indexE];
+
+			b.left = node;
+			b.parent = a.parent;
+			a.parent = indexB;
+
+			if (b.parent == NullNode)
+			{
+				m_root = indexB;
+			}
+			else if (m_nodes[b.parent].left == node)
+			{
+				m_nodes[b.parent].left = indexB;
+			}
+			else
+			{
+				m_nodes[b.parent].right = indexB;
+			}
+
+			auto &taller = d.height > e.height ? d : e;
+			auto &shorter = d.height > e.height ? e : d;
+			auto indexTaller = d.height > e.height ? indexD : indexE;
+			auto indexShorter = d.height > e.height ? indexE : indexD;
+
+			b.right = indexTaller;
+			a.left = indexShorter;
+			shorter.parent = node;
+			a.min = Vector3::MinVector(c.min, shorter.min);
+			a.max = Vector3::MaxVector(c.max, shorter.max);
+			b.min = Vector3::MinVector(a.min, taller.min);
+			b.max = Vector3::MaxVector(a.max, taller.max);
+			a.height = 1 + std::max(c.height, shorter.height);
+			b.height = 1 + std::max(a.height, taller.height);
+			return indexB;
+		}
+
+		return node;
+	}
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <vector>
+#include "Helpers/NonCopyable.hpp"
+#include "Maths/Vector3.hpp"
+
+namespace acid
+{
+	class Entity;
+	class Frustum;
+
+	/// <summary>
+	/// A dynamic bounding volume tree over the bounds of entities, queried in logarithmic time.
+	/// Each leaf stores the bounds of its entity grown by a margin, an entity that moves within its grown bounds only updates its leaf.
+	/// Leaves are inserted beside the node that grows the surface area of the tree the least, and rotations keep the tree balanced.
+	/// </summary>
+	class ACID_EXPORT SpatialTree :
+		public NonCopyable
+	{
+	public:
+		/// <summary>
+		/// The index of a node that does not exist, used for the leaf of entities that are not in a tree.
+		/// </summary>
+		static const uint32_t NullNode;
+
+		/// <summary>
+		/// Creates a new empty spatial tree.
+		/// </summary>
+		/// <param name="margin"> The distance leaf bounds are grown by, so small movements do not change the tree. </param>
+		explicit SpatialTree(const float &margin = 0.1f);
+
+		~SpatialTree();
+
+		/// <summary>
+		/// Adds a entity to the tree.
+		/// </summary>
+		/// <param name="entity"> The entity to add. </param>
+		/// <param name="min"> The minimum corner of the world bounds of the entity. </param>
+		/// <param name="max"> The maximum corner of the world bounds of the entity. </param>
+		void Add(Entity *entity, const Vector3 &min, const Vector3 &max);
+
+		/// <summary>
+		/// Removes a entity from the tree.
+		/// </summary>
+		/// <param name="entity"> The entity to remove. </param>
+		void Remove(Entity *entity);
+
+		/// <summary>
+		/// Updates the bounds of a entity in the tree, the leaf is only inserted again when the bounds leave its grown bounds.
+		/// </summary>
+		/// <param name="entity"> The entity that moved. </param>
+		/// <param name="min"> The minimum corner of the new world bounds. </param>
+		/// <param name="max"> The maximum corner of the new world bounds. </param>
+		/// <returns> If the leaf was inserted again. </returns>
+		bool Move(Entity *entity, const Vector3 &min, const Vector3 &max);
+
+		/// <summary>
+		/// Gets if a entity is in the tree.
+		/// </summary>
+		/// <param name="entity"> The entity to check for. </param>
+		/// <returns> If the tree contains the entity. </returns>
+		bool Contains(Entity *entity) const;
+
+		/// <summary>
+		/// Removes all entities from the tree.
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Finds the entities with bounds inside or intersecting a frustum, the same test as <seealso cref="Frustum#CubeInFrustum()"/>.
+		/// Subtrees fully inside the frustum are added without testing their leaves.
+		/// </summary>
+		/// <param name="frustum"> The frustum. </param>
+		/// <param name="result"> The list the entities are added to. </param>
+		void QueryFrustum(const Frustum &frustum, std::vector<Entity *> &result) const;
+
+		/// <summary>
+		/// Finds the entities with bounds intersecting a sphere.
+		/// </summary>
+		/// <param name="centre"> The centre of the sphere. </param>
+		/// <param name="radius"> The radius of the sphere. </param>
+		/// <param name="result"> The list the entities are added to. </param>
+		void QuerySphere(const Vector3 &centre, const float &radius, std::vector<Entity *> &result) const;
+
+		/// <summary>
+		/// Finds the entities with bounds intersecting a box.
+		/// </summary>
+		/// <param name="min"> The minimum corner of the box. </param>
+		/// <param name="max"> The maximum corner of the box. </param>
+		/// <param name="result"> The list the entities are added to. </param>
+		void QueryCube(const Vector3 &min, const Vector3 &max, std::vector<Entity *> &result) const;
+
+		/// <summary>
+		/// Finds the entities with bounds hit by a ray, in no particular order.
+		/// </summary>
+		/// <param name="origin"> The start of the ray. </param>
+		/// <param name="direction"> The direction of the ray, does not need to be normalized. </param>
+		/// <param name="distance"> The length of the ray. </param>
+		/// <param name="result"> The list the entities are added to. </param>
+		void QueryRay(const Vector3 &origin, const Vector3 &direction, const float &distance, std::vector<Entity *> &result) const;
+
+		/// <summary>
+		/// Gets the number of entities in the tree.
+		/// </summary>
+		/// <returns> The number of leaves. </returns>
+		const std::size_t &GetSize() const { return m_leafCount; }
+
+		/// <summary>
+		/// Gets the height of the tree, the longest path from the root to a leaf.
+		/// </summary>
+		/// <returns> The height of the root, or 0 when the tree is empty. </returns>
+		int32_t GetHeight() const;
+
+		const float &GetMargin() const { return m_margin; }
+	private:
+		struct Node
+		{
+			// The union of the children, or the grown bounds for a leaf.
+			Vector3 min;
+			Vector3 max;
+			// The bounds of the entity, only used by leaves.
+			Vector3 entityMin;
+			Vector3 entityMax;
+			Entity *entity;
+			// The parent node, or the next free node when this node is not used.
+			uint32_t parent;
+			uint32_t left;
+			uint32_t right;
+			int32_t height;
+
+			bool IsLeaf() const { return left == NullNode; }
+		};
+
+		uint32_t AllocateNode();
+
+		void FreeNode(const uint32_t &node);
+
+		void InsertLeaf(const uint32_t &leaf);
+
+		void RemoveLeaf(const uint32_t &leaf);
+
+		/// <summary>
+		/// Rotates a node with its taller child if their heights differ by more than one.
+		/// </summary>
+		/// <param name="node"> The node to balance. </param>
+		/// <returns> The node that is now in the place of the node. </returns>
+		uint32_t Balance(const uint32_t &node);
+
+		/// <summary>
+		/// Walks the tree from the root, entering every node with bounds that pass a test and adding the entities of the leaves that pass.
+		/// </summary>
+		/// <param name="overlaps"> The test, called with the minimum and maximum of a node. </param>
+		/// <param name="result"> The list the entities are added to. </param>
+		template<typename F>
+		void Query(const F &overlaps, std::vector<Entity *> &result) const;
+
+		std::vector<Node> m_nodes;
+		uint32_t m_root;
+		uint32_t m_freeList;
+		std::size_t m_leafCount;
+		float m_margin;
+	};
+}
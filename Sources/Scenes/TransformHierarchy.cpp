@@ -0,0 +1,205 @@
+#include "TransformHierarchy.hpp"
+
+#include <limits>
+#include "Threads/JobSystem.hpp"
+#include "Entity.hpp"
+
+namespace acid
+{
+	// Subtrees are small, a few roots are given to each range so a job does enough work.
+	static const std::size_t ROOTS_PER_RANGE = 64;
+
+	const uint32_t TransformHierarchy::NoParent = std::numeric_limits<uint32_t>::max();
+
+	TransformHierarchy::TransformHierarchy() :
+		m_sorted(true)
+	{
+	}
+
+	TransformHierarchy::~TransformHierarchy()
+	{
+		for (auto &entity : m_entities)
+		{
+			entity->m_hierarchy = nullptr;
+		}
+	}
+
+	void TransformHierarchy::Add(Entity *entity)
+	{
+		if (entity->m_hierarchy != nullptr)
+		{
+			entity->m_hierarchy->Remove(entity);
+		}
+
+		auto node = static_cast<uint32_t>(m_entities.size());
+		entity->m_hierarchy = this;
+		entity->m_node = node;
+		entity->m_localTransform.SetDirty(true);
+
+		m_entities.emplace_back(entity);
+		m_parents.emplace_back(NoParent);
+		m_worldTransforms.emplace_back();
+		m_worldMatrices.emplace_back();
+		m_moved.emplace_back(1);
+
+		// A entity without a parent or children here is a subtree of its own, it is appended without sorting again.
+		auto parent = entity->m_parent;
+
+		if (m_sorted && (parent == nullptr || parent->m_hierarchy != this) && entity->m_children.empty())
+		{
+			m_roots.emplace_back(node);
+			return;
+		}
+
+		m_sorted = false;
+	}
+
+	void TransformHierarchy::Remove(Entity *entity)
+	{
+		if (entity->m_hierarchy != this)
+		{
+			return;
+		}
+
+		// The last node is swapped into the removed one, the order is sorted again before the next update.
+		auto node = entity->m_node;
+		auto last = m_entities.size() - 1;
+
+		if (node != last)
+		{
+			m_entities[node] = m_entities[last];
+			m_worldTransforms[node] = m_worldTransforms[last];
+			m_worldMatrices[node] = m_worldMatrices[last];
+			m_entities[node]->m_node = node;
+		}
+
+		m_entities.pop_back();
+		m_parents.pop_back();
+		m_worldTransforms.pop_back();
+		m_worldMatrices.pop_back();
+		m_moved.pop_back();
+		entity->m_hierarchy = nullptr;
+		m_sorted = false;
+	}
+
+	void TransformHierarchy::Update(JobSystem *jobSystem)
+	{
+		if (!m_sorted)
+		{
+			Sort();
+		}
+
+		if (jobSystem == nullptr || m_roots.size() < 2 * ROOTS_PER_RANGE)
+		{
+			UpdateRange(0, m_entities.size());
+			return;
+		}
+
+		jobSystem->ParallelFor(0, m_roots.size(), ROOTS_PER_RANGE, [this](const std::size_t &begin, const std::size_t &end)
+		{
+			UpdateRange(m_roots[begin], end < m_roots.size() ? m_roots[end] : m_entities.size());
+		});
+	}
+
+	void TransformHierarchy::Sort()
+	{
+		auto size = m_entities.size();
+		std::vector<uint32_t> order;
+		std::vector<Entity *> stack;
+		order.reserve(size);
+		m_roots.clear();
+
+		for (const auto &entity : m_entities)
+		{
+			if (entity->m_parent != nullptr && entity->m_parent->m_hierarchy == this)
+			{
+				continue;
+			}
+
+			m_roots.emplace_back(static_cast<uint32_t>(order.size()));
+			stack.emplace_back(entity);
+
+			while (!stack.empty())
+			{
+				auto node = stack.back();
+				stack.pop_back();
+				order.emplace_back(node->m_node);
+
+				// Children are pushed in reverse so they are visited in the order they were added.
+				for (auto it = node->m_children.rbegin(); it != node->m_children.rend(); ++it)
+				{
+					if ((*it)->m_hierarchy == this)
+					{
+						stack.emplace_back(*it);
+					}
+				}
+			}
+		}
+
+		// Nodes are moved to their new index with their world transforms, so entities that did not move are not updated.
+		std::vector<Entity *> entities(size);
+		std::vector<Transform> worldTransforms(size);
+		std::vector<Matrix4> worldMatrices(size);
+
+		for (std::size_t i = 0; i < size; i++)
+		{
+			entities[i] = m_entities[order[i]];
+			worldTransforms[i] = m_worldTransforms[order[i]];
+			worldMatrices[i] = m_worldMatrices[order[i]];
+		}
+
+		for (std::size_t i = 0; i < size; i++)
+		{
+			entities[i]->m_node = static_cast<uint32_t>(i);
+		}
+
+		for (std::size_t i = 0; i < size; i++)
+		{
+			auto parent = entities[i]->m_parent;
+			m_parents[i] = parent != nullptr && parent->m_hierarchy == this ? parent->m_node : NoParent;
+		}
+
+		m_entities = std::move(entities);
+		m_worldTransforms = std::move(worldTransforms);
+		m_worldMatrices = std::move(worldMatrices);
+		m_sorted = true;
+	}
+
+	void TransformHierarchy::UpdateRange(const std::size_t &begin, const std::size_t &end)
+	{
+		for (auto i = begin; i < end; i++)
+		{
+			auto entity = m_entities[i];
+			auto &localTransform = entity->m_localTransform;
+			auto parent = m_parents[i];
+
+			// A parent outside of this hierarchy is not tracked, so its children are updated every time.
+			bool moved = localTransform.IsDirty() || (parent != NoParent ? m_moved[parent] != 0 : entity->m_parent != nullptr);
+			m_moved[i] = moved;
+
+			if (!moved)
+			{
+				continue;
+			}
+
+			if (parent != NoParent)
+			{
+				m_worldTransforms[i] = m_worldTransforms[parent] * localTransform;
+				m_worldMatrices[i] = m_worldTransforms[i].GetWorldMatrix();
+				localTransform.SetDirty(false);
+			}
+			else if (entity->m_parent != nullptr)
+			{
+				m_worldTransforms[i] = entity->m_parent->GetWorldTransform() * localTransform;
+				m_worldMatrices[i] = m_worldTransforms[i].GetWorldMatrix();
+				localTransform.SetDirty(false);
+			}
+			else
+			{
+				// The world transform of a root is its local transform, building the local matrix also clears its dirty flag.
+				m_worldMatrices[i] = localTransform.GetWorldMatrix();
+				m_worldTransforms[i] = localTransform;
+			}
+		}
+	}
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <vector>
+#include "Helpers/NonCopyable.hpp"
+#include "Maths/Transform.hpp"
+
+namespace acid
+{
+	class Entity;
+	class JobSystem;
+
+	/// <summary>
+	/// Stores the world transforms of the entities in a scene structure in flat arrays, sorted depth first so every parent comes before its children.
+	/// Each node keeps the index of its parent and if it moved in the last update, so one pass in order updates every world transform once.
+	/// The subtree of each root is a contiguous range of nodes, the ranges are updated in parallel.
+	/// </summary>
+	class ACID_EXPORT TransformHierarchy :
+		public NonCopyable
+	{
+	public:
+		/// <summary>
+		/// The parent index of a node that has no parent in this hierarchy.
+		/// </summary>
+		static const uint32_t NoParent;
+
+		/// <summary>
+		/// Creates a new empty transform hierarchy.
+		/// </summary>
+		TransformHierarchy();
+
+		~TransformHierarchy();
+
+		/// <summary>
+		/// Adds a entity to the hierarchy, it is updated from its local transform the next update.
+		/// </summary>
+		/// <param name="entity"> The entity to add. </param>
+		void Add(Entity *entity);
+
+		/// <summary>
+		/// Removes a entity from the hierarchy, its children stay in the hierarchy.
+		/// </summary>
+		/// <param name="entity"> The entity to remove. </param>
+		void Remove(Entity *entity);
+
+		/// <summary>
+		/// Marks the order of the nodes as out of date, the nodes are sorted again before the next update.
+		/// </summary>
+		void Invalidate() { m_sorted = false; }
+
+		/// <summary>
+		/// Sorts the nodes if entities were added, removed or moved to another parent, then updates the world transform of every node with a moved local transform or parent.
+		/// </summary>
+		/// <param name="jobSystem"> The job system the subtrees are updated on, or nullptr to update on this thread. </param>
+		void Update(JobSystem *jobSystem = nullptr);
+
+		/// <summary>
+		/// Gets if the nodes are sorted, until they are sorted again the node indices of entities are not valid.
+		/// </summary>
+		/// <returns> If the nodes are sorted. </returns>
+		const bool &IsSorted() const { return m_sorted; }
+
+		std::size_t GetSize() const { return m_entities.size(); }
+
+		const std::vector<Entity *> &GetEntities() const { return m_entities; }
+
+		const Transform &GetWorldTransform(const uint32_t &node) const { return m_worldTransforms[node]; }
+
+		const Matrix4 &GetWorldMatrix(const uint32_t &node) const { return m_worldMatrices[node]; }
+
+		/// <summary>
+		/// Gets the world matrices of every node, in the order of the nodes.
+		/// </summary>
+		/// <returns> The world matrices. </returns>
+		const std::vector<Matrix4> &GetWorldMatrices() const { return m_worldMatrices; }
+
+		/// <summary>
+		/// Gets if the world transform of a node changed in the last update.
+		/// </summary>
+		/// <param name="node"> The node index. </param>
+		/// <returns> If the node moved. </returns>
+		bool IsMoved(const uint32_t &node) const { return m_moved[node] != 0; }
+	private:
+		/// <summary>
+		/// Orders the nodes depth first from each root, keeping the world transforms of every node.
+		/// </summary>
+		void Sort();
+
+		/// <summary>
+		/// Updates a range of nodes that holds whole subtrees, the kernel that is run by each job.
+		/// </summary>
+		/// <param name="begin"> The first node. </param>
+		/// <param name="end"> One past the last node. </param>
+		void UpdateRange(const std::size_t &begin, const std::size_t &end);
+
+		std::vector<Entity *> m_entities;
+		std::vector<uint32_t> m_parents;
+		std::vector<Transform> m_worldTransforms;
+		std::vector<Matrix4> m_worldMatrices;
+		std::vector<uint8_t> m_moved;
+		// The first node of the subtree of each root.
+		std::vector<uint32_t> m_roots;
+		bool m_sorted;
+	};
+}
@@ -0,0 +1,510 @@
+#include "Binary.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+#include "Engine/Log.hpp"
+
+namespace acid
+{
+	const std::string Binary::Extension = ".abin";
+
+	// Sections are written in the byte order of the writer, documents from a different byte order fail the magic check.
+	static const char BinaryMagic[4] = {'A', 'B', 'I', 'N'};
+	static const uint32_t BinaryVersion = 1;
+
+	struct BinaryHeader
+	{
+		char m_magic[4];
+		uint32_t m_version;
+		uint32_t m_nodeCount;
+		uint32_t m_stringCount;
+		uint32_t m_nodesOffset;
+		uint32_t m_stringsOffset;
+		uint32_t m_dataOffset;
+		uint32_t m_size;
+	};
+
+	struct BinaryString
+	{
+		// Offset from the start of the data section.
+		uint32_t m_offset;
+		uint32_t m_length;
+	};
+
+	struct BinaryNode
+	{
+		uint32_t m_name;
+		uint32_t m_value;
+		// Children are stored breadth first, so they are a contiguous range of nodes.
+		uint32_t m_firstChild;
+		uint32_t m_childCount;
+		// Offset in the data section of the name and value string index pairs.
+		uint32_t m_attributes;
+		uint32_t m_attributeCount;
+		uint8_t m_valueType;
+		uint8_t m_padding[3];
+		uint32_t m_floatCount;
+
+		union
+		{
+			int64_t m_integer;
+			double m_float;
+			// Offset in the data section of the packed floats.
+			uint64_t m_floats;
+		};
+	};
+
+	static_assert(sizeof(BinaryHeader) == 32, "Binary header must be packed");
+	static_assert(sizeof(BinaryNode) == 40, "Binary node must be packed");
+
+	/// <summary>
+	/// Gets if a string is a decimal number, as written by <seealso cref="String#To()"/>.
+	/// </summary>
+	static bool IsNumber(const std::string_view &string, bool &integer)
+	{
+		std::size_t i = 0;
+
+		auto digits = [&]()
+		{
+			auto start = i;
+
+			while (i < string.size() && string[i] >= '0' && string[i] <= '9')
+			{
+				i++;
+			}
+
+			return i - start;
+		};
+
+		if (i < string.size() && (string[i] == '-' || string[i] == '+'))
+		{
+			i++;
+		}
+
+		auto whole = digits();
+		integer = true;
+
+		if (i < string.size() && string[i] == '.')
+		{
+			i++;
+			integer = false;
+
+			if (digits() == 0 && whole == 0)
+			{
+				return false;
+			}
+		}
+		else if (whole == 0)
+		{
+			return false;
+		}
+
+		if (i < string.size() && (string[i] == 'e' || string[i] == 'E'))
+		{
+			i++;
+			integer = false;
+
+			if (i < string.size() && (string[i] == '-' || string[i] == '+'))
+			{
+				i++;
+			}
+
+			if (digits() == 0)
+			{
+				return false;
+			}
+		}
+
+		return i == string.size();
+	}
+
+	/// <summary>
+	/// Finds the typed value of a text value, lists of numbers are stored as float arrays.
+	/// </summary>
+	static Metadata::ValueType ClassifyValue(const std::string_view &value, BinaryNode &record, std::vector<float> &floats)
+	{
+		if (value == "true" || value == "false")
+		{
+			record.m_integer = value == "true";
+			return Metadata::ValueType::Boolean;
+		}
+
+		bool integer;
+
+		if (IsNumber(value, integer))
+		{
+			std::string text(value);
+
+			if (integer)
+			{
+				errno = 0;
+				auto result = std::strtoll(text.c_str(), nullptr, 10);
+
+				if (errno == ERANGE)
+				{
+					return Metadata::ValueType::String;
+				}
+
+				record.m_integer = result;
+				return Metadata::ValueType::Integer;
+			}
+
+			record.m_float = std::strtod(text.c_str(), nullptr);
+			return Metadata::ValueType::Float;
+		}
+
+		// Only lists containing a decimal are packed, index lists are left as text.
+		auto decimal = false;
+		floats.clear();
+
+		for (std::size_t start = 0; start < value.size();)
+		{
+			auto end = value.find_first_of(" \t\r\n", start);
+
+			if (end == std::string_view::npos)
+			{
+				end = value.size();
+			}
+
+			if (end > start)
+			{
+				auto token = value.substr(start, end - start);
+
+				if (!IsNumber(token, integer))
+				{
+					return Metadata::ValueType::String;
+				}
+
+				decimal |= !integer;
+				floats.emplace_back(std::strtof(std::string(token).c_str(), nullptr));
+			}
+
+			start = end + 1;
+		}
+
+		if (floats.size() < 2 || !decimal)
+		{
+			return Metadata::ValueType::String;
+		}
+
+		return Metadata::ValueType::FloatArray;
+	}
+
+	Binary::Binary() :
+		Metadata("", "")
+	{
+	}
+
+	Binary::Binary(Metadata *metadata) :
+		Metadata("", "")
+	{
+		AddChildren(metadata, this);
+	}
+
+	void Binary::Load(std::istream *inStream)
+	{
+		Load(this, inStream);
+	}
+
+	void Binary::Write(std::ostream *outStream) const
+	{
+		Write(*this, outStream);
+	}
+
+	bool Binary::Load(Metadata *destination, std::istream *inStream)
+	{
+		auto document = destination->CreateDocument(inStream);
+		return Parse(document, destination);
+	}
+
+	bool Binary::Load(Metadata *destination, const std::string &filename)
+	{
+		auto mapping = std::make_unique<MappedFile>(filename);
+
+		if (!mapping->IsOpen())
+		{
+			return false;
+		}
+
+		auto document = destination->CreateDocument(std::move(mapping));
+		return Parse(document, destination);
+	}
+
+	void Binary::Write(const Metadata &source, std::ostream *outStream)
+	{
+		std::vector<const Metadata *> nodes = {&source};
+		std::vector<BinaryNode> records;
+		std::vector<BinaryString> strings;
+		std::unordered_map<std::string_view, uint32_t> stringIndices;
+		std::vector<char> data;
+		std::vector<float> floats;
+
+		auto align = [&data](const std::size_t &alignment)
+		{
+			data.resize((data.size() + alignment - 1) / alignment * alignment);
+		};
+
+		auto append = [&data](const void *bytes, const std::size_t &size)
+		{
+			auto offset = data.size();
+			data.insert(data.end(), static_cast<const char *>(bytes), static_cast<const char *>(bytes) + size);
+			return static_cast<uint32_t>(offset);
+		};
+
+		auto addString = [&](const std::string_view &string)
+		{
+			auto it = stringIndices.find(string);
+
+			if (it != stringIndices.end())
+			{
+				return it->second;
+			}
+
+			auto index = static_cast<uint32_t>(strings.size());
+			strings.emplace_back(BinaryString{append(string.data(), string.size()), static_cast<uint32_t>(string.size())});
+			stringIndices.emplace(string, index);
+			return index;
+		};
+
+		addString("");
+
+		// Nodes are visited breadth first, the children of a node are queued together so they end up contiguous.
+		for (std::size_t i = 0; i < nodes.size(); i++)
+		{
+			auto node = nodes[i];
+			BinaryNode record;
+			std::memset(&record, 0, sizeof(BinaryNode));
+			record.m_name = addString(node->GetName());
+			record.m_value = addString(node->GetValue());
+			record.m_firstChild = static_cast<uint32_t>(nodes.size());
+			record.m_childCount = node->GetChildCount();
+
+			for (const auto &child : node->GetChildren())
+			{
+				nodes.emplace_back(child.get());
+			}
+
+			if (node->GetAttributeCount() != 0)
+			{
+				std::vector<uint32_t> attributes;
+
+				for (const auto &[attribute, value] : node->GetAttributes())
+				{
+					attributes.emplace_back(addString(attribute));
+					attributes.emplace_back(addString(value));
+				}
+
+				align(alignof(uint32_t));
+				record.m_attributes = append(attributes.data(), attributes.size() * sizeof(uint32_t));
+				record.m_attributeCount = node->GetAttributeCount();
+			}
+
+			auto valueType = ClassifyValue(node->GetValue(), record, floats);
+
+			if (valueType == ValueType::FloatArray)
+			{
+				align(alignof(float));
+				record.m_floats = append(floats.data(), floats.size() * sizeof(float));
+				record.m_floatCount = static_cast<uint32_t>(floats.size());
+			}
+
+			record.m_valueType = static_cast<uint8_t>(valueType);
+			records.emplace_back(record);
+		}
+
+		BinaryHeader header;
+		std::memset(&header, 0, sizeof(BinaryHeader));
+		std::memcpy(header.m_magic, BinaryMagic, sizeof(BinaryMagic));
+		header.m_version = BinaryVersion;
+		auto size = sizeof(BinaryHeader) + records.size() * sizeof(BinaryNode) + strings.size() * sizeof(BinaryString) + data.size();
+
+		if (size > std::numeric_limits<uint32_t>::max())
+		{
+			Log::Error("Binary document is too large to write (%llu bytes)\n", static_cast<unsigned long long>(size));
+			return;
+		}
+
+		header.m_nodeCount = static_cast<uint32_t>(records.size());
+		header.m_stringCount = static_cast<uint32_t>(strings.size());
+		header.m_nodesOffset = sizeof(BinaryHeader);
+		header.m_stringsOffset = header.m_nodesOffset + static_cast<uint32_t>(records.size() * sizeof(BinaryNode));
+		header.m_dataOffset = header.m_stringsOffset + static_cast<uint32_t>(strings.size() * sizeof(BinaryString));
+		header.m_size = static_cast<uint32_t>(size);
+
+		outStream->write(reinterpret_cast<const char *>(&header), sizeof(BinaryHeader));
+		outStream->write(reinterpret_cast<const char *>(records.data()), records.size() * sizeof(BinaryNode));
+		outStream->write(reinterpret_cast<const char *>(strings.data()), strings.size() * sizeof(BinaryString));
+		outStream->write(data.data(), data.size());
+	}
+
+	void Binary::AddChildren(const Metadata *source, Metadata *destination)
+	{
+		for (const auto &child : source->GetChildren())
+		{
+			auto created = destination->CreateChild(child->GetName(), child->GetValue());
+			AddChildren(child.get(), created);
+		}
+
+		for (const auto &attribute : source->GetAttributes())
+		{
+			destination->AddAttribute(attribute.first, attribute.second);
+		}
+	}
+
+	bool Binary::Parse(MetadataArena *document, Metadata *destination)
+	{
+		auto source = document->GetSource();
+
+		auto error = [destination](const char *reason)
+		{
+			Log::Error("Invalid binary document: %s\n", reason);
+			destination->ClearChildren();
+			destination->ClearAttributes();
+			return false;
+		};
+
+		if (source.size() < sizeof(BinaryHeader))
+		{
+			return error("too small for header");
+		}
+
+		BinaryHeader header;
+		std::memcpy(&header, source.data(), sizeof(BinaryHeader));
+
+		if (std::memcmp(header.m_magic, BinaryMagic, sizeof(BinaryMagic)) != 0 || header.m_version != BinaryVersion)
+		{
+			return error("unknown magic or version");
+		}
+
+		// Tables are read in place, so every section must be inside the buffer and aligned.
+		if (header.m_size != source.size() || header.m_nodeCount == 0 ||
+			header.m_nodesOffset % alignof(BinaryNode) != 0 || reinterpret_cast<std::uintptr_t>(source.data()) % alignof(BinaryNode) != 0 ||
+			static_cast<uint64_t>(header.m_nodesOffset) + static_cast<uint64_t>(header.m_nodeCount) * sizeof(BinaryNode) > source.size() ||
+			header.m_stringsOffset % alignof(BinaryString) != 0 ||
+			static_cast<uint64_t>(header.m_stringsOffset) + static_cast<uint64_t>(header.m_stringCount) * sizeof(BinaryString) > source.size() ||
+			header.m_dataOffset % alignof(float) != 0 || header.m_dataOffset > source.size())
+		{
+			return error("sections out of bounds");
+		}
+
+		auto records = reinterpret_cast<const BinaryNode *>(source.data() + header.m_nodesOffset);
+		auto strings = reinterpret_cast<const BinaryString *>(source.data() + header.m_stringsOffset);
+		auto data = source.substr(header.m_dataOffset);
+
+		auto getString = [&](const uint32_t &index, std::string_view &result)
+		{
+			if (index >= header.m_stringCount || static_cast<uint64_t>(strings[index].m_offset) + strings[index].m_length > data.size())
+			{
+				return false;
+			}
+
+			result = data.substr(strings[index].m_offset, strings[index].m_length);
+			return true;
+		};
+
+		// The node table is only needed while loading, so it is taken from the arena instead of the heap.
+		auto nodes = static_cast<Metadata **>(document->Allocate(header.m_nodeCount * sizeof(Metadata *), alignof(Metadata *)));
+		nodes[0] = destination;
+		uint32_t nextChild = 1;
+
+		if (!getString(records[0].m_name, destination->m_name) || !getString(records[0].m_value, destination->m_value))
+		{
+			return error("string index out of bounds");
+		}
+
+		for (uint32_t i = 0; i < header.m_nodeCount; i++)
+		{
+			const auto &record = records[i];
+			auto node = nodes[i];
+			auto valueType = static_cast<ValueType>(record.m_valueType);
+
+			switch (valueType)
+			{
+			case ValueType::String:
+				break;
+			case ValueType::Boolean:
+			case ValueType::Integer:
+				node->m_integer = record.m_integer;
+				break;
+			case ValueType::Float:
+				node->m_float = record.m_float;
+				break;
+			case ValueType::FloatArray:
+				if (record.m_floats % alignof(float) != 0 || record.m_floats + static_cast<uint64_t>(record.m_floatCount) * sizeof(float) > data.size())
+				{
+					return error("float array out of bounds");
+				}
+
+				node->m_floats = reinterpret_cast<const float *>(data.data() + record.m_floats);
+				node->m_floatCount = record.m_floatCount;
+				break;
+			default:
+				return error("unknown value type");
+			}
+
+			node->m_valueType = valueType;
+
+			if (record.m_attributeCount != 0)
+			{
+				if (record.m_attributes % alignof(uint32_t) != 0 ||
+					static_cast<uint64_t>(record.m_attributes) + static_cast<uint64_t>(record.m_attributeCount) * 2 * sizeof(uint32_t) > data.size())
+				{
+					return error("attributes out of bounds");
+				}
+
+				auto attributes = reinterpret_cast<const uint32_t *>(data.data() + record.m_attributes);
+
+				for (uint32_t j = 0; j < record.m_attributeCount; j++)
+				{
+					std::string_view attribute, value;
+
+					if (!getString(attributes[2 * j], attribute) || !getString(attributes[2 * j + 1], value))
+					{
+						return error("string index out of bounds");
+					}
+
+					node->AddAttribute(std::string(attribute), std::string(value));
+				}
+			}
+
+			if (record.m_childCount == 0)
+			{
+				continue;
+			}
+
+			if (record.m_firstChild != nextChild || static_cast<uint64_t>(record.m_firstChild) + record.m_childCount > header.m_nodeCount)
+			{
+				return error("children are not breadth first");
+			}
+
+			node->m_children.reserve(record.m_childCount);
+
+			for (uint32_t c = record.m_firstChild; c < record.m_firstChild + record.m_childCount; c++)
+			{
+				std::string_view name, value;
+
+				if (!getString(records[c].m_name, name) || !getString(records[c].m_value, value))
+				{
+					return error("string index out of bounds");
+				}
+
+				nodes[c] = document->CreateView(name, value);
+				node->m_children.emplace_back(nodes[c]);
+			}
+
+			nextChild += record.m_childCount;
+		}
+
+		if (nextChild != header.m_nodeCount)
+		{
+			return error("unreachable nodes");
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>
+#include "Serialized/Metadata.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// A compact binary metadata document, made to be memory mapped and loaded without parsing.
+	/// Nodes are stored breadth first in a fixed size table so children are contiguous and referenced by index,
+	/// names and values are views into a deduplicated string table and numbers are stored typed next to their text.
+	/// </summary>
+	class ACID_EXPORT Binary :
+		public Metadata
+	{
+	public:
+		/// <summary>
+		/// The extension of binary documents, a baked copy of a text document is found by appending this to its filename.
+		/// </summary>
+		static const std::string Extension;
+
+		Binary();
+
+		explicit Binary(Metadata *metadata);
+
+		void Load(std::istream *inStream) override;
+
+		void Write(std::ostream *outStream) const override;
+
+		/// <summary>
+		/// Loads a binary document from a stream into any metadata node, the stream is read into a single buffer.
+		/// </summary>
+		/// <param name="destination"> The node to load the document into, its children are replaced. </param>
+		/// <param name="inStream"> The stream to read from. </param>
+		/// <returns> If the document was valid. </returns>
+		static bool Load(Metadata *destination, std::istream *inStream);
+
+		/// <summary>
+		/// Loads a binary document by memory mapping a file, nodes are created in the arena and view into the mapping.
+		/// </summary>
+		/// <param name="destination"> The node to load the document into, its children are replaced. </param>
+		/// <param name="filename"> The real path of the file to map. </param>
+		/// <returns> If the file was mapped and the document was valid. </returns>
+		static bool Load(Metadata *destination, const std::string &filename);
+
+		/// <summary>
+		/// Writes any metadata tree as a binary document.
+		/// </summary>
+		/// <param name="source"> The root of the tree to write. </param>
+		/// <param name="outStream"> The stream to write to, should be opened in binary mode. </param>
+		static void Write(const Metadata &source, std::ostream *outStream);
+	private:
+		static void AddChildren(const Metadata *source, Metadata *destination);
+
+		static bool Parse(MetadataArena *document, Metadata *destination);
+	};
+}
@@ -1,11 +1,221 @@
 #include "Json.hpp"
 
-#include <utility>
-#include "Files/Files.hpp"
-#include "Helpers/String.hpp"
+#include <algorithm>
+#include <vector>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ACID_JSON_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(ACID_BUILD_MSVC)
+#include <intrin.h>
+#endif
+#include "Engine/Log.hpp"
 
 namespace acid
 {
+	static uint32_t CountTrailingZeros(const uint32_t &mask)
+	{
+#if defined(ACID_BUILD_MSVC)
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return static_cast<uint32_t>(index);
+#else
+		return static_cast<uint32_t>(__builtin_ctz(mask));
+#endif
+	}
+
+	/// <summary>
+	/// Finds the first character that is not whitespace or a control character.
+	/// </summary>
+	static const char *SkipWhitespace(const char *it, const char *end)
+	{
+#if defined(ACID_JSON_SSE2)
+		const auto space = _mm_set1_epi8(' ');
+
+		while (end - it >= 16)
+		{
+			auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(it));
+			// Bytes at or below a space are equal to their unsigned minimum with a space.
+			auto mask = ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(chunk, space), chunk))) & 0xFFFF;
+
+			if (mask != 0)
+			{
+				return it + CountTrailingZeros(mask);
+			}
+
+			it += 16;
+		}
+#endif
+
+		while (it != end && static_cast<unsigned char>(*it) <= ' ')
+		{
+			++it;
+		}
+
+		return it;
+	}
+
+	/// <summary>
+	/// Finds the first quote or backslash.
+	/// </summary>
+	static const char *FindQuoteOrEscape(const char *it, const char *end)
+	{
+#if defined(ACID_JSON_SSE2)
+		const auto quote = _mm_set1_epi8('"');
+		const auto backslash = _mm_set1_epi8('\\');
+
+		while (end - it >= 16)
+		{
+			auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(it));
+			auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash))));
+
+			if (mask != 0)
+			{
+				return it + CountTrailingZeros(mask);
+			}
+
+			it += 16;
+		}
+#endif
+
+		while (it != end && *it != '"' && *it != '\\')
+		{
+			++it;
+		}
+
+		return it;
+	}
+
+	/// <summary>
+	/// Finds the closing quote of a string, starting after the opening quote.
+	/// </summary>
+	static const char *FindStringEnd(const char *it, const char *end)
+	{
+		while (true)
+		{
+			it = FindQuoteOrEscape(it, end);
+
+			if (it == end || *it == '"')
+			{
+				return it;
+			}
+
+			// Skips the escaped character, escapes are kept as written.
+			if (end - it < 2)
+			{
+				return end;
+			}
+
+			it += 2;
+		}
+	}
+
+	/// <summary>
+	/// Finds the end of a number, boolean or null.
+	/// </summary>
+	static const char *FindLiteralEnd(const char *it, const char *end)
+	{
+#if defined(ACID_JSON_SSE2)
+		const auto space = _mm_set1_epi8(' ');
+		const auto comma = _mm_set1_epi8(',');
+		const auto closeObject = _mm_set1_epi8('}');
+		const auto closeArray = _mm_set1_epi8(']');
+
+		while (end - it >= 16)
+		{
+			auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(it));
+			auto delimiters = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, comma), _mm_cmpeq_epi8(chunk, closeObject)),
+				_mm_or_si128(_mm_cmpeq_epi8(chunk, closeArray), _mm_cmpeq_epi8(_mm_min_epu8(chunk, space), chunk)));
+			auto mask = static_cast<uint32_t>(_mm_movemask_epi8(delimiters));
+
+			if (mask != 0)
+			{
+				return it + CountTrailingZeros(mask);
+			}
+
+			it += 16;
+		}
+#endif
+
+		while (it != end && static_cast<unsigned char>(*it) > ' ' && *it != ',' && *it != '}' && *it != ']')
+		{
+			++it;
+		}
+
+		return it;
+	}
+
+	/// <summary>
+	/// Gets if a literal is a number, boolean or null as written by the Json grammar.
+	/// </summary>
+	static bool IsLiteral(const std::string_view &literal)
+	{
+		if (literal == "true" || literal == "false" || literal == "null")
+		{
+			return true;
+		}
+
+		auto it = literal.begin();
+		auto end = literal.end();
+		auto isDigit = [](const char &c)
+		{
+			return c >= '0' && c <= '9';
+		};
+		auto skipDigits = [&]()
+		{
+			auto start = it;
+
+			while (it != end && isDigit(*it))
+			{
+				++it;
+			}
+
+			return it != start;
+		};
+
+		if (it != end && *it == '-')
+		{
+			++it;
+		}
+
+		// The integer part has no leading zeros.
+		if (it != end && *it == '0')
+		{
+			++it;
+		}
+		else if (!skipDigits())
+		{
+			return false;
+		}
+
+		if (it != end && *it == '.')
+		{
+			++it;
+
+			if (!skipDigits())
+			{
+				return false;
+			}
+		}
+
+		if (it != end && (*it == 'e' || *it == 'E'))
+		{
+			++it;
+
+			if (it != end && (*it == '+' || *it == '-'))
+			{
+				++it;
+			}
+
+			if (!skipDigits())
+			{
+				return false;
+			}
+		}
+
+		return it == end;
+	}
+
 	Json::Json() :
 		Metadata("", "")
 	{
@@ -19,83 +229,117 @@ namespace acid
 
 	void Json::Load(std::istream *inStream)
 	{
-		ClearChildren();
-		ClearAttributes();
+		auto document = CreateDocument(inStream);
+		std::string_view source = document->GetSource();
 
-		auto topSection = std::make_unique<Section>(nullptr, "", "");
-		Section *currentSection = nullptr;
-		std::stringstream summation;
+		// Skips the UTF-8 byte order mark.
+		if (source.compare(0, 3, "\xEF\xBB\xBF") == 0)
+		{
+			source.remove_prefix(3);
+		}
 
-		size_t lineNum = 0;
-		std::string linebuf;
+		// A malformed document is not half loaded, the error has been logged and the node is left empty.
+		if (!Parse(source, this))
+		{
+			CreateDocument();
+		}
+	}
 
-		while (inStream->peek() != -1)
+	void Json::Write(std::ostream *outStream) const
+	{
+		struct Frame
 		{
-			Files::SafeGetLine(*inStream, linebuf);
-			lineNum++;
+			const Metadata *m_node;
+			uint32_t m_indentation;
+			bool m_end;
+			char m_closeBrace;
+			std::size_t m_nextChild;
+		};
 
-			for (const char &c : linebuf)
+		std::vector<Frame> stack;
+
+		auto writeOpen = [&](const Metadata *node, const uint32_t &indentation, const bool &end)
+		{
+			auto isArray = std::any_of(node->GetChildren().begin(), node->GetChildren().end(), [](const Child &child)
+			{
+				return child->GetName().empty();
+			});
+			char openBrace = isArray ? '[' : '{';
+			char closeBrace = isArray ? ']' : '}';
+
+			WriteIndentation(outStream, indentation);
+
+			if (node->GetValue().empty())
 			{
-				if (c == '{' || c == '[')
+				if (!node->GetName().empty())
 				{
-					if (currentSection == nullptr)
-					{
-						currentSection = topSection.get();
-						continue;
-					}
-
-					std::string name;
-
-					if (!summation.str().empty())
-					{
-						auto contentSplit = String::Split(summation.str(), "\"");
-
-						if (static_cast<int32_t>(contentSplit.size()) - 2 >= 0)
-						{
-							name = contentSplit.at(contentSplit.size() - 2);
-						}
-					}
-
-					currentSection->m_content += summation.str();
-					summation.str(std::string());
-
-					auto section = new Section(currentSection, name, "");
-					currentSection->m_children.emplace_back(section);
-					currentSection = section;
+					*outStream << '\"' << node->GetName() << "\": ";
 				}
-				else if (c == '}' || c == ']')
-				{
-					currentSection->m_content += summation.str();
-					summation.str(std::string());
 
-					if (currentSection->m_parent != nullptr)
-					{
-						currentSection = currentSection->m_parent;
-					}
+				*outStream << openBrace << '\n';
+			}
+			else
+			{
+				if (!node->GetName().empty())
+				{
+					*outStream << '\"' << node->GetName() << "\": ";
 				}
-				else if (c == '\n')
+
+				*outStream << node->GetValue();
+
+				if (!(end && node->GetAttributes().empty()))
 				{
+					*outStream << ", ";
 				}
-				else
+
+				*outStream << '\n';
+			}
+
+			for (const auto &[attribute, value] : node->GetAttributes())
+			{
+				WriteIndentation(outStream, indentation + 1);
+				*outStream << "\"_" << attribute << "\": \"" << value << '\"';
+
+				if (!(end && node->GetChildren().empty()))
 				{
-					summation << c;
+					*outStream << ", ";
 				}
+
+				*outStream << '\n';
 			}
-		}
 
-		Convert(topSection.get(), this, true);
-	}
+			stack.emplace_back(Frame{node, indentation, end, closeBrace, 0});
+		};
 
-	void Json::Write(std::ostream *outStream) const
-	{
-		AppendData(this, outStream, 0);
+		writeOpen(this, 0, false);
+
+		while (!stack.empty())
+		{
+			auto frame = stack.back();
+			const auto &children = frame.m_node->GetChildren();
+
+			if (frame.m_nextChild < children.size())
+			{
+				stack.back().m_nextChild++;
+				writeOpen(children[frame.m_nextChild].get(), frame.m_indentation + 1, frame.m_nextChild + 1 == children.size());
+				continue;
+			}
+
+			stack.pop_back();
+
+			if (frame.m_node->GetValue().empty())
+			{
+				WriteIndentation(outStream, frame.m_indentation);
+				*outStream << frame.m_closeBrace << ((frame.m_end || frame.m_indentation == 0) ? "\n" : ",\n");
+			}
+		}
 	}
 
 	void Json::AddChildren(const Metadata *source, Metadata *destination)
 	{
 		for (const auto &child : source->GetChildren())
 		{
-			auto created = destination->AddChild(new Metadata(child->GetName(), child->GetValue()));
+			auto created = destination->CreateChild(child->GetName(), child->GetValue());
 			AddChildren(child.get(), created);
 		}
 
@@ -105,133 +349,183 @@ namespace acid
 		}
 	}
 
-	void Json::Convert(const Section *source, Metadata *parent, const bool &isTopSection)
+	bool Json::Parse(const std::string_view &source, Metadata *parent)
 	{
-		auto thisValue = parent;
+		auto arena = parent->GetArena();
+		auto begin = source.data();
+		auto end = begin + source.size();
+		auto it = SkipWhitespace(begin, end);
 
-		if (!isTopSection)
+		if (it == end)
 		{
-			thisValue = new Metadata(source->m_name, "");
-			parent->AddChild(thisValue);
+			return true;
 		}
 
-		auto contentSplit = String::Split(source->m_content, ",", true);
+		if (*it != '{' && *it != '[')
+		{
+			Log::Error("Json expected a object or array at offset %i\n", static_cast<int32_t>(it - begin));
+			return false;
+		}
+
+		// The open containers, if they are arrays and if they have a element that must be followed by a comma, the top level members are added to the parent.
+		struct Container
+		{
+			Metadata *m_metadata;
+			bool m_array;
+			bool m_hasElement;
+		};
+
+		std::vector<Container> stack;
+		stack.emplace_back(Container{parent, *it == '[', false});
+		++it;
+
+		auto error = [&](const char *message)
+		{
+			Log::Error("Json %s at offset %i\n", message, static_cast<int32_t>(it - begin));
+			return false;
+		};
 
-		for (const auto &data : contentSplit)
+		while (!stack.empty())
 		{
-			std::string name;
-			std::string value = data;
+			it = SkipWhitespace(it, end);
 
-			if (String::Contains(data, ":"))
+			if (it == end)
 			{
-				name = String::Trim(data.substr(0, data.find(':')));
-				value = String::Trim(String::ReplaceFirst(value, name, ""));
-				value = String::Trim(value.erase(0, 1));
-				name = name.substr(1, name.size() - 2);
+				return error("is missing a closing brace");
 			}
 
-			if (value.empty())
+			auto &container = stack.back();
+
+			if (*it == '}' || *it == ']')
 			{
+				if (*it != (container.m_array ? ']' : '}'))
+				{
+					return error(container.m_array ? "expected ']'" : "expected '}'");
+				}
+
+				stack.pop_back();
+				++it;
 				continue;
 			}
 
-			if (String::StartsWith(name, "_"))
+			if (container.m_hasElement)
 			{
-				name = name.erase(0, 1);
-
-				if (!value.empty())
+				if (*it != ',')
 				{
-					value = value.substr(1, value.size() - 2);
+					return error("expected ','");
 				}
 
-				thisValue->AddAttribute(name, value);
+				it = SkipWhitespace(it + 1, end);
+
+				if (it == end || *it == '}' || *it == ']')
+				{
+					return error("expected a value after ','");
+				}
 			}
-			else
+
+			container.m_hasElement = true;
+			auto current = container.m_metadata;
+			std::string_view name;
+
+			if (!container.m_array)
 			{
-				auto newChild = new Metadata(name, value);
-				thisValue->AddChild(newChild);
-			}
-		}
+				if (*it != '\"')
+				{
+					return error("expected a name");
+				}
 
-		for (const auto &child : source->m_children)
-		{
-			Convert(child.get(), thisValue, false);
-		}
-	}
+				auto nameEnd = FindStringEnd(it + 1, end);
 
-	void Json::AppendData(const Metadata *source, std::ostream *outStream, const int32_t &indentation, const bool &end)
-	{
-		std::stringstream indents;
+				if (nameEnd == end)
+				{
+					return error("has a unterminated string");
+				}
 
-		for (int32_t i = 0; i < indentation; i++)
-		{
-			indents << "  ";
-		}
+				name = std::string_view(it + 1, nameEnd - it - 1);
+				it = SkipWhitespace(nameEnd + 1, end);
 
-		char openBrace = '{';
-		char closeBrace = '}';
+				if (it == end || *it != ':')
+				{
+					return error("expected ':'");
+				}
 
-		for (const auto &child : source->GetChildren())
-		{
-			if (child->GetName().empty())
+				it = SkipWhitespace(it + 1, end);
+
+				if (it == end)
+				{
+					return error("expected a value");
+				}
+			}
+
+			if (*it == '{' || *it == '[')
 			{
-				openBrace = '[';
-				closeBrace = ']';
-				break;
+				// The reference to the container is not used after this, adding to the stack may move it.
+				stack.emplace_back(Container{current->AddChild(arena->Create(name)), *it == '[', false});
+				++it;
+				continue;
 			}
-		}
 
-		*outStream << indents.str();
+			const char *valueEnd;
 
-		if (source->GetName().empty())
-		{
-			*outStream << openBrace << "\n";
-		}
-		else if (source->GetValue().empty())
-		{
-			*outStream << "\"" << source->GetName() << "\": " << openBrace << "\n";
-		}
-		else
-		{
-			*outStream << "\"" << source->GetName() << "\": " << source->GetValue();
+			if (*it == '\"')
+			{
+				valueEnd = FindStringEnd(it + 1, end);
+
+				if (valueEnd == end)
+				{
+					return error("has a unterminated string");
+				}
 
-			if (!(end && source->GetAttributes().empty()))
+				++valueEnd;
+			}
+			else
 			{
-				*outStream << ", ";
+				valueEnd = FindLiteralEnd(it, end);
+
+				if (!IsLiteral(std::string_view(it, valueEnd - it)))
+				{
+					return error("expected a value");
+				}
 			}
 
-			*outStream << "\n";
-		}
+			std::string_view value(it, valueEnd - it);
+			it = valueEnd;
 
-		for (const auto &attribute : source->GetAttributes())
-		{
-			*outStream << indents.str() << "  \"_" << attribute.first + "\": \"" << attribute.second << "\"";
+			if (!name.empty() && name.front() == '_')
+			{
+				if (value.size() >= 2 && value.front() == '\"')
+				{
+					value = value.substr(1, value.size() - 2);
+				}
 
-			if (!(end && source->GetChildren().empty()))
+				current->AddAttribute(std::string(name.substr(1)), std::string(value));
+			}
+			else
 			{
-				*outStream << ", ";
+				// Strings keep their quotes, see Metadata::GetString.
+				current->AddChild(arena->Create(name, value));
 			}
-
-			*outStream << "\n";
 		}
 
-		for (const auto &child : source->GetChildren())
+		it = SkipWhitespace(it, end);
+
+		if (it != end)
 		{
-			AppendData(child.get(), outStream, indentation + 1, child == source->GetChildren().back());
+			return error("has characters after the root value");
 		}
 
-		if (source->GetValue().empty())
-		{
-			*outStream << indents.str();
+		return true;
+	}
 
-			if (end || indentation == 0)
-			{
-				*outStream << closeBrace << "\n";
-			}
-			else
-			{
-				*outStream << closeBrace << ",\n";
-			}
+	void Json::WriteIndentation(std::ostream *outStream, const uint32_t &indentation)
+	{
+		static const std::string_view spaces = "                                ";
+
+		for (std::size_t count = indentation * 2; count > 0;)
+		{
+			auto length = std::min(count, spaces.size());
+			outStream->write(spaces.data(), length);
+			count -= length;
 		}
 	}
 }
@@ -1,33 +1,17 @@
 #pragma once
 
-#include <utility>
-#include "Helpers/NonCopyable.hpp"
+#include <string_view>
 #include "Serialized/Metadata.hpp"
 
 namespace acid
 {
+	/// <summary>
+	/// A JSON document, parsed in a single pass over the source buffer into the documents <seealso cref="MetadataArena"/>.
+	/// </summary>
 	class ACID_EXPORT Json :
 		public Metadata
 	{
 	public:
-		class Section :
-			public NonCopyable
-		{
-		public:
-			Section *m_parent;
-			std::vector<std::unique_ptr<Section>> m_children;
-
-			std::string m_name;
-			std::string m_content;
-
-			Section(Section *parent, std::string name, std::string content) :
-				m_parent(parent),
-				m_name(std::move(name)),
-				m_content(std::move(content))
-			{
-			}
-		};
-
 		Json();
 
 		explicit Json(Metadata *metadata);
@@ -38,8 +22,14 @@ namespace acid
 	private:
 		static void AddChildren(const Metadata *source, Metadata *destination);
 
-		static void Convert(const Section *source, Metadata *parent, const bool &isTopSection = true);
+		/// <summary>
+		/// Parses a JSON buffer, nodes are created in the arena of the parent and reference the buffer.
+		/// </summary>
+		/// <param name="source"> The buffer to parse, must be owned by the arena of the parent. </param>
+		/// <param name="parent"> The node that the top level object members are added to. </param>
+		/// <returns> If the buffer was parsed without errors. </returns>
+		static bool Parse(const std::string_view &source, Metadata *parent);
 
-		static void AppendData(const Metadata *source, std::ostream *outStream, const int32_t &indentation, const bool &end = false);
+		static void WriteIndentation(std::ostream *outStream, const uint32_t &indentation);
 	};
 }
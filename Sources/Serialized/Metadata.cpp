@@ -1,43 +1,107 @@
 #include "Metadata.hpp"
 
 #include <algorithm>
+#include <functional>
+#include <iterator>
 #include <utility>
 #include "Engine/Log.hpp"
 
 namespace acid
 {
-	Metadata::Metadata(const std::string &name, const std::string &value, std::map<std::string, std::string> attributes) :
-		m_name(String::Trim(String::RemoveAll(name, '\"'))), // TODO: Remove first and last.
-		m_value(String::Trim(value)),
-		m_attributes(std::move(attributes))
+	void Metadata::Deleter::operator()(Metadata *metadata) const
 	{
+		if (metadata->m_arenaAllocated)
+		{
+			metadata->~Metadata();
+			return;
+		}
+
+		delete metadata;
+	}
+
+	Metadata::Metadata(const std::string_view &name, const std::string_view &value, std::map<std::string, std::string> attributes) :
+		m_arena(nullptr),
+		m_arenaAllocated(false),
+		m_valueType(ValueType::String),
+		m_floatCount(0),
+		m_attributes(attributes.empty() ? nullptr : std::make_unique<std::map<std::string, std::string>>(std::move(attributes))),
+		m_integer(0)
+	{
+		SetStorage(String::Trim(String::RemoveAll(std::string(name), '\"')), String::Trim(value)); // TODO: Remove first and last.
+	}
+
+	Metadata::Metadata(MetadataArena *arena, const std::string_view &name, const std::string_view &value) :
+		m_arena(arena),
+		m_arenaAllocated(true),
+		m_valueType(ValueType::String),
+		m_floatCount(0),
+		m_name(name),
+		m_value(value),
+		m_children(MetadataArena::Allocator<Child>(arena)),
+		m_integer(0)
+	{
+	}
+
+	void Metadata::SetName(const std::string_view &name)
+	{
+		if (m_arena != nullptr)
+		{
+			m_name = m_arena->Intern(name);
+			return;
+		}
+
+		SetStorage(name, m_value);
+	}
+
+	void Metadata::SetValue(const std::string_view &value)
+	{
+		m_valueType = ValueType::String;
+
+		if (m_arena != nullptr)
+		{
+			m_value = m_arena->Owns(value) ? value : m_arena->Store(value);
+			return;
+		}
+
+		SetStorage(m_name, value);
+	}
+
+	void Metadata::SetStorage(const std::string_view &name, const std::string_view &value)
+	{
+		std::string storage;
+		storage.reserve(name.size() + value.size());
+		storage.append(name);
+		storage.append(value);
+		m_storage = std::move(storage);
+		m_name = std::string_view(m_storage.data(), name.size());
+		m_value = std::string_view(m_storage.data() + name.size(), value.size());
 	}
 
 	std::string Metadata::GetString() const
 	{
-		std::string string = m_value;
+		auto string = m_value;
 
 		if (string.empty())
 		{
-			return string;
+			return std::string();
 		}
 
 		if (string.front() == '\"')
 		{
-			string.erase(0, 1);
+			string.remove_prefix(1);
 		}
 
-		if (string.back() == '\"')
+		if (!string.empty() && string.back() == '\"')
 		{
-			string.pop_back();
+			string.remove_suffix(1);
 		}
 
-		return string;
+		return std::string(string);
 	}
 
 	void Metadata::SetString(const std::string &data)
 	{
-		m_value = "\"" + data + "\"";
+		SetValue("\"" + data + "\"");
 	}
 
 	Metadata *Metadata::AddChild(Metadata *child)
@@ -46,15 +110,25 @@ namespace acid
 		return child;
 	}
 
+	Metadata *Metadata::CreateChild(const std::string_view &name, const std::string_view &value)
+	{
+		if (m_arena != nullptr)
+		{
+			return AddChild(m_arena->Create(name, m_arena->Store(value)));
+		}
+
+		return AddChild(new Metadata(name, value));
+	}
+
 	void Metadata::RemoveChild(Metadata *child)
 	{
-		m_children.erase(std::remove_if(m_children.begin(), m_children.end(), [&](std::unique_ptr<Metadata> &c)
+		m_children.erase(std::remove_if(m_children.begin(), m_children.end(), [&](Child &c)
 		{
 			return c.get() == child;
 		}), m_children.end());
 	}
 
-	std::vector<Metadata *> Metadata::FindChildren(const std::string &name) const
+	std::vector<Metadata *> Metadata::FindChildren(const std::string_view &name) const
 	{
 		std::vector<Metadata *> result = {};
 
@@ -69,13 +143,39 @@ namespace acid
 		return result;
 	}
 
-	Metadata *Metadata::FindChild(const std::string &name, const bool &reportError) const
+	Metadata *Metadata::FindChild(const std::string_view &name, const bool &reportError) const
 	{
-		std::string nameNoSpaces = String::ReplaceAll(name, " ", "_");
+		// Interned names from the same arena can be matched by pointer.
+		for (const auto &child : m_children)
+		{
+			if (child->m_name.data() == name.data() && child->m_name.size() == name.size())
+			{
+				return child.get();
+			}
+		}
+
+		// Spaces in the name also match underscores, as written by formats that do not allow spaces.
+		auto matches = [&name](const std::string_view &childName)
+		{
+			if (childName.size() != name.size())
+			{
+				return false;
+			}
+
+			for (std::size_t i = 0; i < name.size(); i++)
+			{
+				if (childName[i] != name[i] && !(name[i] == ' ' && childName[i] == '_'))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		};
 
 		for (const auto &child : m_children)
 		{
-			if (child->m_name == name || child->m_name == nameNoSpaces)
+			if (matches(child->m_name))
 			{
 				return child.get();
 			}
@@ -83,13 +183,13 @@ namespace acid
 
 		if (reportError)
 		{
-			Log::Error("Could not find child in metadata by name '%s'\n", name.c_str());
+			Log::Error("Could not find child in metadata by name '%s'\n", std::string(name).c_str());
 		}
 
 		return nullptr;
 	}
 
-	Metadata *Metadata::FindChildWithBackup(const std::string &name, const std::string &backupName, const bool &reportError) const
+	Metadata *Metadata::FindChildWithBackup(const std::string_view &name, const std::string_view &backupName, const bool &reportError) const
 	{
 		auto result = FindChild(name, reportError);
 
@@ -101,7 +201,7 @@ namespace acid
 		return FindChild(backupName, reportError);
 	}
 
-	Metadata *Metadata::FindChildWithAttribute(const std::string &childName, const std::string &attribute, const std::string &value, const bool &reportError) const
+	Metadata *Metadata::FindChildWithAttribute(const std::string_view &childName, const std::string &attribute, const std::string &value, const bool &reportError) const
 	{
 		auto children = FindChildren(childName);
 
@@ -122,19 +222,35 @@ namespace acid
 
 		if (reportError)
 		{
-			Log::Error("Could not find child in metadata '%s' with '%s'\n", childName.c_str(), attribute.c_str());
+			Log::Error("Could not find child in metadata '%s' with '%s'\n", std::string(childName).c_str(), attribute.c_str());
 		}
 
 		return nullptr;
 	}
 
+	const std::map<std::string, std::string> &Metadata::GetAttributes() const
+	{
+		static const std::map<std::string, std::string> empty = {};
+		return m_attributes == nullptr ? empty : *m_attributes;
+	}
+
+	void Metadata::SetAttributes(const std::map<std::string, std::string> &attributes)
+	{
+		m_attributes = attributes.empty() ? nullptr : std::make_unique<std::map<std::string, std::string>>(attributes);
+	}
+
 	void Metadata::AddAttribute(const std::string &attribute, const std::string &value)
 	{
-		auto it = m_attributes.find(attribute);
+		if (m_attributes == nullptr)
+		{
+			m_attributes = std::make_unique<std::map<std::string, std::string>>();
+		}
+
+		auto it = m_attributes->find(attribute);
 
-		if (it == m_attributes.end())
+		if (it == m_attributes->end())
 		{
-			m_attributes.emplace(attribute, value);
+			m_attributes->emplace(attribute, value);
 			return;
 		}
 
@@ -143,19 +259,29 @@ namespace acid
 
 	void Metadata::RemoveAttribute(const std::string &attribute)
 	{
-		auto it = m_attributes.find(attribute);
+		if (m_attributes == nullptr)
+		{
+			return;
+		}
+
+		auto it = m_attributes->find(attribute);
 
-		if (it != m_attributes.end()) // TODO: Clean remove.
+		if (it != m_attributes->end()) // TODO: Clean remove.
 		{
-			m_attributes.erase(it);
+			m_attributes->erase(it);
 		}
 	}
 
 	std::string Metadata::FindAttribute(const std::string &attribute) const
 	{
-		auto it = m_attributes.find(attribute);
+		if (m_attributes == nullptr)
+		{
+			return "";
+		}
 
-		if (it == m_attributes.end())
+		auto it = m_attributes->find(attribute);
+
+		if (it == m_attributes->end())
 		{
 			return "";
 		}
@@ -165,7 +291,7 @@ namespace acid
 
 	Metadata *Metadata::Clone() const
 	{
-		auto result = new Metadata(m_name, m_value, m_attributes);
+		auto result = new Metadata(m_name, m_value, GetAttributes());
 
 		for (const auto &child : m_children)
 		{
@@ -175,10 +301,35 @@ namespace acid
 		return result;
 	}
 
+	std::size_t Metadata::GetHash() const
+	{
+		static const auto combine = [](std::size_t &seed, const std::size_t &hash)
+		{
+			seed ^= hash + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+		};
+
+		std::hash<std::string_view> hasher;
+		std::size_t result = hasher(m_name);
+		combine(result, hasher(m_value));
+
+		for (const auto &[attribute, value] : GetAttributes())
+		{
+			combine(result, hasher(attribute));
+			combine(result, hasher(value));
+		}
+
+		for (const auto &child : m_children)
+		{
+			combine(result, child->GetHash());
+		}
+
+		return result;
+	}
+
 	bool Metadata::operator==(const Metadata &other) const
 	{
-		return m_name == other.m_name && m_value == other.m_value && m_attributes == other.m_attributes && m_children.size() == other.m_children.size() &&
-			std::equal(m_children.begin(), m_children.end(), other.m_children.begin(), [](const std::unique_ptr<Metadata> &left, const std::unique_ptr<Metadata> &right)
+		return m_name == other.m_name && m_value == other.m_value && GetAttributes() == other.GetAttributes() && m_children.size() == other.m_children.size() &&
+			std::equal(m_children.begin(), m_children.end(), other.m_children.begin(), [](const Child &left, const Child &right)
 			{
 				return *left == *right;
 			});
@@ -191,13 +342,67 @@ namespace acid
 
 	bool Metadata::operator<(const Metadata &other) const
 	{
-		return m_name < other.m_name || m_value < other.m_value || m_attributes < other.m_attributes || m_children < other.m_children;
+		return m_name < other.m_name || m_value < other.m_value || GetAttributes() < other.GetAttributes() || m_children < other.m_children;
 	}
 
 	void Metadata::Load(std::istream *inStream)
 	{
 	}
 
+	MetadataArena *Metadata::CreateDocument(std::istream *inStream)
+	{
+		std::string source;
+
+		if (inStream != nullptr)
+		{
+			// Reads the stream in one block when its size is known, otherwise falls back to the stream buffer.
+			auto start = inStream->tellg();
+			inStream->seekg(0, std::ios::end);
+			auto end = inStream->tellg();
+
+			if (start != std::streampos(-1) && end != std::streampos(-1) && end >= start)
+			{
+				inStream->seekg(start);
+				source.resize(static_cast<std::size_t>(end - start));
+				inStream->read(source.data(), static_cast<std::streamsize>(source.size()));
+				source.resize(static_cast<std::size_t>(inStream->gcount()));
+			}
+			else
+			{
+				inStream->clear();
+				source.assign(std::istreambuf_iterator<char>(*inStream), std::istreambuf_iterator<char>());
+			}
+		}
+
+		return ResetDocument(std::make_unique<MetadataArena>(std::move(source)));
+	}
+
+	MetadataArena *Metadata::CreateDocument(std::unique_ptr<MappedFile> mapping)
+	{
+		return ResetDocument(std::make_unique<MetadataArena>(std::move(mapping)));
+	}
+
+	MetadataArena *Metadata::ResetDocument(std::unique_ptr<MetadataArena> document)
+	{
+		ClearChildren();
+		ClearAttributes();
+		m_valueType = ValueType::String;
+
+		// Detaches the name and value from the previous arena before it is released.
+		auto arena = m_arena;
+		m_arena = nullptr;
+
+		if (arena != nullptr)
+		{
+			SetStorage(m_name, m_value);
+		}
+
+		m_document = std::move(document);
+		m_arena = m_document.get();
+		m_children = Children(MetadataArena::Allocator<Child>(m_arena));
+		return m_arena;
+	}
+
 	void Metadata::Write(std::ostream *outStream) const
 	{
 	}
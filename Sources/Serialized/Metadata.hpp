@@ -1,36 +1,69 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <map>
 #include <memory>
 #include <vector>
 #include "Helpers/String.hpp"
 #include "Helpers/NonCopyable.hpp"
+#include "MetadataArena.hpp"
 
 namespace acid
 {
 	/// <summary>
 	/// A class that is used to represent a tree of values, used in file-object serialization.
+	/// Nodes are either heap allocated and own their strings, or live in the <seealso cref="MetadataArena"/> of a loaded document
+	/// where names are interned and values are views into the document source.
 	/// </summary>
 	class ACID_EXPORT Metadata :
 		public NonCopyable
 	{
 	public:
-		explicit Metadata(const std::string &name = "", const std::string &value = "", std::map<std::string, std::string> attributes = {});
+		/// <summary>
+		/// The type of a nodes value, text formats always load strings while binary documents store typed values next to their text.
+		/// </summary>
+		enum class ValueType : uint8_t
+		{
+			String, Boolean, Integer, Float, FloatArray
+		};
+
+		/// <summary>
+		/// Destroys a node, arena nodes only run their destructor since their memory is owned by the arena.
+		/// </summary>
+		struct ACID_EXPORT Deleter
+		{
+			void operator()(Metadata *metadata) const;
+		};
+
+		typedef std::unique_ptr<Metadata, Deleter> Child;
+		typedef std::vector<Child, MetadataArena::Allocator<Child>> Children;
+
+		explicit Metadata(const std::string_view &name = "", const std::string_view &value = "", std::map<std::string, std::string> attributes = {});
+
+		const std::string_view &GetName() const { return m_name; }
 
-		const std::string &GetName() const { return m_name; }
+		void SetName(const std::string_view &name);
 
-		void SetName(const std::string &name) { m_name = name; }
+		const std::string_view &GetValue() const { return m_value; }
 
-		const std::string &GetValue() const { return m_value; }
+		void SetValue(const std::string_view &value);
 
-		void SetValue(const std::string &value) { m_value = value; }
+		const ValueType &GetValueType() const { return m_valueType; }
+
+		/// <summary>
+		/// Gets the packed floats of a <seealso cref="ValueType#FloatArray"/> value, the text value holds the same numbers separated by spaces.
+		/// </summary>
+		/// <returns> The floats, or nullptr if the value is not a float array. </returns>
+		const float *GetFloats() const { return m_valueType == ValueType::FloatArray ? m_floats : nullptr; }
+
+		uint32_t GetFloatCount() const { return m_valueType == ValueType::FloatArray ? m_floatCount : 0; }
 
 		std::string GetString() const;
 
 		void SetString(const std::string &data);
 
-		const std::vector<std::unique_ptr<Metadata>> &GetChildren() const { return m_children; }
+		const Children &GetChildren() const { return m_children; }
 
 		uint32_t GetChildCount() const { return static_cast<uint32_t>(m_children.size()); }
 
@@ -38,15 +71,23 @@ namespace acid
 
 		Metadata *AddChild(Metadata *child);
 
+		/// <summary>
+		/// Creates a child node, in the arena of this node if it belongs to a document.
+		/// </summary>
+		/// <param name="name"> The childs name. </param>
+		/// <param name="value"> The childs value, this is copied. </param>
+		/// <returns> The created child. </returns>
+		Metadata *CreateChild(const std::string_view &name, const std::string_view &value = "");
+
 		void RemoveChild(Metadata *child);
 
-		std::vector<Metadata *> FindChildren(const std::string &name) const;
+		std::vector<Metadata *> FindChildren(const std::string_view &name) const;
 
-		Metadata *FindChild(const std::string &name, const bool &reportError = true) const;
+		Metadata *FindChild(const std::string_view &name, const bool &reportError = true) const;
 
-		Metadata *FindChildWithBackup(const std::string &name, const std::string &backupName, const bool &reportError = true) const;
+		Metadata *FindChildWithBackup(const std::string_view &name, const std::string_view &backupName, const bool &reportError = true) const;
 
-		Metadata *FindChildWithAttribute(const std::string &childName, const std::string &attribute, const std::string &value, const bool &reportError = true) const;
+		Metadata *FindChildWithAttribute(const std::string_view &childName, const std::string &attribute, const std::string &value, const bool &reportError = true) const;
 
 		template<typename T>
 		struct is_vector : public std::false_type
@@ -59,7 +100,7 @@ namespace acid
 		};
 
 		template<typename T>
-		T GetChild(const std::string &name) const
+		T GetChild(const std::string_view &name) const
 		{
 			auto child = FindChild(name);
 
@@ -72,7 +113,7 @@ namespace acid
 		}
 
 		template<typename T>
-		void GetChild(const std::string &name, T &dest) const
+		void GetChild(const std::string_view &name, T &dest) const
 		{
 			auto child = FindChild(name);
 
@@ -91,7 +132,7 @@ namespace acid
 
 					if constexpr (std::is_same_v<std::pair<std::string, std::string>, base_type>)
 					{
-						dest.emplace_back(child2->GetName(), child2->Get<std::string>());
+						dest.emplace_back(std::string(child2->GetName()), child2->Get<std::string>());
 					}
 					else
 					{
@@ -106,13 +147,13 @@ namespace acid
 		}
 
 		template<typename T>
-		T GetChildDefault(const std::string &name, const T &value)
+		T GetChildDefault(const std::string_view &name, const T &value)
 		{
 			auto child = FindChild(name, false);
 
 			if (child == nullptr)
 			{
-				child = AddChild(new Metadata(name));
+				child = CreateChild(name);
 				child->Set(value);
 			}
 
@@ -120,7 +161,7 @@ namespace acid
 		}
 
 		template<typename T>
-		std::shared_ptr<T> GetResource(const std::string &name) const
+		std::shared_ptr<T> GetResource(const std::string_view &name) const
 		{
 			auto child = FindChild(name);
 
@@ -133,7 +174,7 @@ namespace acid
 		}
 
 		template<typename T>
-		void GetResource(const std::string &name, std::shared_ptr<T> &dest) const
+		void GetResource(const std::string_view &name, std::shared_ptr<T> &dest) const
 		{
 			auto child = FindChild(name);
 
@@ -147,14 +188,13 @@ namespace acid
 		}
 
 		template<typename T>
-		void SetChild(const std::string &name, const T &value)
+		void SetChild(const std::string_view &name, const T &value)
 		{
 			auto child = FindChild(name, false);
 
 			if (child == nullptr)
 			{
-				child = new Metadata(name);
-				m_children.emplace_back(child);
+				child = CreateChild(name);
 			}
 
 			if constexpr (is_vector<T>::value)
@@ -165,11 +205,11 @@ namespace acid
 
 					if constexpr (std::is_same_v<std::pair<std::string, std::string>, base_type>)
 					{
-						child->AddChild(new Metadata(x.first, x.second));
+						child->CreateChild(x.first, x.second);
 					}
 					else
 					{
-						child->AddChild(new Metadata("", x));
+						child->CreateChild("", x);
 					}
 				}
 			}
@@ -180,14 +220,13 @@ namespace acid
 		}
 
 		template<typename T>
-		void SetResource(const std::string &name, const std::shared_ptr<T> &value)
+		void SetResource(const std::string_view &name, const std::shared_ptr<T> &value)
 		{
 			auto child = FindChild(name, false);
 
 			if (child == nullptr)
 			{
-				child = new Metadata(name);
-				m_children.emplace_back(child);
+				child = CreateChild(name);
 			}
 
 			child->Set<std::shared_ptr<T>>(value);
@@ -208,6 +247,47 @@ namespace acid
 			}
 			else
 			{
+				// Typed values are converted directly instead of being parsed from text.
+				if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+				{
+					if (m_valueType == ValueType::Boolean && std::is_same_v<bool, T>)
+					{
+						return m_integer == 1;
+					}
+
+					if (m_valueType == ValueType::Integer)
+					{
+						if constexpr (std::is_same_v<bool, T>)
+						{
+							return m_integer == 1;
+						}
+						else if constexpr (std::is_enum_v<T>)
+						{
+							return static_cast<T>(static_cast<std::underlying_type_t<T>>(m_integer));
+						}
+						else
+						{
+							return static_cast<T>(m_integer);
+						}
+					}
+
+					if (m_valueType == ValueType::Float)
+					{
+						if constexpr (std::is_same_v<bool, T>)
+						{
+							return static_cast<int32_t>(m_float) == 1;
+						}
+						else if constexpr (std::is_enum_v<T>)
+						{
+							return static_cast<T>(static_cast<std::underlying_type_t<T>>(m_float));
+						}
+						else
+						{
+							return static_cast<T>(m_float);
+						}
+					}
+				}
+
 				return String::From<T>(m_value);
 			}
 		}
@@ -247,13 +327,13 @@ namespace acid
 			}
 		}
 
-		const std::map<std::string, std::string> &GetAttributes() const { return m_attributes; }
+		const std::map<std::string, std::string> &GetAttributes() const;
 
-		uint32_t GetAttributeCount() const { return static_cast<uint32_t>(m_attributes.size()); }
+		uint32_t GetAttributeCount() const { return m_attributes == nullptr ? 0 : static_cast<uint32_t>(m_attributes->size()); }
 
-		void SetAttributes(const std::map<std::string, std::string> &attributes) { m_attributes = attributes; }
+		void SetAttributes(const std::map<std::string, std::string> &attributes);
 
-		void ClearAttributes() { m_attributes.clear(); }
+		void ClearAttributes() { m_attributes = nullptr; }
 
 		void AddAttribute(const std::string &attribute, const std::string &value);
 
@@ -267,15 +347,66 @@ namespace acid
 
 		Metadata *Clone() const;
 
+		/// <summary>
+		/// Gets a structural hash of this metadata tree, two equal trees will always produce the same hash.
+		/// </summary>
+		/// <returns> The hash of the name, value, attributes and children. </returns>
+		std::size_t GetHash() const;
+
 		bool operator==(const Metadata &other) const;
 
 		bool operator!=(const Metadata &other) const;
 
 		bool operator<(const Metadata &other) const;
+
+		/// <summary>
+		/// Gets the arena this node allocates its strings and children from.
+		/// </summary>
+		/// <returns> The arena, or nullptr if this node is heap allocated. </returns>
+		MetadataArena *GetArena() const { return m_arena; }
 	protected:
-		std::string m_name;
-		std::string m_value;
-		std::vector<std::unique_ptr<Metadata>> m_children;
-		std::map<std::string, std::string> m_attributes;
+		/// <summary>
+		/// Clears this node and gives it a new arena, the arena owns the source buffer so parsers can build nodes that view into it.
+		/// </summary>
+		/// <param name="inStream"> The stream to read the source buffer of the document from, or nullptr. </param>
+		/// <returns> The new arena. </returns>
+		MetadataArena *CreateDocument(std::istream *inStream = nullptr);
+
+		/// <summary>
+		/// Clears this node and gives it a new arena over a memory mapped file.
+		/// </summary>
+		/// <param name="mapping"> The mapped file, must be open. </param>
+		/// <returns> The new arena. </returns>
+		MetadataArena *CreateDocument(std::unique_ptr<MappedFile> mapping);
+
+		// Declared first so it is destroyed after the children that live in it.
+		std::unique_ptr<MetadataArena> m_document;
+		MetadataArena *m_arena;
+		bool m_arenaAllocated;
+		ValueType m_valueType;
+		uint32_t m_floatCount;
+		std::string_view m_name;
+		std::string_view m_value;
+		// Holds the name followed by the value for nodes that are not in a arena.
+		std::string m_storage;
+		Children m_children;
+		// Most nodes have no attributes, so the map is only created when needed.
+		std::unique_ptr<std::map<std::string, std::string>> m_attributes;
+		// The typed value, only valid when the value type is not a string.
+		union
+		{
+			int64_t m_integer;
+			double m_float;
+			const float *m_floats;
+		};
+	private:
+		friend class MetadataArena;
+		friend class Binary;
+
+		Metadata(MetadataArena *arena, const std::string_view &name, const std::string_view &value);
+
+		void SetStorage(const std::string_view &name, const std::string_view &value);
+
+		MetadataArena *ResetDocument(std::unique_ptr<MetadataArena> document);
 	};
 }
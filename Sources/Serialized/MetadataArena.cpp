@@ -0,0 +1,123 @@
+#include "MetadataArena.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include "Metadata.hpp"
+
+namespace acid
+{
+	MetadataArena::MetadataArena(std::string source, const std::size_t &blockSize) :
+		m_sourceStorage(std::move(source)),
+		m_source(m_sourceStorage),
+		m_blockSize(blockSize),
+		m_current(nullptr),
+		m_remaining(0),
+		m_bytesAllocated(0),
+		m_nodeCount(0)
+	{
+	}
+
+	MetadataArena::MetadataArena(std::unique_ptr<MappedFile> mapping, const std::size_t &blockSize) :
+		m_mapping(std::move(mapping)),
+		m_source(m_mapping->GetData(), m_mapping->GetSize()),
+		m_blockSize(blockSize),
+		m_current(nullptr),
+		m_remaining(0),
+		m_bytesAllocated(0),
+		m_nodeCount(0)
+	{
+	}
+
+	void *MetadataArena::Allocate(const std::size_t &size, const std::size_t &alignment)
+	{
+		auto padding = (alignment - reinterpret_cast<std::uintptr_t>(m_current) % alignment) % alignment;
+
+		if (m_current == nullptr || padding + size > m_remaining)
+		{
+			// Large allocations get their own block so the current block is not wasted.
+			auto blockSize = std::max(m_blockSize, size + alignment);
+			auto &[block, blockLength] = m_blocks.emplace_back(new char[blockSize], blockSize);
+
+			if (size + alignment > m_blockSize)
+			{
+				auto result = block.get() + (alignment - reinterpret_cast<std::uintptr_t>(block.get()) % alignment) % alignment;
+				m_bytesAllocated += size;
+				return result;
+			}
+
+			m_current = block.get();
+			m_remaining = blockLength;
+			padding = (alignment - reinterpret_cast<std::uintptr_t>(m_current) % alignment) % alignment;
+		}
+
+		auto result = m_current + padding;
+		m_current += padding + size;
+		m_remaining -= padding + size;
+		m_bytesAllocated += size;
+		return result;
+	}
+
+	Metadata *MetadataArena::Create(const std::string_view &name, const std::string_view &value)
+	{
+		auto memory = Allocate(sizeof(Metadata), alignof(Metadata));
+		m_nodeCount++;
+		return new(memory) Metadata(this, Intern(name), value);
+	}
+
+	Metadata *MetadataArena::CreateView(const std::string_view &name, const std::string_view &value)
+	{
+		auto memory = Allocate(sizeof(Metadata), alignof(Metadata));
+		m_nodeCount++;
+		return new(memory) Metadata(this, name, value);
+	}
+
+	std::string_view MetadataArena::Intern(const std::string_view &string)
+	{
+		auto it = m_interned.find(string);
+
+		if (it != m_interned.end())
+		{
+			return *it;
+		}
+
+		auto stored = Store(string);
+		m_interned.emplace(stored);
+		return stored;
+	}
+
+	std::string_view MetadataArena::Store(const std::string_view &string)
+	{
+		if (string.empty())
+		{
+			return {};
+		}
+
+		auto memory = static_cast<char *>(Allocate(string.size(), 1));
+		std::memcpy(memory, string.data(), string.size());
+		return std::string_view(memory, string.size());
+	}
+
+	bool MetadataArena::Owns(const std::string_view &string) const
+	{
+		auto contains = [&](const char *begin, const std::size_t &length)
+		{
+			return string.data() >= begin && string.data() + string.size() <= begin + length;
+		};
+
+		if (contains(m_source.data(), m_source.size()))
+		{
+			return true;
+		}
+
+		for (const auto &[block, blockLength] : m_blocks)
+		{
+			if (contains(block.get(), blockLength))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+#include "Files/MappedFile.hpp"
+#include "Helpers/NonCopyable.hpp"
+
+namespace acid
+{
+	class Metadata;
+
+	/// <summary>
+	/// A monotonic arena that owns the nodes and strings of one loaded metadata document.
+	/// Memory is only released when the arena is destroyed, names are interned so equal names share one view.
+	/// </summary>
+	class ACID_EXPORT MetadataArena :
+		public NonCopyable
+	{
+	public:
+		/// <summary>
+		/// A allocator that draws from a arena, or from the heap when no arena is set.
+		/// </summary>
+		/// <param name="T"> The type to allocate. </param>
+		template<typename T>
+		class Allocator
+		{
+		public:
+			typedef T value_type;
+			typedef std::true_type propagate_on_container_move_assignment;
+			typedef std::true_type propagate_on_container_swap;
+
+			Allocator(MetadataArena *arena = nullptr) noexcept :
+				m_arena(arena)
+			{
+			}
+
+			template<typename U>
+			Allocator(const Allocator<U> &other) noexcept :
+				m_arena(other.m_arena)
+			{
+			}
+
+			T *allocate(const std::size_t n)
+			{
+				if (m_arena == nullptr)
+				{
+					return static_cast<T *>(::operator new(n * sizeof(T)));
+				}
+
+				return static_cast<T *>(m_arena->Allocate(n * sizeof(T), alignof(T)));
+			}
+
+			void deallocate(T *p, const std::size_t n) noexcept
+			{
+				if (m_arena == nullptr)
+				{
+					::operator delete(p);
+				}
+			}
+
+			template<typename U>
+			bool operator==(const Allocator<U> &other) const { return m_arena == other.m_arena; }
+
+			template<typename U>
+			bool operator!=(const Allocator<U> &other) const { return m_arena != other.m_arena; }
+
+			MetadataArena *m_arena;
+		};
+
+		/// <summary>
+		/// Creates a new arena.
+		/// </summary>
+		/// <param name="source"> The source buffer of the document, node values may be views into this buffer. </param>
+		/// <param name="blockSize"> The size of each block allocated by the arena. </param>
+		explicit MetadataArena(std::string source = "", const std::size_t &blockSize = 64 * 1024);
+
+		/// <summary>
+		/// Creates a new arena over a memory mapped file.
+		/// </summary>
+		/// <param name="mapping"> The mapped file used as the source buffer of the document. </param>
+		/// <param name="blockSize"> The size of each block allocated by the arena. </param>
+		explicit MetadataArena(std::unique_ptr<MappedFile> mapping, const std::size_t &blockSize = 64 * 1024);
+
+		/// <summary>
+		/// Allocates uninitialized memory from the arena.
+		/// </summary>
+		/// <param name="size"> The size in bytes. </param>
+		/// <param name="alignment"> The alignment of the memory. </param>
+		/// <returns> The allocated memory, valid until the arena is destroyed. </returns>
+		void *Allocate(const std::size_t &size, const std::size_t &alignment = alignof(std::max_align_t));
+
+		/// <summary>
+		/// Creates a new node in the arena, the value is not copied and must outlive the arena (a view into the source, or from <seealso cref="#Store()"/>).
+		/// </summary>
+		/// <param name="name"> The name of the node, will be interned. </param>
+		/// <param name="value"> The value of the node. </param>
+		/// <returns> The created node. </returns>
+		Metadata *Create(const std::string_view &name, const std::string_view &value = {});
+
+		/// <summary>
+		/// Creates a new node in the arena without interning its name, used when the name is already unique to the source (like a string table).
+		/// </summary>
+		/// <param name="name"> The name of the node, must outlive the arena. </param>
+		/// <param name="value"> The value of the node, must outlive the arena. </param>
+		/// <returns> The created node. </returns>
+		Metadata *CreateView(const std::string_view &name, const std::string_view &value = {});
+
+		/// <summary>
+		/// Gets the interned copy of a string, equal strings always return the same view.
+		/// </summary>
+		/// <param name="string"> The string to intern. </param>
+		/// <returns> The interned string. </returns>
+		std::string_view Intern(const std::string_view &string);
+
+		/// <summary>
+		/// Copies a string into the arena.
+		/// </summary>
+		/// <param name="string"> The string to copy. </param>
+		/// <returns> The copied string. </returns>
+		std::string_view Store(const std::string_view &string);
+
+		/// <summary>
+		/// Gets if a view points inside the source buffer or the memory of this arena.
+		/// </summary>
+		/// <param name="string"> The view to check. </param>
+		/// <returns> If the view is owned by this arena. </returns>
+		bool Owns(const std::string_view &string) const;
+
+		const std::string_view &GetSource() const { return m_source; }
+
+		std::size_t GetBytesAllocated() const { return m_bytesAllocated; }
+
+		uint32_t GetNodeCount() const { return m_nodeCount; }
+	private:
+		std::string m_sourceStorage;
+		std::unique_ptr<MappedFile> m_mapping;
+		std::string_view m_source;
+		std::size_t m_blockSize;
+		std::vector<std::pair<std::unique_ptr<char[]>, std::size_t>> m_blocks;
+		char *m_current;
+		std::size_t m_remaining;
+		std::size_t m_bytesAllocated;
+		uint32_t m_nodeCount;
+		std::unordered_set<std::string_view> m_interned;
+	};
+}
@@ -1,6 +1,6 @@
 #include "Xml.hpp"
 
-#include "Files/Files.hpp"
+#include "Helpers/String.hpp"
 
 namespace acid
 {
@@ -17,73 +17,59 @@ namespace acid
 
 	void Xml::Load(std::istream *inStream)
 	{
-		ClearChildren();
-		ClearAttributes();
+		auto document = CreateDocument(inStream);
+		std::string_view source = document->GetSource();
 
 		auto topNode = std::make_unique<Node>(nullptr, "", "");
-		Node *currentSection = nullptr;
-		std::stringstream summation;
-		bool end = false;
+		Node *currentSection = topNode.get();
+		std::size_t contentStart = 0;
 
-		size_t lineNum = 0;
-		std::string linebuf;
-
-		while (inStream->peek() != -1)
+		for (auto tagStart = source.find('<'); tagStart != std::string_view::npos; tagStart = source.find('<', contentStart))
 		{
-			Files::SafeGetLine(*inStream, linebuf);
-			lineNum++;
-
-			for (auto it = linebuf.begin(); it != linebuf.end(); ++it)
+			if (source.compare(tagStart, 4, "<!--") == 0) // Comment.
 			{
-				if (*it == '<')
+				auto commentEnd = source.find("-->", tagStart);
+
+				if (commentEnd == std::string_view::npos)
 				{
-					if (*(it + 1) == '?') // Prolog.
-					{
-						currentSection = topNode.get();
-						continue;
-					}
+					break;
+				}
 
-					if (*(it + 1) == '/') // End tag.
-					{
-						currentSection->m_content += summation.str();
-						end = true;
-					}
-					else // Start tag.
-					{
-						auto section = new Node(currentSection, "", "");
-						currentSection->m_children.emplace_back(section);
-						currentSection = section;
-					}
+				contentStart = commentEnd + 3;
+				continue;
+			}
 
-					summation.str(std::string());
-				}
-				else if (*it == '>')
-				{
-					if (!end)
-					{
-						currentSection->m_attributes += summation.str();
-					}
+			auto tagEnd = source.find('>', tagStart);
 
-					summation.str(std::string());
+			if (tagEnd == std::string_view::npos)
+			{
+				break;
+			}
 
-					if (end || *(it - 1) == '/') // End tag.
-					{
-						end = false;
+			if (source[tagStart + 1] == '?') // Prolog.
+			{
+			}
+			else if (source[tagStart + 1] == '/') // End tag.
+			{
+				currentSection->m_content = source.substr(contentStart, tagStart - contentStart);
 
-						if (currentSection->m_parent != nullptr)
-						{
-							currentSection = currentSection->m_parent;
-						}
-					}
-				}
-				else if (*it == '\n')
+				if (currentSection->m_parent != nullptr)
 				{
+					currentSection = currentSection->m_parent;
 				}
-				else
+			}
+			else // Start tag.
+			{
+				auto section = new Node(currentSection, source.substr(tagStart + 1, tagEnd - tagStart - 1), "");
+				currentSection->m_children.emplace_back(section);
+
+				if (source[tagEnd - 1] != '/')
 				{
-					summation << *it;
+					currentSection = section;
 				}
 			}
+
+			contentStart = tagEnd + 1;
 		}
 
 		if (!topNode->m_children.empty())
@@ -104,7 +90,7 @@ namespace acid
 	{
 		for (const auto &child : source->GetChildren())
 		{
-			auto created = destination->AddChild(new Metadata(child->GetName(), child->GetValue()));
+			auto created = destination->CreateChild(child->GetName(), child->GetValue());
 			AddChildren(child.get(), created);
 		}
 
@@ -116,17 +102,21 @@ namespace acid
 
 	void Xml::Convert(const Node *source, Metadata *parent, const uint32_t &depth)
 	{
-		int32_t firstSpace = String::FindCharPos(source->m_attributes, ' ');
-		std::string name = String::Trim(String::Substring(source->m_attributes, 0, firstSpace));
-		std::string attributes = String::Substring(source->m_attributes, firstSpace + 1, static_cast<int32_t>(source->m_attributes.size()));
-		attributes = String::Trim(attributes);
+		auto tag = String::Trim(source->m_attributes);
 
-		if (attributes[attributes.size() - 1] == '/' || attributes[attributes.size() - 1] == '?')
+		if (!tag.empty() && (tag.back() == '/' || tag.back() == '?'))
 		{
-			attributes.pop_back();
+			tag.remove_suffix(1);
 		}
 
-		attributes = String::Trim(attributes);
+		auto firstSpace = tag.find_first_of(" \t\r\n");
+		auto name = String::Trim(tag.substr(0, firstSpace));
+		std::string_view attributes;
+
+		if (firstSpace != std::string_view::npos)
+		{
+			attributes = String::Trim(tag.substr(firstSpace + 1));
+		}
 
 		std::map<std::string, std::string> parseAttributes = {};
 
@@ -171,19 +161,21 @@ namespace acid
 			}
 		}
 
+		auto content = String::Trim(source->m_content);
 		auto thisValue = parent;
 
 		if (depth != 0)
 		{
 			if (depth != 1)
 			{
-				thisValue = new Metadata(name, source->m_content, parseAttributes);
-				parent->AddChild(thisValue);
+				// Names and values are views into the document source, nothing is copied.
+				thisValue = parent->AddChild(parent->GetArena()->Create(name, content));
+				thisValue->SetAttributes(parseAttributes);
 			}
 			else
 			{
 				thisValue->SetName(name);
-				thisValue->SetValue(source->m_content);
+				thisValue->SetValue(content);
 				thisValue->SetAttributes(parseAttributes);
 			}
 
@@ -195,7 +187,7 @@ namespace acid
 		else
 		{
 			parent->SetName(name);
-			parent->SetValue(source->m_content);
+			parent->SetValue(content);
 			parent->SetAttributes(parseAttributes);
 		}
 	}
@@ -209,7 +201,7 @@ namespace acid
 			indents << "  ";
 		}
 
-		std::string name = String::ReplaceAll(source->GetName(), " ", "_");
+		std::string name = String::ReplaceAll(std::string(source->GetName()), " ", "_");
 
 		std::stringstream nameAttributes;
 		nameAttributes << name;
@@ -17,13 +17,13 @@ namespace acid
 			Node *m_parent;
 			std::vector<std::unique_ptr<Node>> m_children;
 
-			std::string m_attributes;
-			std::string m_content;
+			std::string_view m_attributes;
+			std::string_view m_content;
 
-			Node(Node *parent, std::string attributes, std::string content) :
+			Node(Node *parent, const std::string_view &attributes, const std::string_view &content) :
 				m_parent(parent),
-				m_attributes(std::move(attributes)),
-				m_content(std::move(content))
+				m_attributes(attributes),
+				m_content(content)
 			{
 			}
 		};
@@ -1,6 +1,6 @@
 #include "Yaml.hpp"
 
-#include "Files/Files.hpp"
+#include <algorithm>
 #include "Helpers/String.hpp"
 
 namespace acid
@@ -18,20 +18,25 @@ namespace acid
 
 	void Yaml::Load(std::istream *inStream)
 	{
-		ClearChildren();
-		ClearAttributes();
+		auto document = CreateDocument(inStream);
+		std::string_view source = document->GetSource();
 
 		auto topSection = std::make_unique<Section>(nullptr, "", 0);
 		Section *currentSection = topSection.get();
 		uint32_t lastIndentation = 0;
 
-		size_t lineNum = 0;
-		std::string linebuf;
+		std::size_t lineStart = 0;
 
-		while (inStream->peek() != -1)
+		while (lineStart < source.size())
 		{
-			Files::SafeGetLine(*inStream, linebuf);
-			lineNum++;
+			auto lineEnd = std::min(source.find('\n', lineStart), source.size());
+			auto linebuf = source.substr(lineStart, lineEnd - lineStart);
+			lineStart = lineEnd + 1;
+
+			if (!linebuf.empty() && linebuf.back() == '\r')
+			{
+				linebuf.remove_suffix(1);
+			}
 
 			// Start marker.
 			if (linebuf == "---")
@@ -129,7 +134,7 @@ namespace acid
 	{
 		for (const auto &child : source->GetChildren())
 		{
-			auto created = destination->AddChild(new Metadata(child->GetName(), child->GetValue()));
+			auto created = destination->CreateChild(child->GetName(), child->GetValue());
 			AddChildren(child.get(), created);
 		}
 
@@ -141,22 +146,27 @@ namespace acid
 
 	void Yaml::Convert(const Section *source, Metadata *parent, const bool &isTopSection)
 	{
-		auto name = String::Trim(source->m_content.substr(0, source->m_content.find(':')));
-		auto value = String::Trim(String::ReplaceFirst(source->m_content, name, ""));
-		value = String::Trim(value.erase(0, 1));
+		auto separator = source->m_content.find(':');
+		auto name = String::Trim(source->m_content.substr(0, separator));
+		std::string_view value;
+
+		if (separator != std::string_view::npos)
+		{
+			value = String::Trim(source->m_content.substr(separator + 1));
+		}
 
 		auto thisValue = parent;
 
-		if (String::StartsWith(name, "_"))
+		if (!name.empty() && name.front() == '_')
 		{
-			name = name.erase(0, 1);
-			parent->AddAttribute(name, value);
+			parent->AddAttribute(std::string(name.substr(1)), std::string(value));
 			return;
 		}
+
 		if (!isTopSection)
 		{
-			thisValue = new Metadata(name, value);
-			parent->AddChild(thisValue);
+			// Names and values are views into the document source, nothing is copied.
+			thisValue = parent->AddChild(parent->GetArena()->Create(name, value));
 		}
 
 		for (const auto &child : source->m_children)
@@ -18,12 +18,12 @@ namespace acid
 			std::vector<std::unique_ptr<Section>> m_children;
 
 			uint32_t m_indentation;
-			std::string m_content;
+			std::string_view m_content;
 
-			Section(Section *parent, std::string content, const uint32_t &indentation) :
+			Section(Section *parent, const std::string_view &content, const uint32_t &indentation) :
 				m_parent(parent),
 				m_indentation(indentation),
-				m_content(std::move(content))
+				m_content(content)
 			{
 			}
 		};
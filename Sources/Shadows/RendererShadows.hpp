@@ -17,6 +17,8 @@ namespace acid
 		explicit RendererShadows(const Pipeline::Stage &pipelineStage);
 
 		void Render(const CommandBuffer &commandBuffer) override;
+
+		bool IsParallel() const override { return true; }
 	private:
 		std::vector<Shader::Define> GetDefines();
 
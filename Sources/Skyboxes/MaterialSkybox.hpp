@@ -28,6 +28,8 @@ namespace acid
 
 		void PushDescriptors(DescriptorsHandler &descriptorSet) override;
 
+		bool IsLoaded() const override { return m_cubemap == nullptr || m_cubemap->IsLoaded(); }
+
 		const std::shared_ptr<Cubemap> &GetCubemap() const { return m_cubemap; }
 
 		void SetCubemap(const std::shared_ptr<Cubemap> &cubemap) { m_cubemap = cubemap; }
@@ -3,7 +3,9 @@
 #include <string>
 #include <vector>
 #include <vulkan/vulkan.h>
+#include "Renderer/Commands/UploadQueue.hpp"
 #include "Renderer/Descriptors/Descriptor.hpp"
+#include "Renderer/Memory/MemoryAllocator.hpp"
 #include "Resources/Resource.hpp"
 
 namespace acid
@@ -79,6 +81,8 @@ namespace acid
 
 		void Encode(Metadata &metadata) const override;
 
+		std::size_t GetByteSize() const override;
+
 		/// <summary>
 		/// Gets a copy of the face of a cubemaps pixels from memory, after usage is finished remember to delete the result.
 		/// </summary>
@@ -124,11 +128,17 @@ namespace acid
 
 		const VkImage &GetImage() const { return m_image; }
 
-		const VkDeviceMemory &GetDMemory() { return m_memory; }
+		const VkDeviceMemory &GetDMemory() { return m_memory.GetMemory(); }
 
 		const VkImageView &GetView() const { return m_view; }
 
 		const VkSampler &GetSampler() const { return m_sampler; }
+
+		/// <summary>
+		/// Gets if the pixels and layout of the image have been submitted to the device, until then the cubemap should not be drawn with.
+		/// </summary>
+		/// <returns> If the image is ready to be used in a frame. </returns>
+		bool IsLoaded() const;
 	private:
 		std::string m_filename;
 		std::string m_fileSuffix;
@@ -147,9 +157,10 @@ namespace acid
 		uint8_t *m_pixels;
 
 		VkImage m_image;
-		VkDeviceMemory m_memory;
+		MemoryAllocation m_memory;
 		VkImageView m_view;
 		VkSampler m_sampler;
 		VkFormat m_format;
+		UploadQueue::Ticket m_upload;
 	};
 }
@@ -1,13 +1,12 @@
 #pragma once
 
 #include "Renderer/Descriptors/Descriptor.hpp"
-#include "Renderer/Buffers/Buffer.hpp"
+#include "Renderer/Memory/MemoryAllocator.hpp"
 
 namespace acid
 {
 	class ACID_EXPORT DepthStencil :
-		public Descriptor,
-		public Buffer
+		public Descriptor
 	{
 	public:
 		DepthStencil(const uint32_t &width, const uint32_t &height, const VkSampleCountFlagBits &samples = VK_SAMPLE_COUNT_1_BIT);
@@ -32,6 +31,7 @@ namespace acid
 		uint32_t m_width, m_height;
 
 		VkImage m_image;
+		MemoryAllocation m_memory;
 		VkImageView m_imageView;
 		VkSampler m_sampler;
 		VkFormat m_format;
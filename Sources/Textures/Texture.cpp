@@ -21,15 +21,15 @@ namespace acid
 
 	std::shared_ptr<Texture> Texture::Create(const Metadata &metadata)
 	{
-		auto resource = Resources::Get()->Find(metadata);
+		auto resource = Resources::Get()->Find<Texture>(metadata);
 
 		if (resource != nullptr)
 		{
-			return std::dynamic_pointer_cast<Texture>(resource);
+			return resource;
 		}
 
 		auto result = std::make_shared<Texture>("");
-		Resources::Get()->Add(metadata, std::dynamic_pointer_cast<Resource>(result));
+		Resources::Get()->Add(metadata, result);
 		result->Decode(metadata);
 		result->Load();
 		return result;
@@ -57,10 +57,10 @@ namespace acid
 		m_height(0),
 		m_pixels(nullptr),
 		m_image(VK_NULL_HANDLE),
-		m_memory(VK_NULL_HANDLE),
 		m_view(VK_NULL_HANDLE),
 		m_sampler(VK_NULL_HANDLE),
-		m_format(VK_FORMAT_R8G8B8A8_UNORM)
+		m_format(VK_FORMAT_R8G8B8A8_UNORM),
+		m_upload(0)
 	{
 		if (load)
 		{
@@ -83,22 +83,25 @@ namespace acid
 		m_height(height),
 		m_pixels(pixels),
 		m_image(VK_NULL_HANDLE),
-		m_memory(VK_NULL_HANDLE),
 		m_view(VK_NULL_HANDLE),
 		m_sampler(VK_NULL_HANDLE),
-		m_format(format)
+		m_format(format),
+		m_upload(0)
 	{
 		Texture::Load();
 	}
 
 	Texture::~Texture()
 	{
+		// The image can not be destroyed while a upload is still writing to it.
+		Renderer::Get()->GetUploadQueue()->Wait(m_upload);
+
 		auto logicalDevice = Renderer::Get()->GetLogicalDevice();
 
 		vkDestroySampler(logicalDevice->GetLogicalDevice(), m_sampler, nullptr);
 		vkDestroyImageView(logicalDevice->GetLogicalDevice(), m_view, nullptr);
-		vkFreeMemory(logicalDevice->GetLogicalDevice(), m_memory, nullptr);
 		vkDestroyImage(logicalDevice->GetLogicalDevice(), m_image, nullptr);
+		Renderer::Get()->GetMemoryAllocator()->Free(m_memory);
 	}
 
 	VkDescriptorSetLayoutBinding Texture::GetDescriptorSetLayout(const uint32_t &binding, const VkDescriptorType &descriptorType, const VkShaderStageFlags &stage, const uint32_t &count)
@@ -150,40 +153,32 @@ namespace acid
 			return;
 		}
 
-		auto logicalDevice = Renderer::Get()->GetLogicalDevice();
 		auto mipLevels = m_mipmap ? GetMipLevels(m_width, m_height) : 1;
 
 		CreateImage(m_image, m_memory, m_width, m_height, VK_IMAGE_TYPE_2D, m_samples, mipLevels, m_format, VK_IMAGE_TILING_OPTIMAL, m_usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 1);
 
-		if (m_pixels != nullptr || m_mipmap)
-		{
-			TransitionImageLayout(m_image, m_format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_ASPECT_COLOR_BIT, mipLevels, 0, 1);
-		}
-
-		if (m_pixels != nullptr)
+		// The copy, mipmaps and layout transitions are recorded into the next upload batch instead of waiting on the device here.
+		auto pixelsSize = m_pixels != nullptr ? static_cast<VkDeviceSize>(m_width) * m_height * 4 : 0;
+		m_upload = Renderer::Get()->GetUploadQueue()->UploadImage(m_image, m_pixels, pixelsSize, m_width, m_height, mipLevels, 0, 1, [this, mipLevels](const VkCommandBuffer &commandBuffer)
 		{
-			Buffer bufferStaging = Buffer(m_width * m_height * 4, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-			void *data;
-			vkMapMemory(logicalDevice->GetLogicalDevice(), bufferStaging.GetBufferMemory(), 0, bufferStaging.GetSize(), 0, &data);
-			memcpy(data, m_pixels, bufferStaging.GetSize());
-			vkUnmapMemory(logicalDevice->GetLogicalDevice(), bufferStaging.GetBufferMemory());
-
-			CopyBufferToImage(bufferStaging.GetBuffer(), m_image, m_width, m_height, 0, 1);
-		}
+			if (m_mipmap)
+			{
+				if (m_pixels == nullptr)
+				{
+					TransitionImageLayout(commandBuffer, m_image, m_format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_ASPECT_COLOR_BIT, mipLevels, 0, 1);
+				}
 
-		if (m_mipmap)
-		{
-			CreateMipmaps(m_image, m_width, m_height, m_layout, mipLevels, 0, 1);
-		}
-		else if (m_pixels != nullptr)
-		{
-			TransitionImageLayout(m_image, m_format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_layout, VK_IMAGE_ASPECT_COLOR_BIT, mipLevels, 0, 1);
-		}
-		else
-		{
-			TransitionImageLayout(m_image, m_format, VK_IMAGE_LAYOUT_UNDEFINED, m_layout, VK_IMAGE_ASPECT_COLOR_BIT, mipLevels, 0, 1);
-		}
+				CreateMipmaps(commandBuffer, m_image, m_width, m_height, m_layout, mipLevels, 0, 1);
+			}
+			else if (m_pixels != nullptr)
+			{
+				TransitionImageLayout(commandBuffer, m_image, m_format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_layout, VK_IMAGE_ASPECT_COLOR_BIT, mipLevels, 0, 1);
+			}
+			else
+			{
+				TransitionImageLayout(commandBuffer, m_image, m_format, VK_IMAGE_LAYOUT_UNDEFINED, m_layout, VK_IMAGE_ASPECT_COLOR_BIT, mipLevels, 0, 1);
+			}
+		});
 
 		CreateImageSampler(m_sampler, m_filter, m_addressMode, m_anisotropic, mipLevels);
 		CreateImageView(m_image, m_view, VK_IMAGE_VIEW_TYPE_2D, m_format, VK_IMAGE_ASPECT_COLOR_BIT, mipLevels, 0, 1);
@@ -208,12 +203,24 @@ namespace acid
 		metadata.SetChild("Mipmap", m_mipmap);
 	}
 
+	std::size_t Texture::GetByteSize() const
+	{
+		return static_cast<std::size_t>(m_width) * m_height * 4;
+	}
+
+	bool Texture::IsLoaded() const
+	{
+		return Renderer::Get()->GetUploadQueue()->IsSubmitted(m_upload);
+	}
+
 	uint8_t *Texture::GetPixels() const
 	{
+		Renderer::Get()->GetUploadQueue()->Wait(m_upload);
+
 		auto logicalDevice = Renderer::Get()->GetLogicalDevice();
 
 		VkImage dstImage;
-		VkDeviceMemory dstImageMemory;
+		MemoryAllocation dstImageMemory;
 		CopyImage(m_image, dstImage, dstImageMemory, m_width, m_height, false, 0, 1);
 
 		VkImageSubresource imageSubresource = {};
@@ -226,27 +233,23 @@ namespace acid
 
 		auto result = new uint8_t[subresourceLayout.size];
 
-		void *data;
-		vkMapMemory(logicalDevice->GetLogicalDevice(), dstImageMemory, subresourceLayout.offset, subresourceLayout.size, 0, &data);
+		auto data = static_cast<char *>(dstImageMemory.GetMapped()) + subresourceLayout.offset;
 		std::memcpy(result, data, static_cast<size_t>(subresourceLayout.size));
-		vkUnmapMemory(logicalDevice->GetLogicalDevice(), dstImageMemory);
 
-		vkFreeMemory(logicalDevice->GetLogicalDevice(), dstImageMemory, nullptr);
 		vkDestroyImage(logicalDevice->GetLogicalDevice(), dstImage, nullptr);
+		Renderer::Get()->GetMemoryAllocator()->Free(dstImageMemory);
 
 		return result;
 	}
 
 	void Texture::SetPixels(const uint8_t *pixels)
 	{
-		auto logicalDevice = Renderer::Get()->GetLogicalDevice();
-
 		Buffer bufferStaging = Buffer(m_width * m_height * 4, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
 
 		void *data;
-		vkMapMemory(logicalDevice->GetLogicalDevice(), bufferStaging.GetBufferMemory(), 0, bufferStaging.GetSize(), 0, &data);
+		bufferStaging.Map(&data);
 		std::memcpy(data, pixels, bufferStaging.GetSize());
-		vkUnmapMemory(logicalDevice->GetLogicalDevice(), bufferStaging.GetBufferMemory());
+		bufferStaging.Unmap();
 	}
 
 	uint8_t *Texture::LoadPixels(const std::string &filename, uint32_t *width, uint32_t *height, uint32_t *components)
@@ -346,7 +349,7 @@ namespace acid
 		return std::find(STENCIL_FORMATS.begin(), STENCIL_FORMATS.end(), format) != std::end(STENCIL_FORMATS);
 	}
 
-	void Texture::CreateImage(VkImage &image, VkDeviceMemory &memory, const uint32_t &width, const uint32_t &height, const VkImageType &type, const VkSampleCountFlagBits &samples, 
+	void Texture::CreateImage(VkImage &image, MemoryAllocation &memory, const uint32_t &width, const uint32_t &height, const VkImageType &type, const VkSampleCountFlagBits &samples, 
 		const uint32_t &mipLevels, const VkFormat &format, const VkImageTiling &tiling, const VkImageUsageFlags &usage, const VkMemoryPropertyFlags &properties, const uint32_t &arrayLayers)
 	{
 		auto logicalDevice = Renderer::Get()->GetLogicalDevice();
@@ -369,13 +372,10 @@ namespace acid
 		VkMemoryRequirements memoryRequirements;
 		vkGetImageMemoryRequirements(logicalDevice->GetLogicalDevice(), image, &memoryRequirements);
 
-		VkMemoryAllocateInfo memoryAllocateInfo = {};
-		memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-		memoryAllocateInfo.allocationSize = memoryRequirements.size;
-		memoryAllocateInfo.memoryTypeIndex = Buffer::FindMemoryType(memoryRequirements.memoryTypeBits, properties);
-		Renderer::CheckVk(vkAllocateMemory(logicalDevice->GetLogicalDevice(), &memoryAllocateInfo, nullptr, &memory));
+		auto memoryTiling = tiling == VK_IMAGE_TILING_OPTIMAL ? MemoryAllocator::Tiling::Optimal : MemoryAllocator::Tiling::Linear;
+		memory = Renderer::Get()->GetMemoryAllocator()->Allocate(memoryRequirements, properties, memoryTiling);
 
-		Renderer::CheckVk(vkBindImageMemory(logicalDevice->GetLogicalDevice(), image, memory, 0));
+		Renderer::CheckVk(vkBindImageMemory(logicalDevice->GetLogicalDevice(), image, memory.GetMemory(), memory.GetOffset()));
 	}
 
 	bool Texture::HasStencilComponent(const VkFormat &format)
@@ -387,7 +387,14 @@ namespace acid
 		const VkImageAspectFlags &aspectMask, const uint32_t &mipLevels, const uint32_t &baseArrayLayer, const uint32_t &layerCount)
 	{
 		CommandBuffer commandBuffer = CommandBuffer();
+		TransitionImageLayout(commandBuffer.GetCommandBuffer(), image, format, srcImageLayout, dstImageLayout, aspectMask, mipLevels, baseArrayLayer, layerCount);
+		commandBuffer.End();
+		commandBuffer.SubmitIdle();
+	}
 
+	void Texture::TransitionImageLayout(const VkCommandBuffer &commandBuffer, const VkImage &image, const VkFormat &format, const VkImageLayout &srcImageLayout, 
+		const VkImageLayout &dstImageLayout, const VkImageAspectFlags &aspectMask, const uint32_t &mipLevels, const uint32_t &baseArrayLayer, const uint32_t &layerCount)
+	{
 		VkImageMemoryBarrier imageMemoryBarrier = {};
 		imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
 		imageMemoryBarrier.oldLayout = srcImageLayout;
@@ -459,10 +466,7 @@ namespace acid
 		VkPipelineStageFlags srcStageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
 		VkPipelineStageFlags dstStageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
 
-		vkCmdPipelineBarrier(commandBuffer.GetCommandBuffer(), srcStageMask, dstStageMask, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
-
-		commandBuffer.End();
-		commandBuffer.SubmitIdle();
+		vkCmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
 	}
 
 	void Texture::CopyBufferToImage(const VkBuffer &buffer, const VkImage &image, const uint32_t &width, const uint32_t &height, const uint32_t &baseArrayLayer, const uint32_t &layerCount)
@@ -489,7 +493,14 @@ namespace acid
 		const uint32_t &mipLevels, const uint32_t &baseArrayLayer, const uint32_t &layerCount)
 	{
 		CommandBuffer commandBuffer = CommandBuffer();
+		CreateMipmaps(commandBuffer.GetCommandBuffer(), image, width, height, dstImageLayout, mipLevels, baseArrayLayer, layerCount);
+		commandBuffer.End();
+		commandBuffer.SubmitIdle();
+	}
 
+	void Texture::CreateMipmaps(const VkCommandBuffer &commandBuffer, const VkImage &image, const uint32_t &width, const uint32_t &height, 
+		const VkImageLayout &dstImageLayout, const uint32_t &mipLevels, const uint32_t &baseArrayLayer, const uint32_t &layerCount)
+	{
 		int32_t mipWidth = width;
 		int32_t mipHeight = height;
 
@@ -509,7 +520,7 @@ namespace acid
 			barrier0.subresourceRange.levelCount = 1;
 			barrier0.subresourceRange.baseArrayLayer = baseArrayLayer;
 			barrier0.subresourceRange.layerCount = layerCount;
-			vkCmdPipelineBarrier(commandBuffer.GetCommandBuffer(), VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier0);
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier0);
 
 			VkImageBlit imageBlit = {};
 			imageBlit.srcOffsets[0] = {0, 0, 0};
@@ -524,7 +535,7 @@ namespace acid
 			imageBlit.dstSubresource.mipLevel = i;
 			imageBlit.dstSubresource.baseArrayLayer = baseArrayLayer;
 			imageBlit.dstSubresource.layerCount = layerCount;
-			vkCmdBlitImage(commandBuffer.GetCommandBuffer(), image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &imageBlit, VK_FILTER_LINEAR);
+			vkCmdBlitImage(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &imageBlit, VK_FILTER_LINEAR);
 
 			VkImageMemoryBarrier barrier1 = {};
 			barrier1.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
@@ -540,7 +551,7 @@ namespace acid
 			barrier1.subresourceRange.levelCount = 1;
 			barrier1.subresourceRange.baseArrayLayer = baseArrayLayer;
 			barrier1.subresourceRange.layerCount = layerCount;
-			vkCmdPipelineBarrier(commandBuffer.GetCommandBuffer(), VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier1);
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier1);
 
 			if (mipWidth > 1)
 			{
@@ -567,10 +578,7 @@ namespace acid
 		barrier.subresourceRange.levelCount = 1;
 		barrier.subresourceRange.baseArrayLayer = baseArrayLayer;
 		barrier.subresourceRange.layerCount = layerCount;
-		vkCmdPipelineBarrier(commandBuffer.GetCommandBuffer(), VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
-
-		commandBuffer.End();
-		commandBuffer.SubmitIdle();
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
 	}
 
 	void Texture::CreateImageSampler(VkSampler &sampler, const VkFilter &filter, const VkSamplerAddressMode &addressMode, const bool &anisotropic, const uint32_t &mipLevels)
@@ -623,7 +631,7 @@ namespace acid
 		Renderer::CheckVk(vkCreateImageView(logicalDevice->GetLogicalDevice(), &imageViewCreateInfo, nullptr, &imageView));
 	}
 
-	bool Texture::CopyImage(const VkImage &srcImage, VkImage &dstImage, VkDeviceMemory &dstImageMemory, const uint32_t &width, const uint32_t &height, const bool &srcSwapchain, const uint32_t &baseArrayLayer, const uint32_t &layerCount)
+	bool Texture::CopyImage(const VkImage &srcImage, VkImage &dstImage, MemoryAllocation &dstImageMemory, const uint32_t &width, const uint32_t &height, const bool &srcSwapchain, const uint32_t &baseArrayLayer, const uint32_t &layerCount)
 	{
 		auto physicalDevice = Renderer::Get()->GetPhysicalDevice();
 		auto surface = Renderer::Get()->GetSurface();
@@ -3,7 +3,9 @@
 #include <string>
 #include <vector>
 #include <vulkan/vulkan.h>
+#include "Renderer/Commands/UploadQueue.hpp"
 #include "Renderer/Descriptors/Descriptor.hpp"
+#include "Renderer/Memory/MemoryAllocator.hpp"
 #include "Resources/Resource.hpp"
 
 namespace acid
@@ -77,6 +79,8 @@ namespace acid
 
 		void Encode(Metadata &metadata) const override;
 
+		std::size_t GetByteSize() const override;
+
 		/// <summary>
 		/// Gets a copy of the textures pixels from memory, after usage is finished remember to delete the result.
 		/// </summary>
@@ -113,12 +117,18 @@ namespace acid
 
 		const VkImage &GetImage() { return m_image; }
 
-		const VkDeviceMemory &GetDMemory() { return m_memory; }
+		const VkDeviceMemory &GetDMemory() { return m_memory.GetMemory(); }
 
 		const VkImageView &GetView() const { return m_view; }
 
 		const VkSampler &GetSampler() const { return m_sampler; }
 
+		/// <summary>
+		/// Gets if the pixels and layout of the image have been submitted to the device, until then the texture should not be drawn with.
+		/// </summary>
+		/// <returns> If the image is ready to be used in a frame. </returns>
+		bool IsLoaded() const;
+
 		static uint8_t *LoadPixels(const std::string &filename, uint32_t *width, uint32_t *height, uint32_t *components);
 
 		static uint8_t *LoadPixels(const std::string &filename, const std::string &fileSuffix, const std::vector<std::string> &fileSides, uint32_t *width, uint32_t *height, uint32_t *components);
@@ -141,7 +151,7 @@ namespace acid
 		/// <returns> If this has a stencil component. </returns>
 		static bool HasStencil(const VkFormat &format);
 
-		static void CreateImage(VkImage &image, VkDeviceMemory &memory, const uint32_t &width, const uint32_t &height, const VkImageType &type, const VkSampleCountFlagBits &samples, 
+		static void CreateImage(VkImage &image, MemoryAllocation &memory, const uint32_t &width, const uint32_t &height, const VkImageType &type, const VkSampleCountFlagBits &samples, 
 			const uint32_t &mipLevels, const VkFormat &format, const VkImageTiling &tiling, const VkImageUsageFlags &usage, const VkMemoryPropertyFlags &properties, const uint32_t &arrayLayers);
 
 		static bool HasStencilComponent(const VkFormat &format);
@@ -149,19 +159,25 @@ namespace acid
 		static void TransitionImageLayout(const VkImage &image, const VkFormat &format, const VkImageLayout &srcImageLayout, const VkImageLayout &dstImageLayout, 
 			const VkImageAspectFlags &aspectMask, const uint32_t &mipLevels, const uint32_t &baseArrayLayer, const uint32_t &layerCount);
 
+		static void TransitionImageLayout(const VkCommandBuffer &commandBuffer, const VkImage &image, const VkFormat &format, const VkImageLayout &srcImageLayout, 
+			const VkImageLayout &dstImageLayout, const VkImageAspectFlags &aspectMask, const uint32_t &mipLevels, const uint32_t &baseArrayLayer, const uint32_t &layerCount);
+
 		static void CopyBufferToImage(const VkBuffer &buffer, const VkImage &image, const uint32_t &width, const uint32_t &height, 
 			const uint32_t &baseArrayLayer, const uint32_t &layerCount);
 
 		static void CreateMipmaps(const VkImage &image, const uint32_t &width, const uint32_t &height, const VkImageLayout &dstImageLayout, 
 			const uint32_t &mipLevels, const uint32_t &baseArrayLayer, const uint32_t &layerCount);
 
+		static void CreateMipmaps(const VkCommandBuffer &commandBuffer, const VkImage &image, const uint32_t &width, const uint32_t &height, 
+			const VkImageLayout &dstImageLayout, const uint32_t &mipLevels, const uint32_t &baseArrayLayer, const uint32_t &layerCount);
+
 		static void CreateImageSampler(VkSampler &sampler, const VkFilter &filter, const VkSamplerAddressMode &addressMode, const bool &anisotropic,
 			const uint32_t &mipLevels);
 
 		static void CreateImageView(const VkImage &image, VkImageView &imageView, const VkImageViewType &type, const VkFormat &format, 
 			const VkImageAspectFlags &imageAspect, const uint32_t &mipLevels, const uint32_t &baseArrayLayer, const uint32_t &layerCount);
 
-		static bool CopyImage(const VkImage &srcImage, VkImage &dstImage, VkDeviceMemory &dstImageMemory, const uint32_t &width, const uint32_t &height, const bool &srcSwapchain, const uint32_t &baseArrayLayer, const uint32_t &layerCount);
+		static bool CopyImage(const VkImage &srcImage, VkImage &dstImage, MemoryAllocation &dstImageMemory, const uint32_t &width, const uint32_t &height, const bool &srcSwapchain, const uint32_t &baseArrayLayer, const uint32_t &layerCount);
 
 		static void InsertImageMemoryBarrier(const VkCommandBuffer &cmdbuffer, const VkImage &image, const VkAccessFlags &srcAccessMask, 
 			const VkAccessFlags &dstAccessMask, const VkImageLayout &oldImageLayout, const VkImageLayout &newImageLayout, const VkPipelineStageFlags &srcStageMask, 
@@ -182,9 +198,10 @@ namespace acid
 		uint8_t *m_pixels;
 
 		VkImage m_image;
-		VkDeviceMemory m_memory;
+		MemoryAllocation m_memory;
 		VkImageView m_view;
 		VkSampler m_sampler;
 		VkFormat m_format;
+		UploadQueue::Ticket m_upload;
 	};
 }
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "Helpers/NonCopyable.hpp"
+
+namespace acid
+{
+	class JobCounter;
+
+	/// <summary>
+	/// A function run by the job system. Functions that fit are stored in place, so scheduling a lambda with a few captures does not allocate.
+	/// Larger functions are moved onto the heap.
+	/// </summary>
+	class alignas(64) Job :
+		public NonCopyable
+	{
+	public:
+		/// <summary>
+		/// The largest function stored in place, a job with its counter takes up one cache line.
+		/// </summary>
+		static const std::size_t StorageSize = 40;
+
+		Job() :
+			m_invoke(nullptr),
+			m_counter(nullptr),
+			m_free(true)
+		{
+		}
+
+		/// <summary>
+		/// Stores a function in the job.
+		/// </summary>
+		/// <param name="function"> The function to run. </param>
+		/// <param name="counter"> The counter decremented once the function has run, or nullptr. </param>
+		template<typename F>
+		void Set(F &&function, JobCounter *counter)
+		{
+			using T = std::decay_t<F>;
+
+			if constexpr (sizeof(T) <= StorageSize && alignof(T) <= alignof(void *))
+			{
+				new(&m_storage) T(std::forward<F>(function));
+				m_invoke = [](void *storage)
+				{
+					auto stored = static_cast<T *>(storage);
+					(*stored)();
+					stored->~T();
+				};
+			}
+			else
+			{
+				new(&m_storage) T *(new T(std::forward<F>(function)));
+				m_invoke = [](void *storage)
+				{
+					auto stored = *static_cast<T **>(storage);
+					(*stored)();
+					delete stored;
+				};
+			}
+
+			m_counter = counter;
+		}
+
+		/// <summary>
+		/// Runs and destroys the stored function.
+		/// </summary>
+		void Run()
+		{
+			m_invoke(&m_storage);
+			m_invoke = nullptr;
+		}
+
+		JobCounter *GetCounter() const { return m_counter; }
+
+		/// <summary>
+		/// Gets if the job is not scheduled, and can be given a new function.
+		/// </summary>
+		/// <returns> If the job is free. </returns>
+		bool IsFree() const { return m_free.load(std::memory_order_acquire); }
+
+		void SetFree(const bool &free) { m_free.store(free, std::memory_order_release); }
+	private:
+		std::aligned_storage_t<StorageSize, alignof(void *)> m_storage;
+		void (*m_invoke)(void *storage);
+		JobCounter *m_counter;
+		std::atomic<bool> m_free;
+	};
+}
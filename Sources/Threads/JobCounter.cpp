@@ -0,0 +1,71 @@
+#include "JobCounter.hpp"
+
+#include "JobSystem.hpp"
+
+namespace acid
+{
+	JobCounter::JobCounter() :
+		m_count(0)
+	{
+	}
+
+	bool JobCounter::IsDone() const
+	{
+		if (m_count.load() != 0)
+		{
+			return false;
+		}
+
+		// The last decrement holds the lock while it reaches zero.
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_count.load() == 0;
+	}
+
+	void JobCounter::Increment()
+	{
+		m_count.fetch_add(1);
+	}
+
+	void JobCounter::Decrement()
+	{
+		auto count = m_count.load();
+
+		// While other jobs are counted the counter cannot reach zero, so the lock is not needed.
+		while (count > 1)
+		{
+			if (m_count.compare_exchange_weak(count, count - 1))
+			{
+				return;
+			}
+		}
+
+		std::vector<std::pair<JobSystem *, Job *>> dependents;
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			if (m_count.fetch_sub(1) == 1)
+			{
+				dependents.swap(m_dependents);
+			}
+		}
+
+		for (const auto &[jobSystem, job] : dependents)
+		{
+			jobSystem->Schedule(job);
+		}
+	}
+
+	bool JobCounter::AddDependent(JobSystem *jobSystem, Job *job)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (m_count.load() == 0)
+		{
+			return false;
+		}
+
+		m_dependents.emplace_back(jobSystem, job);
+		return true;
+	}
+}
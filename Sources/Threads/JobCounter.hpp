@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "Engine/Exports.hpp"
+#include "Helpers/NonCopyable.hpp"
+
+namespace acid
+{
+	class Job;
+	class JobSystem;
+
+	/// <summary>
+	/// Counts the jobs left in a group of jobs, jobs can be waited on with <seealso cref="JobSystem#Wait()"/> or made to depend on a counter.
+	/// Jobs that depend on a counter are held by it and scheduled once it reaches zero.
+	/// A counter must outlive the jobs it counts and the jobs that depend on it.
+	/// </summary>
+	class ACID_EXPORT JobCounter :
+		public NonCopyable
+	{
+	public:
+		JobCounter();
+
+		/// <summary>
+		/// Gets if every job counted has finished.
+		/// </summary>
+		/// <returns> If the counter is zero. </returns>
+		bool IsDone() const;
+	private:
+		friend class JobSystem;
+
+		void Increment();
+
+		/// <summary>
+		/// Decrements the counter after a job has finished, the jobs depending on the counter are scheduled when it reaches zero.
+		/// </summary>
+		void Decrement();
+
+		/// <summary>
+		/// Holds a job until the counter reaches zero.
+		/// </summary>
+		/// <returns> If the job was held, false if the counter is already zero and the job can run now. </returns>
+		bool AddDependent(JobSystem *jobSystem, Job *job);
+
+		std::atomic<int32_t> m_count;
+		// Taken when the counter reaches zero, so a waiter that sees zero cannot destroy the counter while it is still being used.
+		mutable std::mutex m_mutex;
+		std::vector<std::pair<JobSystem *, Job *>> m_dependents;
+	};
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include "Helpers/NonCopyable.hpp"
+#include "Job.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// A bounded lock free work stealing deque of jobs, from Chase and Lev.
+	/// The worker that owns the deque pushes and pops at the bottom, any other thread steals from the top.
+	/// </summary>
+	class JobDeque :
+		public NonCopyable
+	{
+	public:
+		static const int64_t Capacity = 1024;
+
+		JobDeque() :
+			m_top(0),
+			m_bottom(0),
+			m_jobs()
+		{
+		}
+
+		/// <summary>
+		/// Pushes a job onto the bottom of the deque, only called by the owner.
+		/// </summary>
+		/// <param name="job"> The job to push. </param>
+		/// <returns> If the job was pushed, false if the deque is full. </returns>
+		bool Push(Job *job)
+		{
+			auto bottom = m_bottom.load(std::memory_order_relaxed);
+			auto top = m_top.load(std::memory_order_acquire);
+
+			if (bottom - top >= Capacity)
+			{
+				return false;
+			}
+
+			m_jobs[bottom & (Capacity - 1)].store(job, std::memory_order_release);
+			m_bottom.store(bottom + 1);
+			return true;
+		}
+
+		/// <summary>
+		/// Pops the last pushed job from the bottom of the deque, only called by the owner.
+		/// </summary>
+		/// <returns> The job, or nullptr if the deque is empty. </returns>
+		Job *Pop()
+		{
+			auto bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+			m_bottom.store(bottom);
+			auto top = m_top.load();
+
+			if (top > bottom)
+			{
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			auto job = m_jobs[bottom & (Capacity - 1)].load(std::memory_order_acquire);
+
+			// The last job may be stolen at the same time, whoever moves the top first takes it.
+			if (top == bottom)
+			{
+				if (!m_top.compare_exchange_strong(top, top + 1))
+				{
+					job = nullptr;
+				}
+
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+
+			return job;
+		}
+
+		/// <summary>
+		/// Steals the first pushed job from the top of the deque, called by any thread.
+		/// </summary>
+		/// <returns> The job, or nullptr if the deque is empty or another thread took the job first. </returns>
+		Job *Steal()
+		{
+			auto top = m_top.load();
+			auto bottom = m_bottom.load();
+
+			if (top >= bottom)
+			{
+				return nullptr;
+			}
+
+			auto job = m_jobs[top & (Capacity - 1)].load(std::memory_order_acquire);
+
+			if (!m_top.compare_exchange_strong(top, top + 1))
+			{
+				return nullptr;
+			}
+
+			return job;
+		}
+
+		bool IsEmpty() const { return m_top.load() >= m_bottom.load(); }
+	private:
+		// The top is stolen from by other threads, so it is kept on a different cache line to the bottom.
+		alignas(64) std::atomic<int64_t> m_top;
+		alignas(64) std::atomic<int64_t> m_bottom;
+		alignas(64) std::array<std::atomic<Job *>, Capacity> m_jobs;
+	};
+}
@@ -0,0 +1,216 @@
+#include "JobSystem.hpp"
+
+namespace acid
+{
+	const uint32_t JobSystem::HardwareConcurrency = std::max(std::thread::hardware_concurrency(), 1u);
+	const uint32_t JobSystem::DefaultWorkerCount = HardwareConcurrency - 1;
+
+	// The jobs in the pool of each thread, must be a power of two.
+	static const uint32_t JOBS_PER_THREAD = 1024;
+	// The times a worker looks for a job before it sleeps.
+	static const uint32_t SPIN_COUNT = 64;
+
+	// The job system and worker index of the calling thread, set on worker threads.
+	static thread_local JobSystem *CURRENT_JOB_SYSTEM = nullptr;
+	static thread_local int32_t CURRENT_WORKER_INDEX = -1;
+
+	JobSystem::JobSystem(const uint32_t &workerCount) :
+		m_injectedCount(0),
+		m_pending(0),
+		m_sleeping(0),
+		m_destroying(false)
+	{
+		for (uint32_t i = 0; i < workerCount; i++)
+		{
+			m_workers.emplace_back(std::make_unique<Worker>());
+		}
+
+		// Workers steal from each other, so they are started once every deque exists.
+		for (uint32_t i = 0; i < workerCount; i++)
+		{
+			m_workers[i]->m_thread = std::thread(&JobSystem::WorkerLoop, this, static_cast<int32_t>(i));
+		}
+	}
+
+	JobSystem::~JobSystem()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_sleepMutex);
+			m_destroying = true;
+		}
+
+		m_sleepCondition.notify_all();
+
+		for (auto &worker : m_workers)
+		{
+			worker->m_thread.join();
+		}
+	}
+
+	JobSystem *JobSystem::Get()
+	{
+		static JobSystem jobSystem;
+		return &jobSystem;
+	}
+
+	void JobSystem::Wait(const JobCounter &counter)
+	{
+		auto workerIndex = GetWorkerIndex();
+
+		while (!counter.IsDone())
+		{
+			if (auto job = Find(workerIndex); job != nullptr)
+			{
+				Execute(job);
+				continue;
+			}
+
+			std::this_thread::yield();
+		}
+	}
+
+	Job *JobSystem::Allocate()
+	{
+		static thread_local std::unique_ptr<Job[]> jobs;
+		static thread_local uint32_t next = 0;
+
+		if (jobs == nullptr)
+		{
+			jobs = std::make_unique<Job[]>(JOBS_PER_THREAD);
+		}
+
+		// Jobs usually finish in the order they were scheduled, so the next job in the ring is almost always free.
+		for (uint32_t i = 0; i < JOBS_PER_THREAD; i++)
+		{
+			auto job = &jobs[next++ & (JOBS_PER_THREAD - 1)];
+
+			if (job->IsFree())
+			{
+				job->SetFree(false);
+				return job;
+			}
+		}
+
+		return nullptr;
+	}
+
+	int32_t JobSystem::GetWorkerIndex() const
+	{
+		return CURRENT_JOB_SYSTEM == this ? CURRENT_WORKER_INDEX : -1;
+	}
+
+	void JobSystem::Schedule(Job *job)
+	{
+		auto workerIndex = GetWorkerIndex();
+
+		if (workerIndex == -1 || !m_workers[workerIndex]->m_deque.Push(job))
+		{
+			std::lock_guard<std::mutex> lock(m_injectedMutex);
+			m_injected.emplace_back(job);
+			m_injectedCount++;
+		}
+
+		// A worker going to sleep counts itself before it checks for jobs, so either it sees this job or it is woken.
+		m_pending++;
+
+		if (m_sleeping.load() > 0)
+		{
+			std::lock_guard<std::mutex> lock(m_sleepMutex);
+			m_sleepCondition.notify_one();
+		}
+	}
+
+	Job *JobSystem::Find(const int32_t &workerIndex)
+	{
+		Job *job = nullptr;
+
+		if (workerIndex != -1)
+		{
+			job = m_workers[workerIndex]->m_deque.Pop();
+		}
+
+		if (job == nullptr && m_injectedCount.load() > 0)
+		{
+			std::lock_guard<std::mutex> lock(m_injectedMutex);
+
+			if (!m_injected.empty())
+			{
+				job = m_injected.front();
+				m_injected.pop_front();
+				m_injectedCount--;
+			}
+		}
+
+		// Steals from the workers after this one, so thieves spread out over the workers.
+		auto workerCount = static_cast<int32_t>(m_workers.size());
+
+		for (int32_t i = 1; job == nullptr && i <= workerCount; i++)
+		{
+			auto victim = (workerIndex + i) % workerCount;
+
+			if (victim != workerIndex)
+			{
+				job = m_workers[victim]->m_deque.Steal();
+			}
+		}
+
+		if (job != nullptr)
+		{
+			m_pending--;
+		}
+
+		return job;
+	}
+
+	void JobSystem::Execute(Job *job)
+	{
+		auto counter = job->GetCounter();
+		job->Run();
+		job->SetFree(true);
+
+		if (counter != nullptr)
+		{
+			counter->Decrement();
+		}
+	}
+
+	void JobSystem::WorkerLoop(const int32_t &workerIndex)
+	{
+		CURRENT_JOB_SYSTEM = this;
+		CURRENT_WORKER_INDEX = workerIndex;
+
+		while (true)
+		{
+			Job *job = nullptr;
+
+			for (uint32_t i = 0; job == nullptr && i < SPIN_COUNT; i++)
+			{
+				job = Find(workerIndex);
+
+				if (job == nullptr)
+				{
+					std::this_thread::yield();
+				}
+			}
+
+			if (job != nullptr)
+			{
+				Execute(job);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(m_sleepMutex);
+			m_sleeping++;
+			m_sleepCondition.wait(lock, [this]()
+			{
+				return m_pending.load() > 0 || m_destroying;
+			});
+			m_sleeping--;
+
+			if (m_destroying && m_pending.load() <= 0)
+			{
+				break;
+			}
+		}
+	}
+}
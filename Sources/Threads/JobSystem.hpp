@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Job.hpp"
+#include "JobCounter.hpp"
+#include "JobDeque.hpp"
+
+namespace acid
+{
+	/// <summary>
+	/// Runs jobs on a set of worker threads, each worker has a lock free deque it pushes its own jobs to and idle workers steal from.
+	/// Jobs scheduled from other threads go into a shared queue. A thread waiting on a counter runs jobs until the counter is done,
+	/// so jobs can schedule and wait on jobs of their own. Jobs are taken from a pool owned by the scheduling thread,
+	/// a thread must wait for the jobs it scheduled before it exits.
+	/// </summary>
+	class ACID_EXPORT JobSystem :
+		public NonCopyable
+	{
+	public:
+		/// <summary>
+		/// Creates a new job system and starts its workers.
+		/// </summary>
+		/// <param name="workerCount"> The number of worker threads, the thread waiting on jobs also runs them so one less than the cores is used by default. </param>
+		explicit JobSystem(const uint32_t &workerCount = DefaultWorkerCount);
+
+		~JobSystem();
+
+		/// <summary>
+		/// Gets the job system shared by the engine, it is created the first time it is used.
+		/// </summary>
+		/// <returns> The shared job system. </returns>
+		static JobSystem *Get();
+
+		/// <summary>
+		/// Schedules a function to run on the job system.
+		/// </summary>
+		/// <param name="function"> The function to run. </param>
+		/// <param name="counter"> The counter to count the job with, or nullptr. </param>
+		/// <param name="dependency"> A counter that must be done before the job starts, or nullptr. </param>
+		template<typename F>
+		void Run(F &&function, JobCounter *counter = nullptr, JobCounter *dependency = nullptr)
+		{
+			if (counter != nullptr)
+			{
+				counter->Increment();
+			}
+
+			auto job = Allocate();
+
+			// Every job in the pool of this thread is scheduled, so the function is run now.
+			if (job == nullptr)
+			{
+				if (dependency != nullptr)
+				{
+					Wait(*dependency);
+				}
+
+				function();
+
+				if (counter != nullptr)
+				{
+					counter->Decrement();
+				}
+
+				return;
+			}
+
+			job->Set(std::forward<F>(function), counter);
+
+			if (dependency == nullptr || !dependency->AddDependent(this, job))
+			{
+				Schedule(job);
+			}
+		}
+
+		/// <summary>
+		/// Calls a function over ranges of a loop on the job system and waits for them, the calling thread runs the first range.
+		/// </summary>
+		/// <param name="begin"> The first index of the loop. </param>
+		/// <param name="end"> The index after the last index of the loop. </param>
+		/// <param name="grainSize"> The fewest indices in a range, a loop smaller than twice this runs on the calling thread. </param>
+		/// <param name="function"> The function called with the begin and end index of each range. </param>
+		template<typename F>
+		void ParallelFor(const std::size_t &begin, const std::size_t &end, const std::size_t &grainSize, const F &function)
+		{
+			if (end <= begin)
+			{
+				return;
+			}
+
+			auto count = end - begin;
+			auto grain = std::max<std::size_t>(grainSize, 1);
+			// A few ranges for each thread, so threads that finish early steal the ranges of the others.
+			auto rangeCount = std::min(count / grain, static_cast<std::size_t>(GetThreadCount()) * RangesPerThread);
+
+			if (rangeCount <= 1)
+			{
+				function(begin, end);
+				return;
+			}
+
+			auto rangeSize = (count + rangeCount - 1) / rangeCount;
+			JobCounter counter;
+
+			for (auto rangeBegin = begin + rangeSize; rangeBegin < end; rangeBegin += rangeSize)
+			{
+				auto rangeEnd = std::min(end, rangeBegin + rangeSize);
+				Run([&function, rangeBegin, rangeEnd]()
+				{
+					function(rangeBegin, rangeEnd);
+				}, &counter);
+			}
+
+			function(begin, begin + rangeSize);
+			Wait(counter);
+		}
+
+		/// <summary>
+		/// Runs jobs on this thread until every job counted by a counter has finished.
+		/// </summary>
+		/// <param name="counter"> The counter to wait on. </param>
+		void Wait(const JobCounter &counter);
+
+		/// <summary>
+		/// Gets the number of worker threads.
+		/// </summary>
+		/// <returns> The worker count. </returns>
+		uint32_t GetWorkerCount() const { return static_cast<uint32_t>(m_workers.size()); }
+
+		/// <summary>
+		/// Gets the number of threads that run jobs while a thread waits, the workers and the waiting thread.
+		/// </summary>
+		/// <returns> The thread count. </returns>
+		uint32_t GetThreadCount() const { return GetWorkerCount() + 1; }
+
+		static const uint32_t HardwareConcurrency;
+		static const uint32_t DefaultWorkerCount;
+	private:
+		friend class JobCounter;
+
+		struct Worker
+		{
+			JobDeque m_deque;
+			std::thread m_thread;
+		};
+
+		// The ranges a parallel for is split into for each thread.
+		static const std::size_t RangesPerThread = 4;
+
+		/// <summary>
+		/// Takes a free job from the pool of the calling thread.
+		/// </summary>
+		/// <returns> The job, or nullptr if every job in the pool is scheduled. </returns>
+		static Job *Allocate();
+
+		/// <summary>
+		/// Gets the index of the calling thread in the workers.
+		/// </summary>
+		/// <returns> The worker index, or -1 if the calling thread is not a worker of this system. </returns>
+		int32_t GetWorkerIndex() const;
+
+		void Schedule(Job *job);
+
+		Job *Find(const int32_t &workerIndex);
+
+		void Execute(Job *job);
+
+		void WorkerLoop(const int32_t &workerIndex);
+
+		std::vector<std::unique_ptr<Worker>> m_workers;
+
+		std::mutex m_injectedMutex;
+		std::deque<Job *> m_injected;
+		std::atomic<int32_t> m_injectedCount;
+
+		// Jobs scheduled but not yet taken, workers sleep while there are none.
+		std::atomic<int32_t> m_pending;
+		std::atomic<int32_t> m_sleeping;
+		std::mutex m_sleepMutex;
+		std::condition_variable m_sleepCondition;
+		bool m_destroying;
+	};
+}
@@ -202,6 +202,11 @@ namespace test
 
 					for (auto &component : entity->GetComponents())
 					{
+						if (component->IsRemoved())
+						{
+							continue;
+						}
+
 					//	if (component->IsFromPrefab())
 					//	{
 					//		continue;
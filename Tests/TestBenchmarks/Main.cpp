@@ -0,0 +1,1679 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <BulletCollision/CollisionShapes/btSphereShape.h>
+#include <BulletCollision/CollisionShapes/btStaticPlaneShape.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#include <BulletDynamics/Dynamics/btRigidBody.h>
+#include <Animations/Animator.hpp>
+#include <Engine/Log.hpp>
+#include <Files/FileSystem.hpp>
+#include <Helpers/String.hpp>
+#include <Maths/Culling.hpp>
+#include <Maths/Maths.hpp>
+#include <Models/Obj/ObjParser.hpp>
+#include <Particles/ParticleSorter.hpp>
+#include <Particles/ParticleStore.hpp>
+#include <Physics/Frustum.hpp>
+#include <Renderer/Memory/MemoryBlock.hpp>
+#include <Renderer/Pipelines/Shader.hpp>
+#include <Scenes/Archetypes/View.hpp>
+#include <Scenes/Entity.hpp>
+#include <Scenes/ScenePhysics.hpp>
+#include <Scenes/SceneStructure.hpp>
+#include <Scenes/SpatialTree.hpp>
+#include <Scenes/TransformHierarchy.hpp>
+#include <Serialized/Binary/Binary.hpp>
+#include <Serialized/Json/Json.hpp>
+#include <Serialized/Xml/Xml.hpp>
+#include <Serialized/Yaml/Yaml.hpp>
+#include <Threads/JobSystem.hpp>
+
+using namespace acid;
+
+/// <summary>
+/// Creates a random local-space joint transform.
+/// </summary>
+JointTransform RandomJointTransform()
+{
+	return JointTransform(Vector3(Maths::Random(-1.0f, 1.0f), Maths::Random(0.0f, 1.0f), Maths::Random(-1.0f, 1.0f)),
+		Quaternion(Maths::Random(-1.0f, 1.0f), Maths::Random(-1.0f, 1.0f), Maths::Random(-1.0f, 1.0f), Maths::Random(0.5f, 1.0f)).Normalize());
+}
+
+/// <summary>
+/// Creates a humanoid sized joint hierarchy, a root with four long limbs.
+/// </summary>
+JointData *CreateJoints(uint32_t &index, const uint32_t &depth)
+{
+	auto joint = new JointData(index, "Joint" + String::To(index), RandomJointTransform().GetLocalTransform());
+	index++;
+
+	for (uint32_t i = 0; depth < 10 && i < (depth == 0 ? 4 : 1); i++)
+	{
+		joint->AddChild(CreateJoints(index, depth + 1));
+	}
+
+	return joint;
+}
+
+/// <summary>
+/// Moves a position by a velocity every update, the component version of the archetype benchmark.
+/// </summary>
+class Mover :
+	public Component
+{
+public:
+	explicit Mover(const Vector3 &velocity) :
+		m_velocity(velocity)
+	{
+	}
+
+	void Update() override
+	{
+		m_position += m_velocity * (1.0f / 60.0f);
+	}
+
+	Vector3 m_position;
+	Vector3 m_velocity;
+};
+
+struct Position
+{
+	Vector3 m_position;
+};
+
+struct Velocity
+{
+	Vector3 m_velocity;
+};
+
+/// <summary>
+/// Runs a function a number of times and gets the average time of each run in milliseconds.
+/// </summary>
+template<typename F>
+double Measure(const uint32_t &runs, F function)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+
+	for (uint32_t i = 0; i < runs; i++)
+	{
+		function();
+	}
+
+	auto end = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration<double, std::milli>(end - start).count() / runs;
+}
+
+/// <summary>
+/// Benchmarks updating and sorting particles, the parallel update must match the serial update.
+/// </summary>
+/// <returns> The number of checks that failed. </returns>
+uint32_t BenchmarkParticles()
+{
+	uint32_t failures = 0;
+
+	{
+		const uint32_t particleCount = 1000000;
+		const uint32_t frames = 120;
+
+		// Life lengths are long enough that every particle survives the benchmark.
+		ParticleStore particles;
+
+		for (uint32_t i = 0; i < particleCount; i++)
+		{
+			particles.Add(Particle(nullptr, Vector3(Maths::Random(-100.0f, 100.0f), Maths::Random(0.0f, 50.0f), Maths::Random(-100.0f, 100.0f)),
+				Vector3(Maths::Random(-1.0f, 1.0f), Maths::Random(0.0f, 5.0f), Maths::Random(-1.0f, 1.0f)), Maths::Random(10.0f, 20.0f),
+				1.0f, Maths::Random(0.0f, 360.0f), 1.0f, 0.5f));
+		}
+
+		ParticleStore::UpdateInfo info = {};
+		info.m_delta = 1.0f / 60.0f;
+		info.m_cameraPosition = Vector3(0.0f, 10.0f, 0.0f);
+		info.m_numberOfRows = 4;
+		info.m_textured = true;
+
+		auto jobSystem = JobSystem::Get();
+		auto serialParticles = particles;
+		auto serial = Measure(frames, [&]()
+		{
+			serialParticles.Update(info);
+		});
+		auto parallel = Measure(frames, [&]()
+		{
+			particles.Update(info, jobSystem);
+		});
+
+		// Chunks are split on whole vectors, so the parallel update gives exactly the serial results.
+		auto matches = particles.GetSize() == serialParticles.GetSize() && particles.GetTransparencies() == serialParticles.GetTransparencies() &&
+			particles.GetDistancesToCamera() == serialParticles.GetDistancesToCamera();
+
+		for (std::size_t i = 0; matches && i < particles.GetSize(); i++)
+		{
+			matches = particles.GetPosition(i) == serialParticles.GetPosition(i) && particles.GetVelocity(i) == serialParticles.GetVelocity(i);
+		}
+
+		Log::Out("Particles: %i live, %i threads\n", static_cast<int>(particles.GetSize()), static_cast<int>(jobSystem->GetThreadCount()));
+
+		if (!matches)
+		{
+			Log::Error("Particles: parallel update differs from the serial update\n");
+			failures++;
+		}
+
+		Log::Out("Particles Update Serial: %fms\n", serial);
+		Log::Out("Particles Update Parallel: %fms\n", parallel);
+		Log::Out("\n");
+	}
+
+	{
+		const uint32_t particleCount = 100000;
+		const uint32_t frames = 60;
+
+		std::vector<float> distances(particleCount);
+		std::vector<uint32_t> indices(particleCount);
+		std::iota(indices.begin(), indices.end(), 0);
+
+		for (auto &distance : distances)
+		{
+			distance = Maths::Random(0.0f, 10000.0f);
+		}
+
+		auto comparison = Measure(frames, [&]()
+		{
+			auto order = indices;
+			std::sort(order.begin(), order.end(), [&distances](const uint32_t &a, const uint32_t &b)
+			{
+				return distances[a] > distances[b];
+			});
+		});
+
+		ParticleSorter sorter;
+		auto radix = Measure(frames, [&]()
+		{
+			sorter.Reset();
+			sorter.Sort(distances, indices);
+		});
+		// The camera barely moves, so each sort starts from a nearly sorted order.
+		auto incremental = Measure(frames, [&]()
+		{
+			for (uint32_t i = 0; i < particleCount; i += 97)
+			{
+				distances[i] *= 1.001f;
+			}
+
+			sorter.Sort(distances, indices);
+		});
+
+		// Every index must be sorted once, back to front within the depth that one key covers.
+		auto nearDepth = std::sqrt(*std::min_element(distances.begin(), distances.end()));
+		auto farDepth = std::sqrt(*std::max_element(distances.begin(), distances.end()));
+		auto keyDepth = (farDepth - nearDepth) / std::numeric_limits<uint16_t>::max();
+		auto isSorted = [&](std::vector<uint32_t> order)
+		{
+			for (std::size_t i = 1; i < order.size(); i++)
+			{
+				if (std::sqrt(distances[order[i - 1]]) + keyDepth < std::sqrt(distances[order[i]]))
+				{
+					return false;
+				}
+			}
+
+			std::sort(order.begin(), order.end());
+			return order == indices;
+		};
+		auto incrementalSorted = isSorted(sorter.Sort(distances, indices));
+		sorter.Reset();
+		auto radixSorted = isSorted(sorter.Sort(distances, indices));
+
+		if (!incrementalSorted || !radixSorted)
+		{
+			Log::Error("Particles Sort: %s order is not back to front\n", radixSorted ? "incremental" : "radix");
+			failures++;
+		}
+
+		Log::Out("Particles Sort Comparison: %fms\n", comparison);
+		Log::Out("Particles Sort Radix: %fms\n", radix);
+		Log::Out("Particles Sort Incremental: %fms\n", incremental);
+		Log::Out("\n");
+	}
+
+	return failures;
+}
+
+/// <summary>
+/// Benchmarks updating animators serially, in parallel and while blending.
+/// </summary>
+void BenchmarkAnimations()
+{
+	const uint32_t characterCount = 1000;
+	const uint32_t keyframeCount = 60;
+	const uint32_t frames = 120;
+
+	uint32_t jointCount = 0;
+	std::unique_ptr<JointData> headJoint(CreateJoints(jointCount, 0));
+	std::vector<Keyframe> keyframes;
+
+	for (uint32_t i = 0; i < keyframeCount; i++)
+	{
+		std::map<std::string, JointTransform> pose;
+
+		for (uint32_t j = 0; j < jointCount; j++)
+		{
+			pose.emplace("Joint" + String::To(j), RandomJointTransform());
+		}
+
+		keyframes.emplace_back(Time::Seconds(i / 30.0f), pose);
+	}
+
+	// Every character shares the skeleton and clip, and starts at a different time in the clip.
+	Skeleton skeleton(*headJoint);
+	AnimationClip clip(Animation(Time::Seconds((keyframeCount - 1) / 30.0f), keyframes), skeleton);
+	std::vector<std::unique_ptr<Animator>> animators;
+
+	for (uint32_t i = 0; i < characterCount; i++)
+	{
+		auto animator = std::make_unique<Animator>(&skeleton);
+		animator->DoAnimation(&clip);
+		animator->Update(Time::Seconds(Maths::Random(0.0f, 2.0f)));
+		animators.emplace_back(std::move(animator));
+	}
+
+	auto update = Measure(frames, [&]()
+	{
+		for (auto &animator : animators)
+		{
+			animator->Update(Time::Seconds(1.0f / 60.0f));
+		}
+	});
+
+	// The same split as the animations module, each job updates a contiguous run of animators writing into one shared array.
+	std::vector<Matrix4> jointTransforms(characterCount * skeleton.GetTransformCount());
+
+	for (uint32_t i = 0; i < characterCount; i++)
+	{
+		animators[i]->SetJointTransforms(jointTransforms.data() + i * skeleton.GetTransformCount());
+	}
+
+	auto parallelUpdate = [&]()
+	{
+		JobSystem::Get()->ParallelFor(0, animators.size(), 16, [&animators](const std::size_t &begin, const std::size_t &end)
+		{
+			for (auto i = begin; i < end; i++)
+			{
+				animators[i]->Update(Time::Seconds(1.0f / 60.0f));
+			}
+		});
+	};
+	auto parallel = Measure(frames, parallelUpdate);
+
+	// Every character is fading into the clip again, with the clip layered on top as a additive animation.
+	for (auto &animator : animators)
+	{
+		animator->CrossFade(&clip, Time::Seconds(100.0f));
+		animator->SetAdditive(&clip, 0.5f);
+	}
+
+	auto blended = Measure(frames, parallelUpdate);
+
+	Log::Out("Animations: %i characters, %i joints\n", characterCount, jointCount);
+	Log::Out("Animations Update Serial: %fms\n", update);
+	Log::Out("Animations Update Parallel: %fms\n", parallel);
+	Log::Out("Animations Update Parallel Blended: %fms\n", blended);
+	Log::Out("\n");
+}
+
+/// <summary>
+/// Benchmarks moving entities through components and through archetype views.
+/// </summary>
+void BenchmarkEntities()
+{
+	const uint32_t entityCount = 100000;
+	const uint32_t frames = 60;
+
+	std::vector<std::unique_ptr<Entity>> entities;
+	ArchetypeStorage storage;
+
+	for (uint32_t i = 0; i < entityCount; i++)
+	{
+		Vector3 velocity = Vector3(Maths::Random(-1.0f, 1.0f), Maths::Random(-1.0f, 1.0f), Maths::Random(-1.0f, 1.0f));
+		auto entity = std::make_unique<Entity>(Transform::Identity);
+		entity->AddComponent<Mover>(velocity);
+		entities.emplace_back(std::move(entity));
+		storage.Create(Position{Vector3::Zero}, Velocity{velocity});
+	}
+
+	auto components = Measure(frames, [&]()
+	{
+		for (auto &entity : entities)
+		{
+			entity->Update();
+		}
+	});
+	auto query = Measure(frames, [&]()
+	{
+		for (auto &entity : entities)
+		{
+			auto mover = entity->GetComponent<Mover>();
+			mover->m_position += mover->m_velocity * (1.0f / 60.0f);
+		}
+	});
+	View<Position, const Velocity> view(&storage);
+	auto archetypes = Measure(frames, [&]()
+	{
+		view.EachChunk([](const uint32_t &count, const EntityId *entities, Position *positions, const Velocity *velocities)
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				positions[i].m_position += velocities[i].m_velocity * (1.0f / 60.0f);
+			}
+		});
+	});
+
+	Log::Out("Entities: %i\n", entityCount);
+	Log::Out("Entities Component Update: %fms\n", components);
+	Log::Out("Entities Component Query: %fms\n", query);
+	Log::Out("Entities Archetype View: %fms\n", archetypes);
+	Log::Out("\n");
+}
+
+/// <summary>
+/// Benchmarks parsing a large OBJ file serially and in parallel chunks.
+/// </summary>
+void BenchmarkObj()
+{
+	const uint32_t gridSize = 500;
+	const uint32_t runs = 5;
+
+	// A grid with a position, uv and normal for each point and two triangles for each cell, shared corners are merged by the parser.
+	std::string text;
+
+	for (uint32_t y = 0; y <= gridSize; y++)
+	{
+		for (uint32_t x = 0; x <= gridSize; x++)
+		{
+			text += "v " + String::To(x * 0.1f) + " " + String::To(Maths::Random(-1.0f, 1.0f)) + " " + String::To(y * 0.1f) + "\n";
+			text += "vt " + String::To(x / static_cast<float>(gridSize)) + " " + String::To(y / static_cast<float>(gridSize)) + "\n";
+			text += "vn 0 1 0\n";
+		}
+	}
+
+	for (uint32_t y = 0; y < gridSize; y++)
+	{
+		for (uint32_t x = 0; x < gridSize; x++)
+		{
+			auto a = String::To(y * (gridSize + 1) + x + 1);
+			auto b = String::To(y * (gridSize + 1) + x + 2);
+			auto c = String::To((y + 1) * (gridSize + 1) + x + 1);
+			auto d = String::To((y + 1) * (gridSize + 1) + x + 2);
+			text += "f " + a + "/" + a + "/" + a + " " + b + "/" + b + "/" + b + " " + d + "/" + d + "/" + d + "\n";
+			text += "f " + a + "/" + a + "/" + a + " " + d + "/" + d + "/" + d + " " + c + "/" + c + "/" + c + "\n";
+		}
+	}
+
+	std::vector<VertexModel> vertices;
+	std::vector<uint32_t> indices;
+	auto serial = Measure(runs, [&]()
+	{
+		ObjParser::Parse(text, vertices, indices);
+	});
+
+	auto parallel = Measure(runs, [&]()
+	{
+		ObjParser::Parse(text, vertices, indices, JobSystem::Get());
+	});
+
+	Log::Out("Obj: %iKB, %i vertices, %i triangles\n", static_cast<int>(text.size() / 1024), static_cast<int>(vertices.size()),
+		static_cast<int>(indices.size() / 3));
+	Log::Out("Obj Parse Serial: %fms\n", serial);
+	Log::Out("Obj Parse Parallel: %fms\n", parallel);
+	Log::Out("\n");
+}
+
+/// <summary>
+/// Checks valid Json documents load and malformed documents are rejected.
+/// </summary>
+/// <returns> The number of checks that failed. </returns>
+uint32_t TestJsonDocuments()
+{
+	// Each document is loaded and must either give a tree or be rejected with a error and leave the node empty.
+	const std::vector<std::pair<std::string, bool>> documents = {
+		{R"({"a": [1, 2], "b": {"c": "}]"}, "_d": "e"})", true},
+		{R"([{"a": 1}, {"b": 2}])", true},
+		{R"([0, -1.5, 2e10, 3.25E-2, true, false, null])", true},
+		{R"({"a": abc})", false},
+		{R"({"a": tru})", false},
+		{R"([01])", false},
+		{R"([1.])", false},
+		{R"([-])", false},
+		{R"([1e])", false},
+		{R"({"a":[1}})", false},
+		{R"({"a": {"b": 1]})", false},
+		{R"([1 2])", false},
+		{R"({"a": 1 "b": 2})", false},
+		{R"({"a" 1})", false},
+		{R"({"a": 1,})", false},
+		{R"({"a": })", false},
+		{R"({"a": 1} {"b": 2})", false},
+		{R"({"a": 1}])", false},
+		{R"({"a": [1, 2])", false}
+	};
+	uint32_t failures = 0;
+
+	for (const auto &[document, valid] : documents)
+	{
+		std::stringstream stream(document);
+		Json json;
+		json.Load(&stream);
+
+		if (json.GetChildren().empty() == valid)
+		{
+			Log::Error("Json: %s was %s\n", document.c_str(), valid ? "rejected" : "accepted");
+			failures++;
+		}
+	}
+
+	Log::Out("Json Documents: %i of %i loaded as expected\n", static_cast<int>(documents.size() - failures), static_cast<int>(documents.size()));
+	Log::Out("\n");
+	return failures;
+}
+
+/// <summary>
+/// Checks every text document in a directory loads the same after being written as a binary document and loaded back.
+/// </summary>
+/// <param name="directory"> The directory searched for Json, Yaml and Xml documents. </param>
+/// <returns> The number of checks that failed. </returns>
+uint32_t TestBinaryRoundTrips(const std::string &directory)
+{
+	if (!FileSystem::IsDirectory(directory))
+	{
+		Log::Error("Binary: directory '%s' does not exist\n", directory.c_str());
+		return 1;
+	}
+
+	const std::string binaryFilename = "BenchmarkRoundTrip" + Binary::Extension;
+	uint32_t documentCount = 0;
+	uint32_t failures = 0;
+
+	for (const auto &filename : FileSystem::FilesInPath(directory))
+	{
+		auto suffix = String::Lowercase(FileSystem::FileSuffix(filename));
+		std::unique_ptr<Metadata> text;
+
+		if (suffix == ".json")
+		{
+			text = std::make_unique<Json>();
+		}
+		else if (suffix == ".yaml" || suffix == ".yml")
+		{
+			text = std::make_unique<Yaml>();
+		}
+		else if (suffix == ".xml" || suffix == ".dae")
+		{
+			text = std::make_unique<Xml>("");
+		}
+		else
+		{
+			continue;
+		}
+
+		std::ifstream inStream(filename, std::ios::binary);
+		text->Load(&inStream);
+
+		{
+			std::ofstream outStream(binaryFilename, std::ios::binary);
+			Binary::Write(*text, &outStream);
+		}
+
+		// Baked documents are memory mapped by File::Read, other streams are read into a single buffer.
+		Binary mapped;
+		Binary streamed;
+		std::ifstream binaryStream(binaryFilename, std::ios::binary);
+		auto loaded = Binary::Load(&mapped, binaryFilename) && Binary::Load(&streamed, &binaryStream);
+
+		if (!loaded || text->GetChildren().empty() || mapped != *text || streamed != *text)
+		{
+			Log::Error("Binary: '%s' differs from its text load after a round trip\n", filename.c_str());
+			failures++;
+		}
+
+		documentCount++;
+	}
+
+	FileSystem::Delete(binaryFilename);
+
+	Log::Out("Binary Round Trips: %i of %i documents match their text loads\n", documentCount - failures, documentCount);
+	Log::Out("\n");
+	return failures;
+}
+
+/// <summary>
+/// Benchmarks converting numbers to and from strings.
+/// </summary>
+void BenchmarkString()
+{
+	const uint32_t valueCount = 1000000;
+	const uint32_t runs = 5;
+
+	std::vector<float> values(valueCount);
+	std::string text;
+
+	for (auto &value : values)
+	{
+		value = Maths::Random(-1000.0f, 1000.0f);
+		text += String::To(value) + " ";
+	}
+
+	// The stream versions are how String::From and String::To used to convert values.
+	auto streamFrom = Measure(runs, [&]()
+	{
+		for (const auto &token : String::Split(text, " "))
+		{
+			std::istringstream iss(token);
+			iss >> values[0];
+		}
+	});
+	auto charsFrom = Measure(runs, [&]()
+	{
+		for (const auto &token : String::Split(text, " "))
+		{
+			values[0] = String::From<float>(token);
+		}
+	});
+	auto charsFromList = Measure(runs, [&]()
+	{
+		values = String::FromList<float>(text);
+	});
+	auto streamTo = Measure(runs, [&]()
+	{
+		for (const auto &value : values)
+		{
+			std::to_string(value);
+		}
+	});
+	auto charsTo = Measure(runs, [&]()
+	{
+		for (const auto &value : values)
+		{
+			String::To(value);
+		}
+	});
+
+	Log::Out("String: %i floats, %iKB\n", valueCount, static_cast<int>(text.size() / 1024));
+	Log::Out("String From Stream: %fms\n", streamFrom);
+	Log::Out("String From Chars: %fms\n", charsFrom);
+	Log::Out("String From List: %fms\n", charsFromList);
+	Log::Out("String To Stream: %fms\n", streamTo);
+	Log::Out("String To Chars: %fms\n", charsTo);
+	Log::Out("\n");
+}
+
+/// <summary>
+/// Benchmarks compiling a shader stage with a cold and a warm cache.
+/// </summary>
+void BenchmarkShaderCache()
+{
+	const uint32_t runs = 10;
+	const std::string cacheDirectory = "BenchmarkCache";
+
+	// A fragment shader about the size of the deferred lighting shader.
+	std::string shaderCode = R"(#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+layout(binding = 0) uniform UniformScene
+{
+	mat4 projection;
+	mat4 view;
+	vec3 cameraPosition;
+	int lightsCount;
+	vec4 fogColour;
+	float fogDensity;
+	float fogGradient;
+} scene;
+
+struct Light
+{
+	vec4 colour;
+	vec3 position;
+	float radius;
+};
+
+layout(binding = 1) buffer BufferLights
+{
+	Light lights[];
+} bufferLights;
+
+layout(binding = 2) uniform sampler2D samplerPosition;
+layout(binding = 3) uniform sampler2D samplerDiffuse;
+layout(binding = 4) uniform sampler2D samplerNormal;
+layout(binding = 5) uniform sampler2D samplerMaterial;
+
+layout(location = 0) in vec2 inUv;
+
+layout(location = 0) out vec4 outColour;
+
+float attenuation(float distance, float radius)
+{
+	return clamp(1.0f - distance * distance / (radius * radius), 0.0f, 1.0f);
+}
+
+void main()
+{
+	vec3 worldPosition = texture(samplerPosition, inUv).rgb;
+	vec4 diffuse = texture(samplerDiffuse, inUv);
+	vec3 normal = normalize(texture(samplerNormal, inUv).rgb * 2.0f - 1.0f);
+	vec3 material = texture(samplerMaterial, inUv).rgb;
+	vec3 viewDirection = normalize(scene.cameraPosition - worldPosition);
+	vec3 colour = diffuse.rgb * 0.1f;
+
+	for (int i = 0; i < scene.lightsCount; i++)
+	{
+		Light light = bufferLights.lights[i];
+		vec3 lightDirection = light.position - worldPosition;
+		float distance = length(lightDirection);
+		lightDirection /= distance;
+		vec3 halfway = normalize(lightDirection + viewDirection);
+		float specular = pow(max(dot(normal, halfway), 0.0f), mix(8.0f, 128.0f, 1.0f - material.g)) * material.r;
+		colour += (diffuse.rgb * max(dot(normal, lightDirection), 0.0f) + specular) * light.colour.rgb * attenuation(distance, light.radius);
+	}
+
+	float fog = exp(-pow(length(scene.cameraPosition - worldPosition) * scene.fogDensity, scene.fogGradient));
+	outColour = vec4(mix(scene.fogColour.rgb, colour, clamp(fog, 0.0f, 1.0f)), 1.0f);
+}
+)";
+
+	// A cold start compiles with a empty cache and fills it, a warm start loads the stage and its reflection from the cache.
+	Shader::Compiler compiler;
+	auto previousCacheDirectory = Shader::GetCacheDirectory();
+	Shader::SetCacheDirectory(cacheDirectory);
+
+	auto clearCache = [&cacheDirectory]()
+	{
+		if (!FileSystem::IsDirectory(cacheDirectory))
+		{
+			return;
+		}
+
+		for (const auto &file : FileSystem::FilesInPath(cacheDirectory))
+		{
+			FileSystem::Delete(file);
+		}
+	};
+	auto cold = Measure(runs, [&]()
+	{
+		clearCache();
+		Shader shader("Benchmark.frag");
+		shader.CompileStage(shaderCode, VK_SHADER_STAGE_FRAGMENT_BIT);
+		shader.ProcessShader();
+	});
+	auto warm = Measure(runs, [&]()
+	{
+		Shader shader("Benchmark.frag");
+		shader.CompileStage(shaderCode, VK_SHADER_STAGE_FRAGMENT_BIT);
+		shader.ProcessShader();
+	});
+
+	clearCache();
+	FileSystem::Delete(cacheDirectory);
+	Shader::SetCacheDirectory(previousCacheDirectory);
+
+	Log::Out("Shader Stage Cold: %fms\n", cold);
+	Log::Out("Shader Stage Warm: %fms\n", warm);
+	Log::Out("\n");
+}
+
+/// <summary>
+/// Benchmarks allocating and freeing ranges of a memory block.
+/// </summary>
+void BenchmarkMemoryBlock()
+{
+	const uint32_t allocationCount = 20000;
+	const uint32_t runs = 10;
+
+	// Buffer and texture sized ranges with their alignments, the block only keeps the books so it needs no device memory.
+	const VkDeviceSize alignments[] = {256, 4096, 65536};
+	std::vector<std::pair<VkDeviceSize, VkDeviceSize>> requests(allocationCount);
+
+	VkDeviceSize blockSize = 0;
+
+	for (auto &[size, alignment] : requests)
+	{
+		size = static_cast<VkDeviceSize>(Maths::Random(256.0f, 262144.0f));
+		alignment = alignments[static_cast<uint32_t>(Maths::Random(0.0f, 2.99f))];
+		blockSize += size + alignment;
+	}
+
+	// Room to spare, so the free ranges left by the churn are a large part of the free memory.
+	blockSize += blockSize / 2;
+
+	// Half of the ranges are freed in a random order and allocated again, like resources being streamed in and out.
+	std::vector<uint32_t> churn(allocationCount);
+	std::iota(churn.begin(), churn.end(), 0);
+	std::shuffle(churn.begin(), churn.end(), std::mt19937(1));
+	churn.resize(allocationCount / 2);
+
+	float fragmentation = 0.0f;
+	std::size_t freeRanges = 0;
+	auto churned = Measure(runs, [&]()
+	{
+		MemoryBlock block(VK_NULL_HANDLE, blockSize, 0);
+		std::vector<VkDeviceSize> offsets(allocationCount);
+
+		for (uint32_t i = 0; i < allocationCount; i++)
+		{
+			offsets[i] = *block.Allocate(requests[i].first, requests[i].second);
+		}
+
+		for (const auto &i : churn)
+		{
+			block.Free(offsets[i], requests[i].first);
+		}
+
+		for (const auto &i : churn)
+		{
+			offsets[i] = *block.Allocate(requests[i].first, requests[i].second);
+		}
+
+		auto freeBytes = block.GetSize() - block.GetUsed();
+		fragmentation = 1.0f - static_cast<float>(block.GetLargestFreeRange()) / static_cast<float>(freeBytes);
+		freeRanges = block.GetFreeRangeCount();
+
+		for (uint32_t i = 0; i < allocationCount; i++)
+		{
+			block.Free(offsets[i], requests[i].first);
+		}
+	});
+
+	auto operations = 3 * allocationCount;
+	Log::Out("Memory Block: %i allocations, %i churned\n", allocationCount, static_cast<int>(churn.size()));
+	Log::Out("Memory Block Allocate and Free: %fus per operation\n", 1000.0 * churned / operations);
+	Log::Out("Memory Block After Churn: %i free ranges, %f fragmentation\n", static_cast<int>(freeRanges), fragmentation);
+	Log::Out("\n");
+}
+
+/// <summary>
+/// Benchmarks stepping the physics world and batched physics queries.
+/// </summary>
+void BenchmarkPhysics()
+{
+	{
+		const uint32_t bodyGrid = 22;
+		const uint32_t frames = 120;
+
+		// Spheres dropped in a tall grid onto a plane, most of the run is spent colliding and solving the pile.
+		btSphereShape sphereShape(0.5f);
+		btStaticPlaneShape planeShape(btVector3(0.0f, 1.0f, 0.0f), 0.0f);
+		btVector3 sphereInertia;
+		sphereShape.calculateLocalInertia(1.0f, sphereInertia);
+
+		auto simulate = [&](const bool &multithreaded, uint32_t &bodyCount)
+		{
+			std::vector<std::unique_ptr<btRigidBody>> bodies;
+			double step;
+
+			{
+				ScenePhysics physics(multithreaded);
+				bodies.emplace_back(std::make_unique<btRigidBody>(0.0f, nullptr, &planeShape));
+				physics.GetDynamicsWorld()->addRigidBody(bodies.back().get());
+
+				for (uint32_t x = 0; x < bodyGrid; x++)
+				{
+					for (uint32_t y = 0; y < bodyGrid; y++)
+					{
+						for (uint32_t z = 0; z < bodyGrid; z++)
+						{
+							btRigidBody::btRigidBodyConstructionInfo info(1.0f, nullptr, &sphereShape, sphereInertia);
+							info.m_startWorldTransform.setOrigin(btVector3(x * 1.1f, 1.0f + y * 1.1f, z * 1.1f));
+							bodies.emplace_back(std::make_unique<btRigidBody>(info));
+							physics.GetDynamicsWorld()->addRigidBody(bodies.back().get());
+						}
+					}
+				}
+
+				bodyCount = static_cast<uint32_t>(bodies.size() - 1);
+				step = Measure(frames, [&]()
+				{
+					physics.Simulate(Time::Seconds(1.0f / 60.0f));
+				});
+			}
+
+			return step;
+		};
+
+		uint32_t bodyCount = 0;
+		auto serial = simulate(false, bodyCount);
+		auto multithreaded = simulate(true, bodyCount);
+
+		Log::Out("Physics: %i rigidbodies, %i threads\n", bodyCount, static_cast<int>(JobSystem::Get()->GetThreadCount()));
+		Log::Out("Physics Step Serial: %fms\n", serial);
+		Log::Out("Physics Step Multithreaded: %fms\n", multithreaded);
+		Log::Out("\n");
+	}
+
+	{
+		const uint32_t bodyGrid = 40;
+		const uint32_t queryCount = 100000;
+		const uint32_t runs = 5;
+
+		// A floor of static spheres, queries start above it and end below it so most of them hit.
+		btSphereShape sphereShape(0.5f);
+		std::vector<std::unique_ptr<btRigidBody>> bodies;
+		std::vector<RayQuery> rays(queryCount);
+		std::vector<SweepQuery> sweeps(queryCount);
+		std::vector<OverlapQuery> overlaps(queryCount);
+
+		for (uint32_t i = 0; i < queryCount; i++)
+		{
+			auto start = Vector3(Maths::Random(0.0f, bodyGrid * 1.5f), 10.0f, Maths::Random(0.0f, bodyGrid * 1.5f));
+			auto end = start + Vector3(Maths::Random(-2.0f, 2.0f), -20.0f, Maths::Random(-2.0f, 2.0f));
+			rays[i] = {start, end};
+			sweeps[i] = {start, end, 0.25f};
+			overlaps[i] = {Vector3(start.m_x, 0.0f, start.m_z), 1.0f};
+		}
+
+		QueryFilter allHits;
+		allHits.m_allHits = true;
+		allHits.m_maxHits = 8;
+
+		std::vector<QueryHit> hits(queryCount * allHits.GetHitStride());
+		std::vector<uint32_t> hitCounts(queryCount);
+		uint32_t overlapCount = 0;
+
+		double single, batched, batchedAllHits, sweep, overlap;
+
+		{
+			ScenePhysics physics;
+
+			for (uint32_t x = 0; x < bodyGrid; x++)
+			{
+				for (uint32_t z = 0; z < bodyGrid; z++)
+				{
+					btRigidBody::btRigidBodyConstructionInfo info(0.0f, nullptr, &sphereShape);
+					info.m_startWorldTransform.setOrigin(btVector3(x * 1.5f, 0.0f, z * 1.5f));
+					bodies.emplace_back(std::make_unique<btRigidBody>(info));
+					physics.GetDynamicsWorld()->addRigidBody(bodies.back().get());
+				}
+			}
+
+			single = Measure(runs, [&]()
+			{
+				for (const auto &ray : rays)
+				{
+					physics.Raytest(ray.m_start, ray.m_end);
+				}
+			});
+			batched = Measure(runs, [&]()
+			{
+				physics.Raytest(rays.data(), rays.size(), hits.data(), hitCounts.data());
+			});
+			batchedAllHits = Measure(runs, [&]()
+			{
+				physics.Raytest(rays.data(), rays.size(), hits.data(), hitCounts.data(), allHits);
+			});
+			sweep = Measure(runs, [&]()
+			{
+				physics.SphereSweep(sweeps.data(), sweeps.size(), hits.data(), hitCounts.data());
+			});
+			overlap = Measure(runs, [&]()
+			{
+				physics.Overlap(overlaps.data(), overlaps.size(), hits.data(), hitCounts.data(), allHits);
+			});
+
+			overlapCount = std::accumulate(hitCounts.begin(), hitCounts.end(), 0u);
+		}
+
+		// Queries per millisecond, in thousands of queries a second.
+		Log::Out("Physics Queries: %i bodies, %i queries, %i overlapping\n", static_cast<int>(bodies.size()), queryCount, overlapCount);
+		Log::Out("Physics Raytest Single: %fms, %fk/s\n", single, queryCount / single);
+		Log::Out("Physics Raytest Batched: %fms, %fk/s\n", batched, queryCount / batched);
+		Log::Out("Physics Raytest Batched All Hits: %fms, %fk/s\n", batchedAllHits, queryCount / batchedAllHits);
+		Log::Out("Physics Sphere Sweep Batched: %fms, %fk/s\n", sweep, queryCount / sweep);
+		Log::Out("Physics Overlap Batched All Hits: %fms, %fk/s\n", overlap, queryCount / overlap);
+		Log::Out("\n");
+	}
+}
+
+/// <summary>
+/// Benchmarks parallel loops and small jobs on job systems with more and more threads.
+/// </summary>
+void BenchmarkJobs()
+{
+	const uint32_t valueCount = 1000000;
+	const uint32_t jobCount = 10000;
+	const uint32_t runs = 20;
+
+	// The same loop on job systems with more and more workers, the thread waiting on the loop also runs ranges of it.
+	std::vector<float> values(valueCount);
+	auto loop = [&values](const std::size_t &begin, const std::size_t &end)
+	{
+		for (auto i = begin; i < end; i++)
+		{
+			values[i] = std::sqrt(std::sin(static_cast<float>(i)) * std::cos(static_cast<float>(i)) + 2.0f);
+		}
+	};
+
+	auto serial = Measure(runs, [&]()
+	{
+		loop(0, values.size());
+	});
+
+	Log::Out("Jobs: %i values, %i small jobs, %i cores\n", valueCount, jobCount, static_cast<int>(JobSystem::HardwareConcurrency));
+	Log::Out("Jobs Serial Loop: %fms\n", serial);
+
+	for (uint32_t threadCount = 1; ; threadCount = std::min(threadCount * 2, JobSystem::HardwareConcurrency))
+	{
+		JobSystem jobSystem(threadCount - 1);
+		auto parallelFor = Measure(runs, [&]()
+		{
+			jobSystem.ParallelFor(0, values.size(), 1024, loop);
+		});
+		// Jobs that do almost nothing, this measures the cost of scheduling, stealing and counting a job.
+		std::atomic<uint32_t> ran(0);
+		auto smallJobs = Measure(runs, [&]()
+		{
+			JobCounter counter;
+
+			for (uint32_t i = 0; i < jobCount; i++)
+			{
+				jobSystem.Run([&ran]()
+				{
+					ran++;
+				}, &counter);
+			}
+
+			jobSystem.Wait(counter);
+		});
+
+		Log::Out("Jobs %i Threads: Parallel For %fms (%fx), Small Jobs %fus per job\n", threadCount, parallelFor, serial / parallelFor,
+			1000.0 * smallJobs / jobCount);
+
+		if (threadCount == JobSystem::HardwareConcurrency)
+		{
+			break;
+		}
+	}
+
+	Log::Out("\n");
+}
+
+/// <summary>
+/// Benchmarks the cost of filtered, suppressed and queued log messages.
+/// </summary>
+void BenchmarkLog()
+{
+	const uint32_t messageCount = 100000;
+	const uint32_t writtenCount = 64;
+
+	// Messages below the log level are checked against an atomic and never formatted.
+	Log::SetLevel(Log::Level::Info);
+	auto filtered = Measure(messageCount, []()
+	{
+		Log::Debug("Log: filtered message %i\n", 1);
+	});
+	Log::SetLevel(Log::Level::Debug);
+
+	// Messages past the rate limit of a call site are only counted.
+	auto suppressed = Measure(messageCount, []()
+	{
+		Log::Out("Log: suppressed message %i\n", 1);
+	});
+	Log::Flush();
+
+	// The writer thread writes these to the console and file, the calling thread only formats them into the queue.
+	auto rateLimit = Log::GetRateLimit();
+	Log::SetRateLimit(0);
+	auto start = std::chrono::high_resolution_clock::now();
+
+	for (uint32_t i = 0; i < writtenCount; i++)
+	{
+		Log::Out("Log: written message %i of %i, %f\n", i, writtenCount, 0.5f * i);
+	}
+
+	auto queued = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	Log::Flush();
+	auto flushed = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	Log::SetRateLimit(rateLimit);
+
+	Log::Out("Log Filtered: %fus per message\n", 1000.0 * filtered);
+	Log::Out("Log Suppressed: %fus per message\n", 1000.0 * suppressed);
+	Log::Out("Log Queued: %fus per message, written after %fms\n", 1000.0 * queued / writtenCount, flushed);
+	Log::Out("\n");
+}
+
+/// <summary>
+/// Benchmarks culling and transforming bounds one at a time and in batches, the batched results must match.
+/// </summary>
+/// <returns> The number of checks that failed. </returns>
+uint32_t BenchmarkCulling()
+{
+	uint32_t failures = 0;
+
+	for (const std::size_t count : {100000, 1000000})
+	{
+		const uint32_t runs = 20;
+
+		// Boxes and spheres spread around a camera at the origin looking down -z, about a fifth of them are in view.
+		std::vector<float> minX(count), minY(count), minZ(count), maxX(count), maxY(count), maxZ(count), radius(count);
+
+		for (std::size_t i = 0; i < count; i++)
+		{
+			minX[i] = Maths::Random(-500.0f, 500.0f);
+			minY[i] = Maths::Random(-50.0f, 50.0f);
+			minZ[i] = Maths::Random(-500.0f, 500.0f);
+			maxX[i] = minX[i] + Maths::Random(0.5f, 4.0f);
+			maxY[i] = minY[i] + Maths::Random(0.5f, 4.0f);
+			maxZ[i] = minZ[i] + Maths::Random(0.5f, 4.0f);
+			radius[i] = Maths::Random(0.5f, 4.0f);
+		}
+
+		Frustum frustum;
+		frustum.Update(Matrix4::ViewMatrix(Vector3::Zero, Vector3::Zero), Matrix4::PerspectiveMatrix(70.0f, 16.0f / 9.0f, 0.1f, 400.0f));
+		Culling::Cubes cubes = {minX.data(), minY.data(), minZ.data(), maxX.data(), maxY.data(), maxZ.data()};
+		Culling::Spheres spheres = {minX.data(), minY.data(), minZ.data(), radius.data()};
+
+		std::size_t cubesVisible = 0;
+		std::size_t cubesVisibleBatched = 0;
+		std::size_t spheresVisible = 0;
+		std::size_t spheresVisibleBatched = 0;
+		std::vector<uint64_t> visible(Culling::GetBitsetSize(count));
+		std::vector<uint32_t> indices;
+		auto jobSystem = JobSystem::Get();
+
+		auto cubesSingle = Measure(runs, [&]()
+		{
+			cubesVisible = 0;
+
+			for (std::size_t i = 0; i < count; i++)
+			{
+				if (frustum.CubeInFrustum(Vector3(minX[i], minY[i], minZ[i]), Vector3(maxX[i], maxY[i], maxZ[i])))
+				{
+					cubesVisible++;
+				}
+			}
+		});
+		auto cubesBitset = Measure(runs, [&]()
+		{
+			cubesVisibleBatched = Culling::CubesInFrustum(frustum, cubes, count, visible.data());
+		});
+		auto cubesIndices = Measure(runs, [&]()
+		{
+			indices.clear();
+			Culling::CubesInFrustum(frustum, cubes, count, indices);
+		});
+		// Each range starts on a word of the bitset, so threads never write the same word.
+		auto cubesParallel = Measure(runs, [&]()
+		{
+			jobSystem->ParallelFor(0, visible.size(), 256, [&](const std::size_t &begin, const std::size_t &end)
+			{
+				auto first = 64 * begin;
+				auto last = std::min(count, 64 * end);
+				Culling::Cubes range = {minX.data() + first, minY.data() + first, minZ.data() + first, maxX.data() + first, maxY.data() + first, maxZ.data() + first};
+				Culling::CubesInFrustum(frustum, range, last - first, visible.data() + begin);
+			});
+		});
+
+		auto spheresSingle = Measure(runs, [&]()
+		{
+			spheresVisible = 0;
+
+			for (std::size_t i = 0; i < count; i++)
+			{
+				if (frustum.SphereInFrustum(Vector3(minX[i], minY[i], minZ[i]), radius[i]))
+				{
+					spheresVisible++;
+				}
+			}
+		});
+		auto spheresBitset = Measure(runs, [&]()
+		{
+			spheresVisibleBatched = Culling::SpheresInFrustum(frustum, spheres, count, visible.data());
+		});
+
+		std::vector<Vector4> vectors(count);
+		std::vector<Vector4> transformed(count);
+		std::vector<Matrix4> matrices(count / 4);
+		std::vector<Matrix4> multiplied(count / 4);
+		auto viewProjection = Matrix4::PerspectiveMatrix(70.0f, 16.0f / 9.0f, 0.1f, 400.0f) * Matrix4::ViewMatrix(Vector3(0.0f, 2.0f, 0.0f), Vector3::Zero);
+
+		for (std::size_t i = 0; i < count; i++)
+		{
+			vectors[i] = Vector4(minX[i], minY[i], minZ[i], 1.0f);
+		}
+
+		for (std::size_t i = 0; i < matrices.size(); i++)
+		{
+			matrices[i] = Matrix4::TransformationMatrix(Vector3(minX[i], minY[i], minZ[i]), Vector3(maxX[i], maxY[i], maxZ[i]), Vector3(radius[i], radius[i], radius[i]));
+		}
+
+		auto transformSingle = Measure(runs, [&]()
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				transformed[i] = viewProjection.Transform(vectors[i]);
+			}
+		});
+		auto transformArray = Measure(runs, [&]()
+		{
+			Matrix4::TransformArray(viewProjection, vectors.data(), transformed.data(), count);
+		});
+		auto multiplySingle = Measure(runs, [&]()
+		{
+			for (std::size_t i = 0; i < matrices.size(); i++)
+			{
+				multiplied[i] = viewProjection * matrices[i];
+			}
+		});
+		auto multiplyArray = Measure(runs, [&]()
+		{
+			Matrix4::MultiplyArray(viewProjection, matrices.data(), multiplied.data(), matrices.size());
+		});
+
+		Log::Out("Culling: %i bounds, %i cubes and %i spheres visible\n", static_cast<int>(count), static_cast<int>(cubesVisible), static_cast<int>(spheresVisible));
+
+		if (cubesVisible != cubesVisibleBatched || cubesVisible != indices.size() || spheresVisible != spheresVisibleBatched)
+		{
+			Log::Error("Culling: batched results differ, %i cubes and %i spheres visible\n", static_cast<int>(cubesVisibleBatched), static_cast<int>(spheresVisibleBatched));
+			failures++;
+		}
+
+		Log::Out("Culling Cubes Single: %fms\n", cubesSingle);
+		Log::Out("Culling Cubes Batched Bitset: %fms (%fx)\n", cubesBitset, cubesSingle / cubesBitset);
+		Log::Out("Culling Cubes Batched Indices: %fms (%fx)\n", cubesIndices, cubesSingle / cubesIndices);
+		Log::Out("Culling Cubes Batched Parallel: %fms (%fx), %i threads\n", cubesParallel, cubesSingle / cubesParallel, static_cast<int>(jobSystem->GetThreadCount()));
+		Log::Out("Culling Spheres Single: %fms\n", spheresSingle);
+		Log::Out("Culling Spheres Batched Bitset: %fms (%fx)\n", spheresBitset, spheresSingle / spheresBitset);
+		Log::Out("Transform Vectors Single: %fms\n", transformSingle);
+		Log::Out("Transform Vectors Array: %fms (%fx)\n", transformArray, transformSingle / transformArray);
+		Log::Out("Multiply %i Matrices Single: %fms\n", static_cast<int>(matrices.size()), multiplySingle);
+		Log::Out("Multiply %i Matrices Array: %fms (%fx)\n", static_cast<int>(matrices.size()), multiplyArray, multiplySingle / multiplyArray);
+		Log::Out("\n");
+	}
+
+	return failures;
+}
+
+/// <summary>
+/// Benchmarks updating world transforms from a hierarchy, the world matrices must match building them on demand.
+/// </summary>
+/// <returns> The number of checks that failed. </returns>
+uint32_t BenchmarkTransformHierarchy()
+{
+	uint32_t failures = 0;
+
+	const uint32_t treeCount = 20000;
+	const uint32_t treeSize = 10;
+	const uint32_t frames = 30;
+
+	std::vector<std::unique_ptr<Entity>> entities;
+	std::vector<Entity *> roots;
+
+	for (uint32_t i = 0; i < treeCount; i++)
+	{
+		auto first = entities.size();
+
+		for (uint32_t j = 0; j < treeSize; j++)
+		{
+			auto entity = std::make_unique<Entity>(Transform(Vector3(Maths::Random(-10.0f, 10.0f), Maths::Random(-10.0f, 10.0f), Maths::Random(-10.0f, 10.0f)),
+				Vector3(Maths::Random(0.0f, 360.0f), Maths::Random(0.0f, 360.0f), Maths::Random(0.0f, 360.0f)), Maths::Random(0.5f, 1.5f)));
+
+			if (j == 0)
+			{
+				roots.emplace_back(entity.get());
+			}
+			else
+			{
+				entity->SetParent(entities[first + static_cast<std::size_t>(Maths::Random(0.0f, static_cast<float>(j) - 0.01f))].get());
+			}
+
+			entities.emplace_back(std::move(entity));
+		}
+	}
+
+	float offset = 0.0f;
+	auto moveRoots = [&]()
+	{
+		offset += 1.0f;
+
+		for (auto &root : roots)
+		{
+			root->GetLocalTransform().SetPosition(Vector3(offset, 0.0f, 0.0f));
+		}
+	};
+
+	// Without a hierarchy every world matrix is built on demand by walking up its parents.
+	std::vector<Matrix4> expected(entities.size());
+	auto onDemand = Measure(frames, [&]()
+	{
+		moveRoots();
+
+		for (std::size_t i = 0; i < entities.size(); i++)
+		{
+			expected[i] = entities[i]->GetWorldMatrix();
+		}
+	});
+
+	TransformHierarchy hierarchy;
+
+	for (auto &entity : entities)
+	{
+		hierarchy.Add(entity.get());
+	}
+
+	hierarchy.Update();
+	auto serial = Measure(frames, [&]()
+	{
+		moveRoots();
+		hierarchy.Update();
+	});
+	auto parallel = Measure(frames, [&]()
+	{
+		moveRoots();
+		hierarchy.Update(JobSystem::Get());
+	});
+	auto unmoved = Measure(frames, [&]()
+	{
+		hierarchy.Update(JobSystem::Get());
+	});
+
+	// The last frame measured on demand is moved to again, the hierarchy must give the same world matrices.
+	offset = static_cast<float>(frames) - 1.0f;
+	moveRoots();
+	hierarchy.Update(JobSystem::Get());
+	std::size_t differences = 0;
+
+	for (std::size_t i = 0; i < entities.size(); i++)
+	{
+		if (entities[i]->GetWorldMatrix() != expected[i])
+		{
+			differences++;
+		}
+	}
+
+	Log::Out("Transform Hierarchy: %i entities in %i trees\n", static_cast<int>(entities.size()), treeCount);
+
+	if (differences != 0)
+	{
+		Log::Error("Transform Hierarchy: %i world matrices differ\n", static_cast<int>(differences));
+		failures++;
+	}
+
+	Log::Out("Transform Hierarchy On Demand: %fms\n", onDemand);
+	Log::Out("Transform Hierarchy Serial: %fms (%fx)\n", serial, onDemand / serial);
+	Log::Out("Transform Hierarchy Parallel: %fms (%fx), %i threads\n", parallel, onDemand / parallel, static_cast<int>(JobSystem::Get()->GetThreadCount()));
+	Log::Out("Transform Hierarchy Unmoved: %fms\n", unmoved);
+	Log::Out("\n");
+
+	return failures;
+}
+
+/// <summary>
+/// Benchmarks building, moving and querying a spatial tree, the queries must match a linear scan.
+/// </summary>
+/// <returns> The number of checks that failed. </returns>
+uint32_t BenchmarkSpatialTree()
+{
+	uint32_t failures = 0;
+
+	const uint32_t staticCount = 200000;
+	const uint32_t movingCount = 10000;
+	const uint32_t queryCount = 100;
+	const uint32_t frames = 10;
+	const float radius = 10.0f;
+	const float distance = 100.0f;
+
+	// Boxes are spread over a flat world a kilometre wide, the last ones move every frame.
+	std::vector<std::unique_ptr<Entity>> entities;
+	std::vector<Vector3> mins;
+	std::vector<Vector3> maxs;
+	std::vector<Vector3> velocities;
+
+	for (uint32_t i = 0; i < staticCount + movingCount; i++)
+	{
+		auto centre = Vector3(Maths::Random(-500.0f, 500.0f), Maths::Random(0.0f, 50.0f), Maths::Random(-500.0f, 500.0f));
+		auto extent = Vector3(Maths::Random(0.25f, 2.0f), Maths::Random(0.25f, 2.0f), Maths::Random(0.25f, 2.0f));
+		entities.emplace_back(std::make_unique<Entity>(Transform(centre)));
+		mins.emplace_back(centre - extent);
+		maxs.emplace_back(centre + extent);
+
+		if (i >= staticCount)
+		{
+			velocities.emplace_back(Vector3(Maths::Random(-5.0f, 5.0f), Maths::Random(-1.0f, 1.0f), Maths::Random(-5.0f, 5.0f)));
+		}
+	}
+
+	Frustum frustum;
+	frustum.Update(Matrix4::ViewMatrix(Vector3(0.0f, 20.0f, 0.0f), Vector3(10.0f, 45.0f, 0.0f)), Matrix4::PerspectiveMatrix(70.0f, 16.0f / 9.0f, 0.1f, 200.0f));
+	std::vector<Vector3> centres;
+	std::vector<Vector3> directions;
+
+	for (uint32_t i = 0; i < queryCount; i++)
+	{
+		centres.emplace_back(Vector3(Maths::Random(-500.0f, 500.0f), Maths::Random(0.0f, 50.0f), Maths::Random(-500.0f, 500.0f)));
+		directions.emplace_back(Vector3(Maths::Random(-1.0f, 1.0f), Maths::Random(-0.1f, 0.1f), Maths::Random(-1.0f, 1.0f)));
+	}
+
+	// Each frame runs one frustum query, then a sphere, cube and ray query from every centre.
+	std::vector<std::vector<Entity *>> linearResults(1 + 3 * queryCount);
+	std::vector<std::vector<Entity *>> treeResults(1 + 3 * queryCount);
+
+	SpatialTree tree;
+	auto build = Measure(1, [&]()
+	{
+		for (std::size_t i = 0; i < entities.size(); i++)
+		{
+			tree.Add(entities[i].get(), mins[i], maxs[i]);
+		}
+	});
+
+	std::size_t reinserted = 0;
+	auto move = Measure(frames, [&]()
+	{
+		for (uint32_t i = 0; i < movingCount; i++)
+		{
+			auto index = staticCount + i;
+			auto offset = velocities[i] * (1.0f / 60.0f);
+			mins[index] += offset;
+			maxs[index] += offset;
+
+			if (tree.Move(entities[index].get(), mins[index], maxs[index]))
+			{
+				reinserted++;
+			}
+		}
+	});
+	auto queries = Measure(frames, [&]()
+	{
+		for (auto &result : treeResults)
+		{
+			result.clear();
+		}
+
+		tree.QueryFrustum(frustum, treeResults[0]);
+
+		for (uint32_t j = 0; j < queryCount; j++)
+		{
+			tree.QuerySphere(centres[j], radius, treeResults[1 + j]);
+			tree.QueryCube(centres[j] - radius, centres[j] + radius, treeResults[1 + queryCount + j]);
+			tree.QueryRay(centres[j], directions[j], distance, treeResults[1 + 2 * queryCount + j]);
+		}
+	});
+	auto linear = Measure(1, [&]()
+	{
+		for (auto &result : linearResults)
+		{
+			result.clear();
+		}
+
+		for (std::size_t i = 0; i < entities.size(); i++)
+		{
+			if (frustum.CubeInFrustum(mins[i], maxs[i]))
+			{
+				linearResults[0].emplace_back(entities[i].get());
+			}
+		}
+
+		for (uint32_t j = 0; j < queryCount; j++)
+		{
+			auto cubeMin = centres[j] - radius;
+			auto cubeMax = centres[j] + radius;
+			auto normal = directions[j] / directions[j].Length();
+			auto inverse = Vector3(1.0f / normal.m_x, 1.0f / normal.m_y, 1.0f / normal.m_z);
+
+			for (std::size_t i = 0; i < entities.size(); i++)
+			{
+				auto closest = Vector3::MaxVector(mins[i], Vector3::MinVector(centres[j], maxs[i]));
+
+				if ((closest - centres[j]).LengthSquared() <= radius * radius)
+				{
+					linearResults[1 + j].emplace_back(entities[i].get());
+				}
+
+				if (mins[i].m_x <= cubeMax.m_x && mins[i].m_y <= cubeMax.m_y && mins[i].m_z <= cubeMax.m_z &&
+					cubeMin.m_x <= maxs[i].m_x && cubeMin.m_y <= maxs[i].m_y && cubeMin.m_z <= maxs[i].m_z)
+				{
+					linearResults[1 + queryCount + j].emplace_back(entities[i].get());
+				}
+
+				float enter = 0.0f;
+				float leave = distance;
+				bool hit = true;
+
+				for (uint32_t k = 0; k < 3 && hit; k++)
+				{
+					if (normal[k] == 0.0f)
+					{
+						hit = centres[j][k] >= mins[i][k] && centres[j][k] <= maxs[i][k];
+						continue;
+					}
+
+					auto t1 = (mins[i][k] - centres[j][k]) * inverse[k];
+					auto t2 = (maxs[i][k] - centres[j][k]) * inverse[k];
+					enter = std::max(enter, std::min(t1, t2));
+					leave = std::min(leave, std::max(t1, t2));
+					hit = enter <= leave;
+				}
+
+				if (hit)
+				{
+					linearResults[1 + 2 * queryCount + j].emplace_back(entities[i].get());
+				}
+			}
+		}
+	});
+
+	std::size_t found = 0;
+	std::size_t differences = 0;
+
+	for (std::size_t i = 0; i < treeResults.size(); i++)
+	{
+		std::sort(linearResults[i].begin(), linearResults[i].end());
+		std::sort(treeResults[i].begin(), treeResults[i].end());
+		found += treeResults[i].size();
+
+		if (linearResults[i] != treeResults[i])
+		{
+			differences++;
+		}
+	}
+
+	Log::Out("Spatial: %i static and %i moving entities, %i queries found %i entities\n", staticCount, movingCount, static_cast<int>(treeResults.size()),
+		static_cast<int>(found));
+
+	if (differences != 0)
+	{
+		Log::Error("Spatial: %i tree queries differ from the linear scan\n", static_cast<int>(differences));
+		failures++;
+	}
+
+	Log::Out("Spatial Tree Build: %fms, height %i\n", build, tree.GetHeight());
+	Log::Out("Spatial Tree Move: %fms, %i of %i moves inserted again\n", move, static_cast<int>(reinserted), static_cast<int>(frames * movingCount));
+	Log::Out("Spatial Linear Queries: %fms\n", linear);
+	Log::Out("Spatial Tree Queries: %fms (%fx)\n", queries, linear / queries);
+	Log::Out("\n");
+
+	return failures;
+}
+
+/// <summary>
+/// Checks the queries of a scene structure after entities are added, moved and removed, they must match a linear scan.
+/// Entities without a collision object are kept as points, so they are placed on a grid that rays along an axis hit exactly.
+/// </summary>
+/// <returns> The number of checks that failed. </returns>
+uint32_t TestSceneStructure()
+{
+	uint32_t failures = 0;
+
+	const uint32_t entityCount = 20000;
+	const uint32_t queryCount = 100;
+	const float radius = 10.0f;
+	const float distance = 100.0f;
+
+	auto randomPoint = []()
+	{
+		return Vector3(std::round(Maths::Random(-20.0f, 20.0f)), std::round(Maths::Random(0.0f, 5.0f)), std::round(Maths::Random(-100.0f, 100.0f)));
+	};
+
+	SceneStructure scene;
+	std::vector<Entity *> entities;
+
+	for (uint32_t i = 0; i < entityCount; i++)
+	{
+		entities.emplace_back(scene.CreateEntity(Transform(randomPoint())));
+	}
+
+	scene.Update();
+
+	// Every fourth entity moves, every tenth is removed now or flagged to be removed in the next update.
+	for (uint32_t i = 0; i < entityCount; i++)
+	{
+		if (i % 4 == 0)
+		{
+			entities[i]->GetLocalTransform().SetPosition(randomPoint());
+		}
+
+		if (i % 10 == 1)
+		{
+			scene.Remove(entities[i]);
+			entities[i] = nullptr;
+		}
+		else if (i % 10 == 2)
+		{
+			entities[i]->SetRemoved(true);
+			entities[i] = nullptr;
+		}
+	}
+
+	scene.Update();
+
+	// Entities flagged after the update are still in the tree, queries must skip them.
+	for (uint32_t i = 0; i < entityCount; i++)
+	{
+		if (i % 10 == 3 && entities[i] != nullptr)
+		{
+			entities[i]->SetRemoved(true);
+		}
+	}
+
+	entities.erase(std::remove_if(entities.begin(), entities.end(), [](Entity *entity)
+	{
+		return entity == nullptr || entity->IsRemoved();
+	}), entities.end());
+
+	Frustum frustum;
+	frustum.Update(Matrix4::ViewMatrix(Vector3(0.0f, 2.0f, 120.0f), Vector3(0.0f, 0.0f, 0.0f)), Matrix4::PerspectiveMatrix(70.0f, 16.0f / 9.0f, 0.1f, 100.0f));
+	std::vector<std::vector<Entity *>> linearResults(1 + 3 * queryCount);
+	std::vector<std::vector<Entity *>> sceneResults(1 + 3 * queryCount);
+
+	sceneResults[0] = scene.QueryFrustum(frustum);
+
+	for (auto entity : entities)
+	{
+		auto position = entity->GetWorldTransform().GetPosition();
+
+		if (frustum.CubeInFrustum(position, position))
+		{
+			linearResults[0].emplace_back(entity);
+		}
+	}
+
+	for (uint32_t j = 0; j < queryCount; j++)
+	{
+		auto centre = randomPoint();
+		// With identity matrices the ray from the centre of the screen points down the negative z axis.
+		Ray ray(false, Vector2::Zero);
+		ray.Update(centre + Vector3(0.0f, 0.0f, 50.0f), Vector2::Zero, Matrix4(), Matrix4());
+		sceneResults[1 + j] = scene.QuerySphere(centre, radius);
+		sceneResults[1 + queryCount + j] = scene.QueryCube(centre - radius, centre + radius);
+		sceneResults[1 + 2 * queryCount + j] = scene.QueryRay(ray, distance);
+
+		for (auto entity : entities)
+		{
+			auto position = entity->GetWorldTransform().GetPosition();
+
+			if ((position - centre).LengthSquared() <= radius * radius)
+			{
+				linearResults[1 + j].emplace_back(entity);
+			}
+
+			if (std::abs(position.m_x - centre.m_x) <= radius && std::abs(position.m_y - centre.m_y) <= radius && std::abs(position.m_z - centre.m_z) <= radius)
+			{
+				linearResults[1 + queryCount + j].emplace_back(entity);
+			}
+
+			auto along = ray.GetOrigin().m_z - position.m_z;
+
+			if (position.m_x == ray.GetOrigin().m_x && position.m_y == ray.GetOrigin().m_y && along >= 0.0f && along <= distance)
+			{
+				linearResults[1 + 2 * queryCount + j].emplace_back(entity);
+			}
+		}
+	}
+
+	std::size_t found = 0;
+	std::size_t differences = 0;
+
+	for (std::size_t i = 0; i < sceneResults.size(); i++)
+	{
+		std::sort(linearResults[i].begin(), linearResults[i].end());
+		std::sort(sceneResults[i].begin(), sceneResults[i].end());
+		found += sceneResults[i].size();
+
+		if (linearResults[i] != sceneResults[i])
+		{
+			differences++;
+		}
+	}
+
+	Log::Out("Scene Structure: %i entities, %i queries found %i entities\n", static_cast<int>(entities.size()), static_cast<int>(sceneResults.size()),
+		static_cast<int>(found));
+
+	if (differences != 0)
+	{
+		Log::Error("Scene Structure: %i queries differ from the linear scan\n", static_cast<int>(differences));
+		failures++;
+	}
+
+	Log::Out("\n");
+
+	return failures;
+}
+
+int main(int argc, char **argv)
+{
+	// The resources directory can be given as the first argument, the test passes the one in the source tree.
+	std::string resourcesDirectory = argc > 1 ? argv[1] : "Resources";
+	uint32_t failures = 0;
+	failures += BenchmarkParticles();
+	BenchmarkAnimations();
+	BenchmarkEntities();
+	BenchmarkObj();
+	failures += TestJsonDocuments();
+	failures += TestBinaryRoundTrips(resourcesDirectory);
+	BenchmarkString();
+	BenchmarkShaderCache();
+	BenchmarkMemoryBlock();
+	BenchmarkPhysics();
+	BenchmarkJobs();
+	BenchmarkLog();
+	failures += BenchmarkCulling();
+	failures += BenchmarkTransformHierarchy();
+	failures += BenchmarkSpatialTree();
+	failures += TestSceneStructure();
+
+	if (failures != 0)
+	{
+		Log::Error("Benchmarks: %i checks failed\n", failures);
+	}
+
+	// Pauses the console.
+	std::cout << "Press enter to continue...";
+	std::cin.get();
+	return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1,4 +1,7 @@
+#include <chrono>
 #include <iostream>
+#include <random>
+#include <vector>
 #include <Engine/Log.hpp>
 #include <Maths/Maths.hpp>
 #include <Maths/Time.hpp>
@@ -11,6 +14,7 @@
 #include <Maths/Vector3.hpp>
 #include <Maths/Vector4.hpp>
 #include <Maths/Transform.hpp>
+#include "Reference.hpp"
 
 /*#include <Engine/Engine.hpp>
 #include <Files/File.hpp>
@@ -21,6 +25,47 @@
 
 using namespace acid;
 
+/// <summary>
+/// Runs a function a number of times and gets the average time of each run in milliseconds.
+/// </summary>
+template<typename F>
+double Measure(const uint32_t &runs, F function)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+
+	for (uint32_t i = 0; i < runs; i++)
+	{
+		function();
+	}
+
+	auto end = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration<double, std::milli>(end - start).count() / runs;
+}
+
+/// <summary>
+/// Gets the largest difference between two matrices.
+/// </summary>
+float Difference(const Matrix4 &left, const Matrix4 &right)
+{
+	float result = 0.0f;
+
+	for (int32_t i = 0; i < 4; i++)
+	{
+		for (int32_t j = 0; j < 4; j++)
+		{
+			result = std::max(result, std::fabs(left[i][j] - right[i][j]));
+		}
+	}
+
+	return result;
+}
+
+float Difference(const Vector4 &left, const Vector4 &right)
+{
+	return std::max(std::max(std::fabs(left.m_x - right.m_x), std::fabs(left.m_y - right.m_y)),
+		std::max(std::fabs(left.m_z - right.m_z), std::fabs(left.m_w - right.m_w)));
+}
+
 int main(int argc, char **argv)
 {
 	/*auto engine = std::make_unique<Engine>(argv[0], true);
@@ -119,7 +164,194 @@ int main(int argc, char **argv)
 		Log::Out("\n");
 	}
 
+	{
+		const uint32_t count = 4096;
+		const uint32_t runs = 200;
+
+		std::mt19937 generator(7);
+		std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+		auto random = [&]() { return distribution(generator); };
+
+		std::vector<Matrix4> matrices(count);
+		std::vector<Vector4> vectors(count);
+		std::vector<Quaternion> quaternions(count);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			// Rotation, scale and translation keeps the matrices well conditioned for the inverse.
+			auto rotation = Quaternion(random(), random(), random(), random()).Normalize();
+			matrices[i] = Matrix4::TransformationMatrix(Vector3(random(), random(), random()), rotation,
+				Vector3(1.0f + std::fabs(random()), 1.0f + std::fabs(random()), 1.0f + std::fabs(random())));
+			vectors[i] = Vector4(random(), random(), random(), random());
+			quaternions[i] = rotation;
+		}
+
+		std::vector<Matrix4> matrixResults(count);
+		std::vector<Matrix4> matrixReferences(count);
+		std::vector<Vector4> vectorResults(count);
+		std::vector<Vector4> vectorReferences(count);
+		std::vector<Quaternion> quaternionResults(count);
+		std::vector<Quaternion> quaternionReferences(count);
+		std::vector<float> dotResults(count);
+		std::vector<float> dotReferences(count);
+
+		auto compare = [&](const char *name, auto current, auto reference, auto difference)
+		{
+			auto currentTime = Measure(runs, current);
+			auto referenceTime = Measure(runs, reference);
+			float error = 0.0f;
+
+			for (uint32_t i = 0; i < count; i++)
+			{
+				error = std::max(error, difference(i));
+			}
+
+			Log::Out("  %s: %fms, reference %fms, %.2fx, max error %g\n", name, currentTime, referenceTime, referenceTime / currentTime, error);
+		};
+		auto matrixDifference = [&](const uint32_t &i) { return Difference(matrixResults[i], matrixReferences[i]); };
+		auto vectorDifference = [&](const uint32_t &i) { return Difference(vectorResults[i], vectorReferences[i]); };
+
+		Log::Out("Benchmarks (%i elements, %i runs):\n", static_cast<int>(count), static_cast<int>(runs));
+		compare("Vector4 Add", [&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				vectorResults[i] = vectors[i] + vectors[count - 1 - i];
+			}
+		}, [&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				vectorReferences[i] = Reference::Add(vectors[i], vectors[count - 1 - i]);
+			}
+		}, vectorDifference);
+		compare("Vector4 Dot", [&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				dotResults[i] = vectors[i].Dot(vectors[count - 1 - i]);
+			}
+		}, [&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				dotReferences[i] = Reference::Dot(vectors[i], vectors[count - 1 - i]);
+			}
+		}, [&](const uint32_t &i) { return std::fabs(dotResults[i] - dotReferences[i]) / std::max(1.0f, std::fabs(dotReferences[i])); });
+		compare("Vector3 Cross", [&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				vectorResults[i] = Vector4(Vector3(vectors[i]).Cross(Vector3(vectors[count - 1 - i])));
+			}
+		}, [&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				vectorReferences[i] = Vector4(Reference::Cross(Vector3(vectors[i]), Vector3(vectors[count - 1 - i])));
+			}
+		}, vectorDifference);
+		compare("Quaternion Multiply", [&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				quaternionResults[i] = quaternions[i] * quaternions[count - 1 - i];
+			}
+		}, [&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				quaternionReferences[i] = Reference::Multiply(quaternions[i], quaternions[count - 1 - i]);
+			}
+		}, [&](const uint32_t &i)
+		{
+			auto &a = quaternionResults[i];
+			auto &b = quaternionReferences[i];
+			return Difference(Vector4(a.m_x, a.m_y, a.m_z, a.m_w), Vector4(b.m_x, b.m_y, b.m_z, b.m_w));
+		});
+		compare("Matrix4 Add", [&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				matrixResults[i] = matrices[i] + matrices[count - 1 - i];
+			}
+		}, [&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				matrixReferences[i] = Reference::Add(matrices[i], matrices[count - 1 - i]);
+			}
+		}, matrixDifference);
+		compare("Matrix4 Multiply", [&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				matrixResults[i] = matrices[i] * matrices[count - 1 - i];
+			}
+		}, [&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				matrixReferences[i] = Reference::Multiply(matrices[i], matrices[count - 1 - i]);
+			}
+		}, [&](const uint32_t &i) { return Difference(matrixResults[i], matrixReferences[i]) / 100.0f; });
+		compare("Matrix4 Transform", [&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				vectorResults[i] = matrices[i].Transform(vectors[i]);
+			}
+		}, [&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				vectorReferences[i] = Reference::Transform(matrices[i], vectors[i]);
+			}
+		}, [&](const uint32_t &i) { return Difference(vectorResults[i], vectorReferences[i]) / 100.0f; });
+		compare("Matrix4 Transpose", [&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				matrixResults[i] = matrices[i].Transpose();
+			}
+		}, [&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				matrixReferences[i] = Reference::Transpose(matrices[i]);
+			}
+		}, matrixDifference);
+		compare("Matrix4 Determinant", [&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				dotResults[i] = matrices[i].Determinant();
+			}
+		}, [&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				dotReferences[i] = Reference::Determinant(matrices[i]);
+			}
+		}, [&](const uint32_t &i) { return std::fabs(dotResults[i] - dotReferences[i]) / std::max(1.0f, std::fabs(dotReferences[i])); });
+		compare("Matrix4 Invert", [&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				matrixResults[i] = matrices[i].Invert();
+			}
+		}, [&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				matrixReferences[i] = Reference::Invert(matrices[i]);
+			}
+		}, matrixDifference);
+		Log::Out("\n");
+	}
+
 	// Pauses the console.
+	Log::Flush();
 	std::cout << "Press enter to continue...";
 	std::cin.get();
 	return EXIT_SUCCESS;
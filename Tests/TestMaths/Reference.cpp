@@ -0,0 +1,126 @@
+#include "Reference.hpp"
+
+#include <cstring>
+#include <Maths/Matrix3.hpp>
+
+Vector4 Reference::Add(const Vector4 &left, const Vector4 &right)
+{
+	return Vector4(left.m_x + right.m_x, left.m_y + right.m_y, left.m_z + right.m_z, left.m_w + right.m_w);
+}
+
+float Reference::Dot(const Vector4 &left, const Vector4 &right)
+{
+	return left.m_x * right.m_x + left.m_y * right.m_y + left.m_z * right.m_z + left.m_w * right.m_w;
+}
+
+Vector3 Reference::Cross(const Vector3 &left, const Vector3 &right)
+{
+	return Vector3(left.m_y * right.m_z - left.m_z * right.m_y, right.m_x * left.m_z - right.m_z * left.m_x, left.m_x * right.m_y - left.m_y * right.m_x);
+}
+
+Quaternion Reference::Multiply(const Quaternion &left, const Quaternion &right)
+{
+	return Quaternion(left.m_x * right.m_w + left.m_w * right.m_x + left.m_y * right.m_z - left.m_z * right.m_y,
+		left.m_y * right.m_w + left.m_w * right.m_y + left.m_z * right.m_x - left.m_x * right.m_z,
+		left.m_z * right.m_w + left.m_w * right.m_z + left.m_x * right.m_y - left.m_y * right.m_x,
+		left.m_w * right.m_w - left.m_x * right.m_x - left.m_y * right.m_y - left.m_z * right.m_z);
+}
+
+Matrix4 Reference::Add(const Matrix4 &left, const Matrix4 &right)
+{
+	Matrix4 result;
+	memset(result.m_rows, 0, 4 * sizeof(Vector4));
+
+	for (int32_t row = 0; row < 4; row++)
+	{
+		for (int32_t col = 0; col < 4; col++)
+		{
+			result[row][col] = left[row][col] + right[row][col];
+		}
+	}
+
+	return result;
+}
+
+Matrix4 Reference::Multiply(const Matrix4 &left, const Matrix4 &right)
+{
+	Matrix4 result;
+
+	for (int32_t row = 0; row < 4; row++)
+	{
+		for (int32_t col = 0; col < 4; col++)
+		{
+			result[row][col] = left[0][col] * right[row][0] + left[1][col] * right[row][1] + left[2][col] * right[row][2] + left[3][col] * right[row][3];
+		}
+	}
+
+	return result;
+}
+
+Vector4 Reference::Transform(const Matrix4 &left, const Vector4 &right)
+{
+	Vector4 result;
+
+	for (int32_t row = 0; row < 4; row++)
+	{
+		result[row] = left[0][row] * right.m_x + left[1][row] * right.m_y + left[2][row] * right.m_z + left[3][row] * right.m_w;
+	}
+
+	return result;
+}
+
+Matrix4 Reference::Transpose(const Matrix4 &matrix)
+{
+	Matrix4 result;
+
+	for (int32_t row = 0; row < 4; row++)
+	{
+		for (int32_t col = 0; col < 4; col++)
+		{
+			result[row][col] = matrix[col][row];
+		}
+	}
+
+	return result;
+}
+
+float Reference::Determinant(const Matrix4 &matrix)
+{
+	float result = 0.0f;
+
+	for (int32_t i = 0; i < 4; i++)
+	{
+		// Get minor of element [0][i].
+		float minor = matrix.GetSubmatrix(0, i).Determinant();
+
+		// If this is an odd-numbered row, negate the value.
+		float factor = (i % 2 == 1) ? -1.0f : 1.0f;
+
+		result += factor * matrix[0][i] * minor;
+	}
+
+	return result;
+}
+
+Matrix4 Reference::Invert(const Matrix4 &matrix)
+{
+	Matrix4 result;
+	float det = Determinant(matrix);
+
+	for (int32_t j = 0; j < 4; j++)
+	{
+		for (int32_t i = 0; i < 4; i++)
+		{
+			// Get minor of element [j][i] - not [i][j], this is where the transpose happens.
+			float minor = matrix.GetSubmatrix(j, i).Determinant();
+
+			// Multiply by (−1)^{i+j}.
+			float factor = ((i + j) % 2 == 1) ? -1.0f : 1.0f;
+			float cofactor = minor * factor;
+
+			result[i][j] = cofactor / det;
+		}
+	}
+
+	return result;
+}
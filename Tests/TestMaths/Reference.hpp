@@ -0,0 +1,36 @@
+#pragma once
+
+#include <Maths/Matrix4.hpp>
+#include <Maths/Quaternion.hpp>
+#include <Maths/Vector3.hpp>
+#include <Maths/Vector4.hpp>
+
+using namespace acid;
+
+/// <summary>
+/// The scalar maths the engine used before the SIMD classes, kept out of line in its own source file so the compiler cannot inline it.
+/// The benchmarks compare the maths classes against these, and check both give the same results.
+/// </summary>
+class Reference
+{
+public:
+	static Vector4 Add(const Vector4 &left, const Vector4 &right);
+
+	static float Dot(const Vector4 &left, const Vector4 &right);
+
+	static Vector3 Cross(const Vector3 &left, const Vector3 &right);
+
+	static Quaternion Multiply(const Quaternion &left, const Quaternion &right);
+
+	static Matrix4 Add(const Matrix4 &left, const Matrix4 &right);
+
+	static Matrix4 Multiply(const Matrix4 &left, const Matrix4 &right);
+
+	static Vector4 Transform(const Matrix4 &left, const Vector4 &right);
+
+	static Matrix4 Transpose(const Matrix4 &matrix);
+
+	static float Determinant(const Matrix4 &matrix);
+
+	static Matrix4 Invert(const Matrix4 &matrix);
+};
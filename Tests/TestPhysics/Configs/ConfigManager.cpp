@@ -40,6 +40,7 @@ namespace test
 		Window::Get()->SetFloating(graphicsData->GetChildDefault<bool>("Floating", false));
 		Window::Get()->SetFullscreen(graphicsData->GetChildDefault<bool>("Fullscreen", false));
 		Engine::Get()->SetFpsLimit(graphicsData->GetChildDefault<float>("FPS Limit", 0.0f));
+		Renderer::Get()->SetMultithreaded(graphicsData->GetChildDefault<bool>("Multithreaded Recording", false));
 	}
 
 	void ConfigManager::Save()
@@ -60,6 +61,7 @@ namespace test
 		graphicsData->SetChild<bool>("Floating", Window::Get()->IsFloating());
 		graphicsData->SetChild<bool>("Fullscreen", Window::Get()->IsFullscreen());
 		graphicsData->SetChild<float>("FPS Limit", Engine::Get()->GetFpsLimit());
+		graphicsData->SetChild<bool>("Multithreaded Recording", Renderer::Get()->IsMultithreaded());
 		m_graphics.Write();
 	}
 }
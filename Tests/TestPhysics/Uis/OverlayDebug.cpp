@@ -3,6 +3,7 @@
 #include <Maths/Visual/DriverConstant.hpp>
 #include <Scenes/Scenes.hpp>
 #include <Guis/Gui.hpp>
+#include <Renderer/Renderer.hpp>
 #include "World/World.hpp"
 
 namespace test
@@ -13,6 +14,7 @@ namespace test
 		m_textFps(this, UiBound(Vector2(0.002f, 0.978f), UiReference::BottomLeft), 1.1f, "", FontType::Create("Fonts/ProximaNova", "Regular"), Text::Justify::Left, 1.0f, Colour::White),
 		m_textUps(this, UiBound(Vector2(0.002f, 0.958f), UiReference::BottomLeft), 1.1f, "", FontType::Create("Fonts/ProximaNova", "Regular"), Text::Justify::Left, 1.0f, Colour::White),
 		m_textTime(this, UiBound(Vector2(0.002f, 0.938f), UiReference::BottomLeft), 1.1f, "", FontType::Create("Fonts/ProximaNova", "Regular"), Text::Justify::Left, 1.0f, Colour::White),
+		m_textRecordTime(this, UiBound(Vector2(0.002f, 0.918f), UiReference::BottomLeft), 1.1f, "", FontType::Create("Fonts/ProximaNova", "Regular"), Text::Justify::Left, 1.0f, Colour::White),
 		m_timerUpdate(Time::Seconds(0.5f))
 	{
 	}
@@ -22,6 +24,8 @@ namespace test
 		m_textFrameTime.SetString("Frame Time: " + String::To(1000.0f / Engine::Get()->GetFps()) + "ms");
 		m_textFps.SetString("FPS: " + String::To(Engine::Get()->GetFps()));
 		m_textUps.SetString("UPS: " + String::To(Engine::Get()->GetUps()));
+		m_textRecordTime.SetString("Record Time: " + String::To(Renderer::Get()->GetRecordTime().AsMicroseconds() / 1000.0f) + "ms" +
+			(Renderer::Get()->IsMultithreaded() ? " (Multithreaded)" : ""));
 
 		if (m_timerUpdate.IsPassedTime())
 		{
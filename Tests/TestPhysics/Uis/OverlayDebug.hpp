@@ -20,6 +20,7 @@ namespace test
 		Text m_textFps;
 		Text m_textUps;
 		Text m_textTime;
+		Text m_textRecordTime;
 		Timer m_timerUpdate;
 	};
 }
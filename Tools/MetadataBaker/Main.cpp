@@ -0,0 +1,104 @@
+#include <fstream>
+#include <memory>
+#include <Engine/Log.hpp>
+#include <Files/FileSystem.hpp>
+#include <Helpers/String.hpp>
+#include <Serialized/Binary/Binary.hpp>
+#include <Serialized/Json/Json.hpp>
+#include <Serialized/Xml/Xml.hpp>
+#include <Serialized/Yaml/Yaml.hpp>
+
+using namespace acid;
+
+/// <summary>
+/// Bakes every text metadata document in the given directories (Resources by default) into a binary copy next to it,
+/// <seealso cref="File#Read()"/> loads the binary copy in place of the text document when it is up to date.
+/// Usage: MetadataBaker [--force] [directories...]
+/// </summary>
+int main(int argc, char **argv)
+{
+	auto force = false;
+	std::vector<std::string> directories;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string argument = argv[i];
+
+		if (argument == "--force")
+		{
+			force = true;
+			continue;
+		}
+
+		directories.emplace_back(argument);
+	}
+
+	if (directories.empty())
+	{
+		directories.emplace_back("Resources");
+	}
+
+	uint32_t baked = 0;
+	uint32_t skipped = 0;
+	uint32_t failed = 0;
+
+	for (const auto &directory : directories)
+	{
+		if (!FileSystem::IsDirectory(directory))
+		{
+			Log::Error("Directory '%s' does not exist\n", directory.c_str());
+			failed++;
+			continue;
+		}
+
+		for (const auto &filename : FileSystem::FilesInPath(directory))
+		{
+			auto suffix = String::Lowercase(FileSystem::FileSuffix(filename));
+			std::unique_ptr<Metadata> metadata;
+
+			if (suffix == ".json")
+			{
+				metadata = std::make_unique<Json>();
+			}
+			else if (suffix == ".yaml" || suffix == ".yml")
+			{
+				metadata = std::make_unique<Yaml>();
+			}
+			else if (suffix == ".xml" || suffix == ".dae")
+			{
+				metadata = std::make_unique<Xml>("");
+			}
+			else
+			{
+				continue;
+			}
+
+			auto bakedFilename = filename + Binary::Extension;
+
+			if (!force && FileSystem::Exists(bakedFilename) && FileSystem::LastModified(bakedFilename) >= FileSystem::LastModified(filename))
+			{
+				skipped++;
+				continue;
+			}
+
+			std::ifstream inStream(filename, std::ios::binary);
+			metadata->Load(&inStream);
+
+			std::ofstream outStream(bakedFilename, std::ios::binary);
+			Binary::Write(*metadata, &outStream);
+
+			if (!outStream)
+			{
+				Log::Error("Failed to write '%s'\n", bakedFilename.c_str());
+				failed++;
+				continue;
+			}
+
+			Log::Out("Baked '%s'\n", bakedFilename.c_str());
+			baked++;
+		}
+	}
+
+	Log::Out("Baked %i documents, %i up to date, %i failed\n", baked, skipped, failed);
+	return failed == 0 ? 0 : 1;
+}